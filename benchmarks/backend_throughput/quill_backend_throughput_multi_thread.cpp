@@ -0,0 +1,94 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/NullSink.h"
+
+static constexpr size_t total_messages = 1'000'000;
+static constexpr size_t max_thread_count = 256;
+
+/**
+ * Measures the backend throughput while merging the events of an increasing number of producer
+ * threads. The frontend queues are filled first, then the backend is run on this thread through
+ * the ManualBackendWorker and the time to drain all of them is measured.
+ */
+int main()
+{
+  quill::ManualBackendWorker* backend = quill::Backend::acquire_manual_backend_worker();
+  quill::BackendOptions backend_options;
+
+  // The unbounded queues grow while they are filled, do not report it
+  backend_options.error_notifier = [](std::string const&) {};
+  backend->init(backend_options);
+
+  quill::Logger* logger = quill::Frontend::create_or_get_logger(
+    "bench_logger", quill::Frontend::create_or_get_sink<quill::NullSink>("null_sink"),
+    quill::PatternFormatterOptions{
+      "%(time) [%(thread_id)] %(short_source_location) %(log_level) %(message)", "%H:%M:%S.%Qns",
+      quill::Timezone::LocalTime, false});
+
+  std::cout << "threads | throughput million msgs/sec | total time ms\n";
+
+  for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+  {
+    size_t const messages_per_thread = total_messages / thread_count;
+
+    std::atomic<size_t> producers_done{0};
+    std::promise<void> release_producers;
+    std::shared_future<void> const producers_released = release_producers.get_future().share();
+
+    std::vector<std::thread> producers;
+    producers.reserve(thread_count);
+
+    for (size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+      producers.emplace_back(
+        [logger, messages_per_thread, &producers_done, producers_released]()
+        {
+          for (size_t i = 0; i < messages_per_thread; ++i)
+          {
+            LOG_INFO(logger, "Iteration: {} int: {} double: {}", i, i * 2, static_cast<double>(i) / 2);
+          }
+
+          producers_done.fetch_add(1);
+
+          // Stay alive without using the cpu until the backend has drained the queue
+          producers_released.wait();
+        });
+    }
+
+    while (producers_done.load() != thread_count)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    auto const start_time = std::chrono::steady_clock::now();
+    backend->poll();
+    auto const delta = std::chrono::steady_clock::now() - start_time;
+
+    release_producers.set_value();
+
+    for (auto& producer : producers)
+    {
+      producer.join();
+    }
+
+    // Let the backend release the queues of the finished threads, this happens on an idle poll
+    backend->poll_one();
+
+    auto const delta_d = std::chrono::duration_cast<std::chrono::duration<double>>(delta).count();
+
+    std::cout << fmtquill::format("{:>7} | {:>27.2f} | {:>13}\n", thread_count,
+                                  static_cast<double>(messages_per_thread * thread_count) / delta_d / 1e6,
+                                  std::chrono::duration_cast<std::chrono::milliseconds>(delta).count());
+  }
+
+  backend->shutdown();
+}
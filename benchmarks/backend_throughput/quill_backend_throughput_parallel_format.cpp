@@ -0,0 +1,73 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+static constexpr size_t total_iterations = 1'000'000;
+static constexpr size_t max_formatter_threads = 8;
+
+/**
+ * Measures the backend throughput for 1 to max_formatter_threads formatter threads.
+ * The messages are queued before the backend starts, so only the backend processing is measured.
+ */
+int main()
+{
+  // Create a file sink to write to a file
+  std::shared_ptr<quill::Sink> file_sink = quill::Frontend::create_or_get_sink<quill::FileSink>(
+    "quill_backend_parallel_format.log",
+    []()
+    {
+      quill::FileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      return cfg;
+    }(),
+    quill::FileEventNotifier{});
+
+  quill::Logger* logger = quill::Frontend::create_or_get_logger(
+    "bench_logger", std::move(file_sink),
+    quill::PatternFormatterOptions{
+      "%(time) [%(thread_id)] %(short_source_location) %(log_level) %(message)", "%H:%M:%S.%Qns",
+      quill::Timezone::LocalTime, false});
+
+  std::string const text{"some text to format"};
+
+  for (size_t formatter_threads = 1; formatter_threads <= max_formatter_threads; ++formatter_threads)
+  {
+    for (size_t iteration = 0; iteration < total_iterations; ++iteration)
+    {
+      LOG_INFO(logger, "Iteration: {} double: {:.6f} hex: {:#x} text: {:>24} sci: {:e}", iteration,
+               static_cast<double>(iteration) / 3, iteration, text, static_cast<double>(iteration) * 1e5);
+    }
+
+    quill::BackendOptions backend_options;
+    backend_options.sleep_duration = std::chrono::nanoseconds{0};
+    backend_options.formatter_threads = formatter_threads;
+    backend_options.error_notifier = [](std::string const&) {};
+
+    // start counting the time until backend worker finishes
+    auto const start_time = std::chrono::steady_clock::now();
+
+    quill::Backend::start(backend_options);
+
+    // block until all messages are flushed
+    logger->flush_log(0);
+
+    auto const end_time = std::chrono::steady_clock::now();
+
+    quill::Backend::stop();
+
+    auto const delta = end_time - start_time;
+    auto delta_d = std::chrono::duration_cast<std::chrono::duration<double>>(delta).count();
+
+    std::cout << fmtquill::format(
+                   "formatter_threads: {} throughput is {:.2f} million msgs/sec average, total time "
+                   "elapsed: {} ms for {} log messages",
+                   formatter_threads, total_iterations / delta_d / 1e6,
+                   std::chrono::duration_cast<std::chrono::milliseconds>(delta).count(), total_iterations)
+              << std::endl;
+  }
+}
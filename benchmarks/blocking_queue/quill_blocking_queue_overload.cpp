@@ -0,0 +1,128 @@
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Sustained overload of a blocking queue: the producers log faster than the backend can write to
+ * the file, so they spend most of the run blocked on a full queue. Compares the default polling
+ * wait against FrontendOptions::blocking_queue_futex_wait.
+ *
+ * Reports the process CPU time, the throughput and the latency of a single log call.
+ */
+static constexpr size_t number_of_threads = 4;
+static constexpr size_t messages_per_thread = 500'000;
+
+struct PollingFrontendOptions : quill::FrontendOptions
+{
+  static constexpr quill::QueueType queue_type = quill::QueueType::BoundedBlocking;
+  static constexpr size_t initial_queue_capacity = 64u * 1024u;
+};
+
+struct FutexWaitFrontendOptions : PollingFrontendOptions
+{
+  static constexpr bool blocking_queue_futex_wait = true;
+};
+
+/***/
+template <typename TFrontendOptions>
+void run_overload_bench(char const* description)
+{
+  using frontend_t = quill::FrontendImpl<TFrontendOptions>;
+
+  quill::BackendOptions backend_options;
+  backend_options.error_notifier = [](std::string const&) {};
+  quill::Backend::start(backend_options);
+
+  auto file_sink = frontend_t::template create_or_get_sink<quill::FileSink>(
+    "quill_blocking_queue_overload.log",
+    []()
+    {
+      quill::FileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      return cfg;
+    }(),
+    quill::FileEventNotifier{});
+
+  auto* logger = frontend_t::create_or_get_logger(description, std::move(file_sink));
+
+  std::vector<std::vector<uint64_t>> latencies(number_of_threads);
+  std::vector<std::thread> producers;
+
+  std::clock_t const cpu_start = std::clock();
+  auto const start_time = std::chrono::steady_clock::now();
+
+  for (size_t thread_index = 0; thread_index < number_of_threads; ++thread_index)
+  {
+    producers.emplace_back(
+      [logger, thread_index, &latencies]()
+      {
+        std::vector<uint64_t>& thread_latencies = latencies[thread_index];
+        thread_latencies.reserve(messages_per_thread);
+
+        for (size_t i = 0; i < messages_per_thread; ++i)
+        {
+          auto const begin = std::chrono::steady_clock::now();
+          LOG_INFO(logger, "Thread {} message {} value {}", thread_index, i, static_cast<double>(i) / 3);
+          auto const end = std::chrono::steady_clock::now();
+
+          thread_latencies.push_back(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+        }
+      });
+  }
+
+  for (auto& producer : producers)
+  {
+    producer.join();
+  }
+
+  logger->flush_log();
+
+  auto const delta = std::chrono::steady_clock::now() - start_time;
+  std::clock_t const cpu_end = std::clock();
+
+  quill::Backend::stop();
+  frontend_t::remove_logger(logger);
+
+  std::vector<uint64_t> all_latencies;
+  all_latencies.reserve(number_of_threads * messages_per_thread);
+
+  for (auto const& thread_latencies : latencies)
+  {
+    all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+
+  std::sort(all_latencies.begin(), all_latencies.end());
+
+  auto percentile = [&all_latencies](double p)
+  { return all_latencies[static_cast<size_t>(p * static_cast<double>(all_latencies.size() - 1))]; };
+
+  double const wall_s = std::chrono::duration_cast<std::chrono::duration<double>>(delta).count();
+  double const cpu_s = static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+
+  std::cout << fmtquill::format(
+                 "{}\n  wall time {:.2f} s, process cpu time {:.2f} s, throughput {:.2f} million "
+                 "msgs/sec\n  log call latency ns: 50th {} 99th {} 99.9th {} 99.99th {} max {}\n",
+                 description, wall_s, cpu_s,
+                 static_cast<double>(all_latencies.size()) / wall_s / 1e6, percentile(0.5),
+                 percentile(0.99), percentile(0.999), percentile(0.9999), all_latencies.back())
+            << std::endl;
+}
+
+/***/
+int main()
+{
+  run_overload_bench<PollingFrontendOptions>("BoundedBlocking polling wait");
+  run_overload_bench<FutexWaitFrontendOptions>("BoundedBlocking futex wait");
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Measures how long the backend thread is stalled inside the FileSink when fsync is enabled.
+ *
+ * The backend calls flush_sink() and run_periodic_tasks() each time it runs out of messages to
+ * process, and flush_sink() for each flush_log(). With the stdio write path both the fflush and the fsync run on the backend thread,
+ * with the io_uring write path they are submitted and their completions are reaped later.
+ */
+static constexpr size_t total_iterations = 2'000'000;
+static constexpr size_t burst_size = 10'000;
+
+/**
+ * Records the time spent in the flushes that had data to write and in the periodic tasks
+ */
+class TimedFileSink final : public quill::FileSink
+{
+public:
+  using quill::FileSink::FileSink;
+
+  void flush_sink() override
+  {
+    if (!_write_occurred)
+    {
+      return;
+    }
+
+    auto const begin = std::chrono::steady_clock::now();
+    quill::FileSink::flush_sink();
+    stalls.push_back(_elapsed_ns(begin));
+  }
+
+  void run_periodic_tasks() override
+  {
+    auto const begin = std::chrono::steady_clock::now();
+    quill::FileSink::run_periodic_tasks();
+    periodic_tasks_ns += _elapsed_ns(begin);
+  }
+
+  std::vector<uint64_t> stalls;
+  uint64_t periodic_tasks_ns{0};
+
+private:
+  static uint64_t _elapsed_ns(std::chrono::steady_clock::time_point begin)
+  {
+    return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+  }
+};
+
+/***/
+void run_fsync_stalls_bench(char const* description, bool io_uring)
+{
+  quill::BackendOptions backend_options;
+  backend_options.sleep_duration = std::chrono::nanoseconds{0};
+  backend_options.error_notifier = [](std::string const& error) { std::cerr << error << std::endl; };
+  quill::Backend::start(backend_options);
+
+  auto file_sink = quill::Frontend::create_or_get_sink<TimedFileSink>(
+    std::string{"quill_file_sink_fsync_stalls_"} + (io_uring ? "io_uring" : "stdio") + ".log",
+    [io_uring]()
+    {
+      quill::FileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_fsync_enabled(true);
+      cfg.set_io_uring_enabled(io_uring);
+      return cfg;
+    }(),
+    quill::FileEventNotifier{});
+
+  auto* timed_file_sink = static_cast<TimedFileSink*>(file_sink.get());
+  quill::Logger* logger = quill::Frontend::create_or_get_logger(description, file_sink);
+
+  auto const start_time = std::chrono::steady_clock::now();
+
+  for (size_t iteration = 0; iteration < total_iterations; ++iteration)
+  {
+    LOG_INFO(logger, "Iteration: {} double: {:.6f} text: {}", iteration,
+             static_cast<double>(iteration) / 3, "some text to format");
+
+    if ((iteration % burst_size) == 0)
+    {
+      // Let the backend catch up and flush, as it does between bursts in an application
+      logger->flush_log(0);
+    }
+  }
+
+  logger->flush_log(0);
+
+  auto const delta = std::chrono::steady_clock::now() - start_time;
+
+  quill::Frontend::remove_logger(logger);
+  quill::Backend::stop();
+
+  std::vector<uint64_t>& stalls = timed_file_sink->stalls;
+  std::sort(stalls.begin(), stalls.end());
+
+  uint64_t total_stall_ns{0};
+  for (uint64_t stall : stalls)
+  {
+    total_stall_ns += stall;
+  }
+
+  auto percentile = [&stalls](double p)
+  { return stalls[static_cast<size_t>(p * static_cast<double>(stalls.size() - 1))]; };
+
+  double const wall_s = std::chrono::duration_cast<std::chrono::duration<double>>(delta).count();
+
+  std::cout << fmtquill::format(
+                 "{}\n  wall time {:.2f} s, throughput {:.2f} million msgs/sec\n  flush_sink: {} "
+                 "calls, total {:.2f} ms, 50th {} ns 99th {} ns max {} ns\n  run_periodic_tasks: "
+                 "total {:.2f} ms\n",
+                 description, wall_s, static_cast<double>(total_iterations) / wall_s / 1e6,
+                 stalls.size(), static_cast<double>(total_stall_ns) / 1e6, percentile(0.5),
+                 percentile(0.99), stalls.back(),
+                 static_cast<double>(timed_file_sink->periodic_tasks_ns) / 1e6)
+            << std::endl;
+}
+
+/***/
+int main()
+{
+  run_fsync_stalls_bench("FileSink fsync, stdio write path", false);
+  run_fsync_stalls_bench("FileSink fsync, io_uring write path", true);
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include "quill/bundled/fmt/format.h"
+#include "quill/core/JsonEscape.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+/**
+ * Measures the time JsonSink takes to escape the fields of a log statement.
+ *
+ * The bulk copy of the runs that need no escaping is compared with the per character escaping it
+ * replaced. The fields have the lengths of a typical JSON log statement.
+ */
+static constexpr size_t total_iterations = 2'000'000;
+
+static std::array<std::string_view, 9> const fields{
+  "order_book.cpp",
+  "233",
+  "2117614",
+  "app_logger",
+  "INFO",
+  "Order {} filled qty {} price {:.6f} venue {} side {}",
+  "483920",
+  "XNAS",
+  "Rejected order for account ACC-2201 reason \"price outside of the collar\" at level 3"};
+
+/**
+ * The previous implementation, every character goes through the switch
+ */
+void append_json_escaped_per_character(fmtquill::memory_buffer& out, std::string_view value)
+{
+  static constexpr char control_escape_table[32][7] = {
+    "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+    "\\u0008", "\\u0009", "\\u000A", "\\u000B", "\\u000C", "\\u000D", "\\u000E", "\\u000F",
+    "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+    "\\u0018", "\\u0019", "\\u001A", "\\u001B", "\\u001C", "\\u001D", "\\u001E", "\\u001F"};
+
+  size_t const size = value.size();
+  char const* const data = value.data();
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    unsigned char const c = static_cast<unsigned char>(data[i]);
+    switch (c)
+    {
+    case '"':
+      out.append(std::string_view{"\\\""});
+      break;
+    case '\\':
+      out.append(std::string_view{"\\\\"});
+      break;
+    case '\b':
+      out.append(std::string_view{"\\b"});
+      break;
+    case '\f':
+      out.append(std::string_view{"\\f"});
+      break;
+    case '\n':
+      out.append(std::string_view{"\\n"});
+      break;
+    case '\r':
+      out.append(std::string_view{"\\r"});
+      break;
+    case '\t':
+      out.append(std::string_view{"\\t"});
+      break;
+    case 0xE2:
+      if (i + 2 < size && static_cast<unsigned char>(data[i + 1]) == 0x80 &&
+          (static_cast<unsigned char>(data[i + 2]) == 0xA8 || static_cast<unsigned char>(data[i + 2]) == 0xA9))
+      {
+        out.append(static_cast<unsigned char>(data[i + 2]) == 0xA8 ? std::string_view{"\\u2028"}
+                                                                   : std::string_view{"\\u2029"});
+        i += 2;
+      }
+      else
+      {
+        out.push_back(static_cast<char>(c));
+      }
+      break;
+    default:
+      if (c < 0x20)
+      {
+        out.append(std::string_view{control_escape_table[c], 6});
+      }
+      else
+      {
+        out.push_back(static_cast<char>(c));
+      }
+      break;
+    }
+  }
+}
+
+/***/
+template <typename TEscape>
+void run(char const* description, TEscape escape)
+{
+  fmtquill::memory_buffer buffer;
+  size_t bytes{0};
+
+  auto const start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < total_iterations; ++i)
+  {
+    buffer.clear();
+
+    for (std::string_view const field : fields)
+    {
+      escape(buffer, field);
+    }
+
+    bytes += buffer.size();
+  }
+
+  double const ns = static_cast<double>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+  std::cout << fmtquill::format("  {:<24} {:>6.1f} ns/msg ({} bytes escaped)\n", description,
+                                ns / static_cast<double>(total_iterations), bytes);
+}
+
+/***/
+int main()
+{
+#if defined(QUILL_JSON_ESCAPE_AVX2)
+  std::cout << "bulk copy scanner: AVX2\n";
+#elif defined(QUILL_JSON_ESCAPE_SSE2)
+  std::cout << "bulk copy scanner: SSE2\n";
+#else
+  std::cout << "bulk copy scanner: scalar\n";
+#endif
+
+  run("bulk copy", [](fmtquill::memory_buffer& out, std::string_view value)
+      { quill::detail::append_json_escaped(out, value); });
+
+  run("per character", [](fmtquill::memory_buffer& out, std::string_view value)
+      { append_json_escaped_per_character(out, value); });
+
+  return 0;
+}
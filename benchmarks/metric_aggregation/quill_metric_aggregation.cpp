@@ -0,0 +1,73 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/MetricAggregation.h"
+#include "quill/sinks/NullSink.h"
+
+static constexpr size_t total_iterations = 20'000'000;
+
+/**
+ * Compares publishing every metric sample with publish_metric() to aggregating them on the
+ * frontend with MetricCounter and MetricHistogram. Measures the total time until the backend
+ * processed all of them
+ */
+template <typename TFunction>
+void run(std::string const& name, quill::Logger* logger, TFunction&& function)
+{
+  auto const start_time = std::chrono::steady_clock::now();
+
+  for (size_t iteration = 0; iteration < total_iterations; ++iteration)
+  {
+    function(iteration);
+  }
+
+  // block until all samples are processed
+  logger->flush_log(0);
+
+  auto const delta = std::chrono::steady_clock::now() - start_time;
+  auto const delta_d = std::chrono::duration_cast<std::chrono::duration<double>>(delta).count();
+
+  std::cout << fmtquill::format("{:<40} throughput {:.2f} million samples/sec, total time elapsed: {} ms\n",
+                                name, total_iterations / delta_d / 1e6,
+                                std::chrono::duration_cast<std::chrono::milliseconds>(delta).count());
+}
+
+int main()
+{
+  quill::BackendOptions backend_options;
+  backend_options.sleep_duration = std::chrono::nanoseconds{0};
+  quill::Backend::start(backend_options);
+
+  quill::Logger* logger = quill::Frontend::create_or_get_logger(
+    "bench_logger", quill::Frontend::create_or_get_sink<quill::NullSink>("null_sink"));
+
+  quill::MetricMetadata const* counter_metadata =
+    quill::Frontend::create_metric("bench_requests_total", "requests_total");
+  quill::MetricMetadata const* histogram_metadata =
+    quill::Frontend::create_metric("bench_latency", "latency");
+
+  logger->publish_metric(counter_metadata, 1.0);
+  logger->flush_log(0);
+
+  run("publish_metric counter", logger,
+      [logger, counter_metadata](size_t) { logger->publish_metric(counter_metadata, 1.0); });
+
+  {
+    quill::MetricCounter counter{logger, counter_metadata};
+    run("MetricCounter", logger, [&counter](size_t) { counter.add(1.0); });
+  }
+
+  run("publish_metric histogram", logger,
+      [logger, histogram_metadata](size_t iteration)
+      { logger->publish_metric(histogram_metadata, static_cast<double>(iteration & 1023)); });
+
+  {
+    quill::MetricHistogram histogram{
+      logger, histogram_metadata, {1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024}};
+    run("MetricHistogram 12 buckets", logger,
+        [&histogram](size_t iteration) { histogram.record(static_cast<double>(iteration & 1023)); });
+  }
+}
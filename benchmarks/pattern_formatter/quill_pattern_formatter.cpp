@@ -0,0 +1,131 @@
+#include "quill/backend/PatternFormatter.h"
+#include "quill/backend/TimestampFormatter.h"
+#include "quill/bundled/fmt/format.h"
+#include "quill/core/Common.h"
+#include "quill/core/LogLevel.h"
+#include "quill/core/MacroMetadata.h"
+#include "quill/core/PatternFormatterOptions.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+/**
+ * Measures the time PatternFormatter takes to format a log statement. Build in Release, the
+ * numbers of an unoptimized build are not representative.
+ *
+ * The compiled PatternFormatter is compared with run_fmt_runtime(), a hand-written copy of the
+ * runtime fmt formatting PatternFormatter used before: the pattern is turned into a fmt format
+ * string that is parsed for every log statement and the attributes are passed as an array of
+ * type erased arguments. It is not the previous PatternFormatter itself, e.g. it skips the
+ * source location and named arguments handling.
+ */
+static constexpr size_t total_iterations = 4'000'000;
+
+static std::string_view const thread_id = "2117614";
+static std::string_view const thread_name = "worker_thread";
+static std::string_view const process_id = "98011";
+static std::string_view const logger_name = "app_logger";
+static std::string_view const log_message =
+  "Order 483920 filled qty 1200 price 102.375000 venue XNAS side buy";
+
+static quill::MacroMetadata const macro_metadata{"order_book.cpp:233",
+                                                 "on_fill",
+                                                 "Order {} filled qty {} price {:.6f} venue {} side {}",
+                                                 nullptr,
+                                                 quill::LogLevel::Info,
+                                                 quill::MacroMetadata::Event::Log};
+
+/***/
+uint64_t now_ns()
+{
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count());
+}
+
+/***/
+void report(char const* description, std::chrono::steady_clock::duration delta, size_t bytes)
+{
+  double const ns =
+    static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count());
+
+  std::cout << fmtquill::format("  {:<32} {:>6.1f} ns/msg ({} bytes formatted)\n", description,
+                                ns / static_cast<double>(total_iterations), bytes);
+}
+
+/***/
+void run_compiled(std::string const& pattern)
+{
+  quill::PatternFormatter formatter{quill::PatternFormatterOptions{pattern}};
+  uint64_t const timestamp = now_ns();
+  size_t bytes{0};
+
+  auto const start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < total_iterations; ++i)
+  {
+    std::string_view const formatted = formatter.format(
+      timestamp + i, thread_id, thread_name, process_id, logger_name, "INFO", "I", macro_metadata,
+      nullptr, log_message, std::string_view{});
+    bytes += formatted.size();
+  }
+
+  report("compiled PatternFormatter", std::chrono::steady_clock::now() - start, bytes);
+}
+
+/**
+ * A hand-written copy of the previous implementation, 17 format arguments with the unused ones
+ * left empty
+ */
+void run_fmt_runtime(std::string const& fmt_format, bool logger_before_message)
+{
+  quill::detail::TimestampFormatter timestamp_formatter{"%H:%M:%S.%Qns"};
+  fmtquill::basic_memory_buffer<char, 512> buffer;
+  uint64_t const timestamp = now_ns();
+  std::string_view const empty;
+  size_t bytes{0};
+
+  auto const start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < total_iterations; ++i)
+  {
+    buffer.clear();
+
+    std::string_view const time =
+      timestamp_formatter.format_timestamp(std::chrono::nanoseconds{timestamp + i});
+    char const* short_source_location = macro_metadata.short_source_location();
+    std::string_view const log_level = "INFO";
+    std::string_view const third = logger_before_message ? logger_name : log_message;
+    std::string_view const fourth = logger_before_message ? log_message : empty;
+
+    fmtquill::vformat_to(std::back_inserter(buffer), fmt_format,
+                         fmtquill::make_format_args(time, thread_id, short_source_location, log_level,
+                                                    third, fourth, empty, empty, empty, empty, empty,
+                                                    empty, empty, empty, empty, empty, empty));
+    bytes += buffer.size();
+  }
+
+  report("fmt runtime format string", std::chrono::steady_clock::now() - start, bytes);
+}
+
+/***/
+int main()
+{
+  std::cout << "%(time) [%(thread_id)] %(short_source_location) %(log_level) %(message)\n";
+  run_compiled("%(time) [%(thread_id)] %(short_source_location) %(log_level) %(message)");
+  run_fmt_runtime("{} [{}] {} {} {}\n", false);
+
+  std::cout << "\n%(time) [%(thread_id)] %(short_source_location:<28) LOG_%(log_level:<9) "
+               "%(logger:<12) %(message)\n";
+  run_compiled(
+    "%(time) [%(thread_id)] %(short_source_location:<28) LOG_%(log_level:<9) %(logger:<12) "
+    "%(message)");
+  run_fmt_runtime("{} [{}] {:<28} LOG_{:<9} {:<12} {}\n", true);
+
+  return 0;
+}
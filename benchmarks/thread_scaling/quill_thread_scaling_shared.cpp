@@ -0,0 +1,16 @@
+#include "thread_scaling_bench.h"
+
+struct SharedFrontendOptions : quill::FrontendOptions
+{
+  static constexpr quill::QueueType queue_type = quill::QueueType::SharedBoundedBlocking;
+};
+
+/***/
+int main()
+{
+  run_thread_scaling_bench<SharedFrontendOptions>(
+    fmtquill::format("SharedBoundedBlocking queues, shared_queue_count: {}",
+                     SharedFrontendOptions::shared_queue_count)
+      .data());
+  return 0;
+}
@@ -0,0 +1,13 @@
+#include "thread_scaling_bench.h"
+
+struct SpscFrontendOptions : quill::FrontendOptions
+{
+  static constexpr quill::QueueType queue_type = quill::QueueType::BoundedBlocking;
+};
+
+/***/
+int main()
+{
+  run_thread_scaling_bench<SpscFrontendOptions>("Per thread BoundedBlocking queues");
+  return 0;
+}
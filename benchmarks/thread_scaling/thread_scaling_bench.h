@@ -0,0 +1,146 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/core/ThreadContextManager.h"
+#include "quill/sinks/NullSink.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * Compares the per thread queues against the shared queues as the number of producer threads
+ * grows. The backend runs on the main thread through the ManualBackendWorker so that its poll cost
+ * can be timed directly.
+ *
+ * For each thread count it reports:
+ * - the frontend queue memory while all producers are alive
+ * - the throughput while every producer logs messages_per_thread messages
+ * - the cost of a single backend poll once all producers are alive but idle
+ */
+static constexpr size_t messages_per_thread = 2'000;
+static constexpr size_t idle_polls = 10'000;
+static constexpr size_t max_thread_count = 256;
+
+/***/
+inline size_t frontend_queue_memory()
+{
+  size_t total_capacity{0};
+
+  quill::detail::ThreadContextManager::instance().for_each_thread_context(
+    [&total_capacity](quill::detail::ThreadContext const* thread_context)
+    {
+      if (thread_context->has_bounded_queue_type())
+      {
+        total_capacity += thread_context->get_spsc_queue_union().bounded_spsc_queue.capacity();
+      }
+      else
+      {
+        total_capacity += thread_context->get_spsc_queue_union().unbounded_spsc_queue.producer_capacity();
+      }
+    });
+
+  return total_capacity;
+}
+
+/***/
+template <typename TFrontendOptions>
+void run_thread_scaling_bench(char const* queue_description)
+{
+  using frontend_t = quill::FrontendImpl<TFrontendOptions>;
+  using logger_t = quill::LoggerImpl<TFrontendOptions>;
+
+  quill::ManualBackendWorker* backend = quill::Backend::acquire_manual_backend_worker();
+  backend->init(quill::BackendOptions{});
+
+  logger_t* logger = frontend_t::create_or_get_logger(
+    "bench_logger", frontend_t::template create_or_get_sink<quill::NullSink>("null_sink"));
+
+  std::cout << queue_description << "\n"
+            << "threads | queue memory KiB | throughput million msgs/sec | idle poll ns\n";
+
+  for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+  {
+    std::atomic<size_t> producers_done{0};
+    std::atomic<bool> release_producers{false};
+
+    std::vector<std::thread> producers;
+    producers.reserve(thread_count);
+
+    auto const start_time = std::chrono::steady_clock::now();
+
+    for (size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+      producers.emplace_back(
+        [logger, thread_index, &producers_done, &release_producers]()
+        {
+          for (size_t i = 0; i < messages_per_thread; ++i)
+          {
+            LOG_INFO(logger, "Thread {} message {} value {}", thread_index, i, static_cast<double>(i) / 2);
+          }
+
+          producers_done.fetch_add(1);
+
+          // Stay alive so that the idle poll below sees every queue
+          while (!release_producers.load())
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+          }
+        });
+    }
+
+    // The backend drains on this thread while the producers are logging
+    while (producers_done.load() != thread_count)
+    {
+      backend->poll_one();
+    }
+
+    backend->poll();
+
+    auto const delta = std::chrono::steady_clock::now() - start_time;
+    double const delta_s = std::chrono::duration_cast<std::chrono::duration<double>>(delta).count();
+
+    size_t const queue_memory = frontend_queue_memory();
+
+    auto const poll_start_time = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < idle_polls; ++i)
+    {
+      backend->poll_one();
+    }
+
+    auto const poll_delta = std::chrono::steady_clock::now() - poll_start_time;
+
+    release_producers.store(true);
+
+    for (auto& producer : producers)
+    {
+      producer.join();
+    }
+
+    // Let the backend release the queues of the finished threads, this happens on an idle poll
+    backend->poll();
+    backend->poll_one();
+
+    std::cout << fmtquill::format(
+                   "{:>7} | {:>16} | {:>27.2f} | {:>12.1f}\n", thread_count, queue_memory / 1024,
+                   static_cast<double>(thread_count * messages_per_thread) / delta_s / 1e6,
+                   static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(poll_delta).count()) /
+                     static_cast<double>(idle_polls));
+  }
+
+  std::cout << std::endl;
+
+  backend->shutdown();
+}
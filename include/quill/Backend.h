@@ -144,6 +144,13 @@ public:
           signal_handler_context.logger_name = signal_handler_options.logger_name;
           signal_handler_context.excluded_logger_substrings = signal_handler_options.excluded_logger_substrings;
           signal_handler_context.signal_handler_timeout_seconds.store(signal_handler_options.timeout_seconds);
+          signal_handler_context.pending_log_statements_fd.store(signal_handler_options.pending_log_statements_fd);
+
+          if (signal_handler_options.pending_log_statements_fd >= 0)
+          {
+            // Decoding the pending log statements from the signal handler should not allocate
+            signal_handler_context.pending_log_statements_args_store.reserve(128);
+          }
 
           // Run the backend worker thread, we wait here until the thread enters the main loop
           detail::BackendManager::instance().start_backend_thread(backend_options);
@@ -233,9 +240,9 @@ public:
   /**
    * Notifies the backend thread to wake up.
    * It is possible to use a long backend sleep_duration and then notify the backend to wake up
-   * from any frontend thread.
+   * from any frontend thread. See also BackendOptions::enable_frontend_wake_up.
    *
-   * @note thread-safe
+   * @note thread-safe and lock free
    */
   static void notify() noexcept { detail::BackendManager::instance().notify_backend_thread(); }
 
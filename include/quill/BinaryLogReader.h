@@ -0,0 +1,413 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/backend/BackendOptions.h"
+#include "quill/backend/BackendWorker.h"
+#include "quill/backend/SerializedFormatArgs.h"
+#include "quill/backend/TransitEvent.h"
+#include "quill/core/Attributes.h"
+#include "quill/core/DynamicFormatArgStore.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/LogLevel.h"
+#include "quill/core/MacroMetadata.h"
+#include "quill/core/QuillError.h"
+#include "quill/sinks/BinaryFileSink.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * A single log statement decoded from a file written by BinaryFileSink.
+ * All views and pointers stay valid until the next call to BinaryLogReader::read_next()
+ */
+struct BinaryLogRecord
+{
+  uint64_t timestamp{0};
+  MacroMetadata const* metadata{nullptr};
+  LogLevel log_level{LogLevel::None};
+  std::string_view process_id;
+  std::string_view logger_name;
+  std::string_view thread_id;
+  std::string_view thread_name;
+  std::string_view log_level_description;
+  std::string_view log_level_short_code;
+  std::string_view log_message;
+  std::vector<std::pair<std::string, std::string>> const* named_args{nullptr};
+};
+
+/**
+ * Reads files produced by BinaryFileSink, one log statement at a time.
+ *
+ * The returned records carry everything the backend would normally pass to
+ * PatternFormatter::format() or Sink::write_log(), so the existing formatters and sinks can be
+ * used to turn the file back into text or json offline. Messages stored as serialized arguments
+ * are formatted by the reader, with the same rules as the backend.
+ *
+ * @code
+ * quill::BinaryLogReader reader{"app.bin"};
+ * quill::BinaryLogRecord record;
+ * while (reader.read_next(record))
+ * {
+ *   std::printf("%.*s\n", static_cast<int>(record.log_message.size()), record.log_message.data());
+ * }
+ * @endcode
+ */
+class BinaryLogReader
+{
+public:
+  /**
+   * Opens a binary log file
+   * @param filename path to a file written by BinaryFileSink
+   * @throws QuillError if the file can not be opened
+   */
+  explicit BinaryLogReader(fs::path const& filename)
+  {
+#if defined(_WIN32)
+    _file = ::_wfopen(filename.c_str(), L"rb");
+#else
+    _file = std::fopen(filename.c_str(), "rb");
+#endif
+
+    if (!_file)
+    {
+      QUILL_THROW(QuillError{std::string{"Failed to open binary log file: "} + filename.string() +
+                             " error: " + std::strerror(errno)});
+    }
+
+    // The backend only serializes strings that pass its check, see serialize_format_args()
+    _options.check_printable_char = {};
+  }
+
+  /***/
+  BinaryLogReader(BinaryLogReader const&) = delete;
+  BinaryLogReader& operator=(BinaryLogReader const&) = delete;
+
+  /***/
+  ~BinaryLogReader()
+  {
+    if (_file)
+    {
+      std::fclose(_file);
+    }
+  }
+
+  /**
+   * Decodes the next log statement, consuming any dictionary records in front of it
+   * @param record populated with the next log statement
+   * @return false when the end of the file is reached
+   * @throws QuillError if the file is truncated or corrupted
+   */
+  QUILL_NODISCARD bool read_next(BinaryLogRecord& record)
+  {
+    while (true)
+    {
+      uint8_t record_type;
+      if (std::fread(&record_type, sizeof(record_type), 1, _file) != 1)
+      {
+        if (std::ferror(_file))
+        {
+          QUILL_THROW(QuillError{"Failed to read binary log file"});
+        }
+
+        // A clean end of file can only happen on a record boundary
+        return false;
+      }
+
+      switch (static_cast<detail::BinaryRecordType>(record_type))
+      {
+      case detail::BinaryRecordType::FileHeader:
+        _read_file_header();
+        break;
+      case detail::BinaryRecordType::CallSite:
+        _read_call_site();
+        break;
+      case detail::BinaryRecordType::String:
+        _read_string_entry();
+        break;
+      case detail::BinaryRecordType::LogEvent:
+        _read_log_event(record);
+        return true;
+      default:
+        QUILL_THROW(QuillError{"Invalid record type " + std::to_string(record_type) +
+                               " in binary log file"});
+      }
+    }
+  }
+
+private:
+  struct CallSite
+  {
+    std::string source_location;
+    std::string caller_function;
+    std::string message_format;
+    std::string tags;
+    MacroMetadata metadata;
+
+    /** The message format without the names of the named args and the names, parsed once **/
+    std::optional<std::pair<std::string, std::vector<std::pair<std::string, std::string>>>> named_args_format;
+  };
+
+  /***/
+  void _read_bytes(void* destination, size_t size)
+  {
+    if ((size != 0) && (std::fread(destination, size, 1, _file) != 1))
+    {
+      QUILL_THROW(QuillError{"Unexpected end of binary log file"});
+    }
+  }
+
+  /***/
+  template <typename T>
+  QUILL_NODISCARD T _read_integral()
+  {
+    T value;
+    _read_bytes(&value, sizeof(T));
+    return value;
+  }
+
+  /***/
+  void _read_string(std::string& value)
+  {
+    value.resize(_read_integral<uint32_t>());
+    _read_bytes(value.data(), value.size());
+  }
+
+  /***/
+  void _read_file_header()
+  {
+    char magic[sizeof(detail::BinaryFileMagic)];
+    _read_bytes(magic, sizeof(magic));
+
+    if (std::memcmp(magic, detail::BinaryFileMagic, sizeof(magic)) != 0)
+    {
+      QUILL_THROW(QuillError{"Invalid binary log file header"});
+    }
+
+    auto const version = _read_integral<uint32_t>();
+    if (version != detail::BinaryFileVersion)
+    {
+      QUILL_THROW(QuillError{"Unsupported binary log file version " + std::to_string(version)});
+    }
+
+    if (_read_integral<uint32_t>() != detail::BinaryFileByteOrderMark)
+    {
+      QUILL_THROW(QuillError{"Binary log file was written on a host with a different byte order"});
+    }
+
+    _read_string(_process_id);
+
+    // A new header starts a new dictionary, e.g. the file was appended to by another process
+    _call_sites.clear();
+    _strings.clear();
+    _transient_call_site.reset();
+  }
+
+  /***/
+  void _read_call_site()
+  {
+    auto const id = _read_integral<uint32_t>();
+    auto const log_level = static_cast<LogLevel>(_read_integral<uint8_t>());
+
+    auto call_site = std::make_unique<CallSite>();
+    _read_string(call_site->source_location);
+    _read_string(call_site->caller_function);
+    _read_string(call_site->message_format);
+    _read_string(call_site->tags);
+
+    // The strings are owned by the heap allocated CallSite so the pointers remain stable. The
+    // metadata is marked as runtime metadata, its address does not outlive the reader
+    call_site->metadata = MacroMetadata{call_site->source_location.data(),
+                                        call_site->caller_function.data(),
+                                        call_site->message_format.data(),
+                                        call_site->tags.empty() ? nullptr : call_site->tags.data(),
+                                        log_level,
+                                        MacroMetadata::Event::Log,
+                                        true};
+
+    if (id == detail::BinaryTransientCallSiteId)
+    {
+      _transient_call_site = std::move(call_site);
+    }
+    else
+    {
+      _call_sites[id] = std::move(call_site);
+    }
+  }
+
+  /***/
+  void _read_string_entry()
+  {
+    auto const id = _read_integral<uint32_t>();
+    _read_string(_strings[id]);
+  }
+
+  /***/
+  QUILL_NODISCARD std::string_view _lookup_string(uint32_t id) const
+  {
+    auto const search = _strings.find(id);
+
+    if (search == _strings.end())
+    {
+      QUILL_THROW(QuillError{"Unknown string id " + std::to_string(id) + " in binary log file"});
+    }
+
+    return search->second;
+  }
+
+  /***/
+  void _read_log_event(BinaryLogRecord& record)
+  {
+    record.timestamp = _read_integral<uint64_t>();
+
+    CallSite* call_site;
+    auto const call_site_id = _read_integral<uint32_t>();
+    if (call_site_id == detail::BinaryTransientCallSiteId)
+    {
+      if (!_transient_call_site)
+      {
+        QUILL_THROW(QuillError{"Missing runtime metadata in binary log file"});
+      }
+
+      call_site = _transient_call_site.get();
+    }
+    else
+    {
+      auto const search = _call_sites.find(call_site_id);
+
+      if (search == _call_sites.end())
+      {
+        QUILL_THROW(QuillError{"Unknown call site id " + std::to_string(call_site_id) +
+                               " in binary log file"});
+      }
+
+      call_site = search->second.get();
+    }
+
+    record.metadata = &call_site->metadata;
+
+    record.log_level = static_cast<LogLevel>(_read_integral<uint8_t>());
+    record.process_id = _process_id;
+    record.logger_name = _lookup_string(_read_integral<uint32_t>());
+    record.thread_id = _lookup_string(_read_integral<uint32_t>());
+    record.thread_name = _lookup_string(_read_integral<uint32_t>());
+    record.log_level_description = _lookup_string(_read_integral<uint32_t>());
+    record.log_level_short_code = _lookup_string(_read_integral<uint32_t>());
+
+    auto const message_kind = static_cast<detail::BinaryMessageKind>(_read_integral<uint8_t>());
+
+    if (message_kind == detail::BinaryMessageKind::FormatArgs)
+    {
+      _read_string(_format_args);
+      _format_message(*call_site, record);
+    }
+    else if (message_kind == detail::BinaryMessageKind::Formatted)
+    {
+      _read_string(_log_message);
+      record.log_message = _log_message;
+
+      auto const named_args_count = _read_integral<uint32_t>();
+      _named_args.resize(named_args_count);
+
+      for (auto& [key, value] : _named_args)
+      {
+        _read_string(key);
+        _read_string(value);
+      }
+
+      record.named_args = named_args_count ? &_named_args : nullptr;
+    }
+    else
+    {
+      QUILL_THROW(QuillError{"Invalid message kind " + std::to_string(static_cast<uint32_t>(message_kind)) +
+                             " in binary log file"});
+    }
+  }
+
+  /**
+   * Formats the message from the serialized arguments, as the backend does when the message is
+   * not serialized
+   */
+  void _format_message(CallSite& call_site, BinaryLogRecord& record)
+  {
+    _format_args_store.clear();
+
+    if (!detail::deserialize_format_args(_format_args, _format_args_store))
+    {
+      QUILL_THROW(QuillError{"Invalid arguments in binary log file"});
+    }
+
+    // An invalid format string is reported in the message itself
+    std::string error;
+
+    if (!call_site.metadata.has_named_args())
+    {
+      detail::BackendWorker::_format_log_message(_formatted_message, call_site.message_format.data(),
+                                                 _format_args_store, call_site.metadata, _options, error);
+      record.named_args = nullptr;
+    }
+    else
+    {
+      if (!call_site.named_args_format)
+      {
+        call_site.named_args_format =
+          detail::BackendWorker::_process_named_args_format_message(call_site.message_format);
+      }
+
+      auto const& [message_format, arg_names] = *call_site.named_args_format;
+
+      detail::BackendWorker::_format_log_message(_formatted_message, message_format.data(),
+                                                 _format_args_store, call_site.metadata, _options, error);
+
+      _named_args.clear();
+      for (auto const& arg_name : arg_names)
+      {
+        _named_args.emplace_back(arg_name.first, std::string{});
+      }
+
+      for (size_t i = arg_names.size(); i < static_cast<size_t>(_format_args_store.size()); ++i)
+      {
+        _named_args.emplace_back(fmtquill::format("_{}", i), std::string{});
+      }
+
+      detail::BackendWorker::_format_named_args(arg_names, _named_args, _format_args_store, _options, error);
+      record.named_args = &_named_args;
+    }
+
+    record.log_message = std::string_view{_formatted_message.data(), _formatted_message.size()};
+  }
+
+private:
+  FILE* _file{nullptr};
+  std::string _process_id;
+  std::string _log_message;
+  std::string _format_args;
+  DynamicFormatArgStore _format_args_store;
+  detail::TransitEvent::FormatBuffer _formatted_message;
+  std::vector<std::pair<std::string, std::string>> _named_args;
+  std::unordered_map<uint32_t, std::unique_ptr<CallSite>> _call_sites;
+  std::unordered_map<uint32_t, std::string> _strings;
+  std::unique_ptr<CallSite> _transient_call_site;
+  BackendOptions _options;
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
@@ -0,0 +1,174 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/QuillError.h"
+#include "quill/sinks/FlightRecorderSink.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * A single record read from a file written by FlightRecorderSink.
+ * The log statement stays valid for the lifetime of the FlightRecorderReader
+ */
+struct FlightRecorderRecord
+{
+  uint64_t sequence{0};
+  uint64_t timestamp{0};
+  std::string_view log_statement;
+};
+
+/**
+ * Reads the circular buffer of a file written by FlightRecorderSink, from the oldest record to the
+ * newest.
+ *
+ * The file is read into memory once, so it can be read while the sink is still writing to it, or
+ * after the process that wrote it was killed.
+ *
+ * @code
+ * quill::FlightRecorderReader reader{"app.flight"};
+ * quill::FlightRecorderRecord record;
+ * while (reader.read_next(record))
+ * {
+ *   std::fwrite(record.log_statement.data(), 1, record.log_statement.size(), stdout);
+ * }
+ * @endcode
+ */
+class FlightRecorderReader
+{
+public:
+  /**
+   * Reads a flight recorder file
+   * @param filename path to a file written by FlightRecorderSink
+   * @throws QuillError if the file can not be read or is not a flight recorder file
+   */
+  explicit FlightRecorderReader(fs::path const& filename)
+  {
+#if defined(_WIN32)
+    FILE* file = ::_wfopen(filename.c_str(), L"rb");
+#else
+    FILE* file = std::fopen(filename.c_str(), "rb");
+#endif
+
+    if (!file)
+    {
+      QUILL_THROW(QuillError{std::string{"Failed to open flight recorder file: "} +
+                             filename.string() + " error: " + std::strerror(errno)});
+    }
+
+    char buffer[64 * 1024];
+    size_t bytes_read;
+    while ((bytes_read = std::fread(buffer, sizeof(char), sizeof(buffer), file)) != 0)
+    {
+      _contents.insert(_contents.end(), buffer, buffer + bytes_read);
+    }
+
+    bool const read_error = std::ferror(file) != 0;
+    std::fclose(file);
+
+    if (read_error)
+    {
+      QUILL_THROW(QuillError{"Failed to read flight recorder file: " + filename.string()});
+    }
+
+    if (_contents.size() < sizeof(detail::FlightRecorderFileHeader))
+    {
+      QUILL_THROW(QuillError{"Not a flight recorder file: " + filename.string()});
+    }
+
+    std::memcpy(&_header, _contents.data(), sizeof(_header));
+
+    if (!detail::is_valid_flight_recorder_header(
+          _header, _contents.size() - sizeof(detail::FlightRecorderFileHeader)))
+    {
+      QUILL_THROW(QuillError{"Not a flight recorder file or corrupted header: " + filename.string()});
+    }
+
+    // The previous lap is read first, then the current lap
+    _read_offset = _header.oldest_offset;
+    _read_end = _header.lap_end;
+    _reading_previous_lap = true;
+  }
+
+  /**
+   * Reads the next record
+   * @param record populated with the next record
+   * @return false when all the records were read
+   * @throws QuillError if a record is corrupted
+   */
+  QUILL_NODISCARD bool read_next(FlightRecorderRecord& record)
+  {
+    if (_read_offset == _read_end)
+    {
+      if (!_reading_previous_lap)
+      {
+        return false;
+      }
+
+      _reading_previous_lap = false;
+      _read_offset = 0;
+      _read_end = _header.write_offset;
+
+      if (_read_offset == _read_end)
+      {
+        return false;
+      }
+    }
+
+    if (_read_end - _read_offset < sizeof(detail::FlightRecorderRecordHeader))
+    {
+      QUILL_THROW(QuillError{"Corrupted flight recorder record at offset " + std::to_string(_read_offset)});
+    }
+
+    detail::FlightRecorderRecordHeader record_header;
+    char const* data = _contents.data() + sizeof(detail::FlightRecorderFileHeader) + _read_offset;
+    std::memcpy(&record_header, data, sizeof(record_header));
+
+    if ((record_header.size < sizeof(detail::FlightRecorderRecordHeader) + record_header.length) ||
+        (record_header.size % detail::FlightRecorderRecordAlignment != 0) ||
+        (record_header.size > _read_end - _read_offset) ||
+        (_has_last_sequence && (record_header.sequence <= _last_sequence)))
+    {
+      QUILL_THROW(QuillError{"Corrupted flight recorder record at offset " + std::to_string(_read_offset)});
+    }
+
+    record.sequence = record_header.sequence;
+    record.timestamp = record_header.timestamp;
+    record.log_statement = std::string_view{data + sizeof(detail::FlightRecorderRecordHeader),
+                                            record_header.length};
+
+    _read_offset += record_header.size;
+    _last_sequence = record_header.sequence;
+    _has_last_sequence = true;
+    return true;
+  }
+
+private:
+  std::vector<char> _contents;
+  detail::FlightRecorderFileHeader _header{};
+  uint64_t _read_offset{0};
+  uint64_t _read_end{0};
+  uint64_t _last_sequence{0};
+  bool _has_last_sequence{false};
+  bool _reading_previous_lap{false};
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
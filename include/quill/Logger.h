@@ -8,6 +8,7 @@
 
 #include "quill/UserClockSource.h"
 #include "quill/core/Attributes.h"
+#include "quill/core/BackendWakeup.h"
 #include "quill/core/ChronoTimeUtils.h"
 #include "quill/core/Codec.h"
 #include "quill/core/Common.h"
@@ -66,6 +67,8 @@ public:
     (frontend_options_t::queue_type == QueueType::UnboundedBlocking) ||
     (frontend_options_t::queue_type == QueueType::UnboundedDropping);
 
+  static constexpr bool using_shared_queue = detail::is_shared_queue_type(frontend_options_t::queue_type);
+
   using queue_t =
     std::conditional_t<using_unbounded_queue, detail::UnboundedSPSCQueue, detail::BoundedSPSCQueue>;
 
@@ -99,6 +102,16 @@ public:
     QUILL_ASSERT(_valid.load(std::memory_order_acquire),
                  "Attempting to log with an invalidated logger");
 
+    if constexpr (using_shared_queue)
+    {
+      return _write_to_shared_queue(
+        macro_metadata, reinterpret_cast<uintptr_t>(detail::decoder_ptr<Args...>), enable_immediate_flush,
+        [&fmt_args...](detail::ThreadContext* thread_context)
+        { return _compute_total_size(thread_context, fmt_args...); },
+        [&fmt_args...](std::byte*& write_buffer, detail::ThreadContext* thread_context)
+        { _encode_args(write_buffer, thread_context, static_cast<decltype(fmt_args)&&>(fmt_args)...); });
+    }
+
     if (_clock_source != ClockSourceType::Tsc)
     {
       return _log_statement_noinline<enable_immediate_flush, Args...>(
@@ -116,9 +129,7 @@ public:
 
     queue_t& queue = thread_context->get_spsc_queue<frontend_options_t::queue_type>();
 
-    size_t total_size = s_packed_header_size +
-      detail::compute_encoded_size_and_cache_string_lengths(
-                          thread_context->get_conditional_arg_size_cache(), fmt_args...);
+    size_t const total_size = _compute_total_size(thread_context, fmt_args...);
 
     auto const reservation = queue.prepare_write_reserve_cached(total_size);
 
@@ -138,8 +149,7 @@ public:
       write_buffer, PackedQword{current_timestamp, reinterpret_cast<uintptr_t>(macro_metadata)},
       PackedQword{reinterpret_cast<uintptr_t>(this), reinterpret_cast<uintptr_t>(detail::decoder_ptr<Args...>)});
 
-    detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(),
-                   static_cast<decltype(fmt_args)&&>(fmt_args)...);
+    _encode_args(write_buffer, thread_context, static_cast<decltype(fmt_args)&&>(fmt_args)...);
 
     QUILL_ASSERT_WITH_FMT(
       write_buffer > write_begin,
@@ -150,7 +160,7 @@ public:
       "Encoded bytes mismatch in log_statement(): total_size=%zu, actual_encoded=%zu, msg=\"%s\"",
       total_size, static_cast<size_t>(write_buffer - write_begin), macro_metadata->message_format());
 
-    _commit_log_statement_reservation(reservation.bounded_queue,
+    _commit_log_statement_reservation(thread_context, reservation.bounded_queue,
                                       reservation.writer_pos + total_size, enable_immediate_flush);
     return true;
   }
@@ -180,6 +190,16 @@ public:
     QUILL_ASSERT(_valid.load(std::memory_order_acquire),
                  "Attempting to log with an invalidated logger");
 
+    if constexpr (using_shared_queue)
+    {
+      uint64_t value_bits;
+      std::memcpy(&value_bits, &value, sizeof(value_bits));
+
+      return _write_to_shared_queue(
+        metric_metadata, value_bits, false,
+        [](detail::ThreadContext*) { return s_packed_header_size; }, [](std::byte*&, detail::ThreadContext*) {});
+    }
+
     if (_clock_source != ClockSourceType::Tsc)
     {
       return _publish_metric_noinline(metric_metadata, 0, value);
@@ -230,6 +250,84 @@ public:
       total_size, static_cast<size_t>(write_buffer - write_begin), metric_metadata->source_location());
 
     queue.finish_and_commit_write_reservation(reservation.writer_pos + total_size);
+    _wake_up_backend_if_parked(thread_context);
+    return true;
+  }
+
+  /**
+   * Push a histogram aggregated on the frontend, e.g. by MetricHistogram, to the spsc queue to be
+   * processed by the backend thread. The backend passes it to Sink::write_metric_histogram().
+   * Unlike publish_metric() the record size depends on the number of buckets.
+   *
+   * @note This function is thread-safe.
+   * @param metric_metadata metadata of the metric event
+   * @param histogram the bucket bounds and counts, copied to the queue
+   *
+   * @return true if the histogram is written to the queue, false if it is dropped
+   */
+  QUILL_ATTRIBUTE_HOT bool publish_metric_histogram(MetricMetadata const* metric_metadata,
+                                                    MetricHistogramData const& histogram)
+  {
+    QUILL_ASSERT(metric_metadata != nullptr,
+                 "publish_metric_histogram() requires a valid MetricMetadata pointer");
+
+    QUILL_ASSERT(_valid.load(std::memory_order_acquire),
+                 "Attempting to log with an invalidated logger");
+
+    // The metric metadata is part of the payload, the header carries the payload size instead of
+    // a decoder
+    static constexpr MacroMetadata macro_metadata{
+      "", "", "", nullptr, LogLevel::None, MacroMetadata::Event::MetricHistogram};
+
+    size_t const payload_size = detail::metric_histogram_encoded_size(histogram.bucket_bounds_count);
+
+    if constexpr (using_shared_queue)
+    {
+      return _write_to_shared_queue(
+        &macro_metadata, static_cast<uint64_t>(payload_size), false,
+        [payload_size](detail::ThreadContext*) { return s_packed_header_size + payload_size; },
+        [metric_metadata, &histogram](std::byte*& write_buffer, detail::ThreadContext*)
+        { detail::encode_metric_histogram(write_buffer, metric_metadata, histogram); });
+    }
+
+    uint64_t const current_timestamp =
+      (_clock_source == ClockSourceType::Tsc) ? detail::rdtsc() : _get_non_tsc_timestamp();
+
+    if (QUILL_UNLIKELY(_thread_context == nullptr))
+    {
+      _thread_context = detail::get_local_thread_context<frontend_options_t>();
+    }
+
+    detail::ThreadContext* const thread_context = _thread_context;
+    queue_t& queue = thread_context->get_spsc_queue<frontend_options_t::queue_type>();
+
+    size_t const total_size = s_packed_header_size + payload_size;
+
+    std::byte* write_buffer = _reserve_queue_space(queue, total_size, &macro_metadata, thread_context);
+
+    if (QUILL_UNLIKELY(write_buffer == nullptr))
+    {
+      return false;
+    }
+
+#if defined(QUILL_ENABLE_ASSERTIONS) || !defined(NDEBUG)
+    std::byte const* const write_begin = write_buffer;
+#endif
+
+    write_buffer = _encode_header(
+      write_buffer, PackedQword{current_timestamp, reinterpret_cast<uintptr_t>(&macro_metadata)},
+      PackedQword{reinterpret_cast<uintptr_t>(this), static_cast<uint64_t>(payload_size)});
+
+    detail::encode_metric_histogram(write_buffer, metric_metadata, histogram);
+
+    QUILL_ASSERT_WITH_FMT(total_size == static_cast<size_t>(write_buffer - write_begin),
+                          "Encoded bytes mismatch in publish_metric_histogram(): total_size=%zu, "
+                          "actual_encoded=%zu, metric_key=\"%s\"",
+                          total_size, static_cast<size_t>(write_buffer - write_begin),
+                          metric_metadata->metric_key().data());
+
+    queue.finish_and_commit_write(total_size);
+    _wake_up_backend_if_parked(thread_context);
     return true;
   }
 
@@ -245,6 +343,8 @@ public:
   template <typename... Args>
   void set_mdc(Args&&... args)
   {
+    static_assert(!using_shared_queue, "MDC is not supported with the shared queue types");
+
     static_assert(sizeof...(Args) > 0, "logger->set_mdc(...) expects key, value pairs");
     static_assert(
       (sizeof...(Args) % 2u) == 0u,
@@ -273,6 +373,8 @@ public:
   template <typename... Keys>
   void erase_mdc(Keys&&... keys)
   {
+    static_assert(!using_shared_queue, "MDC is not supported with the shared queue types");
+
     static_assert(sizeof...(Keys) > 0, "logger->erase_mdc(...) expects one or more keys");
 
     static constexpr MacroMetadata macro_metadata{
@@ -297,6 +399,8 @@ public:
    */
   void clear_mdc()
   {
+    static_assert(!using_shared_queue, "MDC is not supported with the shared queue types");
+
     static constexpr MacroMetadata macro_metadata{
       "", "", "", nullptr, LogLevel::Critical, MacroMetadata::Event::MdcClear};
 
@@ -344,43 +448,81 @@ public:
     QUILL_ASSERT(_valid.load(std::memory_order_acquire),
                  "Attempting to log with an invalidated logger");
 
-    uint64_t const current_timestamp =
-      (_clock_source == ClockSourceType::Tsc) ? detail::rdtsc() : _get_non_tsc_timestamp();
-
-    if (QUILL_UNLIKELY(_thread_context == nullptr))
+    auto compute_total_size = [&](detail::ThreadContext* thread_context) -> size_t
     {
-      _thread_context = detail::get_local_thread_context<frontend_options_t>();
-    }
+      if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy)
+      {
+        return s_packed_header_size +
+          detail::compute_encoded_size_and_cache_string_lengths(
+                 thread_context->get_conditional_arg_size_cache(), fmt, file_path, function_name,
+                 tags, line_number, log_level, fmt_args...);
+      }
 
-    detail::ThreadContext* const thread_context = _thread_context;
-    queue_t& queue = thread_context->get_spsc_queue<frontend_options_t::queue_type>();
+      if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy)
+      {
+        return s_packed_header_size +
+          detail::compute_encoded_size_and_cache_string_lengths(
+                 thread_context->get_conditional_arg_size_cache(), static_cast<void const*>(fmt),
+                 static_cast<void const*>(file_path), static_cast<void const*>(function_name),
+                 static_cast<void const*>(tags), line_number, log_level, fmt_args...);
+      }
 
-    size_t total_size{s_packed_header_size};
+      return s_packed_header_size +
+        detail::compute_encoded_size_and_cache_string_lengths(
+               thread_context->get_conditional_arg_size_cache(), fmt,
+               static_cast<void const*>(file_path), static_cast<void const*>(function_name), tags,
+               line_number, log_level, fmt_args...);
+    };
 
-    if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy)
+    auto encode_args = [&](std::byte*& write_buffer, detail::ThreadContext* thread_context)
     {
-      total_size += detail::compute_encoded_size_and_cache_string_lengths(
-        thread_context->get_conditional_arg_size_cache(), fmt, file_path, function_name, tags,
-        line_number, log_level, fmt_args...);
-    }
-    else if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy)
+      if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy)
+      {
+        detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(), fmt, file_path,
+                       function_name, tags, line_number, log_level,
+                       static_cast<decltype(fmt_args)&&>(fmt_args)...);
+      }
+      else if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy)
+      {
+        detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(),
+                       static_cast<void const*>(fmt), static_cast<void const*>(file_path),
+                       static_cast<void const*>(function_name), static_cast<void const*>(tags),
+                       line_number, log_level, static_cast<decltype(fmt_args)&&>(fmt_args)...);
+      }
+      else
+      {
+        detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(), fmt,
+                       static_cast<void const*>(file_path), static_cast<void const*>(function_name),
+                       tags, line_number, log_level, static_cast<decltype(fmt_args)&&>(fmt_args)...);
+      }
+    };
+
+    if ((macro_metadata->event() != MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy) &&
+        (macro_metadata->event() != MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy) &&
+        (macro_metadata->event() != MacroMetadata::Event::LogWithRuntimeMetadataHybridCopy))
     {
-      total_size += detail::compute_encoded_size_and_cache_string_lengths(
-        thread_context->get_conditional_arg_size_cache(), static_cast<void const*>(fmt),
-        static_cast<void const*>(file_path), static_cast<void const*>(function_name),
-        static_cast<void const*>(tags), line_number, log_level, fmt_args...);
+      return false;
     }
-    else if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataHybridCopy)
+
+    if constexpr (using_shared_queue)
     {
-      total_size += detail::compute_encoded_size_and_cache_string_lengths(
-        thread_context->get_conditional_arg_size_cache(), fmt, static_cast<void const*>(file_path),
-        static_cast<void const*>(function_name), tags, line_number, log_level, fmt_args...);
+      return _write_to_shared_queue(macro_metadata, reinterpret_cast<uintptr_t>(detail::decoder_ptr<Args...>),
+                                    enable_immediate_flush, compute_total_size, encode_args);
     }
-    else
+
+    uint64_t const current_timestamp =
+      (_clock_source == ClockSourceType::Tsc) ? detail::rdtsc() : _get_non_tsc_timestamp();
+
+    if (QUILL_UNLIKELY(_thread_context == nullptr))
     {
-      return false;
+      _thread_context = detail::get_local_thread_context<frontend_options_t>();
     }
 
+    detail::ThreadContext* const thread_context = _thread_context;
+    queue_t& queue = thread_context->get_spsc_queue<frontend_options_t::queue_type>();
+
+    size_t const total_size = compute_total_size(thread_context);
+
     std::byte* write_buffer = _reserve_queue_space(queue, total_size, macro_metadata, thread_context);
 
     if (QUILL_UNLIKELY(write_buffer == nullptr))
@@ -396,24 +538,7 @@ public:
       write_buffer, PackedQword{current_timestamp, reinterpret_cast<uintptr_t>(macro_metadata)},
       PackedQword{reinterpret_cast<uintptr_t>(this), reinterpret_cast<uintptr_t>(detail::decoder_ptr<Args...>)});
 
-    if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy)
-    {
-      detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(), fmt, file_path, function_name,
-                     tags, line_number, log_level, static_cast<decltype(fmt_args)&&>(fmt_args)...);
-    }
-    else if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy)
-    {
-      detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(),
-                     static_cast<void const*>(fmt), static_cast<void const*>(file_path),
-                     static_cast<void const*>(function_name), static_cast<void const*>(tags),
-                     line_number, log_level, static_cast<decltype(fmt_args)&&>(fmt_args)...);
-    }
-    else if (macro_metadata->event() == MacroMetadata::Event::LogWithRuntimeMetadataHybridCopy)
-    {
-      detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(), fmt,
-                     static_cast<void const*>(file_path), static_cast<void const*>(function_name),
-                     tags, line_number, log_level, static_cast<decltype(fmt_args)&&>(fmt_args)...);
-    }
+    encode_args(write_buffer, thread_context);
 
     QUILL_ASSERT_WITH_FMT(write_buffer > write_begin,
                           "write_buffer must be greater than write_begin after encoding in "
@@ -424,7 +549,7 @@ public:
                           "total_size=%zu, actual_encoded=%zu, fmt=\"%s\"",
                           total_size, static_cast<size_t>(write_buffer - write_begin), fmt);
 
-    _commit_log_statement(queue, total_size, enable_immediate_flush);
+    _commit_log_statement(thread_context, queue, total_size, enable_immediate_flush);
 
     return true;
   }
@@ -499,7 +624,7 @@ public:
    *       The calling thread can block for up to backend_options.sleep_duration. If you configure a custom
    *       long sleep duration on the backend thread, e.g., backend_options.sleep_duration = std::chrono::minutes{1},
    *       then you should ideally avoid calling this function as you can block for long period of times unless
-   *       you use another thread that calls Backend::notify()
+   *       backend_options.enable_frontend_wake_up is set or you use another thread that calls Backend::notify()
    */
   void flush_log(uint32_t sleep_duration_ns = 100)
   {
@@ -627,6 +752,7 @@ private:
                           metric_metadata->source_location());
 
     queue.finish_and_commit_write(total_size);
+    _wake_up_backend_if_parked(thread_context);
 
     return true;
   }
@@ -654,9 +780,7 @@ private:
     detail::ThreadContext* const thread_context = _thread_context;
     queue_t& queue = thread_context->get_spsc_queue<frontend_options_t::queue_type>();
 
-    size_t total_size = s_packed_header_size +
-      detail::compute_encoded_size_and_cache_string_lengths(
-                          thread_context->get_conditional_arg_size_cache(), fmt_args...);
+    size_t const total_size = _compute_total_size(thread_context, fmt_args...);
 
     std::byte* write_buffer = _reserve_queue_space(queue, total_size, macro_metadata, thread_context);
 
@@ -674,8 +798,7 @@ private:
       PackedQword{reinterpret_cast<uintptr_t>(this),
                   reinterpret_cast<uintptr_t>(detail::decoder_ptr<OriginalArgs...>)});
 
-    detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(),
-                   static_cast<decltype(fmt_args)&&>(fmt_args)...);
+    _encode_args(write_buffer, thread_context, static_cast<decltype(fmt_args)&&>(fmt_args)...);
 
     QUILL_ASSERT_WITH_FMT(write_buffer > write_begin,
                           "write_buffer must be greater than write_begin after encoding in "
@@ -687,7 +810,168 @@ private:
                           total_size, static_cast<size_t>(write_buffer - write_begin),
                           macro_metadata->message_format());
 
-    _commit_log_statement(queue, total_size, enable_immediate_flush);
+    _commit_log_statement(thread_context, queue, total_size, enable_immediate_flush);
+
+    return true;
+  }
+
+  /**
+   * @brief Computes the header plus payload size of a log statement.
+   * When every argument has a fixed encoded size the result is a compile time constant and the
+   * thread's SizeCacheVector is not touched.
+   */
+  template <typename... Args>
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT static size_t _compute_total_size(
+    QUILL_MAYBE_UNUSED detail::ThreadContext* thread_context, Args const&... fmt_args)
+  {
+    if constexpr (detail::has_fixed_encoded_size_v<Args...>)
+    {
+      constexpr size_t total_size = s_packed_header_size + detail::fixed_encoded_size_v<Args...>;
+      return total_size;
+    }
+    else
+    {
+      return s_packed_header_size +
+        detail::compute_encoded_size_and_cache_string_lengths(
+               thread_context->get_conditional_arg_size_cache(), fmt_args...);
+    }
+  }
+
+  /**
+   * @brief Encodes the arguments after the header, see _compute_total_size()
+   */
+  template <typename... Args>
+  QUILL_ATTRIBUTE_HOT static void _encode_args(std::byte*& write_buffer,
+                                               QUILL_MAYBE_UNUSED detail::ThreadContext* thread_context,
+                                               Args&&... fmt_args)
+  {
+    if constexpr (detail::has_fixed_encoded_size_v<Args...>)
+    {
+      detail::encode_fixed_size(write_buffer, fmt_args...);
+    }
+    else
+    {
+      detail::encode(write_buffer, thread_context->get_conditional_arg_size_cache(),
+                     static_cast<decltype(fmt_args)&&>(fmt_args)...);
+    }
+  }
+
+  /**
+   * Acquires the lock of a shared queue. The lock can be contended by far more threads than
+   * there are cores, so the cpu is yielded instead of spinning for a whole time slice when the
+   * holder has been preempted.
+   */
+  class SharedQueueLockGuard
+  {
+  public:
+    explicit SharedQueueLockGuard(detail::Spinlock& spinlock) : _spinlock(spinlock)
+    {
+      uint32_t spin_count{0};
+
+      while (!_spinlock.try_lock())
+      {
+        if (++spin_count > 64)
+        {
+          detail::yield_thread();
+        }
+      }
+    }
+
+    ~SharedQueueLockGuard() { _spinlock.unlock(); }
+
+    SharedQueueLockGuard(SharedQueueLockGuard const&) = delete;
+    SharedQueueLockGuard& operator=(SharedQueueLockGuard const&) = delete;
+
+  private:
+    detail::Spinlock& _spinlock;
+  };
+
+  /**
+   * Writes an event to the shared queue the calling thread is assigned to.
+   *
+   * The whole write happens under the queue lock, including taking the timestamp, so that the
+   * events of each shared queue remain ordered by timestamp as the backend expects. When a
+   * blocking queue is full the lock is released while waiting for space. The header is
+   * followed by the ThreadIdentity of the calling thread, the backend reads it instead of the
+   * thread id and name of the ThreadContext.
+   *
+   * @param macro_metadata metadata of the event
+   * @param header_hi decoder pointer, or the metric value
+   * @param enable_immediate_flush whether to honor per-logger immediate-flush thresholds
+   * @param compute_total_size returns the header plus payload size, given the ThreadContext
+   * @param encode_args encodes the payload, given the write buffer and the ThreadContext
+   * @return true if the event is written to the queue, false if it is dropped
+   */
+  template <typename TComputeTotalSize, typename TEncodeArgs>
+  QUILL_NODISCARD QUILL_NOINLINE bool _write_to_shared_queue(MacroMetadata const* macro_metadata,
+                                                             uint64_t header_hi, bool enable_immediate_flush,
+                                                             TComputeTotalSize&& compute_total_size,
+                                                             TEncodeArgs&& encode_args)
+  {
+    detail::SharedQueueProducer const& producer =
+      detail::get_local_shared_queue_producer<frontend_options_t>();
+
+    detail::ThreadContext* const thread_context = producer.thread_context;
+    queue_t& queue = thread_context->get_spsc_queue<frontend_options_t::queue_type>();
+
+    bool waited_for_space{false};
+
+    for (;;)
+    {
+      size_t total_size;
+
+      {
+        SharedQueueLockGuard const lock{thread_context->shared_queue_lock()};
+
+        uint64_t const current_timestamp =
+          (_clock_source == ClockSourceType::Tsc) ? detail::rdtsc() : _get_non_tsc_timestamp();
+
+        total_size = compute_total_size(thread_context) + sizeof(uintptr_t);
+
+        std::byte* write_buffer = queue.prepare_write(total_size);
+
+        if (QUILL_LIKELY(write_buffer != nullptr))
+        {
+#if defined(QUILL_ENABLE_ASSERTIONS) || !defined(NDEBUG)
+          std::byte const* const write_begin = write_buffer;
+#endif
+
+          write_buffer = _encode_header(
+            write_buffer, PackedQword{current_timestamp, reinterpret_cast<uintptr_t>(macro_metadata)},
+            PackedQword{reinterpret_cast<uintptr_t>(this), header_hi});
+
+          uintptr_t const thread_identity = reinterpret_cast<uintptr_t>(producer.thread_identity);
+          std::memcpy(write_buffer, &thread_identity, sizeof(thread_identity));
+          write_buffer += sizeof(thread_identity);
+
+          encode_args(write_buffer, thread_context);
+
+          QUILL_ASSERT_WITH_FMT(total_size == static_cast<size_t>(write_buffer - write_begin),
+                                "Encoded bytes mismatch in _write_to_shared_queue(): total_size=%zu, "
+                                "actual_encoded=%zu, msg=\"%s\"",
+                                total_size, static_cast<size_t>(write_buffer - write_begin),
+                                macro_metadata->message_format());
+
+          queue.finish_and_commit_write(total_size);
+          break;
+        }
+
+        if (!waited_for_space && !_on_queue_full(queue, total_size, macro_metadata, thread_context))
+        {
+          return false;
+        }
+      }
+
+      // Wait without the lock, so the other threads of the queue are not blocked behind the
+      // backend. The timestamp is taken again once the lock is retaken to keep the queue ordered
+      waited_for_space = true;
+      _wait_for_queue_space(queue, total_size);
+    }
+
+    _wake_up_backend_if_parked(thread_context);
+
+    // Outside the lock, flush_log() writes to the same queue
+    _flush_after_log_statement_if_needed(enable_immediate_flush);
 
     return true;
   }
@@ -726,32 +1010,62 @@ private:
   {
     std::byte* write_buffer = queue.prepare_write(total_size);
 
+    if (QUILL_UNLIKELY(write_buffer == nullptr) &&
+        _on_queue_full(queue, total_size, macro_metadata, thread_context))
+    {
+      do
+      {
+        _wait_for_queue_space(queue, total_size);
+
+        // not enough space to push to queue, keep trying
+        write_buffer = queue.prepare_write(total_size);
+      } while (write_buffer == nullptr);
+    }
+
+    return write_buffer;
+  }
+
+  /**
+   * Handles a failed attempt to reserve space in the queue, according to the queue type
+   * @param queue Reference to the full queue
+   * @param total_size The total size in bytes needed for the log message
+   * @param macro_metadata Metadata of the log message, used to increment failure counter if needed
+   * @param thread_context The thread context, used to increment failure counter if needed
+   * @return true if the caller should wait for space and retry, false if the message is dropped
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_COLD bool _on_queue_full(QUILL_MAYBE_UNUSED queue_t& queue,
+                                                           QUILL_MAYBE_UNUSED size_t total_size,
+                                                           MacroMetadata const* macro_metadata,
+                                                           detail::ThreadContext* thread_context)
+  {
     if constexpr ((frontend_options_t::queue_type == QueueType::BoundedDropping) ||
-                  (frontend_options_t::queue_type == QueueType::UnboundedDropping))
+                  (frontend_options_t::queue_type == QueueType::UnboundedDropping) ||
+                  (frontend_options_t::queue_type == QueueType::SharedBoundedDropping))
     {
-      if (QUILL_UNLIKELY(write_buffer == nullptr))
+      // Not enough space to push: bump the shared failure counter for both log and metric
+      // drops so that neither silently disappears. Metrics reuse the existing counter rather
+      // than adding a parallel one; the error-notifier message reflects the combined count.
+      // Internal control events (flush, mdc updates, backtrace control, logger removal) are
+      // not counted: their callers retry in a loop until the event is enqueued, so a failed
+      // attempt would report a phantom drop for an event that is eventually delivered
+      MacroMetadata::Event const event = macro_metadata->event();
+
+      if ((event == MacroMetadata::Event::Log) ||
+          (event == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy) ||
+          (event == MacroMetadata::Event::LogWithRuntimeMetadataHybridCopy) ||
+          (event == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy) ||
+          (event == MacroMetadata::Event::Metric) || (event == MacroMetadata::Event::MetricHistogram))
       {
-        // Not enough space to push: bump the shared failure counter for both log and metric
-        // drops so that neither silently disappears. Metrics reuse the existing counter rather
-        // than adding a parallel one; the error-notifier message reflects the combined count.
-        // Internal control events (flush, mdc updates, backtrace control, logger removal) are
-        // not counted: their callers retry in a loop until the event is enqueued, so a failed
-        // attempt would report a phantom drop for an event that is eventually delivered
-        MacroMetadata::Event const event = macro_metadata->event();
-
-        if ((event == MacroMetadata::Event::Log) ||
-            (event == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy) ||
-            (event == MacroMetadata::Event::LogWithRuntimeMetadataHybridCopy) ||
-            (event == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy) ||
-            (event == MacroMetadata::Event::Metric))
-        {
-          thread_context->increment_failure_counter();
-        }
+        thread_context->increment_failure_counter();
       }
+
+      return false;
     }
-    else if constexpr (frontend_options_t::queue_type == QueueType::BoundedBlocking)
+    else if constexpr ((frontend_options_t::queue_type == QueueType::BoundedBlocking) ||
+                       (frontend_options_t::queue_type == QueueType::SharedBoundedBlocking) ||
+                       (frontend_options_t::queue_type == QueueType::UnboundedBlocking))
     {
-      if (QUILL_UNLIKELY(write_buffer == nullptr))
+      if constexpr (frontend_options_t::queue_type != QueueType::UnboundedBlocking)
       {
         if (QUILL_UNLIKELY(total_size > queue.capacity()))
         {
@@ -764,63 +1078,55 @@ private:
                        "Configured bounded queue capacity: " +
                        std::to_string(queue.capacity()) + " bytes"});
         }
+      }
 
-        if (QUILL_UNLIKELY(detail::LoggerBase::is_current_thread_backend_thread()))
-        {
-          // The backend is the only consumer of this queue, so waiting here would self-deadlock.
-          // Do not increment the failure counter: reporting this drop through error_notifier could
-          // recursively fill the same queue.
-          return nullptr;
-        }
-
-        // Both log and metric events bump the counter; blocked events are reported as blocking
-        // occurrences, so unlike the dropping-queue branch no control-event exclusion is needed.
-        (void)macro_metadata;
-        thread_context->increment_failure_counter();
-
-        do
-        {
-          if constexpr (frontend_options_t::blocking_queue_retry_interval_ns > 0)
-          {
-            detail::sleep_for_ns(frontend_options_t::blocking_queue_retry_interval_ns);
-          }
-
-          // not enough space to push to queue, keep trying
-          write_buffer = queue.prepare_write(total_size);
-        } while (write_buffer == nullptr);
+      if (QUILL_UNLIKELY(detail::LoggerBase::is_current_thread_backend_thread()))
+      {
+        // The backend is the only consumer of this queue, so waiting here would self-deadlock.
+        // Do not increment the failure counter: reporting this drop through error_notifier could
+        // recursively fill the same queue.
+        return false;
       }
+
+      // Both log and metric events bump the counter; blocked events are reported as blocking
+      // occurrences, so unlike the dropping-queue branch no control-event exclusion is needed.
+      (void)macro_metadata;
+      thread_context->increment_failure_counter();
+      return true;
     }
-    else if constexpr (frontend_options_t::queue_type == QueueType::UnboundedBlocking)
+    else
     {
-      if (QUILL_UNLIKELY(write_buffer == nullptr))
-      {
-        if (QUILL_UNLIKELY(detail::LoggerBase::is_current_thread_backend_thread()))
-        {
-          // The backend is the only consumer of this queue, so waiting here would self-deadlock.
-          // Do not increment the failure counter: reporting this drop through error_notifier could
-          // recursively fill the same queue.
-          return nullptr;
-        }
-
-        // Both log and metric events bump the counter; blocked events are reported as blocking
-        // occurrences, so unlike the dropping-queue branch no control-event exclusion is needed.
-        (void)macro_metadata;
-        thread_context->increment_failure_counter();
+      (void)macro_metadata;
+      (void)thread_context;
+      return false;
+    }
+  }
 
-        do
-        {
-          if constexpr (frontend_options_t::blocking_queue_retry_interval_ns > 0)
-          {
-            detail::sleep_for_ns(frontend_options_t::blocking_queue_retry_interval_ns);
-          }
-
-          // not enough space to push to queue, keep trying
-          write_buffer = queue.prepare_write(total_size);
-        } while (write_buffer == nullptr);
-      }
+  /**
+   * Waits before retrying to reserve space in a full blocking queue
+   */
+  QUILL_ATTRIBUTE_COLD static void _wait_for_queue_space(QUILL_MAYBE_UNUSED queue_t& queue,
+                                                         QUILL_MAYBE_UNUSED size_t total_size) noexcept
+  {
+#if defined(QUILL_HAS_FUTEX)
+    if constexpr (frontend_options_t::blocking_queue_futex_wait)
+    {
+      // Bounded, so the thread still retries when a wake up is missed or the backend stopped
+      // reading. A retry interval of a few hundred ns would defeat the futex, hence the floor
+      constexpr uint64_t min_futex_wait_ns{1'000'000};
+      constexpr uint64_t futex_wait_ns = (frontend_options_t::blocking_queue_retry_interval_ns > min_futex_wait_ns)
+        ? frontend_options_t::blocking_queue_retry_interval_ns
+        : min_futex_wait_ns;
+
+      queue.wait_for_space(total_size, futex_wait_ns);
+      return;
     }
+#endif
 
-    return write_buffer;
+    if constexpr (frontend_options_t::blocking_queue_retry_interval_ns > 0)
+    {
+      detail::sleep_for_ns(frontend_options_t::blocking_queue_retry_interval_ns);
+    }
   }
 
   /**
@@ -831,13 +1137,16 @@ private:
    * constant (a non-type template parameter on the caller), so the optimizer constant-folds
    * the branch and emits the same code as the templated version.
    *
+   * @param thread_context The thread context owning the queue
    * @param queue Reference to the SPSC queue to commit to
    * @param total_size The total size in bytes of the committed log message
    * @param enable_immediate_flush Whether to honor per-logger immediate-flush thresholds
    */
-  QUILL_ATTRIBUTE_HOT inline void _commit_log_statement(queue_t& queue, size_t total_size, bool enable_immediate_flush)
+  QUILL_ATTRIBUTE_HOT inline void _commit_log_statement(detail::ThreadContext* thread_context, queue_t& queue,
+                                                        size_t total_size, bool enable_immediate_flush)
   {
     queue.finish_and_commit_write(total_size);
+    _wake_up_backend_if_parked(thread_context);
 
     _flush_after_log_statement_if_needed(enable_immediate_flush);
   }
@@ -854,14 +1163,54 @@ private:
    *
    * See `_commit_log_statement` for why `enable_immediate_flush` is a runtime parameter.
    */
-  QUILL_ATTRIBUTE_HOT inline void _commit_log_statement_reservation(detail::BoundedSPSCQueue* bounded_queue,
+  QUILL_ATTRIBUTE_HOT inline void _commit_log_statement_reservation(detail::ThreadContext* thread_context,
+                                                                    detail::BoundedSPSCQueue* bounded_queue,
                                                                     size_t new_writer_pos, bool enable_immediate_flush)
   {
     bounded_queue->finish_and_commit_write_reservation(new_writer_pos);
+    _wake_up_backend_if_parked(thread_context);
 
     _flush_after_log_statement_if_needed(enable_immediate_flush);
   }
 
+  /**
+   * Wakes up the backend thread if it is parked waiting for work, when
+   * BackendOptions::enable_frontend_wake_up is set. The backend sets a flag in the thread context
+   * before it parks and then checks the queues one last time.
+   *
+   * Only the compiler has to keep the queue commit before the load of the flag. The backend issues
+   * a process wide barrier between setting the flag and checking the queues, see
+   * BackendWakeup::process_barrier(), so either the backend sees the message or this thread sees
+   * the flag and a message never waits for sleep_duration. The flag stays 0 with the frontend
+   * wake up disabled, which then costs a single load of the thread context.
+   */
+  QUILL_ATTRIBUTE_HOT static void _wake_up_backend_if_parked(detail::ThreadContext* thread_context) noexcept
+  {
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    if (QUILL_LIKELY(thread_context->backend_wake_up_state() == 0))
+    {
+      return;
+    }
+
+    _wake_up_backend(thread_context);
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_COLD QUILL_NOINLINE static void _wake_up_backend(detail::ThreadContext* thread_context) noexcept
+  {
+    if (thread_context->backend_wake_up_state() & detail::BackendWakeup::ContextFenceRequired)
+    {
+      // membarrier() is not available, the fence pairs with the fence of the backend
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    if (thread_context->clear_backend_parked())
+    {
+      detail::BackendWakeup::instance().notify();
+    }
+  }
+
   /**
    * Applies the per-logger immediate-flush policy after a log statement has been committed.
    *
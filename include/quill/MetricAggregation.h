@@ -0,0 +1,396 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/Logger.h"
+#include "quill/core/Attributes.h"
+#include "quill/core/ChronoTimeUtils.h"
+#include "quill/core/Common.h"
+#include "quill/core/FrontendOptions.h"
+#include "quill/core/Metric.h"
+#include "quill/core/QuillError.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * Controls how often an aggregating metric handle publishes to the backend.
+ */
+struct MetricAggregationOptions
+{
+  /**
+   * Publish after this many updates.
+   */
+  uint32_t max_updates{1024};
+
+  /**
+   * Publish on the first update after this interval has elapsed since the previous publish.
+   * Nothing is published without an update, call flush() to publish immediately.
+   * Set to zero to publish only every max_updates.
+   */
+  std::chrono::nanoseconds max_interval{std::chrono::milliseconds{100}};
+};
+
+namespace detail
+{
+/**
+ * Counts the updates of an aggregating metric handle and decides when to publish them
+ */
+class MetricAggregationPolicy
+{
+public:
+  explicit MetricAggregationPolicy(MetricAggregationOptions const& options)
+    : _max_updates((std::max)(options.max_updates, uint32_t{1}))
+  {
+    // The steady clock needs no calibration, unlike the TSC, so creating a handle on a hot thread
+    // does not spin. The clock is read at most once every clock_check_updates updates
+    if (options.max_interval.count() > 0)
+    {
+      _interval_ns = static_cast<uint64_t>(options.max_interval.count());
+      _deadline_ns = get_steady_time_ns() + _interval_ns;
+    }
+  }
+
+  /**
+   * @return true when the accumulated updates should be published
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool on_update() noexcept
+  {
+    ++_updates;
+
+    if (_updates >= _max_updates)
+    {
+      return true;
+    }
+
+    // Reading the clock costs more than the update itself. It is read on every update of a
+    // rarely updated handle and only once every clock_check_updates updates of a busy one
+    return (_interval_ns != 0) &&
+      ((_updates <= clock_check_updates) || ((_updates & (clock_check_updates - 1)) == 0)) &&
+      (get_steady_time_ns() >= _deadline_ns);
+  }
+
+  /***/
+  void on_publish() noexcept
+  {
+    _updates = 0;
+
+    if (_interval_ns != 0)
+    {
+      _deadline_ns = get_steady_time_ns() + _interval_ns;
+    }
+  }
+
+  QUILL_NODISCARD uint32_t pending_updates() const noexcept { return _updates; }
+
+private:
+  static constexpr uint32_t clock_check_updates{16};
+
+  uint64_t _interval_ns{0};
+  uint64_t _deadline_ns{0};
+  uint32_t _max_updates;
+  uint32_t _updates{0};
+};
+
+/**
+ * Creates the thread context of the calling thread while a metric handle is constructed. A
+ * `thread_local` handle then finishes its construction after the thread context and is destroyed
+ * before it, so the updates published by its destructor still have a queue to go to
+ */
+template <typename TFrontendOptions>
+void init_metric_thread_context()
+{
+  (void)get_local_thread_context<TFrontendOptions>();
+}
+} // namespace detail
+
+/**
+ * @brief A counter aggregated on the frontend.
+ *
+ * Instead of one queue record per sample as with publish_metric(), the values passed to add() are
+ * summed and the sum is published as a single sample, every
+ * MetricAggregationOptions::max_updates updates or MetricAggregationOptions::max_interval.
+ * Sinks receive it through Sink::write_metric(), the same as a sample of the same value.
+ *
+ * The handle is not thread-safe, each thread uses its own, for example a `thread_local` one.
+ * The remaining updates are published on destruction, so the handle must be destroyed before its
+ * logger is removed. The handle creates the thread context of the constructing thread, a
+ * `thread_local` handle is destroyed before it, while a handle with static storage duration is
+ * destroyed after it and must not be used.
+ *
+ * @code
+ *   thread_local quill::MetricCounter requests{logger, metric_metadata};
+ *   requests.add();
+ * @endcode
+ *
+ * @tparam TFrontendOptions Custom frontend options if they are used application-wide. If no custom frontend options are used, then use quill::FrontendOptions.
+ */
+template <typename TFrontendOptions>
+class MetricCounterImpl
+{
+public:
+  MetricCounterImpl(LoggerImpl<TFrontendOptions>* logger, MetricMetadata const* metric_metadata,
+                    MetricAggregationOptions const& options = MetricAggregationOptions{})
+    : _logger(logger), _metric_metadata(metric_metadata), _policy(options)
+  {
+    detail::init_metric_thread_context<TFrontendOptions>();
+  }
+
+  MetricCounterImpl(MetricCounterImpl const&) = delete;
+  MetricCounterImpl& operator=(MetricCounterImpl const&) = delete;
+
+  ~MetricCounterImpl() { (void)flush(); }
+
+  /**
+   * Adds a value to the counter
+   */
+  QUILL_ATTRIBUTE_HOT void add(double value = 1.0)
+  {
+    _value += value;
+
+    if (QUILL_UNLIKELY(_policy.on_update()))
+    {
+      (void)flush();
+    }
+  }
+
+  /**
+   * Publishes the sum of the values added since the previous publish, if any
+   * @return false if the sample was dropped by the queue, the sum is kept for the next attempt
+   */
+  bool flush()
+  {
+    if (_policy.pending_updates() == 0)
+    {
+      return true;
+    }
+
+    if (!_logger->publish_metric(_metric_metadata, _value))
+    {
+      return false;
+    }
+
+    _value = 0;
+    _policy.on_publish();
+    return true;
+  }
+
+private:
+  LoggerImpl<TFrontendOptions>* _logger;
+  MetricMetadata const* _metric_metadata;
+  detail::MetricAggregationPolicy _policy;
+  double _value{0};
+};
+
+/**
+ * @brief A gauge aggregated on the frontend.
+ *
+ * Only the last value passed to set() is published, every MetricAggregationOptions::max_updates
+ * updates or MetricAggregationOptions::max_interval. For gauges that add or subtract the samples
+ * use MetricCounter instead.
+ *
+ * The handle is not thread-safe, each thread uses its own. The last value is published on
+ * destruction, so the handle must be destroyed before its logger is removed.
+ *
+ * @tparam TFrontendOptions Custom frontend options if they are used application-wide. If no custom frontend options are used, then use quill::FrontendOptions.
+ */
+template <typename TFrontendOptions>
+class MetricGaugeImpl
+{
+public:
+  MetricGaugeImpl(LoggerImpl<TFrontendOptions>* logger, MetricMetadata const* metric_metadata,
+                  MetricAggregationOptions const& options = MetricAggregationOptions{})
+    : _logger(logger), _metric_metadata(metric_metadata), _policy(options)
+  {
+    detail::init_metric_thread_context<TFrontendOptions>();
+  }
+
+  MetricGaugeImpl(MetricGaugeImpl const&) = delete;
+  MetricGaugeImpl& operator=(MetricGaugeImpl const&) = delete;
+
+  ~MetricGaugeImpl() { (void)flush(); }
+
+  /**
+   * Sets the value of the gauge
+   */
+  QUILL_ATTRIBUTE_HOT void set(double value)
+  {
+    _value = value;
+
+    if (QUILL_UNLIKELY(_policy.on_update()))
+    {
+      (void)flush();
+    }
+  }
+
+  /**
+   * Publishes the last value if it was set since the previous publish
+   * @return false if the sample was dropped by the queue
+   */
+  bool flush()
+  {
+    if (_policy.pending_updates() == 0)
+    {
+      return true;
+    }
+
+    if (!_logger->publish_metric(_metric_metadata, _value))
+    {
+      return false;
+    }
+
+    _policy.on_publish();
+    return true;
+  }
+
+private:
+  LoggerImpl<TFrontendOptions>* _logger;
+  MetricMetadata const* _metric_metadata;
+  detail::MetricAggregationPolicy _policy;
+  double _value{0};
+};
+
+/**
+ * @brief A histogram with fixed buckets aggregated on the frontend.
+ *
+ * The values passed to record() are counted in the bucket of the first bound greater than or equal
+ * to the value, or in the overflow bucket. The bucket counts, count, sum, min and max are published
+ * as a single record every MetricAggregationOptions::max_updates updates or
+ * MetricAggregationOptions::max_interval and sinks receive them through
+ * Sink::write_metric_histogram(). PrometheusSink merges them into a registered histogram.
+ *
+ * The handle is not thread-safe, each thread uses its own. The remaining values are published on
+ * destruction, so the handle must be destroyed before its logger is removed.
+ *
+ * @tparam TFrontendOptions Custom frontend options if they are used application-wide. If no custom frontend options are used, then use quill::FrontendOptions.
+ */
+template <typename TFrontendOptions>
+class MetricHistogramImpl
+{
+public:
+  /**
+   * @param logger the logger used to publish
+   * @param metric_metadata the metric
+   * @param bucket_bounds the upper bounds of the buckets, strictly increasing
+   * @param options publish policy
+   * @throws QuillError if the bucket bounds are not strictly increasing
+   */
+  MetricHistogramImpl(LoggerImpl<TFrontendOptions>* logger, MetricMetadata const* metric_metadata,
+                      std::vector<double> bucket_bounds,
+                      MetricAggregationOptions const& options = MetricAggregationOptions{})
+    : _logger(logger),
+      _metric_metadata(metric_metadata),
+      _policy(options),
+      _bucket_bounds(std::move(bucket_bounds))
+  {
+    for (size_t i = 1; i < _bucket_bounds.size(); ++i)
+    {
+      if (!(_bucket_bounds[i - 1] < _bucket_bounds[i]))
+      {
+        QUILL_THROW(QuillError{"MetricHistogram bucket bounds must be strictly increasing, metric: " +
+                               metric_metadata->metric_key()});
+      }
+    }
+
+    _bucket_counts.resize(_bucket_bounds.size() + 1, 0);
+    detail::init_metric_thread_context<TFrontendOptions>();
+  }
+
+  MetricHistogramImpl(MetricHistogramImpl const&) = delete;
+  MetricHistogramImpl& operator=(MetricHistogramImpl const&) = delete;
+
+  ~MetricHistogramImpl() { (void)flush(); }
+
+  /**
+   * Records a value
+   */
+  QUILL_ATTRIBUTE_HOT void record(double value)
+  {
+    auto const bucket_index = static_cast<size_t>(
+      std::lower_bound(_bucket_bounds.begin(), _bucket_bounds.end(), value) - _bucket_bounds.begin());
+    ++_bucket_counts[bucket_index];
+
+    if (_count == 0)
+    {
+      _min = value;
+      _max = value;
+    }
+    else
+    {
+      _min = (std::min)(_min, value);
+      _max = (std::max)(_max, value);
+    }
+
+    ++_count;
+    _sum += value;
+
+    if (QUILL_UNLIKELY(_policy.on_update()))
+    {
+      (void)flush();
+    }
+  }
+
+  /**
+   * Publishes the values recorded since the previous publish, if any
+   * @return false if the record was dropped by the queue, the values are kept for the next attempt
+   */
+  bool flush()
+  {
+    if (_count == 0)
+    {
+      return true;
+    }
+
+    MetricHistogramData histogram;
+    histogram.bucket_bounds = _bucket_bounds.data();
+    histogram.bucket_counts = _bucket_counts.data();
+    histogram.bucket_bounds_count = _bucket_bounds.size();
+    histogram.count = _count;
+    histogram.sum = _sum;
+    histogram.min = _min;
+    histogram.max = _max;
+
+    if (!_logger->publish_metric_histogram(_metric_metadata, histogram))
+    {
+      return false;
+    }
+
+    std::fill(_bucket_counts.begin(), _bucket_counts.end(), 0);
+    _count = 0;
+    _sum = 0;
+    _policy.on_publish();
+    return true;
+  }
+
+private:
+  LoggerImpl<TFrontendOptions>* _logger;
+  MetricMetadata const* _metric_metadata;
+  detail::MetricAggregationPolicy _policy;
+  std::vector<double> _bucket_bounds;
+  std::vector<uint64_t> _bucket_counts;
+  uint64_t _count{0};
+  double _sum{0};
+  double _min{0};
+  double _max{0};
+};
+
+using MetricCounter = MetricCounterImpl<FrontendOptions>;
+using MetricGauge = MetricGaugeImpl<FrontendOptions>;
+using MetricHistogram = MetricHistogramImpl<FrontendOptions>;
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
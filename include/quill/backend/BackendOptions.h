@@ -43,6 +43,29 @@ inline bool backend_options_default_check_printable_char(char c) noexcept
 
 QUILL_BEGIN_EXPORT
 
+/**
+ * @brief Configuration options for a sink worker thread.
+ */
+struct SinkWorkerOptions
+{
+  /**
+   * The name assigned to the sink worker thread.
+   */
+  std::string thread_name = "QuillSinkWorker";
+
+  /**
+   * Pins the sink worker to the specified CPUs. Follows the same rules as
+   * `BackendOptions::cpu_affinity`.
+   */
+  std::vector<uint16_t> cpu_affinity;
+
+  /**
+   * Capacity in bytes of the queue between the backend thread and the sink worker, rounded up to
+   * the next power of two. The backend thread waits when the queue is full.
+   */
+  uint32_t queue_capacity = 4u * 1024u * 1024u;
+};
+
 /**
  * @brief Configuration options for the backend.
  *
@@ -68,9 +91,38 @@ struct BackendOptions
 
   /**
    * Specifies the duration the backend sleeps if there is no remaining work to process in the queues.
+   * The sleeping backend is parked on a futex (a condition variable on non-Linux platforms) and
+   * Backend::notify() wakes it up.
    */
   std::chrono::nanoseconds sleep_duration = std::chrono::microseconds{100};
 
+  /**
+   * When enabled, the first message a frontend thread logs wakes up the sleeping backend, so a
+   * long sleep_duration keeps the idle CPU usage low without delaying new messages.
+   *
+   * On the hot path the frontend loads a flag in its thread context after the write to the queue,
+   * whether this is enabled or not. It only makes a system call while the backend is sleeping. On
+   * Linux the backend issues a process wide barrier with membarrier() before it sleeps, elsewhere
+   * the frontend also pays a seq_cst fence per message when enabled.
+   *
+   * When disabled, messages logged while the backend sleeps wait for sleep_duration to expire.
+   */
+  bool enable_frontend_wake_up = false;
+
+  /**
+   * Adaptive backoff of the idle backend. When there is no remaining work, the backend first polls
+   * the queues again idle_spin_count times, then idle_pause_count times issuing a cpu pause
+   * instruction before each poll and then idle_yield_count times yielding the thread. Only then it
+   * sleeps for sleep_duration, or keeps spinning/yielding when sleep_duration is 0. Any work resets
+   * the backoff.
+   *
+   * This trades some idle CPU for a lower latency when messages arrive shortly after the backend
+   * ran out of work. By default the backend sleeps as soon as it is idle.
+   */
+  uint32_t idle_spin_count = 0;
+  uint32_t idle_pause_count = 0;
+  uint32_t idle_yield_count = 0;
+
   /**
    * The backend pops all log messages from the frontend queues and buffers them in a
    * local ring buffer queue as transit events. The transit_event_buffer is unbounded, starting with
@@ -224,6 +276,33 @@ struct BackendOptions
    */
   std::vector<uint16_t> cpu_affinity;
 
+  /**
+   * Additional threads that write to sinks on behalf of the backend thread, one per entry.
+   *
+   * The backend thread still reads the frontend queues, orders and formats every event, but the
+   * sink calls for a sink assigned with `Sink::set_sink_worker(index)` run on the worker at that
+   * index. Slow sinks, such as a json file and a console sink, can then write in parallel on
+   * different cores. Each sink is only ever called from a single thread and sees its events in
+   * the same order as before.
+   *
+   * `logger->flush_log()` returns only after the workers have flushed their sinks. Errors raised
+   * by sinks on a worker are reported through `error_notifier` from the worker thread.
+   */
+  std::vector<SinkWorkerOptions> sink_workers;
+
+  /**
+   * Number of threads formatting the log messages, including the backend thread.
+   *
+   * With a value greater than one, the backend thread decodes the messages it reads from the
+   * frontend queues and formats large batches in parallel on `formatter_threads - 1` additional
+   * threads. The formatted messages are still written to the sinks in timestamp order by the backend
+   * thread. Small batches are always formatted on the backend thread.
+   *
+   * Formatting runs user `fmtquill::formatter` specializations, which must then be safe to call
+   * concurrently for different values.
+   */
+  size_t formatter_threads = 1;
+
   /**
    * The backend may encounter exceptions that cannot be caught within user threads.
    * In such cases, the backend invokes this callback to notify the user.
@@ -295,6 +374,28 @@ struct BackendOptions
    */
   std::chrono::milliseconds sink_min_flush_interval = std::chrono::milliseconds{200};
 
+  /**
+   * Interval at which the backend passes a snapshot of the metric samples it received to
+   * Sink::write_metric_snapshot().
+   *
+   * When set, the samples published through a logger, including the histograms of
+   * MetricHistogram, are also aggregated per metric in a LogLinearHistogram of fixed size. Every
+   * interval the sinks of the logger receive the histogram and its metric_snapshot_quantiles for
+   * each metric that received samples, and the histogram is reset. The remaining samples are
+   * passed when the backend stops or the logger is removed.
+   *
+   * As with sink_min_flush_interval, the snapshots may be passed less frequently while the
+   * backend thread is busy.
+   *
+   * Setting this value to 0 disables the aggregation, which is the default.
+   */
+  std::chrono::milliseconds metric_snapshot_interval = std::chrono::milliseconds{0};
+
+  /**
+   * The quantiles computed for each metric snapshot, between 0 and 1.
+   */
+  std::vector<double> metric_snapshot_quantiles{0.5, 0.9, 0.99, 0.999};
+
   /**
    * This option enables a check that verifies the log message contains only printable characters
    * before forwarding it to the sinks. This adds an extra layer of safety by filtering out
@@ -15,13 +15,19 @@
 #include "quill/backend/BackendUtilities.h"
 #include "quill/backend/BackendWorkerLock.h"
 #include "quill/backend/BacktraceStorage.h"
+#include "quill/backend/FormatterPool.h"
+#include "quill/backend/MetricSnapshotAggregator.h"
 #include "quill/backend/PatternFormatter.h"
 #include "quill/backend/RdtscClock.h"
+#include "quill/backend/SerializedFormatArgs.h"
+#include "quill/backend/SinkWorker.h"
 #include "quill/backend/ThreadUtilities.h"
 #include "quill/backend/TransitEvent.h"
 #include "quill/backend/TransitEventBuffer.h"
+#include "quill/backend/TransitEventHeap.h"
 
 #include "quill/core/Attributes.h"
+#include "quill/core/BackendWakeup.h"
 #include "quill/core/BoundedSPSCQueue.h"
 #include "quill/core/ChronoTimeUtils.h"
 #include "quill/core/Codec.h"
@@ -46,7 +52,6 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -56,7 +61,6 @@
 #include <iterator>
 #include <limits>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -69,6 +73,7 @@ QUILL_BEGIN_NAMESPACE
 
 QUILL_BEGIN_EXPORT
 class ManualBackendWorker; // Forward declaration
+class BinaryLogReader;     // Forward declaration
 QUILL_END_EXPORT
 
 namespace detail
@@ -158,6 +163,33 @@ public:
       QUILL_THROW(QuillError{"BackendOptions::sink_min_flush_interval must not be negative"});
     }
 
+    if (options.metric_snapshot_interval.count() < 0)
+    {
+      QUILL_THROW(QuillError{"BackendOptions::metric_snapshot_interval must not be negative"});
+    }
+
+    for (double const quantile : options.metric_snapshot_quantiles)
+    {
+      if (!(quantile >= 0.0 && quantile <= 1.0))
+      {
+        QUILL_THROW(QuillError{fmtquill::format(
+          "BackendOptions::metric_snapshot_quantiles must be between 0 and 1, got {}", quantile)});
+      }
+    }
+
+    if (options.formatter_threads == 0)
+    {
+      QUILL_THROW(QuillError{"BackendOptions::formatter_threads must be at least 1"});
+    }
+
+    for (SinkWorkerOptions const& sink_worker_options : options.sink_workers)
+    {
+      if (sink_worker_options.queue_capacity < 1024)
+      {
+        QUILL_THROW(QuillError{"SinkWorkerOptions::queue_capacity must be at least 1024"});
+      }
+    }
+
     (void)BackendMdcState{options.mdc_format_pattern};
 
     size_t const soft_limit = (options.transit_events_soft_limit == 0) ? 1 : options.transit_events_soft_limit;
@@ -370,27 +402,43 @@ public:
    * Wakes up the backend worker thread.
    * Thread safe to be called from any thread
    */
-  void notify()
+  void notify() { BackendWakeup::instance().notify(); }
+
+private:
+  /**
+   * A message decoded by the backend thread and waiting to be formatted by the formatter threads
+   */
+  struct FormatJob
   {
-#ifdef __MINGW32__
-    // MinGW can deadlock if the mutex is released before cv.notify_one(),
-    // so keep notify_one() inside the lock for MinGW
-    std::lock_guard<std::mutex> lock{_wake_up_mutex};
-    _wake_up_flag = true;
-    _wake_up_cv.notify_one();
-#else
-    // Set the flag to indicate that the data is ready
-    {
-      std::lock_guard<std::mutex> lock{_wake_up_mutex};
-      _wake_up_flag = true;
-    }
+    DynamicFormatArgStore format_args_store;
+    std::string message_format;
+    std::vector<std::pair<std::string, std::string>> arg_names;
+    std::string error;
+    std::string named_args_error;
+    TransitEventBuffer* transit_event_buffer{nullptr}; /** The buffer of the event being formatted **/
+    size_t transit_event_index{0}; /** The position of the event from the front of its buffer **/
+    bool format_message{false};    /** False when decoding the arguments failed **/
+    MacroMetadata const* macro_metadata{nullptr};
+    std::vector<std::pair<std::string, std::string>>* named_args{nullptr};
+  };
+
+  /** Smaller batches are formatted on the backend thread as waking the formatter threads costs more **/
+  static constexpr size_t min_parallel_format_jobs{64};
 
-    // Signal the condition variable to wake up the worker thread
-    _wake_up_cv.notify_one();
-#endif
-  }
+  /**
+   * The log statements collected for a sink that supports batch writes, written with a single
+   * Sink::write_log_batch() call
+   */
+  struct PendingSinkBatch
+  {
+    Sink* sink{nullptr}; /** nullptr when the entry is not in use **/
+    std::vector<LogRecordView> records;
+    std::string log_statements; /** The log statements of the records, in the same order **/
+  };
+
+  /** A batch is written early once its log statements reach this size **/
+  static constexpr size_t max_pending_sink_batch_size{1024 * 1024};
 
-private:
   /***/
   QUILL_ATTRIBUTE_HOT void _invoke_poll_hook(std::function<void()> const& hook) const
   {
@@ -485,8 +533,16 @@ private:
     // Read all frontend queues and cache the log statements and the metadata as TransitEvents
     size_t const cached_transit_events_count = _populate_transit_events_from_frontend_queues();
 
+    if (QUILL_UNLIKELY(_options.metric_snapshot_interval.count() != 0))
+    {
+      // Also checked while busy, the interval is usually longer than the backend is idle for
+      _write_metric_snapshots(false);
+    }
+
     if (cached_transit_events_count != 0)
     {
+      _idle_poll_count = 0;
+
       // there are cached events to process
       if (cached_transit_events_count < _options.transit_events_soft_limit)
       {
@@ -495,7 +551,10 @@ private:
       }
       else
       {
-        // we want to process a batch of events.
+        // we want to process a batch of events. The log statements of the sinks that support
+        // batch writes are collected and written once the batch is processed
+        _batch_sink_writes = true;
+
         while (!has_pending_events_for_caching_when_transit_event_buffer_empty() &&
                _process_lowest_timestamp_transit_event())
         {
@@ -504,12 +563,21 @@ private:
           // messages can result in out-of-order log entries, as messages with lower timestamps
           // in the queue might be missed.
         }
+
+        _batch_sink_writes = false;
+        _write_pending_sink_batches();
       }
     }
     else
     {
       // No cached transit events to process, minimal thread workload.
 
+      // Drop the sinks the workers kept alive for loggers that have since been removed
+      for (auto const& sink_worker : _sink_workers)
+      {
+        sink_worker->release_unused_sinks();
+      }
+
       // force flush all remaining messages
       _flush_and_run_active_sinks(true, _options.sink_min_flush_interval);
 
@@ -533,32 +601,88 @@ private:
           _invoke_poll_end_once(poll_end_called);
         }
 
-        // There is nothing left to do, and we can let this thread sleep for a while
-        // buffer events are 0 here and also all the producer queues are empty
-        if (_options.sleep_duration.count() != 0)
-        {
-          std::unique_lock<std::mutex> lock{_wake_up_mutex};
+        // There is nothing left to do, buffer events are 0 here and also all the producer queues
+        // are empty
+        _wait_when_idle();
+      }
+    }
 
-          // Wait for a timeout or a notification to wake up
-          _wake_up_cv.wait_for(lock, _options.sleep_duration, [this] { return _wake_up_flag; });
+    // poll hook
+    if (QUILL_UNLIKELY(static_cast<bool>(_options.backend_worker_on_poll_end)))
+    {
+      _invoke_poll_end_once(poll_end_called);
+    }
+  }
+
+  /**
+   * Called when the backend has no work. Goes through the spin, pause and yield stages of the idle
+   * backoff and then lets this thread sleep for a while
+   */
+  QUILL_ATTRIBUTE_HOT void _wait_when_idle()
+  {
+    uint64_t const idle_poll_count = _idle_poll_count++;
+    uint64_t backoff_limit = _options.idle_spin_count;
+
+    if (idle_poll_count < backoff_limit)
+    {
+      return;
+    }
+
+    backoff_limit += _options.idle_pause_count;
+
+    if (idle_poll_count < backoff_limit)
+    {
+      detail::cpu_pause();
+      return;
+    }
+
+    backoff_limit += _options.idle_yield_count;
+
+    if (idle_poll_count < backoff_limit)
+    {
+      detail::yield_thread();
+      return;
+    }
+
+    if (_options.sleep_duration.count() != 0)
+    {
+      BackendWakeup& backend_wakeup = BackendWakeup::instance();
+
+      if (_options.enable_frontend_wake_up)
+      {
+        // The frontend threads check the flag after each message and wake up the parked backend
+        uint8_t const parked_state = backend_wakeup.thread_context_wake_up_state(true);
+
+        for (ThreadContext* thread_context : _active_thread_contexts_cache)
+        {
+          thread_context->set_backend_wake_up_state(parked_state);
+        }
 
-          // set the flag back to false since we woke up here
-          _wake_up_flag = false;
+        // Orders the flags before the last check of the queues below, pairs with the compiler
+        // fence in Logger::_wake_up_backend_if_parked() after the queue commit
+        backend_wakeup.process_barrier();
+      }
 
-          // After waking up resync rdtsc clock again and resume
-          _resync_rdtsc_clock();
+      if (backend_wakeup.prepare_park())
+      {
+        // Check again, a frontend thread may have written to its queue before the flag was set
+        if (_check_frontend_queues_and_cached_transit_events_empty())
+        {
+          // Wait for a timeout or a notification to wake up
+          backend_wakeup.park(_options.sleep_duration);
         }
-        else if (_options.enable_yield_when_idle)
+        else
         {
-          detail::yield_thread();
+          backend_wakeup.finish_park();
         }
       }
-    }
 
-    // poll hook
-    if (QUILL_UNLIKELY(static_cast<bool>(_options.backend_worker_on_poll_end)))
+      // After waking up resync rdtsc clock again and resume
+      _resync_rdtsc_clock();
+    }
+    else if (_options.enable_yield_when_idle)
     {
-      _invoke_poll_end_once(poll_end_called);
+      detail::yield_thread();
     }
   }
 
@@ -568,6 +692,9 @@ private:
   QUILL_ATTRIBUTE_COLD void _init(BackendOptions const& options)
   {
     _options = options;
+    _idle_poll_count = 0;
+    BackendWakeup::instance().set_frontend_wake_up_enabled(_options.enable_frontend_wake_up);
+    _reset_thread_contexts_wake_up_state();
     _is_rdtsc_clock_config_valid.store(_options.sleep_duration <= _options.rdtsc_resync_interval,
                                        std::memory_order_relaxed);
 
@@ -588,12 +715,31 @@ private:
     }
 
     _last_output_timestamp = 0;
+    _last_metric_snapshot_time = std::chrono::steady_clock::now();
 
     // Backend::stop() releases the worker's cache, but thread-local contexts can
     // outlive the backend thread and be reused after a later Backend::start().
     // Refresh unconditionally so existing frontend queues are visible again.
     _update_active_thread_contexts_cache(true);
 
+    // The backend thread is one of the formatter threads
+    _formatter_pool.reset();
+
+    if (_options.formatter_threads > 1)
+    {
+      _formatter_pool =
+        std::make_unique<FormatterPool>(_options.formatter_threads - 1, _options.thread_name + "Fmt");
+    }
+
+    _sink_workers.clear();
+
+    for (SinkWorkerOptions const& sink_worker_options : _options.sink_workers)
+    {
+      _sink_workers.push_back(std::make_unique<SinkWorker>(
+        sink_worker_options, _options.sleep_duration, _options.error_notifier, _process_id));
+      _sink_workers.back()->start();
+    }
+
     // Cache this thread's id only after initialization has succeeded. ManualBackendWorker::init()
     // calls this function on the caller thread and can propagate validation errors.
     uint32_t const worker_thread_id = get_thread_id();
@@ -601,6 +747,18 @@ private:
     LoggerBase::set_current_thread_is_backend_thread(true);
   }
 
+  /**
+   * Updates the thread contexts that exist before the frontend wake up is enabled or disabled, new
+   * ones start with BackendWakeup::thread_context_wake_up_state()
+   */
+  QUILL_ATTRIBUTE_COLD void _reset_thread_contexts_wake_up_state()
+  {
+    uint8_t const state = BackendWakeup::instance().thread_context_wake_up_state(false);
+
+    _thread_context_manager.for_each_thread_context(
+      [state](ThreadContext* thread_context) { thread_context->set_backend_wake_up_state(state); });
+  }
+
   /***/
   void _clear_backend_thread_flag() noexcept
   {
@@ -612,6 +770,9 @@ private:
    */
   QUILL_ATTRIBUTE_COLD void _exit()
   {
+    BackendWakeup::instance().set_frontend_wake_up_enabled(false);
+    _reset_thread_contexts_wake_up_state();
+
     while (true)
     {
       bool const queues_and_events_empty = (!_options.wait_for_queues_to_empty_before_exit) ||
@@ -621,6 +782,7 @@ private:
       {
         // we are done, all queues are now empty
         _check_failure_counter(_options.error_notifier);
+        _write_metric_snapshots(true);
         _flush_and_run_active_sinks(false, std::chrono::milliseconds{0});
         break;
       }
@@ -628,6 +790,8 @@ private:
       uint64_t const cached_transit_events_count = _populate_transit_events_from_frontend_queues();
       if (cached_transit_events_count > 0)
       {
+        _batch_sink_writes = true;
+
         while (!has_pending_events_for_caching_when_transit_event_buffer_empty() &&
                _process_lowest_timestamp_transit_event())
         {
@@ -636,6 +800,9 @@ private:
           // messages can result in out-of-order log entries, as messages with lower timestamps
           // in the queue might be missed.
         }
+
+        _batch_sink_writes = false;
+        _write_pending_sink_batches();
       }
     }
 
@@ -645,6 +812,10 @@ private:
     // resynchronizes, and republishes the same stable allocation.
     _rdtsc_clock.store(nullptr, std::memory_order_release);
 
+    // The final flush above waited for the sink workers, they have nothing left to process
+    _sink_workers.clear();
+    _formatter_pool.reset();
+
     _cleanup_invalidated_thread_contexts();
     _cleanup_invalidated_loggers();
 
@@ -664,6 +835,9 @@ private:
 
     size_t total_cached_transit_events_count{0};
 
+    // The signal handler can pause the backend here and read the frontend queues itself
+    _thread_context_manager.begin_consume();
+
     for (ThreadContext* thread_context : _active_thread_contexts_cache)
     {
       QUILL_ASSERT(thread_context->has_unbounded_queue_type() || thread_context->has_bounded_queue_type(),
@@ -681,6 +855,10 @@ private:
       }
     }
 
+    _run_format_jobs();
+
+    _thread_context_manager.end_consume();
+
     return total_cached_transit_events_count;
   }
 
@@ -710,7 +888,24 @@ private:
 
       if constexpr (std::is_same_v<TFrontendQueue, UnboundedSPSCQueue>)
       {
-        read_pos = _read_unbounded_frontend_queue(frontend_queue, thread_context);
+        read_pos = nullptr;
+
+        if (_format_jobs_count != 0)
+        {
+          read_pos = frontend_queue.prepare_read_current_buffer();
+
+          if (!read_pos)
+          {
+            // The next read can switch to a newer buffer and delete the current one, which the
+            // pending format jobs may reference
+            _run_format_jobs();
+          }
+        }
+
+        if (!read_pos)
+        {
+          read_pos = _read_unbounded_frontend_queue(frontend_queue, thread_context);
+        }
       }
       else
       {
@@ -743,10 +938,19 @@ private:
 
     if (total_bytes_read != 0)
     {
-      // If we read something from the queue, we commit all the reads together at the end.
-      // This strategy enhances cache coherence performance by updating the shared atomic flag
-      // only once.
-      frontend_queue.commit_read();
+      if (_format_jobs_count != 0)
+      {
+        // The arguments of the pending format jobs can reference the queue memory, commit once
+        // they are formatted
+        _thread_contexts_pending_commit.push_back(thread_context);
+      }
+      else
+      {
+        // If we read something from the queue, we commit all the reads together at the end.
+        // This strategy enhances cache coherence performance by updating the shared atomic flag
+        // only once.
+        frontend_queue.commit_read();
+      }
     }
 
     return thread_context->_transit_event_buffer->size();
@@ -785,9 +989,13 @@ private:
       transit_event,
       "transit_event is nullptr in BackendWorker::_populate_transit_event_from_frontend_queue()");
 
-    QUILL_ASSERT(
-      transit_event->formatted_msg,
-      "formatted_msg is nullptr in BackendWorker::_populate_transit_event_from_frontend_queue()");
+    // Clean up the fields left by the previous event that used this transit event
+    if (transit_event->extra_data)
+    {
+      transit_event->extra_data->named_args.clear();
+      transit_event->extra_data->mdc.clear();
+      transit_event->extra_data->runtime_metadata.has_runtime_metadata = false;
+    }
 
     static_assert(sizeof(FormatArgsDecoder) == sizeof(uintptr_t),
                   "FormatArgsDecoder must fit in uintptr_t for packed header decoding");
@@ -803,6 +1011,15 @@ private:
       reinterpret_cast<MacroMetadata const*>(static_cast<uintptr_t>(header_words[1]));
     transit_event->logger_base = reinterpret_cast<LoggerBase*>(static_cast<uintptr_t>(header_words[2]));
 
+    if (thread_context->has_shared_queue_type())
+    {
+      // Shared queues carry the identity of the producing thread after the header
+      uintptr_t thread_identity;
+      std::memcpy(&thread_identity, read_pos, sizeof(thread_identity));
+      read_pos += sizeof(thread_identity);
+      transit_event->thread_identity = reinterpret_cast<ThreadIdentity const*>(thread_identity);
+    }
+
     QUILL_ASSERT(transit_event->logger_base,
                  "transit_event->logger_base is nullptr after memcpy from queue");
 
@@ -882,7 +1099,18 @@ private:
       (transit_event->macro_metadata->event() == MacroMetadata::Event::MdcErase) ||
       (transit_event->macro_metadata->event() == MacroMetadata::Event::MdcClear);
 
-    if (transit_event->macro_metadata->event() != MacroMetadata::Event::Metric)
+    if (transit_event->macro_metadata->event() == MacroMetadata::Event::MetricHistogram)
+    {
+      // The header carries the size of the encoded histogram, it is copied as is and decoded when
+      // the event is written
+      auto const payload_size = static_cast<size_t>(header_words[3]);
+      transit_event->reset_payload();
+      transit_event->formatted_msg.clear();
+      transit_event->formatted_msg.append(reinterpret_cast<char const*>(read_pos),
+                                          reinterpret_cast<char const*>(read_pos + payload_size));
+      read_pos += payload_size;
+    }
+    else if (transit_event->macro_metadata->event() != MacroMetadata::Event::Metric)
     {
       uintptr_t const decoder_bits = static_cast<uintptr_t>(header_words[3]);
       FormatArgsDecoder format_args_decoder;
@@ -908,57 +1136,49 @@ private:
         if ((transit_event->macro_metadata->event() != MacroMetadata::Event::Flush) &&
             (transit_event->macro_metadata->event() != MacroMetadata::Event::LoggerRemovalRequest))
         {
-          format_args_decoder(read_pos, _format_args_store);
+          // A transit event is reused, it can still hold the decoder of a stored backtrace event
+          transit_event->reset_payload();
 
-          if (!transit_event->macro_metadata->has_named_args())
-          {
-            _populate_formatted_log_message(transit_event, transit_event->macro_metadata->message_format());
-          }
-          else if (runtime_metadata_event)
+          if (!_apply_pre_format_filters(*thread_context, *transit_event))
           {
-            // Runtime metadata format strings are user generated and can be unique per call;
-            // caching them would grow _named_args_templates without bound for the lifetime of
-            // the backend, so process them without caching
-            auto const [message_format, arg_names] =
-              _process_named_args_format_message(transit_event->macro_metadata->message_format());
-
-            _populate_formatted_log_message(transit_event, message_format.data());
-            _populate_formatted_named_args(transit_event, arg_names);
+            // No sink writes this log statement, the arguments are only decoded to release them
+            format_args_decoder(read_pos, _format_args_store);
+            transit_event->formatted_msg.clear();
           }
           else
           {
-            // using the message_format as key for lookups
-            _named_args_format_template.assign(transit_event->macro_metadata->message_format());
-
-            if (auto const search = _named_args_templates.find(_named_args_format_template);
-                search != std::cend(_named_args_templates))
-            {
-              // process named args message when we already have parsed the format message once,
-              // and we have the names of each arg cached
-              auto const& [message_format, arg_names] = search->second;
+            bool const backtrace_event = (transit_event->log_level() == LogLevel::Backtrace);
 
-              _populate_formatted_log_message(transit_event, message_format.data());
-              _populate_formatted_named_args(transit_event, arg_names);
-            }
-            else
-            {
-              // process named args log when the message format is processed for the first time
-              // parse name of each arg and stored them to our lookup map
-              auto const [res_it, inserted] = _named_args_templates.try_emplace(
-                _named_args_format_template,
-                _process_named_args_format_message(transit_event->macro_metadata->message_format()));
+            // When the sinks format the message themselves only the arguments are serialized
+            bool const serialize_format_args =
+              !backtrace_event && _writes_format_args(*transit_event->logger_base);
 
-              auto const& [message_format, arg_names] = res_it->second;
+            // With formatter threads the message is only decoded here and formatted later in a
+            // batch. Backtrace log statements are decoded here to find the size of their arguments
+            _format_job = (_formatter_pool && !backtrace_event && !serialize_format_args)
+              ? &_acquire_format_job(*thread_context->_transit_event_buffer)
+              : nullptr;
 
-              // suppress unused warnings
-              (void)inserted;
+            std::byte const* const encoded_args = read_pos;
+            format_args_decoder(read_pos,
+                                _format_job ? _format_job->format_args_store : _format_args_store);
 
-              _populate_formatted_log_message(transit_event, message_format.data());
-              _populate_formatted_named_args(transit_event, arg_names);
+            if (serialize_format_args)
+            {
+              if (!_store_serialized_format_args(transit_event))
+              {
+                _populate_formatted_message(transit_event, runtime_metadata_event);
+              }
+            }
+            else if (!backtrace_event ||
+                     !_store_backtrace_arguments(transit_event, format_args_decoder, encoded_args, read_pos))
+            {
+              _populate_formatted_message(transit_event, runtime_metadata_event);
             }
-          }
 
-          _set_transit_event_mdc(*thread_context, transit_event);
+            _set_transit_event_mdc(*thread_context, transit_event);
+            _format_job = nullptr;
+          }
         }
         else if (transit_event->macro_metadata->event() == MacroMetadata::Event::Flush)
         {
@@ -997,8 +1217,16 @@ private:
 
     if (!is_mdc_event)
     {
+      bool const was_empty = thread_context->_transit_event_buffer->empty();
+
       // commit this transit event
       thread_context->_transit_event_buffer->push_back();
+
+      if (was_empty)
+      {
+        // This is now the front event of the buffer
+        _transit_event_heap.push(transit_event->timestamp, thread_context);
+      }
     }
 
     _format_args_store.clear();
@@ -1014,6 +1242,12 @@ private:
   {
     _update_active_thread_contexts_cache();
 
+    if (_transit_event_heap.size() == _active_thread_contexts_cache.size())
+    {
+      // Every thread context is in the heap, so none of them has an empty transit event buffer
+      return false;
+    }
+
     for (ThreadContext* thread_context : _active_thread_contexts_cache)
     {
       QUILL_ASSERT(thread_context->_transit_event_buffer,
@@ -1046,31 +1280,14 @@ private:
    */
   QUILL_ATTRIBUTE_HOT bool _process_lowest_timestamp_transit_event()
   {
-    // Get the lowest timestamp
-    uint64_t min_ts{(std::numeric_limits<uint64_t>::max)()};
-    ThreadContext* thread_context{nullptr};
-
-    for (ThreadContext* tc : _active_thread_contexts_cache)
-    {
-      QUILL_ASSERT(tc->_transit_event_buffer,
-                   "transit_event_buffer is nullptr in "
-                   "BackendWorker::_process_lowest_timestamp_transit_event(), should be valid in "
-                   "_active_thread_contexts_cache");
-
-      TransitEvent const* te = tc->_transit_event_buffer->front();
-      if (te && (min_ts > te->timestamp))
-      {
-        min_ts = te->timestamp;
-        thread_context = tc;
-      }
-    }
-
-    if (!thread_context)
+    if (_transit_event_heap.empty())
     {
       // all transit event buffers are empty
       return false;
     }
 
+    ThreadContext* const thread_context = _transit_event_heap.top();
+
     TransitEvent* transit_event = thread_context->_transit_event_buffer->front();
     QUILL_ASSERT(
       transit_event,
@@ -1088,20 +1305,23 @@ private:
     }
 #endif
 
-    // Finally, clean up any remaining fields in the transit event
-    if (transit_event->extra_data)
-    {
-      transit_event->extra_data->named_args.clear();
-      transit_event->extra_data->mdc.clear();
-      transit_event->extra_data->runtime_metadata.has_runtime_metadata = false;
-    }
-
+    // Note: the extra_data fields are cleared when the transit event is reused, the log records
+    // of a pending sink batch refer to them until the batch is written.
     // Note: event_payload is reset only in the Flush and Metric branches of _process_transit_event
     // where it is actually populated, rather than unconditionally here. This keeps the common
     // Log path free of an extra variant assignment.
 
     thread_context->_transit_event_buffer->pop_front();
 
+    if (TransitEvent const* next_transit_event = thread_context->_transit_event_buffer->front())
+    {
+      _transit_event_heap.replace_top(next_transit_event->timestamp, thread_context);
+    }
+    else
+    {
+      _transit_event_heap.pop();
+    }
+
     if (flush_flag)
     {
       // Process the second part of the flush event after it's been removed from the buffer,
@@ -1129,6 +1349,15 @@ private:
   QUILL_ATTRIBUTE_HOT void _process_transit_event(ThreadContext const& thread_context,
                                                   TransitEvent& transit_event, std::atomic<bool>*& flush_flag)
   {
+    // Events from a shared queue carry the identity of their producer thread
+    std::string_view const producer_thread_id = transit_event.thread_identity
+      ? std::string_view{transit_event.thread_identity->thread_id}
+      : thread_context.thread_id();
+
+    std::string_view const producer_thread_name = transit_event.thread_identity
+      ? std::string_view{transit_event.thread_identity->thread_name}
+      : thread_context.thread_name();
+
     // If backend_process(...) throws we want to skip this event and move to the next, so we catch
     // the error here instead of catching it in the parent try/catch block of main_loop
     if (transit_event.macro_metadata->event() == MacroMetadata::Event::Log)
@@ -1136,8 +1365,8 @@ private:
       if (transit_event.log_level() != LogLevel::Backtrace)
       {
         _ensure_monotonic_output_timestamp(transit_event);
-        _dispatch_transit_event_to_sinks(transit_event, thread_context.thread_id(),
-                                         thread_context.thread_name());
+        _dispatch_transit_event_to_sinks(transit_event, producer_thread_id, producer_thread_name,
+                                         _batch_sink_writes);
 
         // We also need to check the severity of the log message here against the backtrace
         // Check if we should also flush the backtrace messages:
@@ -1149,9 +1378,15 @@ private:
         {
           if (transit_event.logger_base->_backtrace_storage)
           {
+            // The stored events are cleared after they are written, they can not be batched
+            _write_pending_sink_batches();
+
             transit_event.logger_base->_backtrace_storage->process(
-              [this](TransitEvent const& te, std::string_view thread_id, std::string_view thread_name)
-              { _dispatch_transit_event_to_sinks(te, thread_id, thread_name); });
+              [this](TransitEvent& te, std::string_view thread_id, std::string_view thread_name)
+              {
+                _format_backtrace_arguments(te);
+                _dispatch_transit_event_to_sinks(te, thread_id, thread_name, false);
+              });
           }
         }
       }
@@ -1159,14 +1394,10 @@ private:
       {
         if (transit_event.logger_base->_backtrace_storage)
         {
-          // this is a backtrace log and we will store the transit event
-          // we need to pass a copy of transit_event here and not move the existing
+          // this is a backtrace log and we will store the transit event, the storage copies it as
           // the transit events are reused
-          TransitEvent transit_event_copy;
-          transit_event.copy_to(transit_event_copy);
-
-          transit_event.logger_base->_backtrace_storage->store(
-            std::move(transit_event_copy), thread_context.thread_id(), thread_context.thread_name());
+          transit_event.logger_base->_backtrace_storage->store(transit_event, producer_thread_id,
+                                                               producer_thread_name);
         }
         else
         {
@@ -1186,16 +1417,21 @@ private:
       }
 
       transit_event.logger_base->_backtrace_storage->set_capacity(static_cast<uint32_t>(std::stoul(
-        std::string{transit_event.formatted_msg->begin(), transit_event.formatted_msg->end()})));
+        std::string{transit_event.formatted_msg.begin(), transit_event.formatted_msg.end()})));
     }
     else if (transit_event.macro_metadata->event() == MacroMetadata::Event::FlushBacktrace)
     {
       if (transit_event.logger_base->_backtrace_storage)
       {
         // process all records in backtrace for this logger and log them
+        _write_pending_sink_batches();
+
         transit_event.logger_base->_backtrace_storage->process(
-          [this](TransitEvent const& te, std::string_view thread_id, std::string_view thread_name)
-          { _dispatch_transit_event_to_sinks(te, thread_id, thread_name); });
+          [this](TransitEvent& te, std::string_view thread_id, std::string_view thread_name)
+          {
+            _format_backtrace_arguments(te);
+            _dispatch_transit_event_to_sinks(te, thread_id, thread_name, false);
+          });
       }
     }
     else if (transit_event.macro_metadata->event() == MacroMetadata::Event::Flush)
@@ -1213,12 +1449,26 @@ private:
     else if (transit_event.macro_metadata->event() == MacroMetadata::Event::Metric)
     {
       _ensure_monotonic_output_timestamp(transit_event);
-      _write_metric_sample(transit_event, thread_context.thread_id(), thread_context.thread_name());
+      _write_pending_sink_batches();
+      _write_metric_sample(transit_event, producer_thread_id, producer_thread_name);
+
+      if (_options.metric_snapshot_interval.count() != 0)
+      {
+        _metric_snapshot_aggregator.record(
+          transit_event.logger_base, static_cast<MetricMetadata const*>(transit_event.macro_metadata),
+          transit_event.timestamp, transit_event.metric_value());
+      }
 
       // Reset the payload as TransitEvents are re-used, so a later reuse of this slot starts
       // from a clean variant state instead of still carrying the metric value.
       transit_event.reset_payload();
     }
+    else if (transit_event.macro_metadata->event() == MacroMetadata::Event::MetricHistogram)
+    {
+      _ensure_monotonic_output_timestamp(transit_event);
+      _write_pending_sink_batches();
+      _write_metric_histogram(transit_event, producer_thread_id, producer_thread_name);
+    }
     else
     {
       QUILL_ASSERT(transit_event.macro_metadata->event() == MacroMetadata::Event::LoggerRemovalRequest,
@@ -1254,7 +1504,9 @@ private:
    * Dispatches a transit event
    */
   QUILL_ATTRIBUTE_HOT void _dispatch_transit_event_to_sinks(TransitEvent const& transit_event,
-                                                            std::string_view thread_id, std::string_view thread_name)
+                                                            std::string_view thread_id,
+                                                            std::string_view thread_name,
+                                                            bool batch_sink_writes)
   {
     // First check to see if we should init the pattern formatter on a new Logger
     // Look up to see if we have the formatter and if not create it
@@ -1298,7 +1550,31 @@ private:
 
     _write_log_statement(
       transit_event, thread_id, thread_name, log_level_description, log_level_short_code,
-      std::string_view{transit_event.formatted_msg->data(), transit_event.formatted_msg->size()});
+      std::string_view{transit_event.formatted_msg.data(), transit_event.formatted_msg.size()},
+      batch_sink_writes);
+  }
+
+  /**
+   * Formats the log statement, directly into the output buffer of the sink when one is given
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT std::string_view _format_log_statement(
+    PatternFormatter& pattern_formatter, fmtquill::detail::buffer<char>* sink_buffer,
+    TransitEvent const& transit_event, std::string_view thread_id, std::string_view thread_name,
+    std::string_view log_level_description, std::string_view log_level_short_code,
+    std::string_view log_message) const
+  {
+    if (sink_buffer)
+    {
+      return pattern_formatter.format_to(
+        *sink_buffer, transit_event.timestamp, thread_id, thread_name, _process_id,
+        transit_event.logger_base->_logger_name, log_level_description, log_level_short_code,
+        *transit_event.macro_metadata, transit_event.get_named_args(), log_message, transit_event.mdc());
+    }
+
+    return pattern_formatter.format(transit_event.timestamp, thread_id, thread_name, _process_id,
+                                    transit_event.logger_base->_logger_name, log_level_description,
+                                    log_level_short_code, *transit_event.macro_metadata,
+                                    transit_event.get_named_args(), log_message, transit_event.mdc());
   }
 
   /**
@@ -1320,6 +1596,13 @@ private:
 
     for (auto& sink : transit_event.logger_base->_sinks)
     {
+      if (SinkWorker* sink_worker = _get_sink_worker(*sink))
+      {
+        sink_worker->write_metric(sink.get(), metric_metadata, transit_event.timestamp, thread_id,
+                                  thread_name, transit_event.logger_base->_logger_name, metric_value);
+        continue;
+      }
+
       QUILL_TRY
       {
         sink->write_metric(metric_metadata, transit_event.timestamp, thread_id, thread_name,
@@ -1336,69 +1619,36 @@ private:
   }
 
   /**
-   * Formats and writes the log statement to each sink
+   * Forwards a histogram aggregated on the frontend to each sink associated with the logger.
    */
-  QUILL_ATTRIBUTE_HOT void _write_log_statement(TransitEvent const& transit_event,
-                                                std::string_view const& thread_id,
-                                                std::string_view const& thread_name,
-                                                std::string_view const& log_level_description,
-                                                std::string_view const& log_level_short_code,
-                                                std::string_view const& log_message) const
+  void _write_metric_histogram(TransitEvent const& transit_event, std::string_view thread_id,
+                               std::string_view thread_name)
   {
-    std::string_view default_log_statement;
+    MetricHistogramData histogram;
+    MetricMetadata const* metric_metadata = decode_metric_histogram(
+      reinterpret_cast<std::byte const*>(transit_event.formatted_msg.data()), histogram,
+      _metric_histogram_bucket_bounds, _metric_histogram_bucket_counts);
+
+    if (_options.metric_snapshot_interval.count() != 0)
+    {
+      _metric_snapshot_aggregator.merge(transit_event.logger_base, metric_metadata,
+                                        transit_event.timestamp, histogram);
+    }
 
-    // Process each sink with the appropriate formatting and filtering
     for (auto& sink : transit_event.logger_base->_sinks)
     {
-      QUILL_TRY
+      if (SinkWorker* sink_worker = _get_sink_worker(*sink))
       {
-        std::string_view log_to_write;
-
-        // Determine which formatted log to use
-        if (!sink->_override_pattern_formatter_options)
-        {
-          if (default_log_statement.empty())
-          {
-            // Use the default formatted log statement, here by checking empty() we try to format
-            // once even for multiple sinks
-            default_log_statement = transit_event.logger_base->_pattern_formatter->format(
-              transit_event.timestamp, thread_id, thread_name, _process_id,
-              transit_event.logger_base->_logger_name, log_level_description, log_level_short_code,
-              *transit_event.macro_metadata, transit_event.get_named_args(), log_message,
-              transit_event.mdc());
-          }
-
-          log_to_write = default_log_statement;
-        }
-        else
-        {
-          // Sink has override_pattern_formatter_options, we do not include PatternFormatter
-          // in the frontend fo this reason we init PatternFormatter here
-          if (!sink->_override_pattern_formatter)
-          {
-            // Initialize override formatter if needed
-            sink->_override_pattern_formatter =
-              std::make_shared<PatternFormatter>(*sink->_override_pattern_formatter_options);
-          }
-
-          // Use the sink's override formatter
-          log_to_write = sink->_override_pattern_formatter->format(
-            transit_event.timestamp, thread_id, thread_name, _process_id, transit_event.logger_base->_logger_name,
-            log_level_description, log_level_short_code, *transit_event.macro_metadata,
-            transit_event.get_named_args(), log_message, transit_event.mdc());
-        }
+        sink_worker->write_metric_histogram(sink.get(), metric_metadata, transit_event.timestamp,
+                                            thread_id, thread_name,
+                                            transit_event.logger_base->_logger_name, histogram);
+        continue;
+      }
 
-        // Apply filters now that we have the formatted log
-        if (sink->apply_all_filters(transit_event.macro_metadata, transit_event.timestamp,
-                                    thread_id, thread_name, transit_event.logger_base->_logger_name,
-                                    transit_event.log_level(), log_message, log_to_write))
-        {
-          // Forward the message using the computed log statement that passed the filter
-          sink->write_log(transit_event.macro_metadata, transit_event.timestamp, thread_id,
-                          thread_name, _process_id, transit_event.logger_base->_logger_name,
-                          transit_event.log_level(), log_level_description, log_level_short_code,
-                          transit_event.get_named_args(), log_message, log_to_write);
-        }
+      QUILL_TRY
+      {
+        sink->write_metric_histogram(metric_metadata, transit_event.timestamp, thread_id, thread_name,
+                                     _process_id, transit_event.logger_base->_logger_name, histogram);
       }
 #if !defined(QUILL_NO_EXCEPTIONS)
       QUILL_CATCH(std::exception const& e) { _notify_error(_options.error_notifier, e.what()); }
@@ -1411,28 +1661,305 @@ private:
   }
 
   /**
-   * Check for dropped or blocked events
-   * @param error_notifier error notifier
+   * Passes the metric snapshots to the sinks every metric_snapshot_interval
+   * @param force pass them now, e.g. when the backend stops
    */
-  QUILL_ATTRIBUTE_HOT void _check_failure_counter(std::function<void(std::string const&)> const& error_notifier)
+  void _write_metric_snapshots(bool force)
   {
-    if (!error_notifier)
+    if (_metric_snapshot_aggregator.empty())
     {
       return;
     }
 
-    for (ThreadContext* thread_context : _active_thread_contexts_cache)
+    auto const now = std::chrono::steady_clock::now();
+
+    if (!force && ((now - _last_metric_snapshot_time) < _options.metric_snapshot_interval))
     {
-      size_t const failed_events_cnt = thread_context->get_and_reset_failure_counter();
+      return;
+    }
 
-      if (QUILL_UNLIKELY(failed_events_cnt > 0))
-      {
-        std::string const timestamp = _get_local_time_str();
+    _last_metric_snapshot_time = now;
+    _write_pending_sink_batches();
 
-        if (thread_context->has_dropping_queue())
-        {
-          if (thread_context->has_unbounded_queue_type())
-          {
+    bool sink_workers_idle{false};
+    _metric_snapshot_aggregator.process(
+      [this, &sink_workers_idle](MetricSnapshotAggregator::Series const& series)
+      { _write_metric_snapshot(series, sink_workers_idle); });
+  }
+
+  /**
+   * Forwards the snapshot of a metric to each sink associated with the logger.
+   * @param sink_workers_idle set once the sink workers were waited for in the current snapshot
+   * pass. Nothing else is queued to them during the pass, so they are only waited for once
+   */
+  void _write_metric_snapshot(MetricSnapshotAggregator::Series const& series,
+                              bool& sink_workers_idle)
+  {
+    _metric_snapshot_quantile_values.clear();
+
+    for (double const quantile : _options.metric_snapshot_quantiles)
+    {
+      _metric_snapshot_quantile_values.push_back(series.histogram.value_at_quantile(quantile));
+    }
+
+    MetricSnapshot snapshot;
+    snapshot.histogram = &series.histogram;
+    snapshot.quantiles = _options.metric_snapshot_quantiles.data();
+    snapshot.quantile_values = _metric_snapshot_quantile_values.data();
+    snapshot.quantiles_count = _metric_snapshot_quantile_values.size();
+    snapshot.first_timestamp = series.first_timestamp;
+    snapshot.last_timestamp = series.last_timestamp;
+
+    for (auto& sink : series.logger_base->_sinks)
+    {
+      if (SinkWorker* sink_worker = _get_sink_worker(*sink))
+      {
+        if (!sink_workers_idle)
+        {
+          _wait_until_sink_workers_idle();
+          sink_workers_idle = true;
+        }
+
+        sink_worker->write_metric_snapshot(sink.get(), series.metric_metadata, series.last_timestamp,
+                                           series.logger_base->_logger_name, snapshot);
+        continue;
+      }
+
+      QUILL_TRY
+      {
+        sink->write_metric_snapshot(series.metric_metadata, series.last_timestamp, _process_id,
+                                    series.logger_base->_logger_name, snapshot);
+      }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH(std::exception const& e) { _notify_error(_options.error_notifier, e.what()); }
+      QUILL_CATCH_ALL()
+      {
+        _notify_error(_options.error_notifier, std::string{"Caught unhandled exception."});
+      }
+#endif
+    }
+  }
+
+  /**
+   * Formats and writes the log statement to each sink
+   */
+  QUILL_ATTRIBUTE_HOT void _write_log_statement(TransitEvent const& transit_event,
+                                                std::string_view const& thread_id,
+                                                std::string_view const& thread_name,
+                                                std::string_view const& log_level_description,
+                                                std::string_view const& log_level_short_code,
+                                                std::string_view const& log_message,
+                                                bool batch_sink_writes)
+  {
+    if (transit_event.has_serialized_format_args())
+    {
+      _write_log_format_args(transit_event, thread_id, thread_name, log_level_description,
+                             log_level_short_code, log_message);
+      return;
+    }
+
+    std::string_view default_log_statement;
+
+    std::vector<std::shared_ptr<Sink>> const& sinks = transit_event.logger_base->_sinks;
+
+    // Process each sink with the appropriate formatting and filtering
+    for (size_t i = 0; i < sinks.size(); ++i)
+    {
+      std::shared_ptr<Sink> const& sink = sinks[i];
+
+      QUILL_TRY
+      {
+        SinkWorker* sink_worker = _get_sink_worker(*sink);
+
+        // Skip the formatting when the sink does not accept the log statement
+        if (transit_event.sinks_prefiltered && (i < TransitEvent::max_prefiltered_sinks))
+        {
+          if ((transit_event.accepted_sinks & (uint64_t{1} << i)) == 0)
+          {
+            continue;
+          }
+        }
+        else
+        {
+          bool const accepted = sink_worker
+            ? (transit_event.log_level() >= sink->get_log_level_filter())
+            : sink->apply_metadata_filters(transit_event.macro_metadata, transit_event.timestamp,
+                                           thread_id, thread_name,
+                                           transit_event.logger_base->_logger_name,
+                                           transit_event.log_level());
+
+          if (!accepted)
+          {
+            continue;
+          }
+        }
+
+        std::string_view log_to_write;
+
+        // The output buffer of the sink when the log statement is formatted directly into it,
+        // only when the log statement is not shared with other sinks
+        fmtquill::detail::buffer<char>* sink_buffer{nullptr};
+
+        // Determine which formatted log to use
+        if (!sink->_override_pattern_formatter_options)
+        {
+          if (default_log_statement.empty())
+          {
+            if (!sink_worker && (sinks.size() == 1))
+            {
+              sink_buffer = sink->reserve_log_statement();
+            }
+
+            // Use the default formatted log statement, here by checking empty() we try to format
+            // once even for multiple sinks
+            default_log_statement = _format_log_statement(
+              *transit_event.logger_base->_pattern_formatter, sink_buffer, transit_event, thread_id,
+              thread_name, log_level_description, log_level_short_code, log_message);
+          }
+
+          log_to_write = default_log_statement;
+        }
+        else
+        {
+          // Sink has override_pattern_formatter_options, we do not include PatternFormatter
+          // in the frontend fo this reason we init PatternFormatter here
+          if (!sink->_override_pattern_formatter)
+          {
+            // Initialize override formatter if needed
+            sink->_override_pattern_formatter =
+              std::make_shared<PatternFormatter>(*sink->_override_pattern_formatter_options);
+          }
+
+          if (!sink_worker)
+          {
+            sink_buffer = sink->reserve_log_statement();
+          }
+
+          // Use the sink's override formatter
+          log_to_write = _format_log_statement(*sink->_override_pattern_formatter, sink_buffer,
+                                               transit_event, thread_id, thread_name,
+                                               log_level_description, log_level_short_code, log_message);
+        }
+
+        if (sink_worker)
+        {
+          // The worker applies the filters and writes the log statement, runtime metadata is owned
+          // by the transit event and has to be copied
+          bool const copy_log_metadata =
+            transit_event.extra_data && transit_event.extra_data->runtime_metadata.has_runtime_metadata;
+
+          sink_worker->write_log(sink.get(), transit_event.macro_metadata, copy_log_metadata,
+                                 transit_event.timestamp, thread_id, thread_name,
+                                 transit_event.logger_base->_logger_name, transit_event.log_level(),
+                                 log_level_description, log_level_short_code,
+                                 transit_event.get_named_args(), log_message, log_to_write);
+        }
+        // Apply the rest of the filters now that we have the formatted log
+        else if (sink->apply_formatted_filters(
+                   transit_event.macro_metadata, transit_event.timestamp, thread_id, thread_name,
+                   transit_event.logger_base->_logger_name, transit_event.log_level(), log_message,
+                   log_to_write))
+        {
+          if (sink_buffer)
+          {
+            sink->commit_log_statement(
+              LogRecordView{transit_event.macro_metadata, transit_event.timestamp, thread_id,
+                            thread_name, transit_event.logger_base->_logger_name,
+                            transit_event.log_level(), log_level_description, log_level_short_code,
+                            transit_event.get_named_args(), log_message, log_to_write},
+              _process_id);
+          }
+          else if (batch_sink_writes && _supports_batch_write(*sink))
+          {
+            _append_to_sink_batch(*sink, transit_event, thread_id, thread_name, log_level_description,
+                                  log_level_short_code, log_message, log_to_write);
+          }
+          else
+          {
+            // Forward the message using the computed log statement that passed the filter
+            sink->write_log(transit_event.macro_metadata, transit_event.timestamp, thread_id,
+                            thread_name, _process_id, transit_event.logger_base->_logger_name,
+                            transit_event.log_level(), log_level_description, log_level_short_code,
+                            transit_event.get_named_args(), log_message, log_to_write);
+          }
+        }
+      }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH(std::exception const& e) { _notify_error(_options.error_notifier, e.what()); }
+      QUILL_CATCH_ALL()
+      {
+        _notify_error(_options.error_notifier, std::string{"Caught unhandled exception."});
+      }
+#endif
+    }
+  }
+
+  /**
+   * Writes the serialized arguments of the log statement to each sink, see _writes_format_args()
+   */
+  QUILL_ATTRIBUTE_HOT void _write_log_format_args(TransitEvent const& transit_event,
+                                                  std::string_view thread_id, std::string_view thread_name,
+                                                  std::string_view log_level_description,
+                                                  std::string_view log_level_short_code,
+                                                  std::string_view format_args)
+  {
+    std::vector<std::shared_ptr<Sink>> const& sinks = transit_event.logger_base->_sinks;
+
+    for (size_t i = 0; i < sinks.size(); ++i)
+    {
+      std::shared_ptr<Sink> const& sink = sinks[i];
+
+      QUILL_TRY
+      {
+        bool const accepted = (transit_event.sinks_prefiltered && (i < TransitEvent::max_prefiltered_sinks))
+          ? ((transit_event.accepted_sinks & (uint64_t{1} << i)) != 0)
+          : sink->apply_metadata_filters(transit_event.macro_metadata, transit_event.timestamp,
+                                         thread_id, thread_name,
+                                         transit_event.logger_base->_logger_name,
+                                         transit_event.log_level());
+
+        if (accepted)
+        {
+          sink->write_log_format_args(transit_event.macro_metadata, transit_event.timestamp,
+                                      thread_id, thread_name, _process_id,
+                                      transit_event.logger_base->_logger_name,
+                                      transit_event.log_level(), log_level_description,
+                                      log_level_short_code, format_args);
+        }
+      }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH(std::exception const& e) { _notify_error(_options.error_notifier, e.what()); }
+      QUILL_CATCH_ALL()
+      {
+        _notify_error(_options.error_notifier, std::string{"Caught unhandled exception."});
+      }
+#endif
+    }
+  }
+
+  /**
+   * Check for dropped or blocked events
+   * @param error_notifier error notifier
+   */
+  QUILL_ATTRIBUTE_HOT void _check_failure_counter(std::function<void(std::string const&)> const& error_notifier)
+  {
+    if (!error_notifier)
+    {
+      return;
+    }
+
+    for (ThreadContext* thread_context : _active_thread_contexts_cache)
+    {
+      size_t const failed_events_cnt = thread_context->get_and_reset_failure_counter();
+
+      if (QUILL_UNLIKELY(failed_events_cnt > 0))
+      {
+        std::string const timestamp = _get_local_time_str();
+
+        if (thread_context->has_dropping_queue())
+        {
+          if (thread_context->has_unbounded_queue_type())
+          {
             _notify_error(error_notifier,
                           fmtquill::format("{} Quill INFO: Reached the maximum configured "
                                            "unbounded queue capacity and dropped "
@@ -1729,6 +2256,9 @@ private:
   /***/
   QUILL_ATTRIBUTE_HOT void _flush_and_run_active_sinks(bool run_periodic_tasks, std::chrono::milliseconds sink_min_flush_interval)
   {
+    // The pending log statements are written before the sinks are flushed
+    _write_pending_sink_batches();
+
     // Populate the active sinks cache with unique sinks, consider only the valid loggers
     _logger_manager.for_each_logger(
       [this](LoggerBase* logger)
@@ -1749,6 +2279,11 @@ private:
             if (search_it == std::end(_active_sinks_cache))
             {
               _active_sinks_cache.push_back(logger_sink_ptr);
+
+              if (SinkWorker* sink_worker = _get_sink_worker(*sink))
+              {
+                sink_worker->retain_sink(sink);
+              }
             }
           }
         }
@@ -1777,6 +2312,16 @@ private:
 
     for (auto const& sink : _active_sinks_cache)
     {
+      if (SinkWorker* sink_worker = _get_sink_worker(*sink))
+      {
+        if (should_flush_sinks || run_periodic_tasks)
+        {
+          sink_worker->flush_sink(sink, should_flush_sinks, run_periodic_tasks);
+        }
+
+        continue;
+      }
+
       QUILL_TRY
       {
         if (should_flush_sinks)
@@ -1814,9 +2359,185 @@ private:
       _last_sink_flush_time = now;
     }
 
+    if (!run_periodic_tasks)
+    {
+      // An explicit flush returns only after the sink workers have flushed their sinks
+      _wait_until_sink_workers_idle();
+    }
+
     _active_sinks_cache.clear();
   }
 
+  /**
+   * Blocks until every sink worker has processed all records queued to it
+   */
+  void _wait_until_sink_workers_idle() noexcept
+  {
+    for (auto const& sink_worker : _sink_workers)
+    {
+      sink_worker->wait_until_idle();
+    }
+  }
+
+  /**
+   * Returns the worker the sink is assigned to, or nullptr when the sink is called from the
+   * backend thread
+   */
+  QUILL_NODISCARD SinkWorker* _get_sink_worker(Sink const& sink) const noexcept
+  {
+    uint32_t const sink_worker_index = sink.get_sink_worker();
+    return (sink_worker_index < _sink_workers.size()) ? _sink_workers[sink_worker_index].get() : nullptr;
+  }
+
+  /**
+   * Returns true when the log statements of the sink are written with Sink::write_log_batch()
+   */
+  QUILL_NODISCARD static bool _supports_batch_write(Sink& sink) noexcept
+  {
+    if (QUILL_UNLIKELY(!sink._batch_write.has_value()))
+    {
+      sink._batch_write = sink.supports_batch_write();
+    }
+
+    return *sink._batch_write;
+  }
+
+  /**
+   * Returns true when the log statements of the sink are written with
+   * Sink::write_log_format_args()
+   */
+  QUILL_NODISCARD static bool _supports_format_args(Sink& sink) noexcept
+  {
+    if (QUILL_UNLIKELY(!sink._format_args_write.has_value()))
+    {
+      sink._format_args_write = sink.supports_format_args();
+    }
+
+    return *sink._format_args_write;
+  }
+
+  /**
+   * Returns true when the message of the logger's log statements does not have to be formatted,
+   * every sink formats it from the serialized arguments and none needs the formatted message for
+   * its filters
+   */
+  QUILL_NODISCARD bool _writes_format_args(LoggerBase& logger_base) const
+  {
+    if (logger_base._sinks.empty())
+    {
+      return false;
+    }
+
+    for (std::shared_ptr<Sink> const& sink : logger_base._sinks)
+    {
+      if (!_supports_format_args(*sink) || _get_sink_worker(*sink))
+      {
+        return false;
+      }
+
+      sink->_update_local_filters();
+
+      if (!sink->_local_filters.empty())
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Adds the log statement to the pending batch of the sink. The log statement is copied, the
+   * other fields of the record remain valid until the transit event is reused
+   */
+  QUILL_ATTRIBUTE_HOT void _append_to_sink_batch(Sink& sink, TransitEvent const& transit_event,
+                                                 std::string_view thread_id,
+                                                 std::string_view thread_name,
+                                                 std::string_view log_level_description,
+                                                 std::string_view log_level_short_code,
+                                                 std::string_view log_message,
+                                                 std::string_view log_statement)
+  {
+    PendingSinkBatch* pending_batch{nullptr};
+
+    for (PendingSinkBatch& batch : _pending_sink_batches)
+    {
+      if (batch.sink == &sink)
+      {
+        pending_batch = &batch;
+        break;
+      }
+
+      if (!batch.sink && !pending_batch)
+      {
+        pending_batch = &batch;
+      }
+    }
+
+    if (!pending_batch)
+    {
+      pending_batch = &_pending_sink_batches.emplace_back();
+    }
+
+    pending_batch->sink = &sink;
+
+    // The data of the log statement is set when the batch is written, the buffer can grow
+    pending_batch->records.push_back(LogRecordView{
+      transit_event.macro_metadata, transit_event.timestamp, thread_id, thread_name,
+      transit_event.logger_base->_logger_name, transit_event.log_level(), log_level_description,
+      log_level_short_code, transit_event.get_named_args(), log_message,
+      std::string_view{nullptr, log_statement.size()}});
+
+    pending_batch->log_statements.append(log_statement);
+
+    if (pending_batch->log_statements.size() >= max_pending_sink_batch_size)
+    {
+      _write_pending_sink_batch(*pending_batch);
+    }
+  }
+
+  /**
+   * Writes the pending batches of all the sinks
+   */
+  QUILL_ATTRIBUTE_HOT void _write_pending_sink_batches()
+  {
+    for (PendingSinkBatch& batch : _pending_sink_batches)
+    {
+      if (batch.sink)
+      {
+        _write_pending_sink_batch(batch);
+      }
+    }
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT void _write_pending_sink_batch(PendingSinkBatch& batch)
+  {
+    char const* log_statement = batch.log_statements.data();
+
+    for (LogRecordView& record : batch.records)
+    {
+      record.log_statement = std::string_view{log_statement, record.log_statement.size()};
+      log_statement += record.log_statement.size();
+    }
+
+    QUILL_TRY
+    {
+      batch.sink->write_log_batch(batch.records.data(), batch.records.size(), _process_id);
+    }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH(std::exception const& e) { _notify_error(_options.error_notifier, e.what()); }
+    QUILL_CATCH_ALL()
+    {
+      _notify_error(_options.error_notifier, std::string{"Caught unhandled exception."});
+    }
+#endif
+
+    batch.sink = nullptr;
+    batch.records.clear();
+    batch.log_statements.clear();
+  }
+
   /**
    * Reloads the thread contexts in our local cache.
    */
@@ -1840,6 +2561,9 @@ private:
           // so instead we just add them and expect them to be cleaned in the next iteration
           _active_thread_contexts_cache.push_back(thread_context);
         });
+
+      // Reserve up front, so that pushing to the heap after committing a transit event can not throw
+      _transit_event_heap.reserve(_active_thread_contexts_cache.size());
     }
   }
 
@@ -1914,6 +2638,15 @@ private:
    */
   QUILL_ATTRIBUTE_HOT void _cleanup_invalidated_loggers()
   {
+    if (!_metric_snapshot_aggregator.empty())
+    {
+      // The series keep a pointer to the logger, pass their remaining samples before it is removed
+      bool sink_workers_idle{false};
+      _metric_snapshot_aggregator.process_and_remove_invalidated_loggers(
+        [this, &sink_workers_idle](MetricSnapshotAggregator::Series const& series)
+        { _write_metric_snapshot(series, sink_workers_idle); });
+    }
+
     // since there are no messages we can check for invalidated loggers and clean them up
     _logger_manager.cleanup_invalidated_loggers(
       [this]()
@@ -2088,6 +2821,201 @@ private:
     }
   }
 
+  /**
+   * Applies the log level filter and the metadata only filters of each sink before the log
+   * statement is formatted. The result is stored in the transit event and reused when the log
+   * statement is written, so each filter runs once.
+   * @return false when no sink accepts the log statement
+   */
+  QUILL_ATTRIBUTE_HOT bool _apply_pre_format_filters(ThreadContext const& thread_context,
+                                                     TransitEvent& transit_event)
+  {
+    transit_event.accepted_sinks = 0;
+    transit_event.sinks_prefiltered = false;
+
+    // Backtrace log statements are stored and filtered when the backtrace is flushed
+    if ((transit_event.macro_metadata->event() != MacroMetadata::Event::Log) ||
+        (transit_event.log_level() == LogLevel::Backtrace))
+    {
+      return true;
+    }
+
+    std::string_view const thread_id = transit_event.thread_identity
+      ? std::string_view{transit_event.thread_identity->thread_id}
+      : thread_context.thread_id();
+
+    std::string_view const thread_name = transit_event.thread_identity
+      ? std::string_view{transit_event.thread_identity->thread_name}
+      : thread_context.thread_name();
+
+    std::vector<std::shared_ptr<Sink>> const& sinks = transit_event.logger_base->_sinks;
+    size_t const prefiltered_sinks = (std::min)(sinks.size(), TransitEvent::max_prefiltered_sinks);
+
+    for (size_t i = 0; i < prefiltered_sinks; ++i)
+    {
+      Sink& sink = *sinks[i];
+
+      // The other filters of a sink that runs on a sink worker are applied by the worker
+      bool const accepted = _get_sink_worker(sink)
+        ? (transit_event.log_level() >= sink.get_log_level_filter())
+        : sink.apply_metadata_filters(transit_event.macro_metadata, transit_event.timestamp, thread_id,
+                                      thread_name, transit_event.logger_base->_logger_name,
+                                      transit_event.log_level());
+
+      if (accepted)
+      {
+        transit_event.accepted_sinks |= (uint64_t{1} << i);
+      }
+    }
+
+    transit_event.sinks_prefiltered = true;
+
+    // Any sink after the first max_prefiltered_sinks is filtered when the log statement is written
+    return (transit_event.accepted_sinks != 0) || (sinks.size() > prefiltered_sinks);
+  }
+
+  /**
+   * Formats the message of the transit event from the arguments decoded into the format args
+   * store, and the values of the named arguments
+   */
+  QUILL_ATTRIBUTE_HOT void _populate_formatted_message(TransitEvent* transit_event,
+                                                       bool runtime_metadata_event)
+  {
+    if (!transit_event->macro_metadata->has_named_args())
+    {
+      _populate_formatted_log_message(transit_event,
+                                      transit_event->macro_metadata->message_format());
+    }
+    else if (runtime_metadata_event)
+    {
+      // Runtime metadata format strings are user generated and can be unique per call;
+      // caching them would grow _named_args_templates without bound for the lifetime of
+      // the backend, so process them without caching
+      auto const [message_format, arg_names] =
+        _process_named_args_format_message(transit_event->macro_metadata->message_format());
+
+      _populate_formatted_log_message(transit_event, message_format.data());
+      _populate_formatted_named_args(transit_event, arg_names);
+    }
+    else
+    {
+      // using the message_format as key for lookups
+      _named_args_format_template.assign(transit_event->macro_metadata->message_format());
+
+      if (auto const search = _named_args_templates.find(_named_args_format_template);
+          search != std::cend(_named_args_templates))
+      {
+        // process named args message when we already have parsed the format message once,
+        // and we have the names of each arg cached
+        auto const& [message_format, arg_names] = search->second;
+
+        _populate_formatted_log_message(transit_event, message_format.data());
+        _populate_formatted_named_args(transit_event, arg_names);
+      }
+      else
+      {
+        // process named args log when the message format is processed for the first time
+        // parse name of each arg and stored them to our lookup map
+        auto const [res_it, inserted] =
+          _named_args_templates.try_emplace(_named_args_format_template,
+                                            _process_named_args_format_message(
+                                              transit_event->macro_metadata->message_format()));
+
+        auto const& [message_format, arg_names] = res_it->second;
+
+        // suppress unused warnings
+        (void)inserted;
+
+        _populate_formatted_log_message(transit_event, message_format.data());
+        _populate_formatted_named_args(transit_event, arg_names);
+      }
+    }
+  }
+
+  /**
+   * Serializes the arguments decoded into _format_args_store to the transit event instead of
+   * formatting the message
+   * @return false when the message has to be formatted now, an argument has a type with its own
+   * formatter or can not be serialized
+   */
+  QUILL_ATTRIBUTE_HOT bool _store_serialized_format_args(TransitEvent* transit_event)
+  {
+    transit_event->formatted_msg.clear();
+
+    if (!serialize_format_args(_format_args_store, _options.check_printable_char,
+                               transit_event->formatted_msg))
+    {
+      return false;
+    }
+
+    transit_event->set_serialized_format_args();
+    return true;
+  }
+
+  /**
+   * Keeps the encoded arguments of a backtrace log statement in the transit event instead of
+   * formatting the message, most backtrace log statements are never written. The arguments are
+   * already decoded into _format_args_store, which gives their size.
+   * @return false when the message has to be formatted now. Arguments of a custom type can own
+   * objects or reference memory outside of their encoded bytes, so they can not be decoded again
+   * from a copy
+   */
+  QUILL_ATTRIBUTE_HOT bool _store_backtrace_arguments(TransitEvent* transit_event,
+                                                      FormatArgsDecoder format_args_decoder,
+                                                      std::byte const* encoded_args_begin,
+                                                      std::byte const* encoded_args_end)
+  {
+    if (_format_args_store.has_custom_type())
+    {
+      return false;
+    }
+
+    // The first byte is the alignment offset of the arguments in the frontend queue, they are
+    // decoded again at the same offset
+    auto const alignment_offset = static_cast<char>(
+      reinterpret_cast<uintptr_t>(encoded_args_begin) % alignof(std::max_align_t));
+
+    transit_event->formatted_msg.clear();
+    transit_event->formatted_msg.push_back(alignment_offset);
+    transit_event->formatted_msg.append(reinterpret_cast<char const*>(encoded_args_begin),
+                                        reinterpret_cast<char const*>(encoded_args_end));
+    transit_event->set_backtrace_decoder(format_args_decoder);
+    return true;
+  }
+
+  /**
+   * Formats the message of a stored backtrace event that kept its encoded arguments
+   */
+  void _format_backtrace_arguments(TransitEvent& transit_event)
+  {
+    if (!transit_event.has_backtrace_decoder())
+    {
+      return;
+    }
+
+    FormatArgsDecoder const format_args_decoder = transit_event.backtrace_decoder();
+    transit_event.reset_payload();
+
+    // The message is formatted into formatted_msg, the arguments are copied out first
+    auto const alignment_offset =
+      static_cast<size_t>(static_cast<unsigned char>(transit_event.formatted_msg[0]));
+    size_t const encoded_args_size = transit_event.formatted_msg.size() - 1;
+
+    _backtrace_encoded_args.resize(
+      (alignment_offset + encoded_args_size) / sizeof(std::max_align_t) + 1);
+    std::byte* encoded_args =
+      reinterpret_cast<std::byte*>(_backtrace_encoded_args.data()) + alignment_offset;
+    std::memcpy(encoded_args, transit_event.formatted_msg.data() + 1, encoded_args_size);
+
+    format_args_decoder(encoded_args, _format_args_store);
+
+    bool const runtime_metadata_event =
+      transit_event.extra_data && transit_event.extra_data->runtime_metadata.has_runtime_metadata;
+
+    _populate_formatted_message(&transit_event, runtime_metadata_event);
+    _format_args_store.clear();
+  }
+
   void _set_transit_event_mdc(ThreadContext const& thread_context, TransitEvent* transit_event)
   {
     if (thread_context._backend_mdc_state)
@@ -2154,69 +3082,220 @@ private:
       (*named_args)[i].first = arg_names[i].first;
     }
 
-    for (size_t i = arg_names.size(); i < static_cast<size_t>(_format_args_store.size()); ++i)
+    DynamicFormatArgStore const& format_args_store =
+      _format_job ? _format_job->format_args_store : _format_args_store;
+
+    for (size_t i = arg_names.size(); i < static_cast<size_t>(format_args_store.size()); ++i)
     {
       // we do not have a named_arg for the argument value here so we just append its index as a placeholder
       named_args->push_back(std::pair<std::string, std::string>(fmtquill::format("_{}", i), std::string{}));
     }
 
+    if (_format_job)
+    {
+      // The values are formatted with the message
+      _format_job->named_args = named_args;
+      _format_job->arg_names = arg_names;
+      return;
+    }
+
     // Then populate all the values of each arg
-    QUILL_TRY { _format_and_split_arguments(arg_names, *named_args, _format_args_store, _options); }
+    std::string error;
+    _format_named_args(arg_names, *named_args, _format_args_store, _options, error);
+
+    if (!error.empty())
+    {
+      _notify_error(_options.error_notifier, error);
+    }
+  }
+
+  /***/
+  static void _format_named_args(std::vector<std::pair<std::string, std::string>> const& arg_names,
+                                 std::vector<std::pair<std::string, std::string>>& named_args,
+                                 DynamicFormatArgStore const& format_args_store,
+                                 BackendOptions const& options, std::string& error)
+  {
+    QUILL_TRY { _format_and_split_arguments(arg_names, named_args, format_args_store, options); }
 #if !defined(QUILL_NO_EXCEPTIONS)
     QUILL_CATCH(std::exception const&)
     {
       // This catch block simply catches the exception.
-      // Since the error has already been handled in _populate_formatted_log_message,
+      // Since the error has already been handled when formatting the log message,
       // there is no additional action required here.
     }
-    QUILL_CATCH_ALL()
-    {
-      _notify_error(_options.error_notifier, std::string{"Caught unhandled exception."});
-    }
+    QUILL_CATCH_ALL() { error = "Caught unhandled exception."; }
 #endif
   }
 
   QUILL_ATTRIBUTE_HOT void _populate_formatted_log_message(TransitEvent* transit_event, char const* message_format)
   {
-    transit_event->formatted_msg->clear();
+    if (_format_job)
+    {
+      // Runtime metadata is owned by the transit event's extra data which does not move
+      _format_job->format_message = true;
+      _format_job->macro_metadata = transit_event->macro_metadata;
+      _format_job->message_format.assign(message_format);
+      _format_job->named_args = nullptr;
+      return;
+    }
+
+    std::string error;
+    _format_log_message(transit_event->formatted_msg, message_format, _format_args_store,
+                        *transit_event->macro_metadata, _options, error);
+
+    if (!error.empty())
+    {
+      _notify_error(_options.error_notifier, error);
+    }
+  }
+
+  /**
+   * Formats the log message, on failure the message is replaced with the error which is also
+   * returned in error
+   */
+  QUILL_ATTRIBUTE_HOT static void _format_log_message(TransitEvent::FormatBuffer& formatted_msg,
+                                                      char const* message_format,
+                                                      DynamicFormatArgStore const& format_args_store,
+                                                      MacroMetadata const& macro_metadata,
+                                                      BackendOptions const& options, std::string& error)
+  {
+    formatted_msg.clear();
 
     QUILL_TRY
     {
-      fmtquill::vformat_to(std::back_inserter(*transit_event->formatted_msg), message_format,
+      fmtquill::vformat_to(std::back_inserter(formatted_msg), message_format,
                            fmtquill::basic_format_args<fmtquill::format_context>{
-                             _format_args_store.data(), _format_args_store.size()});
+                             format_args_store.data(), format_args_store.size()});
 
-      if (_options.check_printable_char && _format_args_store.has_string_related_type())
+      if (options.check_printable_char && format_args_store.has_string_related_type())
       {
-        sanitize_non_printable_chars(*transit_event->formatted_msg, _options);
+        sanitize_non_printable_chars(formatted_msg, options);
       }
     }
 #if !defined(QUILL_NO_EXCEPTIONS)
     QUILL_CATCH(std::exception const& e)
     {
-      transit_event->formatted_msg->clear();
-      std::string const error =
-        fmtquill::format(R"([Could not format log statement. message: "{}", location: "{}", error: "{}"])",
-                         transit_event->macro_metadata->message_format(),
-                         transit_event->macro_metadata->short_source_location(), e.what());
+      formatted_msg.clear();
+      error = fmtquill::format(R"([Could not format log statement. message: "{}", location: "{}", error: "{}"])",
+                               macro_metadata.message_format(),
+                               macro_metadata.short_source_location(), e.what());
 
-      transit_event->formatted_msg->append(error);
-      _notify_error(_options.error_notifier, error);
+      formatted_msg.append(error);
     }
     QUILL_CATCH_ALL()
     {
-      transit_event->formatted_msg->clear();
-      std::string const error = fmtquill::format(
+      formatted_msg.clear();
+      error = fmtquill::format(
         R"([Could not format log statement. message: "{}", location: "{}", error: "{}"])",
-        transit_event->macro_metadata->message_format(),
-        transit_event->macro_metadata->short_source_location(), "Caught unhandled exception.");
+        macro_metadata.message_format(), macro_metadata.short_source_location(),
+        "Caught unhandled exception.");
 
-      transit_event->formatted_msg->append(error);
-      _notify_error(_options.error_notifier, error);
+      formatted_msg.append(error);
     }
 #endif
   }
 
+  /***/
+  /**
+   * The event is referenced by its position in the buffer, as the buffer can expand and move the
+   * events before the job runs
+   */
+  QUILL_ATTRIBUTE_HOT FormatJob& _acquire_format_job(TransitEventBuffer& transit_event_buffer)
+  {
+    if (_format_jobs_count == _format_jobs.size())
+    {
+      _format_jobs.push_back(std::make_unique<FormatJob>());
+    }
+
+    FormatJob& job = *_format_jobs[_format_jobs_count++];
+    job.transit_event_buffer = &transit_event_buffer;
+    job.transit_event_index = transit_event_buffer.size();
+    job.format_message = false;
+    job.named_args = nullptr;
+    return job;
+  }
+
+  /**
+   * Formats the messages decoded since the last call and then releases the frontend queues they
+   * were decoded from. Runs on the formatter threads when the batch is large enough to pay for
+   * waking them up.
+   */
+  QUILL_ATTRIBUTE_HOT void _run_format_jobs()
+  {
+    if (_format_jobs_count != 0)
+    {
+      auto format_job = [this](size_t index)
+      {
+        FormatJob& job = *_format_jobs[index];
+
+        if (!job.format_message)
+        {
+          // Decoding the arguments failed, there is nothing to format
+          job.format_args_store.clear();
+          return;
+        }
+
+        TransitEvent* transit_event = job.transit_event_buffer->at(job.transit_event_index);
+        _format_log_message(transit_event->formatted_msg, job.message_format.data(),
+                            job.format_args_store, *job.macro_metadata, _options, job.error);
+
+        if (job.named_args)
+        {
+          _format_named_args(job.arg_names, *job.named_args, job.format_args_store, _options,
+                             job.named_args_error);
+        }
+
+        job.format_args_store.clear();
+      };
+
+      if (_format_jobs_count < min_parallel_format_jobs)
+      {
+        for (size_t i = 0; i < _format_jobs_count; ++i)
+        {
+          format_job(i);
+        }
+      }
+      else
+      {
+        _formatter_pool->run(_format_jobs_count, format_job);
+      }
+
+      // Report the errors from the backend thread, in order
+      for (size_t i = 0; i < _format_jobs_count; ++i)
+      {
+        FormatJob& job = *_format_jobs[i];
+
+        if (!job.error.empty())
+        {
+          _notify_error(_options.error_notifier, job.error);
+          job.error.clear();
+        }
+
+        if (!job.named_args_error.empty())
+        {
+          _notify_error(_options.error_notifier, job.named_args_error);
+          job.named_args_error.clear();
+        }
+      }
+
+      _format_jobs_count = 0;
+    }
+
+    for (ThreadContext* thread_context : _thread_contexts_pending_commit)
+    {
+      if (thread_context->has_unbounded_queue_type())
+      {
+        thread_context->get_spsc_queue_union().unbounded_spsc_queue.commit_read();
+      }
+      else
+      {
+        thread_context->get_spsc_queue_union().bounded_spsc_queue.commit_read();
+      }
+    }
+
+    _thread_contexts_pending_commit.clear();
+  }
+
   void _apply_runtime_metadata(std::byte*& read_pos, TransitEvent* transit_event)
   {
     char const* fmt;
@@ -2307,6 +3386,9 @@ private:
 private:
   friend class quill::ManualBackendWorker;
 
+  // Formats the serialized arguments of a binary log file the same way as the backend
+  friend class quill::BinaryLogReader;
+
   std::unique_ptr<RdtscClock> _rdtsc_clock_owner;
   std::unique_ptr<BackendWorkerLock> _backend_worker_lock;
   ThreadContextManager& _thread_context_manager = ThreadContextManager::instance();
@@ -2314,20 +3396,36 @@ private:
   LoggerManager& _logger_manager = LoggerManager::instance();
   BackendOptions _options;
   uint64_t _last_output_timestamp{0};
+  uint64_t _idle_poll_count{0}; /** Consecutive polls without work, drives the idle backoff */
+  bool _batch_sink_writes{false}; /** Set while a batch of transit events is processed */
   std::thread _worker_thread;
 
   DynamicFormatArgStore _format_args_store; /** Format args tmp storage as member to avoid reallocation */
   std::vector<std::string> _removed_loggers; /** Even an empty vector causes an allocation on Windows */
   std::vector<ThreadContext*> _active_thread_contexts_cache;
+  TransitEventHeap<ThreadContext*> _transit_event_heap; /** Thread contexts with cached transit events, ordered by the timestamp of their front event */
   std::vector<Sink*> _active_sinks_cache; /** Member to avoid re-allocating **/
+  std::vector<PendingSinkBatch> _pending_sink_batches; /** Log statements waiting to be written with Sink::write_log_batch() */
+  std::vector<std::unique_ptr<SinkWorker>> _sink_workers; /** Threads writing to the sinks assigned to them **/
+  std::unique_ptr<FormatterPool> _formatter_pool; /** Formats decoded messages in parallel when formatter_threads > 1 */
+  std::vector<std::unique_ptr<FormatJob>> _format_jobs; /** Messages decoded but not yet formatted, reused between batches */
+  size_t _format_jobs_count{0};
+  FormatJob* _format_job{nullptr}; /** Job of the message being decoded, nullptr when formatting inline */
+  std::vector<ThreadContext*> _thread_contexts_pending_commit; /** Queues to release after the pending format jobs */
   std::vector<std::pair<std::string, std::string>> _mdc_fields; /** MDC set scratch storage */
   std::vector<std::string> _mdc_keys;                           /** MDC erase scratch storage */
   std::unordered_map<std::string, std::pair<std::string, std::vector<std::pair<std::string, std::string>>>> _named_args_templates; /** Avoid re-formating the same named args log template each time */
   std::unordered_map<std::string, std::atomic<bool>*> _logger_removal_flags; /** Maps logger names to atomic flags used for synchronizing remove_logger_blocking(). */
   std::string _named_args_format_template; /** to avoid allocation each time **/
+  std::vector<std::max_align_t> _backtrace_encoded_args; /** aligned copy of the arguments of a stored backtrace event **/
+  std::vector<double> _metric_histogram_bucket_bounds;   /** aligned copy of the bounds of a frontend histogram **/
+  std::vector<uint64_t> _metric_histogram_bucket_counts; /** aligned copy of the counts of a frontend histogram **/
+  MetricSnapshotAggregator _metric_snapshot_aggregator;
+  std::vector<double> _metric_snapshot_quantile_values; /** to avoid allocation each time **/
   std::string _process_id;                 /** Id of the current running process **/
   std::chrono::steady_clock::time_point _last_rdtsc_resync_time;
   std::chrono::steady_clock::time_point _last_sink_flush_time;
+  std::chrono::steady_clock::time_point _last_metric_snapshot_time;
   std::atomic<uint32_t> _worker_thread_id{0};  /** cached backend worker thread id */
   std::atomic<bool> _is_worker_running{false}; /** The spawned backend thread status */
   std::atomic<bool> _has_worker_thread_exited{true}; /** Set to true when the backend thread completes its exit sequence */
@@ -2335,9 +3433,6 @@ private:
 
   alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<RdtscClock*> _rdtsc_clock{
     nullptr}; /** rdtsc clock if enabled, can be accessed by any thread **/
-  alignas(QUILL_CACHE_LINE_ALIGNED) std::mutex _wake_up_mutex;
-  std::condition_variable _wake_up_cv;
-  bool _wake_up_flag{false};
 };
 
 #if defined(_WIN32) && defined(_MSC_VER) && !defined(__GNUC__)
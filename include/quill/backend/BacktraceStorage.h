@@ -25,6 +25,10 @@ namespace detail
  * Stores N max messages per logger name in a vector.
  * For simplicity this class is used ONLY by the backend worker thread.
  * We push to the queue a BacktraceCommand event to communicate this from the frontend caller threads
+ *
+ * The stored events are reused as a ring, an event is copied into the slot of the oldest one. The
+ * backend usually stores the encoded arguments of the message instead of the formatted message,
+ * see TransitEvent::has_backtrace_decoder(), and formats them only when the events are processed.
  */
 class BacktraceStorage
 {
@@ -32,24 +36,24 @@ public:
   BacktraceStorage() = default;
 
   /***/
-  void store(TransitEvent transit_event, std::string_view const& thread_id, std::string_view const& thread_name)
+  void store(TransitEvent const& transit_event, std::string_view const& thread_id, std::string_view const& thread_name)
   {
     if (_capacity == 0)
     {
       return;
     }
 
+    StoredTransitEvent* ste;
+
     if (_stored_events.size() < _capacity)
     {
       // We are still growing the vector to max capacity
-      _stored_events.emplace_back(std::string{thread_id}, std::string{thread_name}, std::move(transit_event));
+      ste = &_stored_events.emplace_back();
     }
     else
     {
       // Store the object in the vector, replacing the previous
-      StoredTransitEvent& ste = _stored_events[_index];
-
-      ste = StoredTransitEvent{std::string{thread_id}, std::string{thread_name}, std::move(transit_event)};
+      ste = &_stored_events[_index];
 
       // Update the index wrapping around the vector capacity
       if (_index < _capacity - 1)
@@ -61,10 +65,18 @@ public:
         _index = 0;
       }
     }
+
+    // Copy into the existing strings and buffers of the slot, they are reused once the ring is full
+    ste->thread_id.assign(thread_id.data(), thread_id.size());
+    ste->thread_name.assign(thread_name.data(), thread_name.size());
+    transit_event.copy_to(ste->transit_event);
   }
 
-  /***/
-  void process(std::function<void(TransitEvent const&, std::string_view thread_id, std::string_view thread_name)> const& callback)
+  /**
+   * Passes the stored events to the callback from the oldest to the newest and then clears them.
+   * The callback can modify the events, e.g. to format their encoded arguments
+   */
+  void process(std::function<void(TransitEvent&, std::string_view thread_id, std::string_view thread_name)> const& callback)
   {
     // we found stored messages for this logger
     size_t index = _index;
@@ -123,13 +135,6 @@ public:
 private:
   struct StoredTransitEvent
   {
-    StoredTransitEvent(std::string thread_id, std::string thread_name, TransitEvent transit_event)
-      : thread_id(std::move(thread_id)),
-        thread_name(std::move(thread_name)),
-        transit_event(std::move(transit_event))
-    {
-    }
-
     /**
      * We use this to take a copy of some objects that are out of scope when a thread finishes but
      * the transit events are still in the buffer
@@ -0,0 +1,193 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/backend/BackendUtilities.h"
+#include "quill/core/Attributes.h"
+#include "quill/core/LoggerBase.h"
+#include "quill/core/ThreadPrimitives.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+/**
+ * A fixed set of threads the backend uses to format a batch of decoded log messages in parallel.
+ *
+ * run() splits the tasks between the pool threads and the calling thread and returns once every
+ * task has completed, so the caller can keep processing the events in timestamp order afterwards.
+ */
+class FormatterPool
+{
+private:
+  struct Batch
+  {
+    void* task_context{nullptr};
+    void (*task_function)(void*, size_t){nullptr};
+    size_t task_count{0};
+  };
+
+public:
+  /**
+   * @param thread_count number of threads to create in addition to the calling thread
+   * @param thread_name name assigned to the pool threads
+   */
+  FormatterPool(size_t thread_count, std::string const& thread_name)
+  {
+    _threads.reserve(thread_count);
+
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+      _threads.emplace_back([this, thread_name]() { _run(thread_name); });
+    }
+  }
+
+  /***/
+  ~FormatterPool()
+  {
+    {
+      std::lock_guard<std::mutex> const lock{_mutex};
+      _stop = true;
+    }
+
+    _cv.notify_all();
+
+    for (auto& thread : _threads)
+    {
+      thread.join();
+    }
+  }
+
+  FormatterPool(FormatterPool const&) = delete;
+  FormatterPool& operator=(FormatterPool const&) = delete;
+
+  /***/
+  QUILL_NODISCARD size_t thread_count() const noexcept { return _threads.size(); }
+
+  /**
+   * Calls task(index) for each index in [0, task_count) and waits for all of them to complete.
+   * The task must not throw.
+   */
+  template <typename TTask>
+  void run(size_t task_count, TTask& task)
+  {
+    Batch const batch{&task, [](void* task_context, size_t index)
+                      { (*static_cast<TTask*>(task_context))(index); }, task_count};
+
+    {
+      std::lock_guard<std::mutex> const lock{_mutex};
+      _batch = batch;
+      _next_task.store(0, std::memory_order_relaxed);
+      _completed_tasks.store(0, std::memory_order_relaxed);
+      _batch_open = true;
+      ++_generation;
+    }
+
+    _cv.notify_all();
+
+    // The calling thread takes part in the work
+    _run_tasks(batch);
+
+    {
+      // Every task is claimed at this point. Closing the batch under the lock stops a pool thread
+      // that wakes up late from registering for it, so once the registered threads are done no
+      // thread can touch the counters when the next batch resets them
+      std::lock_guard<std::mutex> const lock{_mutex};
+      _batch_open = false;
+    }
+
+    while ((_completed_tasks.load(std::memory_order_acquire) != task_count) ||
+           (_active_threads.load(std::memory_order_acquire) != 0))
+    {
+      yield_thread();
+    }
+  }
+
+private:
+  /***/
+  void _run(std::string const& thread_name)
+  {
+    LoggerBase::set_current_thread_is_backend_thread(true);
+
+    QUILL_TRY { set_thread_name(thread_name.data()); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH_ALL()
+    {
+      // The pool thread keeps running without a name
+    }
+#endif
+
+    uint64_t seen_generation{0};
+
+    while (true)
+    {
+      Batch batch;
+
+      {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _cv.wait(lock, [this, seen_generation]
+                 { return _stop || (_batch_open && (_generation != seen_generation)); });
+
+        if (_stop)
+        {
+          break;
+        }
+
+        seen_generation = _generation;
+        batch = _batch;
+
+        // Registered under the lock while the batch is open so run() cannot return, and start the
+        // next batch, while this thread still works on the current one
+        _active_threads.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      _run_tasks(batch);
+      _active_threads.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  /***/
+  void _run_tasks(Batch const& batch) noexcept
+  {
+    size_t index = _next_task.fetch_add(1, std::memory_order_relaxed);
+
+    while (index < batch.task_count)
+    {
+      batch.task_function(batch.task_context, index);
+      _completed_tasks.fetch_add(1, std::memory_order_release);
+      index = _next_task.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::vector<std::thread> _threads;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+
+  Batch _batch;
+  uint64_t _generation{0};
+  bool _batch_open{false};
+  bool _stop{false};
+
+  alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<size_t> _next_task{0};
+  alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<size_t> _completed_tasks{0};
+  alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<size_t> _active_threads{0};
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
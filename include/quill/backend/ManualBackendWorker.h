@@ -60,6 +60,8 @@ public:
 
     options.sleep_duration = std::chrono::nanoseconds{0};
     options.enable_yield_when_idle = false;
+    options.idle_pause_count = 0;
+    options.idle_yield_count = 0;
     _backend_worker->_init(options);
     _started = true;
   }
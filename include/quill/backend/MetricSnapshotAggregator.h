@@ -0,0 +1,149 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/LogLinearHistogram.h"
+#include "quill/core/LoggerBase.h"
+#include "quill/core/Metric.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * Aggregates the metric samples received by the backend in one LogLinearHistogram per metric and
+ * logger, for the periodic snapshots passed to Sink::write_metric_snapshot().
+ * For simplicity this class is used ONLY by the backend worker thread.
+ *
+ * The histograms are allocated the first time a metric is published through a logger and reused
+ * after each snapshot.
+ */
+class MetricSnapshotAggregator
+{
+public:
+  struct Series
+  {
+    LoggerBase* logger_base{nullptr};
+    MetricMetadata const* metric_metadata{nullptr};
+    uint64_t first_timestamp{0};
+    uint64_t last_timestamp{0};
+    LogLinearHistogram histogram;
+  };
+
+  /***/
+  void record(LoggerBase* logger_base, MetricMetadata const* metric_metadata, uint64_t timestamp, double value)
+  {
+    _series(logger_base, metric_metadata, timestamp).histogram.record(value);
+  }
+
+  /***/
+  void merge(LoggerBase* logger_base, MetricMetadata const* metric_metadata, uint64_t timestamp,
+             MetricHistogramData const& histogram)
+  {
+    _series(logger_base, metric_metadata, timestamp).histogram.merge(histogram);
+  }
+
+  /**
+   * Passes each series with values recorded since the previous call to the callback and then
+   * resets it
+   */
+  template <typename TCallback>
+  void process(TCallback&& callback)
+  {
+    for (auto& [key, series] : _series_map)
+    {
+      if (series->histogram.count() != 0)
+      {
+        callback(*series);
+        series->histogram.reset();
+      }
+    }
+  }
+
+  /**
+   * Passes each series of a logger that is no longer valid with values recorded since the
+   * previous snapshot to the callback and then removes the series of these loggers, before the
+   * loggers are destroyed
+   */
+  template <typename TCallback>
+  void process_and_remove_invalidated_loggers(TCallback&& callback)
+  {
+    for (auto it = _series_map.begin(); it != _series_map.end();)
+    {
+      if (it->second->logger_base->is_valid_logger())
+      {
+        ++it;
+        continue;
+      }
+
+      if (it->second->histogram.count() != 0)
+      {
+        callback(*it->second);
+      }
+
+      it = _series_map.erase(it);
+    }
+  }
+
+  QUILL_NODISCARD bool empty() const noexcept { return _series_map.empty(); }
+
+private:
+  struct SeriesKey
+  {
+    LoggerBase const* logger_base;
+    MetricMetadata const* metric_metadata;
+
+    bool operator==(SeriesKey const& other) const noexcept
+    {
+      return (logger_base == other.logger_base) && (metric_metadata == other.metric_metadata);
+    }
+  };
+
+  struct SeriesKeyHash
+  {
+    size_t operator()(SeriesKey const& key) const noexcept
+    {
+      return std::hash<void const*>{}(key.logger_base) ^
+        (std::hash<void const*>{}(key.metric_metadata) * 31u);
+    }
+  };
+
+  /***/
+  QUILL_NODISCARD Series& _series(LoggerBase* logger_base, MetricMetadata const* metric_metadata, uint64_t timestamp)
+  {
+    std::unique_ptr<Series>& series = _series_map[SeriesKey{logger_base, metric_metadata}];
+
+    if (!series)
+    {
+      // The histogram has a fixed size of a few KB, allocate it once per series
+      series = std::make_unique<Series>();
+      series->logger_base = logger_base;
+      series->metric_metadata = metric_metadata;
+    }
+
+    if (series->histogram.count() == 0)
+    {
+      series->first_timestamp = timestamp;
+    }
+
+    series->last_timestamp = timestamp;
+    return *series;
+  }
+
+private:
+  std::unordered_map<SeriesKey, std::unique_ptr<Series>, SeriesKeyHash> _series_map;
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
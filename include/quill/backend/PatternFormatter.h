@@ -10,11 +10,13 @@
 #include "quill/bundled/fmt/base.h"
 #include "quill/bundled/fmt/format.h"
 #include "quill/core/Attributes.h"
+#include "quill/core/CallSiteCache.h"
 #include "quill/core/Common.h"
 #include "quill/core/MacroMetadata.h"
 #include "quill/core/PatternFormatterOptions.h"
 #include "quill/core/QuillError.h"
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <chrono>
@@ -102,6 +104,26 @@ public:
     std::string_view log_level_short_code, MacroMetadata const& log_statement_metadata,
     std::vector<std::pair<std::string, std::string>> const* named_args, std::string_view log_msg,
     std::string_view mdc)
+  {
+    // clear out the existing buffer
+    _formatted_log_message_buffer.clear();
+
+    return format_to(_formatted_log_message_buffer, timestamp, thread_id, thread_name, process_id,
+                     logger, log_level_description, log_level_short_code, log_statement_metadata,
+                     named_args, log_msg, mdc);
+  }
+
+  /**
+   * Formats the log statement and appends it to the given buffer, e.g. the output buffer of a sink
+   * @return The log statement, the appended part of the buffer
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT std::string_view format_to(
+    fmtquill::detail::buffer<char>& out, uint64_t timestamp, std::string_view thread_id,
+    std::string_view thread_name, std::string_view process_id, std::string_view logger,
+    std::string_view log_level_description, std::string_view log_level_short_code,
+    MacroMetadata const& log_statement_metadata,
+    std::vector<std::pair<std::string, std::string>> const* named_args, std::string_view log_msg,
+    std::string_view mdc)
   {
     if (_options.format_pattern.empty())
     {
@@ -111,8 +133,8 @@ public:
       return std::string_view{};
     }
 
-    // clear out the existing buffer
-    _formatted_log_message_buffer.clear();
+    _output = &out;
+    _output_start = out.size();
 
     if (QUILL_UNLIKELY(log_msg.empty()))
     {
@@ -234,11 +256,42 @@ protected:
   }
 
 private:
+  /**
+   * One step of the compiled pattern
+   */
+  struct FormatOp
+  {
+    enum class Type : uint8_t
+    {
+      Literal,
+      Attribute,
+      PaddedAttribute,
+      FormattedAttribute
+    };
+
+    Type type;
+    Attribute attribute;
+    std::string text; /**< The literal, or the fmt replacement field of a formatted attribute */
+    size_t width{0};
+    char fill{' '};
+    char align{'<'};
+  };
+
+  /**
+   * A range of _format_ops, the ranges of call_site ops are cached per call site
+   */
+  struct FormatRun
+  {
+    size_t begin;
+    size_t end;
+    bool call_site;
+  };
+
   void _set_pattern()
   {
     // the order we pass the arguments here must match with the order of Attribute enum
     using namespace fmtquill::literals;
-    std::tie(_fmt_format, _order_index) = _generate_fmt_format_string(
+    auto const [fmt_format, order_index] = _generate_fmt_format_string(
       _is_set_in_pattern, _options.format_pattern, "time"_a = "", "file_name"_a = "",
       "caller_function"_a = "", "log_level"_a = "", "log_level_short_code"_a = "",
       "line_number"_a = "", "logger"_a = "", "full_path"_a = "", "thread_id"_a = "",
@@ -246,59 +299,191 @@ private:
       "short_source_location"_a = "", "message"_a = "", "mdc"_a = "", "tags"_a = "",
       "named_args"_a = "");
 
-    _set_arg<Attribute::Time>(std::string_view("time"));
-    _set_arg<Attribute::FileName>(std::string_view("file_name"));
-    _set_arg<Attribute::CallerFunction>(std::string_view("caller_function"));
-    _set_arg<Attribute::LogLevel>(std::string_view("log_level"));
-    _set_arg<Attribute::LogLevelShortCode>(std::string_view("log_level_short_code"));
-    _set_arg<Attribute::LineNumber>("line_number");
-    _set_arg<Attribute::Logger>(std::string_view("logger"));
-    _set_arg<Attribute::FullPath>(std::string_view("full_path"));
-    _set_arg<Attribute::ThreadId>(std::string_view("thread_id"));
-    _set_arg<Attribute::ThreadName>(std::string_view("thread_name"));
-    _set_arg<Attribute::ProcessId>(std::string_view("process_id"));
-    _set_arg<Attribute::SourceLocation>("source_location");
-    _set_arg<Attribute::ShortSourceLocation>("short_source_location");
-    _set_arg<Attribute::Message>(std::string_view("message"));
-    _set_arg<Attribute::Mdc>(std::string_view("mdc"));
-    _set_arg<Attribute::Tags>(std::string_view("tags"));
-    _set_arg<Attribute::NamedArgs>(std::string_view("named_args"));
+    // Placeholder values with the same types as the formatted values, used to validate the
+    // format specifiers of the pattern
+    std::array<fmtquill::basic_format_arg<fmtquill::format_context>, Attribute::ATTR_NR_ITEMS> args{};
+    args[order_index[Attribute::Time]] = std::string_view("time");
+    args[order_index[Attribute::FileName]] = std::string_view("file_name");
+    args[order_index[Attribute::CallerFunction]] = std::string_view("caller_function");
+    args[order_index[Attribute::LogLevel]] = std::string_view("log_level");
+    args[order_index[Attribute::LogLevelShortCode]] = std::string_view("log_level_short_code");
+    args[order_index[Attribute::LineNumber]] = "line_number";
+    args[order_index[Attribute::Logger]] = std::string_view("logger");
+    args[order_index[Attribute::FullPath]] = std::string_view("full_path");
+    args[order_index[Attribute::ThreadId]] = std::string_view("thread_id");
+    args[order_index[Attribute::ThreadName]] = std::string_view("thread_name");
+    args[order_index[Attribute::ProcessId]] = std::string_view("process_id");
+    args[order_index[Attribute::SourceLocation]] = "source_location";
+    args[order_index[Attribute::ShortSourceLocation]] = "short_source_location";
+    args[order_index[Attribute::Message]] = std::string_view("message");
+    args[order_index[Attribute::Mdc]] = std::string_view("mdc");
+    args[order_index[Attribute::Tags]] = std::string_view("tags");
+    args[order_index[Attribute::NamedArgs]] = std::string_view("named_args");
 
     // Parse the generated fmt string now, while construction errors can be reported to the
     // caller, rather than deferring them until every log record is formatted on the backend.
     char discard{};
 #if defined(QUILL_NO_EXCEPTIONS)
     (void)fmtquill::vformat_to_n(
-      &discard, 0, _fmt_format, fmtquill::basic_format_args(_args.data(), static_cast<int>(_args.size())));
+      &discard, 0, fmt_format, fmtquill::basic_format_args(args.data(), static_cast<int>(args.size())));
 #else
     try
     {
       (void)fmtquill::vformat_to_n(
-        &discard, 0, _fmt_format, fmtquill::basic_format_args(_args.data(), static_cast<int>(_args.size())));
+        &discard, 0, fmt_format, fmtquill::basic_format_args(args.data(), static_cast<int>(args.size())));
     }
     catch (fmtquill::format_error const& error)
     {
       QUILL_THROW(QuillError{"Invalid format pattern: " + std::string{error.what()}});
     }
 #endif
+
+    _compile_format_ops(fmt_format, order_index);
+  }
+
+  /**
+   * Compiles the validated fmt format string into the list of ops that _format() runs for each
+   * log statement. e.g. "{} [{}] {:<12} {}" becomes :
+   *   Attribute(Time), Literal(" ["), Attribute(ThreadId), Literal("] "),
+   *   PaddedAttribute(LogLevel, '<', 12), Literal(" "), Attribute(Message)
+   */
+  void _compile_format_ops(std::string const& fmt_format,
+                           std::array<size_t, Attribute::ATTR_NR_ITEMS> const& order_index)
+  {
+    // the attribute of each replacement field, in the order they appear in the pattern
+    std::array<Attribute, Attribute::ATTR_NR_ITEMS> field_attributes{};
+    for (size_t attr = 0; attr < Attribute::ATTR_NR_ITEMS; ++attr)
+    {
+      if (_is_set_in_pattern[attr])
+      {
+        field_attributes[order_index[attr]] = static_cast<Attribute>(attr);
+      }
+    }
+
+    _format_ops.clear();
+    std::string literal;
+    size_t field_idx{0};
+
+    for (size_t pos = 0; pos < fmt_format.size(); ++pos)
+    {
+      char const c = fmt_format[pos];
+
+      if (((c == '{') || (c == '}')) && ((pos + 1) < fmt_format.size()) && (fmt_format[pos + 1] == c))
+      {
+        // escaped literal brace
+        literal += c;
+        ++pos;
+        continue;
+      }
+
+      if (c != '{')
+      {
+        literal += c;
+        continue;
+      }
+
+      if (!literal.empty())
+      {
+        _format_ops.push_back(FormatOp{FormatOp::Type::Literal, Attribute::ATTR_NR_ITEMS, std::move(literal)});
+        literal.clear();
+      }
+
+      size_t const closing_pos = fmt_format.find('}', pos);
+      std::string_view const specifier{fmt_format.data() + pos + 1, closing_pos - pos - 1};
+
+      FormatOp op{FormatOp::Type::Attribute, field_attributes[field_idx++], std::string{}};
+
+      if (!specifier.empty())
+      {
+        // e.g. {:<12}, formatted by fmt when the value is not ASCII or the specifier is not a
+        // plain [[fill]align]width
+        op.text = fmt_format.substr(pos, closing_pos + 1 - pos);
+        op.type = _parse_padding(specifier, op) ? FormatOp::Type::PaddedAttribute
+                                                : FormatOp::Type::FormattedAttribute;
+      }
+
+      _format_ops.push_back(std::move(op));
+      pos = closing_pos;
+    }
+
+    if (!literal.empty())
+    {
+      _format_ops.push_back(FormatOp{FormatOp::Type::Literal, Attribute::ATTR_NR_ITEMS, std::move(literal)});
+    }
+
+    // Consecutive ops that only depend on the call site are rendered once per call site
+    _format_runs.clear();
+    _has_call_site_attributes = false;
+
+    for (size_t op_idx = 0; op_idx < _format_ops.size(); ++op_idx)
+    {
+      FormatOp const& op = _format_ops[op_idx];
+      bool const call_site = (op.type == FormatOp::Type::Literal) || _is_call_site_attribute(op.attribute);
+
+      if (!_format_runs.empty() && (_format_runs.back().call_site == call_site))
+      {
+        _format_runs.back().end = op_idx + 1;
+      }
+      else
+      {
+        _format_runs.push_back(FormatRun{op_idx, op_idx + 1, call_site});
+      }
+
+      _has_call_site_attributes |= (op.type != FormatOp::Type::Literal) && call_site;
+    }
   }
 
   /***/
-  template <size_t I, typename T>
-  void _set_arg(T const& arg)
+  QUILL_NODISCARD static bool _is_call_site_attribute(Attribute attribute) noexcept
   {
-    _args[_order_index[I]] = arg;
+    return (attribute == Attribute::FileName) || (attribute == Attribute::CallerFunction) ||
+      (attribute == Attribute::LineNumber) || (attribute == Attribute::FullPath) ||
+      (attribute == Attribute::SourceLocation) || (attribute == Attribute::ShortSourceLocation) ||
+      (attribute == Attribute::Tags);
   }
 
-  template <size_t I, typename T>
-  void _set_arg_val(T const& arg)
+  /**
+   * Parses a ":[[fill]align]width" specifier
+   */
+  QUILL_NODISCARD static bool _parse_padding(std::string_view specifier, FormatOp& op) noexcept
   {
-    // This relies on the internal layout used by the bundled fmtquill copy
-    fmtquill::detail::value<fmtquill::format_context>& value_ =
-      *(reinterpret_cast<fmtquill::detail::value<fmtquill::format_context>*>(
-        std::addressof(_args[_order_index[I]])));
+    auto const is_align = [](char c) { return (c == '<') || (c == '>') || (c == '^'); };
+
+    // skip the ':'
+    size_t pos{1};
 
-    value_ = fmtquill::detail::value<fmtquill::format_context>(arg);
+    if (((pos + 1) < specifier.size()) && is_align(specifier[pos + 1]) &&
+        (static_cast<unsigned char>(specifier[pos]) < 0x80))
+    {
+      op.fill = specifier[pos];
+      op.align = specifier[pos + 1];
+      pos += 2;
+    }
+    else if ((pos < specifier.size()) && is_align(specifier[pos]))
+    {
+      op.align = specifier[pos];
+      pos += 1;
+    }
+
+    if ((pos == specifier.size()) || (specifier[pos] < '1') || (specifier[pos] > '9'))
+    {
+      // no width, or the '0' flag
+      return false;
+    }
+
+    size_t width{0};
+    for (; pos < specifier.size(); ++pos)
+    {
+      if ((specifier[pos] < '0') || (specifier[pos] > '9') || (width > 100'000))
+      {
+        return false;
+      }
+
+      width = (width * 10) + static_cast<size_t>(specifier[pos] - '0');
+    }
+
+    op.width = width;
+    return true;
   }
 
   /***/
@@ -565,132 +750,249 @@ private:
                                                std::vector<std::pair<std::string, std::string>> const* named_args,
                                                std::string_view log_msg, std::string_view mdc)
   {
-    if (_is_set_in_pattern[Attribute::Time])
+    std::vector<std::string> const* call_site_fragments = _has_call_site_attributes
+      ? _call_site_fragments.get(&log_statement_metadata,
+                                 [this, &log_statement_metadata](std::vector<std::string>& fragments)
+                                 { _render_call_site_fragments(log_statement_metadata, fragments); })
+      : nullptr;
+
+    if (!call_site_fragments)
     {
-      _set_arg_val<Attribute::Time>(_timestamp_formatter.format_timestamp(std::chrono::nanoseconds{timestamp}));
+      for (FormatOp const& op : _format_ops)
+      {
+        _append_op(op, timestamp, thread_id, thread_name, process_id, logger, log_level_description,
+                   log_level_short_code, log_statement_metadata, named_args, log_msg, mdc);
+      }
     }
-
-    if (_is_set_in_pattern[Attribute::FileName])
+    else
     {
-      _set_arg_val<Attribute::FileName>(log_statement_metadata.file_name());
+      size_t fragment_idx{0};
+
+      for (FormatRun const& run : _format_runs)
+      {
+        if (run.call_site)
+        {
+          _append((*call_site_fragments)[fragment_idx++]);
+          continue;
+        }
+
+        for (size_t op_idx = run.begin; op_idx < run.end; ++op_idx)
+        {
+          _append_op(_format_ops[op_idx], timestamp, thread_id, thread_name, process_id, logger,
+                     log_level_description, log_level_short_code, log_statement_metadata,
+                     named_args, log_msg, mdc);
+        }
+      }
     }
 
-    if (_is_set_in_pattern[Attribute::CallerFunction])
+    return std::string_view{_output->data() + _output_start, _output->size() - _output_start};
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT void _append_op(FormatOp const& op, uint64_t timestamp, std::string_view thread_id,
+                                      std::string_view thread_name, std::string_view process_id,
+                                      std::string_view logger, std::string_view log_level_description,
+                                      std::string_view log_level_short_code,
+                                      MacroMetadata const& log_statement_metadata,
+                                      std::vector<std::pair<std::string, std::string>> const* named_args,
+                                      std::string_view log_msg, std::string_view mdc)
+  {
+    std::string_view value;
+
+    switch (op.attribute)
+    {
+    case Attribute::ATTR_NR_ITEMS:
+      // literal
+      _append(op.text);
+      return;
+    case Attribute::Time:
+      value = _timestamp_formatter.format_timestamp(std::chrono::nanoseconds{timestamp});
+      break;
+    case Attribute::LogLevel:
+      value = log_level_description;
+      break;
+    case Attribute::LogLevelShortCode:
+      value = log_level_short_code;
+      break;
+    case Attribute::Logger:
+      value = logger;
+      break;
+    case Attribute::ThreadId:
+      value = thread_id;
+      break;
+    case Attribute::ThreadName:
+      value = thread_name;
+      break;
+    case Attribute::ProcessId:
+      value = process_id;
+      break;
+    case Attribute::Message:
+      value = log_msg;
+      break;
+    case Attribute::Mdc:
+      value = mdc;
+      break;
+    case Attribute::NamedArgs:
+      value = _format_named_args(named_args);
+      break;
+    default:
+      value = _call_site_attribute_value(op.attribute, log_statement_metadata);
+      break;
+    }
+
+    _append_attribute(op, value);
+  }
+
+  /***/
+  QUILL_NODISCARD std::string_view _call_site_attribute_value(Attribute attribute,
+                                                              MacroMetadata const& log_statement_metadata) const
+  {
+    switch (attribute)
     {
-      std::string_view const function_name = _options.process_function_name
+    case Attribute::FileName:
+      return log_statement_metadata.file_name();
+    case Attribute::CallerFunction:
+      return _options.process_function_name
         ? _options.process_function_name(log_statement_metadata.caller_function())
         : std::string_view{log_statement_metadata.caller_function()};
-
-      _set_arg_val<Attribute::CallerFunction>(function_name);
+    case Attribute::LineNumber:
+      return log_statement_metadata.line();
+    case Attribute::FullPath:
+      return log_statement_metadata.full_path();
+    case Attribute::SourceLocation:
+      return _process_source_location_path(log_statement_metadata.source_location(),
+                                           _options.source_location_path_strip_prefix,
+                                           _options.source_location_remove_relative_paths);
+    case Attribute::ShortSourceLocation:
+      return log_statement_metadata.short_source_location();
+    case Attribute::Tags:
+      return log_statement_metadata.tags() ? std::string_view{log_statement_metadata.tags()}
+                                           : std::string_view{};
+    default:
+      return std::string_view{};
     }
+  }
 
-    if (_is_set_in_pattern[Attribute::LogLevel])
-    {
-      _set_arg_val<Attribute::LogLevel>(log_level_description);
-    }
+  /**
+   * Renders the call site runs of the pattern for a call site
+   */
+  void _render_call_site_fragments(MacroMetadata const& log_statement_metadata,
+                                   std::vector<std::string>& fragments)
+  {
+    // Rendered at the end of the output buffer, which is then restored
+    size_t const buffer_size = _output->size();
 
-    if (_is_set_in_pattern[Attribute::LogLevelShortCode])
+    for (FormatRun const& run : _format_runs)
     {
-      _set_arg_val<Attribute::LogLevelShortCode>(log_level_short_code);
-    }
+      if (!run.call_site)
+      {
+        continue;
+      }
 
-    if (_is_set_in_pattern[Attribute::LineNumber])
-    {
-      _set_arg_val<Attribute::LineNumber>(log_statement_metadata.line());
-    }
+      for (size_t op_idx = run.begin; op_idx < run.end; ++op_idx)
+      {
+        FormatOp const& op = _format_ops[op_idx];
 
-    if (_is_set_in_pattern[Attribute::Logger])
-    {
-      _set_arg_val<Attribute::Logger>(logger);
-    }
+        if (op.type == FormatOp::Type::Literal)
+        {
+          _append(op.text);
+        }
+        else
+        {
+          _append_attribute(op, _call_site_attribute_value(op.attribute, log_statement_metadata));
+        }
+      }
 
-    if (_is_set_in_pattern[Attribute::FullPath])
-    {
-      _set_arg_val<Attribute::FullPath>(log_statement_metadata.full_path());
+      fragments.emplace_back(_output->data() + buffer_size, _output->size() - buffer_size);
+      _output->try_resize(buffer_size);
     }
+  }
 
-    if (_is_set_in_pattern[Attribute::ThreadId])
+  /***/
+  QUILL_ATTRIBUTE_HOT void _append_attribute(FormatOp const& op, std::string_view value)
+  {
+    if (op.type == FormatOp::Type::Attribute)
     {
-      _set_arg_val<Attribute::ThreadId>(thread_id);
+      _append(value);
+      return;
     }
 
-    if (_is_set_in_pattern[Attribute::ThreadName])
+    if ((op.type == FormatOp::Type::PaddedAttribute) && _is_ascii(value))
     {
-      _set_arg_val<Attribute::ThreadName>(thread_name);
-    }
+      // for ASCII the size is the display width fmt pads to
+      size_t const padding = (value.size() < op.width) ? (op.width - value.size()) : 0;
+      size_t const left_padding = (op.align == '>') ? padding : ((op.align == '^') ? (padding / 2) : 0);
 
-    if (_is_set_in_pattern[Attribute::ProcessId])
-    {
-      _set_arg_val<Attribute::ProcessId>(process_id);
+      _append_fill(op.fill, left_padding);
+      _append(value);
+      _append_fill(op.fill, padding - left_padding);
+      return;
     }
 
-    if (_is_set_in_pattern[Attribute::SourceLocation])
-    {
-      _set_arg_val<Attribute::SourceLocation>(_process_source_location_path(
-        log_statement_metadata.source_location(), _options.source_location_path_strip_prefix,
-        _options.source_location_remove_relative_paths));
-    }
+    fmtquill::vformat_to(fmtquill::appender{*_output}, op.text, fmtquill::make_format_args(value));
+  }
 
-    if (_is_set_in_pattern[Attribute::ShortSourceLocation])
-    {
-      _set_arg_val<Attribute::ShortSourceLocation>(log_statement_metadata.short_source_location());
-    }
+  /***/
+  QUILL_ATTRIBUTE_HOT void _append(std::string_view value)
+  {
+    _output->append(value.data(), value.data() + value.size());
+  }
 
-    if (_is_set_in_pattern[Attribute::NamedArgs])
-    {
-      _formatted_named_args_buffer.clear();
+  /***/
+  void _append_fill(char fill, size_t count)
+  {
+    size_t const size = _output->size();
+    _output->try_resize(size + count);
+    std::fill_n(_output->data() + size, count, fill);
+  }
 
-      if (named_args)
+  /***/
+  QUILL_NODISCARD static bool _is_ascii(std::string_view value) noexcept
+  {
+    for (char const c : value)
+    {
+      if (static_cast<unsigned char>(c) >= 0x80)
       {
-        for (size_t i = 0; i < named_args->size(); ++i)
-        {
-          _formatted_named_args_buffer.append((*named_args)[i].first);
-          _formatted_named_args_buffer.append(std::string_view{": "});
-          _formatted_named_args_buffer.append((*named_args)[i].second);
-
-          if (i != named_args->size() - 1)
-          {
-            _formatted_named_args_buffer.append(std::string_view{", "});
-          }
-        }
+        return false;
       }
-
-      _set_arg_val<Attribute::NamedArgs>(
-        std::string_view{_formatted_named_args_buffer.data(), _formatted_named_args_buffer.size()});
     }
 
-    if (_is_set_in_pattern[Attribute::Mdc])
-    {
-      _set_arg_val<Attribute::Mdc>(mdc);
-    }
+    return true;
+  }
+
+  /***/
+  QUILL_NODISCARD std::string_view _format_named_args(std::vector<std::pair<std::string, std::string>> const* named_args)
+  {
+    _formatted_named_args_buffer.clear();
 
-    if (_is_set_in_pattern[Attribute::Tags])
+    if (named_args)
     {
-      if (log_statement_metadata.tags())
+      for (size_t i = 0; i < named_args->size(); ++i)
       {
-        _set_arg_val<Attribute::Tags>(std::string_view{log_statement_metadata.tags()});
-      }
-      else
-      {
-        _set_arg_val<Attribute::Tags>(std::string_view{});
+        _formatted_named_args_buffer.append((*named_args)[i].first);
+        _formatted_named_args_buffer.append(std::string_view{": "});
+        _formatted_named_args_buffer.append((*named_args)[i].second);
+
+        if (i != named_args->size() - 1)
+        {
+          _formatted_named_args_buffer.append(std::string_view{", "});
+        }
       }
     }
 
-    _set_arg_val<Attribute::Message>(log_msg);
-
-    fmtquill::vformat_to(std::back_inserter(_formatted_log_message_buffer), _fmt_format,
-                         fmtquill::basic_format_args(_args.data(), static_cast<int>(_args.size())));
-
-    return std::string_view{_formatted_log_message_buffer.data(), _formatted_log_message_buffer.size()};
+    return std::string_view{_formatted_named_args_buffer.data(), _formatted_named_args_buffer.size()};
   }
 
 private:
   PatternFormatterOptions _options;
-  std::string _fmt_format;
 
-  /** Each named argument in the format_pattern is mapped in order to this array **/
-  std::array<size_t, Attribute::ATTR_NR_ITEMS> _order_index{};
-  std::array<fmtquill::basic_format_arg<fmtquill::format_context>, Attribute::ATTR_NR_ITEMS> _args{};
+  /** The pattern compiled in the order it is formatted **/
+  std::vector<FormatOp> _format_ops;
+  std::vector<FormatRun> _format_runs;
+
+  /** The call site runs of _format_runs rendered for each call site **/
+  detail::CallSiteCache<std::vector<std::string>> _call_site_fragments;
+  bool _has_call_site_attributes{false};
   std::bitset<Attribute::ATTR_NR_ITEMS> _is_set_in_pattern;
 
   /** class responsible for formatting the timestamp */
@@ -699,6 +1001,8 @@ private:
   /** The buffer where we store each formatted string, also stored as class member to avoid
    * re-allocations **/
   fmtquill::basic_memory_buffer<char, 512> _formatted_log_message_buffer;
+  fmtquill::detail::buffer<char>* _output{nullptr}; /** The buffer of the log statement being formatted */
+  size_t _output_start{0};                          /** The size of _output before the log statement */
   fmtquill::basic_memory_buffer<char, 512> _formatted_named_args_buffer;
 };
 
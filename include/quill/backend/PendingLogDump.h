@@ -0,0 +1,366 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#if !defined(_WIN32)
+
+  #include "quill/bundled/fmt/format.h"
+  #include "quill/core/Attributes.h"
+  #include "quill/core/Codec.h"
+  #include "quill/core/Common.h"
+  #include "quill/core/DynamicFormatArgStore.h"
+  #include "quill/core/LogLevel.h"
+  #include "quill/core/LoggerBase.h"
+  #include "quill/core/MacroMetadata.h"
+  #include "quill/core/QuillError.h"
+  #include "quill/core/ThreadContextManager.h"
+
+  #include <algorithm>
+  #include <array>
+  #include <cerrno>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstring>
+  #include <string_view>
+
+  #include <unistd.h>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * Builds a single line in a fixed size buffer and writes it to a file descriptor with ::write.
+ * Longer lines are truncated. Nothing is allocated, so it can be used from a signal handler
+ */
+class SignalSafeLineWriter
+{
+public:
+  explicit SignalSafeLineWriter(int fd) noexcept : _fd(fd) {}
+
+  /***/
+  void append(std::string_view text) noexcept
+  {
+    size_t const n = (std::min)(text.size(), _remaining());
+    std::memcpy(_line.data() + _size, text.data(), n);
+    _size += n;
+  }
+
+  /***/
+  void append(uint64_t value) noexcept
+  {
+    fmtquill::format_int const formatted{value};
+    append(std::string_view{formatted.data(), formatted.size()});
+  }
+
+  /**
+   * Formats into the remaining space of the line
+   */
+  void append_format(std::string_view format, fmtquill::format_args args) noexcept
+  {
+    QUILL_TRY
+    {
+      auto const result = fmtquill::vformat_to_n(_line.data() + _size, _remaining(), format, args);
+      _size += (std::min)(result.size, _remaining());
+    }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH_ALL() { append(" [format error]"); }
+  #endif
+  }
+
+  /**
+   * Writes the line followed by a new line character and starts a new line
+   */
+  void write_line() noexcept
+  {
+    _line[_size++] = '\n';
+
+    size_t written{0};
+    while (written < _size)
+    {
+      ssize_t const res = ::write(_fd, _line.data() + written, _size - written);
+
+      if (res < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+
+        break;
+      }
+
+      written += static_cast<size_t>(res);
+    }
+
+    _size = 0;
+  }
+
+private:
+  /** Space left on the line, one character is kept for the new line */
+  QUILL_NODISCARD size_t _remaining() const noexcept { return _line.size() - 1 - _size; }
+
+private:
+  std::array<char, 4096> _line;
+  size_t _size{0};
+  int _fd;
+};
+
+/***/
+QUILL_NODISCARD inline std::string_view pending_log_level_description(LogLevel log_level) noexcept
+{
+  static constexpr std::array<std::string_view, LogLevelCount> descriptions{
+    "TRACE_L3", "TRACE_L2", "TRACE_L1", "DEBUG",     "INFO", "NOTICE",
+    "WARNING",  "ERROR",    "CRITICAL", "BACKTRACE", "NONE"};
+
+  auto const index = static_cast<size_t>(log_level);
+  return index < descriptions.size() ? descriptions[index] : std::string_view{"UNKNOWN"};
+}
+
+/**
+ * Decodes a single record of a frontend queue, the same way the backend does, and writes it as a
+ * line when it is a log statement.
+ *
+ * The line is `timestamp [thread_id] file:line LEVEL logger message`. The timestamp is in
+ * nanoseconds since epoch, or `tsc:` followed by the raw counter for the loggers using the TSC
+ * clock, as the backend is the one converting it.
+ *
+ * @return the size of the record, or 0 if the record can not be decoded
+ */
+inline size_t write_pending_record(std::byte* record, size_t available_bytes, ThreadContext const& thread_context,
+                                   DynamicFormatArgStore& format_args_store, SignalSafeLineWriter& line_writer,
+                                   size_t& written_log_statements) noexcept
+{
+  uint64_t header_words[4];
+  size_t const header_size = sizeof(header_words) +
+    (thread_context.has_shared_queue_type() ? sizeof(uintptr_t) : 0);
+
+  if (available_bytes < header_size)
+  {
+    return 0;
+  }
+
+  std::byte* read_pos = record;
+  std::memcpy(header_words, read_pos, sizeof(header_words));
+  read_pos += sizeof(header_words);
+
+  auto const* macro_metadata =
+    reinterpret_cast<MacroMetadata const*>(static_cast<uintptr_t>(header_words[1]));
+  auto const* logger_base = reinterpret_cast<LoggerBase const*>(static_cast<uintptr_t>(header_words[2]));
+
+  std::string_view thread_id = thread_context.thread_id();
+
+  if (thread_context.has_shared_queue_type())
+  {
+    uintptr_t thread_identity;
+    std::memcpy(&thread_identity, read_pos, sizeof(thread_identity));
+    read_pos += sizeof(thread_identity);
+
+    if (thread_identity)
+    {
+      thread_id = reinterpret_cast<ThreadIdentity const*>(thread_identity)->thread_id;
+    }
+  }
+
+  if (!macro_metadata || !logger_base)
+  {
+    return 0;
+  }
+
+  MacroMetadata::Event const event = macro_metadata->event();
+
+  if (event == MacroMetadata::Event::Metric)
+  {
+    // Metric records have no payload after the header
+    return static_cast<size_t>(read_pos - record);
+  }
+
+  if (event == MacroMetadata::Event::MetricHistogram)
+  {
+    // The last header word is the size of the encoded histogram
+    read_pos += static_cast<size_t>(header_words[3]);
+    return static_cast<size_t>(read_pos - record);
+  }
+
+  if (event == MacroMetadata::Event::Flush)
+  {
+    read_pos += sizeof(uintptr_t);
+    return static_cast<size_t>(read_pos - record);
+  }
+
+  if (event == MacroMetadata::Event::LoggerRemovalRequest)
+  {
+    read_pos += sizeof(uintptr_t);
+    (void)Codec<std::string>::decode_arg(read_pos);
+    return static_cast<size_t>(read_pos - record);
+  }
+
+  std::string_view source_location{macro_metadata->short_source_location()};
+  std::string_view message_format{macro_metadata->message_format()};
+  LogLevel log_level = macro_metadata->log_level();
+  uint32_t runtime_line{0};
+
+  bool const runtime_metadata_event = (event == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy) ||
+    (event == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy) ||
+    (event == MacroMetadata::Event::LogWithRuntimeMetadataHybridCopy);
+
+  if (runtime_metadata_event)
+  {
+    char const* fmt;
+    char const* file;
+
+    if (event == MacroMetadata::Event::LogWithRuntimeMetadataDeepCopy)
+    {
+      fmt = Codec<char const*>::decode_arg(read_pos);
+      file = Codec<char const*>::decode_arg(read_pos);
+      (void)Codec<char const*>::decode_arg(read_pos);
+      (void)Codec<char const*>::decode_arg(read_pos);
+    }
+    else if (event == MacroMetadata::Event::LogWithRuntimeMetadataShallowCopy)
+    {
+      fmt = static_cast<char const*>(Codec<void const*>::decode_arg(read_pos));
+      file = static_cast<char const*>(Codec<void const*>::decode_arg(read_pos));
+      (void)Codec<void const*>::decode_arg(read_pos);
+      (void)Codec<void const*>::decode_arg(read_pos);
+    }
+    else
+    {
+      fmt = Codec<char const*>::decode_arg(read_pos);
+      file = static_cast<char const*>(Codec<void const*>::decode_arg(read_pos));
+      (void)Codec<void const*>::decode_arg(read_pos);
+      (void)Codec<char const*>::decode_arg(read_pos);
+    }
+
+    message_format = fmt ? std::string_view{fmt} : std::string_view{};
+    source_location = file ? std::string_view{file} : std::string_view{};
+    runtime_line = Codec<uint32_t>::decode_arg(read_pos);
+    log_level = Codec<LogLevel>::decode_arg(read_pos);
+  }
+
+  uintptr_t const decoder_bits = static_cast<uintptr_t>(header_words[3]);
+  FormatArgsDecoder format_args_decoder;
+  std::memcpy(&format_args_decoder, &decoder_bits, sizeof(format_args_decoder));
+  format_args_decoder(read_pos, format_args_store);
+
+  if ((event != MacroMetadata::Event::Log) && !runtime_metadata_event)
+  {
+    // MDC and backtrace control records only carry arguments
+    format_args_store.clear();
+    return static_cast<size_t>(read_pos - record);
+  }
+
+  if (logger_base->get_clock_source_type() == ClockSourceType::Tsc)
+  {
+    line_writer.append("tsc:");
+  }
+
+  line_writer.append(header_words[0]);
+  line_writer.append(" [");
+  line_writer.append(thread_id);
+  line_writer.append("] ");
+  line_writer.append(source_location);
+
+  if (runtime_metadata_event)
+  {
+    // The source location of the log macros already contains the line
+    line_writer.append(":");
+    line_writer.append(static_cast<uint64_t>(runtime_line));
+  }
+
+  line_writer.append(" ");
+  line_writer.append(pending_log_level_description(log_level));
+  line_writer.append(" ");
+  line_writer.append(logger_base->get_logger_name());
+  line_writer.append(" ");
+
+  fmtquill::format_args const format_args{format_args_store.data(), format_args_store.size()};
+
+  if (MacroMetadata::contains_named_args(message_format))
+  {
+    // The argument names are not stored, so the format string is written followed by the values
+    line_writer.append(message_format);
+    line_writer.append(" [");
+
+    for (int i = 0; i < format_args_store.size(); ++i)
+    {
+      if (i != 0)
+      {
+        line_writer.append(", ");
+      }
+
+      line_writer.append_format("{}", fmtquill::format_args{format_args_store.data() + i, 1});
+    }
+
+    line_writer.append("]");
+  }
+  else
+  {
+    line_writer.append_format(message_format, format_args);
+  }
+
+  line_writer.write_line();
+  format_args_store.clear();
+  ++written_log_statements;
+
+  return static_cast<size_t>(read_pos - record);
+}
+
+/**
+ * Writes the log statements that are still in the frontend queues, and were not read by the
+ * backend, to a file descriptor. Used by the signal handler when the backend can not process them
+ * before the process terminates.
+ *
+ * Each record is written as soon as it is decoded, with a fixed size buffer and ::write.
+ * This is best effort: nothing is allocated for the built-in types when the args store was
+ * reserved beforehand, but decoding and formatting user defined types may allocate. Records that
+ * the backend read but did not release yet are not written.
+ *
+ * @param fd an open file descriptor
+ * @param format_args_store store used to decode the arguments
+ * @return the number of log statements written
+ */
+inline size_t write_pending_log_statements(int fd, DynamicFormatArgStore& format_args_store) noexcept
+{
+  SignalSafeLineWriter line_writer{fd};
+  size_t written_log_statements{0};
+
+  line_writer.append("Log statements not processed by the backend:");
+  line_writer.write_line();
+
+  bool const locked = ThreadContextManager::instance().try_for_each_thread_context(
+    [&format_args_store, &line_writer, &written_log_statements](ThreadContext const* thread_context)
+    {
+      auto const write_record = [thread_context, &format_args_store, &line_writer,
+                                 &written_log_statements](std::byte* record, size_t available_bytes)
+      {
+        return write_pending_record(record, available_bytes, *thread_context, format_args_store,
+                                    line_writer, written_log_statements);
+      };
+
+      if (thread_context->has_unbounded_queue_type())
+      {
+        thread_context->get_spsc_queue_union().unbounded_spsc_queue.for_each_unread(write_record);
+      }
+      else
+      {
+        thread_context->get_spsc_queue_union().bounded_spsc_queue.for_each_unread(write_record);
+      }
+    });
+
+  if (!locked)
+  {
+    line_writer.append("Failed to access the frontend queues");
+    line_writer.write_line();
+  }
+
+  return written_log_statements;
+}
+} // namespace detail
+
+QUILL_END_NAMESPACE
+
+#endif
@@ -0,0 +1,336 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/bundled/fmt/base.h"
+#include "quill/core/Attributes.h"
+#include "quill/core/DynamicFormatArgStore.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * Type tag of each argument written by serialize_format_args()
+ */
+enum class SerializedArgType : uint8_t
+{
+  Int = 1,
+  UnsignedInt = 2,
+  LongLong = 3,
+  UnsignedLongLong = 4,
+  Bool = 5,
+  Char = 6,
+  Float = 7,
+  Double = 8,
+  String = 9,
+  Pointer = 10
+};
+
+/***/
+template <typename TBuffer, typename T>
+QUILL_ATTRIBUTE_HOT void append_serialized_value(TBuffer& buffer, T value)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer.append(bytes, bytes + sizeof(T));
+}
+
+/***/
+QUILL_NODISCARD inline bool is_printable(std::string_view value,
+                                         std::function<bool(char)> const& check_printable_char)
+{
+  for (char c : value)
+  {
+    if (!check_printable_char(c))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Serializes the decoded arguments of a log statement, so they can be formatted later outside of
+ * the process that logged them.
+ *
+ * The layout is a uint32_t argument count followed by a one byte SerializedArgType and the value
+ * of each argument. Numbers are stored in the byte order of the host, strings as a uint32_t
+ * length followed by the raw bytes and pointers as a uint64_t.
+ *
+ * @param format_args_store the decoded arguments
+ * @param check_printable_char when set, strings and chars that contain a non-printable char are
+ * not serialized, the backend replaces them when formatting the message
+ * @param buffer appended with the serialized arguments
+ * @return false when an argument can not be serialized, e.g. a type with its own formatter, a
+ * 128-bit integer or a long double. The content appended to buffer is then unspecified
+ */
+template <typename TBuffer>
+QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool serialize_format_args(
+  DynamicFormatArgStore const& format_args_store,
+  std::function<bool(char)> const& check_printable_char, TBuffer& buffer)
+{
+  if (format_args_store.has_custom_type())
+  {
+    return false;
+  }
+
+  append_serialized_value(buffer, static_cast<uint32_t>(format_args_store.size()));
+
+  for (int i = 0; i < format_args_store.size(); ++i)
+  {
+    bool const serialized = format_args_store.data()[i].visit(
+      [&buffer, &check_printable_char](auto value)
+      {
+        using value_t = std::decay_t<decltype(value)>;
+
+        if constexpr (std::is_same_v<value_t, bool>)
+        {
+          append_serialized_value(buffer, SerializedArgType::Bool);
+          append_serialized_value(buffer, static_cast<uint8_t>(value));
+        }
+        else if constexpr (std::is_same_v<value_t, char>)
+        {
+          if (check_printable_char && !check_printable_char(value))
+          {
+            return false;
+          }
+
+          append_serialized_value(buffer, SerializedArgType::Char);
+          append_serialized_value(buffer, value);
+        }
+        else if constexpr (std::is_same_v<value_t, int>)
+        {
+          append_serialized_value(buffer, SerializedArgType::Int);
+          append_serialized_value(buffer, value);
+        }
+        else if constexpr (std::is_same_v<value_t, unsigned>)
+        {
+          append_serialized_value(buffer, SerializedArgType::UnsignedInt);
+          append_serialized_value(buffer, value);
+        }
+        else if constexpr (std::is_same_v<value_t, long long>)
+        {
+          append_serialized_value(buffer, SerializedArgType::LongLong);
+          append_serialized_value(buffer, value);
+        }
+        else if constexpr (std::is_same_v<value_t, unsigned long long>)
+        {
+          append_serialized_value(buffer, SerializedArgType::UnsignedLongLong);
+          append_serialized_value(buffer, value);
+        }
+        else if constexpr (std::is_same_v<value_t, float>)
+        {
+          append_serialized_value(buffer, SerializedArgType::Float);
+          append_serialized_value(buffer, value);
+        }
+        else if constexpr (std::is_same_v<value_t, double>)
+        {
+          append_serialized_value(buffer, SerializedArgType::Double);
+          append_serialized_value(buffer, value);
+        }
+        else if constexpr (std::is_same_v<value_t, char const*> ||
+                           std::is_same_v<value_t, fmtquill::basic_string_view<char>>)
+        {
+          std::string_view str;
+          if constexpr (std::is_same_v<value_t, char const*>)
+          {
+            str = std::string_view{value};
+          }
+          else
+          {
+            str = std::string_view{value.data(), value.size()};
+          }
+
+          if (check_printable_char && !is_printable(str, check_printable_char))
+          {
+            return false;
+          }
+
+          append_serialized_value(buffer, SerializedArgType::String);
+          append_serialized_value(buffer, static_cast<uint32_t>(str.size()));
+          buffer.append(str.data(), str.data() + str.size());
+        }
+        else if constexpr (std::is_same_v<value_t, void const*>)
+        {
+          append_serialized_value(buffer, SerializedArgType::Pointer);
+          append_serialized_value(buffer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        }
+        else
+        {
+          // 128-bit integers, long double and custom types
+          return false;
+        }
+
+        return true;
+      });
+
+    if (!serialized)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Reads a value written by append_serialized_value()
+ * @return false when the serialized arguments are truncated
+ */
+template <typename T>
+QUILL_NODISCARD bool read_serialized_value(std::string_view& serialized_args, T& value)
+{
+  if (serialized_args.size() < sizeof(T))
+  {
+    return false;
+  }
+
+  std::memcpy(&value, serialized_args.data(), sizeof(T));
+  serialized_args.remove_prefix(sizeof(T));
+  return true;
+}
+
+/**
+ * Pushes the arguments written by serialize_format_args() to the store. Strings are not copied,
+ * the serialized arguments have to outlive the store
+ * @return false when the serialized arguments are truncated or hold an unknown type
+ */
+QUILL_NODISCARD inline bool deserialize_format_args(std::string_view serialized_args,
+                                                    DynamicFormatArgStore& format_args_store)
+{
+  uint32_t args_count;
+  if (!read_serialized_value(serialized_args, args_count))
+  {
+    return false;
+  }
+
+  format_args_store.reserve(args_count);
+
+  for (uint32_t i = 0; i < args_count; ++i)
+  {
+    SerializedArgType arg_type;
+    if (!read_serialized_value(serialized_args, arg_type))
+    {
+      return false;
+    }
+
+    bool valid{false};
+
+    switch (arg_type)
+    {
+    case SerializedArgType::Int:
+    {
+      int value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value);
+      }
+      break;
+    }
+    case SerializedArgType::UnsignedInt:
+    {
+      unsigned value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value);
+      }
+      break;
+    }
+    case SerializedArgType::LongLong:
+    {
+      long long value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value);
+      }
+      break;
+    }
+    case SerializedArgType::UnsignedLongLong:
+    {
+      unsigned long long value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value);
+      }
+      break;
+    }
+    case SerializedArgType::Bool:
+    {
+      uint8_t value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value != 0);
+      }
+      break;
+    }
+    case SerializedArgType::Char:
+    {
+      char value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value);
+      }
+      break;
+    }
+    case SerializedArgType::Float:
+    {
+      float value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value);
+      }
+      break;
+    }
+    case SerializedArgType::Double:
+    {
+      double value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(value);
+      }
+      break;
+    }
+    case SerializedArgType::String:
+    {
+      uint32_t size;
+      if ((valid = (read_serialized_value(serialized_args, size) && (serialized_args.size() >= size))))
+      {
+        format_args_store.push_back(std::string_view{serialized_args.data(), size});
+        serialized_args.remove_prefix(size);
+      }
+      break;
+    }
+    case SerializedArgType::Pointer:
+    {
+      uint64_t value;
+      if ((valid = read_serialized_value(serialized_args, value)))
+      {
+        format_args_store.push_back(reinterpret_cast<void const*>(static_cast<uintptr_t>(value)));
+      }
+      break;
+    }
+    }
+
+    if (!valid)
+    {
+      return false;
+    }
+  }
+
+  return serialized_args.empty();
+}
+} // namespace detail
+
+QUILL_END_NAMESPACE
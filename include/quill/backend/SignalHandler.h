@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include "quill/backend/PendingLogDump.h"
 #include "quill/backend/ThreadUtilities.h"
 
 #include "quill/Logger.h"
 #include "quill/core/Attributes.h"
+#include "quill/core/DynamicFormatArgStore.h"
 #include "quill/core/LogLevel.h"
 #include "quill/core/LoggerBase.h"
 #include "quill/core/LoggerManager.h"
@@ -87,6 +89,17 @@ struct SignalHandlerOptions
    * Default: {"__csv__"} to exclude CSV loggers.
    */
   std::vector<std::string> excluded_logger_substrings{"__csv__"};
+
+  /**
+   * File descriptor where the signal handler writes the log statements that are still in the
+   * frontend queues when the backend can not process them before the process terminates, e.g.
+   * when the backend does not flush within timeout_seconds. The file descriptor must be opened by
+   * the application beforehand, for example STDERR_FILENO or a file opened with ::open.
+   * The records are decoded without the backend and written one line per log statement, without
+   * the sinks or the pattern formatter. This is best effort, see the signal handler documentation.
+   * It is only available on Linux and macOS. Default: -1, disabled.
+   */
+  int pending_log_statements_fd{-1};
 };
 
 QUILL_END_EXPORT
@@ -232,6 +245,9 @@ public:
   std::atomic<uint32_t> backend_thread_id{0};
   std::atomic<uint32_t> signal_handler_timeout_seconds{20};
   std::atomic<bool> should_reraise_signal{true};
+  std::atomic<int> pending_log_statements_fd{-1};
+  std::atomic<bool> pending_log_statements_written{false};
+  DynamicFormatArgStore pending_log_statements_args_store;
   std::mutex signal_handlers_mutex;
   std::vector<int> registered_signal_handlers{};
   std::vector<SignalHandlerRestoreEntry> previous_signal_handlers{};
@@ -258,6 +274,48 @@ private:
     }                                                                                              \
   } while (0)
 
+#if !defined(_WIN32)
+/**
+ * Writes the log statements the backend did not process to the configured file descriptor. Only
+ * the first call writes them.
+ *
+ * The unread part of the queues is owned by the backend while it runs. Unless the caller is the
+ * backend thread, the backend is first asked to stop reading the queues and nothing is written
+ * when it does not stop within a second, e.g. because it is blocked in a sink
+ */
+inline void write_pending_log_statements_once() noexcept
+{
+  static constexpr uint64_t backend_pause_timeout_ns{1'000'000'000};
+
+  auto& ctx = SignalHandlerContext::instance();
+  int const fd = ctx.pending_log_statements_fd.load();
+
+  if ((fd < 0) || ctx.pending_log_statements_written.exchange(true))
+  {
+    return;
+  }
+
+  uint32_t const backend_thread_id = ctx.backend_thread_id.load();
+  bool const on_backend_thread = (backend_thread_id != 0) && (backend_thread_id == get_thread_id());
+
+  if (!on_backend_thread && !ThreadContextManager::instance().pause_consumer(backend_pause_timeout_ns))
+  {
+    SignalSafeLineWriter line_writer{fd};
+    line_writer.append("Log statements not processed by the backend: the backend did not stop "
+                       "reading the frontend queues");
+    line_writer.write_line();
+    return;
+  }
+
+  (void)write_pending_log_statements(fd, ctx.pending_log_statements_args_store);
+
+  if (!on_backend_thread)
+  {
+    ThreadContextManager::instance().resume_consumer();
+  }
+}
+#endif
+
 /***/
 template <typename TFrontendOptions>
 void on_signal(int32_t signal_number)
@@ -298,6 +356,10 @@ void on_signal(int32_t signal_number)
   if ((backend_thread_id == 0) || (current_thread_id == backend_thread_id))
   {
     // backend worker thread is not running or the signal handler is called in the backend worker thread
+#if !defined(_WIN32)
+    write_pending_log_statements_once();
+#endif
+
     if (signal_number == SIGINT || signal_number == SIGTERM)
     {
       std::_Exit(EXIT_SUCCESS);
@@ -620,6 +682,27 @@ inline void on_alarm(int32_t signal_number)
     SignalHandlerContext::instance().signal_number = signal_number;
   }
 
+  if (SignalHandlerContext::instance().pending_log_statements_fd.load() >= 0)
+  {
+    // The backend did not process the log statements in time. A second alarm terminates the
+    // process if writing them does not complete
+    std::signal(SIGALRM, SIG_DFL);
+    sigset_t alarm_set;
+    sigemptyset(&alarm_set);
+    sigaddset(&alarm_set, SIGALRM);
+    pthread_sigmask(SIG_UNBLOCK, &alarm_set, nullptr);
+    alarm(SignalHandlerContext::instance().signal_handler_timeout_seconds.load());
+
+    write_pending_log_statements_once();
+
+    // The alarm can interrupt the handler of the original signal on this thread, where the
+    // original signal is blocked. Unblock it so it is delivered when raised below
+    sigset_t original_signal_set;
+    sigemptyset(&original_signal_set);
+    sigaddset(&original_signal_set, SignalHandlerContext::instance().signal_number.load());
+    pthread_sigmask(SIG_UNBLOCK, &original_signal_set, nullptr);
+  }
+
   // We will raise the original signal back
   std::signal(SignalHandlerContext::instance().signal_number, SIG_DFL);
   std::raise(SignalHandlerContext::instance().signal_number);
@@ -0,0 +1,761 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/backend/BackendOptions.h"
+#include "quill/backend/BackendUtilities.h"
+#include "quill/core/Attributes.h"
+#include "quill/core/BoundedSPSCQueue.h"
+#include "quill/core/Common.h"
+#include "quill/core/LogLevel.h"
+#include "quill/core/LoggerBase.h"
+#include "quill/core/MacroMetadata.h"
+#include "quill/core/Metric.h"
+#include "quill/core/QuillError.h"
+#include "quill/core/ThreadPrimitives.h"
+#include "quill/sinks/Sink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+/**
+ * A thread that makes the sink calls for the sinks assigned to it on behalf of the backend thread.
+ *
+ * The backend thread remains the only reader of the frontend queues. It orders and formats each
+ * event as before and then copies everything a sink needs into a record in a bounded SPSC queue
+ * owned by this worker. The worker replays the records in order, so each sink is still called
+ * from a single thread and sees its events in timestamp order.
+ *
+ * Apart from the constructor, start() and stop(), every member function must be called from the
+ * backend thread.
+ */
+class SinkWorker
+{
+public:
+  /***/
+  SinkWorker(SinkWorkerOptions options, std::chrono::nanoseconds sleep_duration,
+             std::function<void(std::string const&)> error_notifier, std::string process_id)
+    : _options(std::move(options)),
+      _queue(_options.queue_capacity),
+      _error_notifier(std::move(error_notifier)),
+      _process_id(std::move(process_id)),
+      _sleep_duration(sleep_duration)
+  {
+  }
+
+  /***/
+  ~SinkWorker() { stop(); }
+
+  SinkWorker(SinkWorker const&) = delete;
+  SinkWorker& operator=(SinkWorker const&) = delete;
+
+  /**
+   * Starts the worker thread
+   */
+  QUILL_ATTRIBUTE_COLD void start()
+  {
+    _is_running.store(true, std::memory_order_release);
+    _thread = std::thread{[this]() { _run(); }};
+  }
+
+  /**
+   * Processes all queued records and joins the worker thread
+   */
+  QUILL_ATTRIBUTE_COLD void stop()
+  {
+    if (!_thread.joinable())
+    {
+      return;
+    }
+
+    _is_running.store(false, std::memory_order_release);
+    _wake_up();
+    _thread.join();
+
+    _processed_records.store(0, std::memory_order_relaxed);
+    _written_records = 0;
+    _sinks.clear();
+  }
+
+  /**
+   * Keeps the sink alive while records for it may still be queued, as the logger owning it can be
+   * removed in the meantime
+   */
+  void retain_sink(std::shared_ptr<Sink> const& sink)
+  {
+    if (std::find(_sinks.begin(), _sinks.end(), sink) == _sinks.end())
+    {
+      _sinks.push_back(sink);
+    }
+  }
+
+  /**
+   * Releases the sinks no longer referenced elsewhere once the worker has processed all records
+   */
+  void release_unused_sinks()
+  {
+    if (_sinks.empty() || !is_idle())
+    {
+      return;
+    }
+
+    _sinks.erase(std::remove_if(_sinks.begin(), _sinks.end(),
+                                [](std::shared_ptr<Sink> const& sink) { return sink.use_count() == 1; }),
+                 _sinks.end());
+  }
+
+  /***/
+  QUILL_NODISCARD bool is_idle() const noexcept
+  {
+    return _processed_records.load(std::memory_order_acquire) == _written_records;
+  }
+
+  /**
+   * Blocks until the worker has processed all records
+   */
+  void wait_until_idle() noexcept
+  {
+    while (!is_idle())
+    {
+      _wake_up();
+      yield_thread();
+    }
+  }
+
+  /**
+   * Queues a log statement for the sink. Runtime metadata is owned by the transit event and is
+   * copied into the record when copy_log_metadata is set.
+   */
+  QUILL_ATTRIBUTE_HOT void write_log(Sink* sink, MacroMetadata const* log_metadata, bool copy_log_metadata,
+                                     uint64_t log_timestamp, std::string_view thread_id,
+                                     std::string_view thread_name, std::string_view logger_name,
+                                     LogLevel log_level, std::string_view log_level_description,
+                                     std::string_view log_level_short_code,
+                                     std::vector<std::pair<std::string, std::string>> const* named_args,
+                                     std::string_view log_message, std::string_view log_statement)
+  {
+    size_t record_size = sizeof(RecordHeader) + _encoded_size(thread_id) + _encoded_size(thread_name) +
+      _encoded_size(logger_name) + _encoded_size(log_level_description) +
+      _encoded_size(log_level_short_code) + _encoded_size(log_message) + _encoded_size(log_statement);
+
+    if (named_args)
+    {
+      record_size += sizeof(uint32_t);
+
+      for (auto const& [key, value] : *named_args)
+      {
+        record_size += _encoded_size(key) + _encoded_size(value);
+      }
+    }
+
+    if (copy_log_metadata)
+    {
+      record_size += _encoded_size(log_metadata->source_location()) +
+        _encoded_size(log_metadata->caller_function()) +
+        _encoded_size(log_metadata->message_format()) + _encoded_size(_tags(log_metadata));
+    }
+
+    if (QUILL_UNLIKELY(record_size > _queue.capacity()))
+    {
+      // The record can never fit, call the sink directly once the worker stopped using it
+      wait_until_idle();
+      _process_log(sink, log_metadata, log_timestamp, thread_id, thread_name, logger_name, log_level,
+                   log_level_description, log_level_short_code, named_args, log_message, log_statement);
+      return;
+    }
+
+    std::byte* write_pos = _prepare_write(record_size);
+
+    RecordHeader const header{log_timestamp,
+                              sink,
+                              copy_log_metadata ? nullptr : log_metadata,
+                              0.0,
+                              static_cast<uint32_t>(record_size),
+                              RecordType::Log,
+                              log_level,
+                              log_metadata->log_level(),
+                              log_metadata->event(),
+                              named_args != nullptr};
+
+    std::memcpy(write_pos, &header, sizeof(RecordHeader));
+    write_pos += sizeof(RecordHeader);
+
+    write_pos = _encode(write_pos, thread_id);
+    write_pos = _encode(write_pos, thread_name);
+    write_pos = _encode(write_pos, logger_name);
+    write_pos = _encode(write_pos, log_level_description);
+    write_pos = _encode(write_pos, log_level_short_code);
+    write_pos = _encode(write_pos, log_message);
+    write_pos = _encode(write_pos, log_statement);
+
+    if (named_args)
+    {
+      auto const named_args_count = static_cast<uint32_t>(named_args->size());
+      std::memcpy(write_pos, &named_args_count, sizeof(uint32_t));
+      write_pos += sizeof(uint32_t);
+
+      for (auto const& [key, value] : *named_args)
+      {
+        write_pos = _encode(write_pos, key);
+        write_pos = _encode(write_pos, value);
+      }
+    }
+
+    if (copy_log_metadata)
+    {
+      write_pos = _encode(write_pos, log_metadata->source_location());
+      write_pos = _encode(write_pos, log_metadata->caller_function());
+      write_pos = _encode(write_pos, log_metadata->message_format());
+      write_pos = _encode(write_pos, _tags(log_metadata));
+    }
+
+    _commit_write(record_size);
+  }
+
+  /**
+   * Queues a metric sample for the sink
+   */
+  QUILL_ATTRIBUTE_HOT void write_metric(Sink* sink, MetricMetadata const* metric_metadata,
+                                        uint64_t log_timestamp, std::string_view thread_id,
+                                        std::string_view thread_name, std::string_view logger_name,
+                                        double value)
+  {
+    size_t const record_size = sizeof(RecordHeader) + _encoded_size(thread_id) +
+      _encoded_size(thread_name) + _encoded_size(logger_name);
+
+    if (QUILL_UNLIKELY(record_size > _queue.capacity()))
+    {
+      wait_until_idle();
+      _process_metric(sink, metric_metadata, log_timestamp, thread_id, thread_name, logger_name, value);
+      return;
+    }
+
+    std::byte* write_pos = _prepare_write(record_size);
+
+    RecordHeader const header{log_timestamp,
+                              sink,
+                              metric_metadata,
+                              value,
+                              static_cast<uint32_t>(record_size),
+                              RecordType::Metric,
+                              metric_metadata->log_level(),
+                              metric_metadata->log_level(),
+                              metric_metadata->event(),
+                              false};
+
+    std::memcpy(write_pos, &header, sizeof(RecordHeader));
+    write_pos += sizeof(RecordHeader);
+
+    write_pos = _encode(write_pos, thread_id);
+    write_pos = _encode(write_pos, thread_name);
+    write_pos = _encode(write_pos, logger_name);
+
+    _commit_write(record_size);
+  }
+
+  /**
+   * Queues a histogram aggregated on the frontend for the sink. The bounds and the bucket counts
+   * are copied into the record
+   */
+  void write_metric_histogram(Sink* sink, MetricMetadata const* metric_metadata, uint64_t log_timestamp,
+                              std::string_view thread_id, std::string_view thread_name,
+                              std::string_view logger_name, MetricHistogramData const& histogram)
+  {
+    size_t const record_size = sizeof(RecordHeader) + _encoded_size(thread_id) + _encoded_size(thread_name) +
+      _encoded_size(logger_name) + metric_histogram_encoded_size(histogram.bucket_bounds_count);
+
+    if (QUILL_UNLIKELY(record_size > _queue.capacity()))
+    {
+      wait_until_idle();
+      _process_metric_histogram(sink, metric_metadata, log_timestamp, thread_id, thread_name,
+                                logger_name, histogram);
+      return;
+    }
+
+    std::byte* write_pos = _prepare_write(record_size);
+
+    RecordHeader const header{log_timestamp,
+                              sink,
+                              metric_metadata,
+                              0.0,
+                              static_cast<uint32_t>(record_size),
+                              RecordType::MetricHistogram,
+                              metric_metadata->log_level(),
+                              metric_metadata->log_level(),
+                              metric_metadata->event(),
+                              false};
+
+    std::memcpy(write_pos, &header, sizeof(RecordHeader));
+    write_pos += sizeof(RecordHeader);
+
+    write_pos = _encode(write_pos, thread_id);
+    write_pos = _encode(write_pos, thread_name);
+    write_pos = _encode(write_pos, logger_name);
+    encode_metric_histogram(write_pos, metric_metadata, histogram);
+
+    _commit_write(record_size);
+  }
+
+  /**
+   * Writes a metric snapshot aggregated by the backend on the calling thread. The snapshot
+   * references the histogram of the aggregator, so it is not copied to the queue. The caller
+   * waits with wait_until_idle() once before a pass of snapshots
+   */
+  void write_metric_snapshot(Sink* sink, MetricMetadata const* metric_metadata, uint64_t log_timestamp,
+                             std::string_view logger_name, MetricSnapshot const& snapshot)
+  {
+    QUILL_ASSERT(is_idle(), "The sink worker must be idle in SinkWorker::write_metric_snapshot()");
+
+    QUILL_TRY { sink->write_metric_snapshot(metric_metadata, log_timestamp, _process_id, logger_name, snapshot); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH(std::exception const& e) { _notify_error(e.what()); }
+    QUILL_CATCH_ALL() { _notify_error(std::string{"Caught unhandled exception."}); }
+#endif
+  }
+
+  /**
+   * Queues a flush of the sink, optionally followed by its periodic tasks. Use wait_until_idle()
+   * to wait for the flush to complete.
+   */
+  void flush_sink(Sink* sink, bool flush, bool run_periodic_tasks)
+  {
+    std::byte* write_pos = _prepare_write(sizeof(RecordHeader));
+
+    RecordHeader const header{0,
+                              sink,
+                              nullptr,
+                              0.0,
+                              static_cast<uint32_t>(sizeof(RecordHeader)),
+                              flush ? RecordType::Flush : RecordType::RunPeriodicTasks,
+                              LogLevel::None,
+                              LogLevel::None,
+                              MacroMetadata::Event::Flush,
+                              run_periodic_tasks};
+
+    std::memcpy(write_pos, &header, sizeof(RecordHeader));
+    _commit_write(sizeof(RecordHeader));
+  }
+
+private:
+  enum class RecordType : uint8_t
+  {
+    Log,
+    Metric,
+    MetricHistogram,
+    Flush,
+    RunPeriodicTasks
+  };
+
+  struct RecordHeader
+  {
+    uint64_t timestamp;
+    Sink* sink;
+    void const* metadata; /* nullptr when the log metadata is copied into the record */
+    double metric_value;
+    uint32_t size;
+    RecordType type;
+    LogLevel log_level;
+    LogLevel metadata_log_level;
+    MacroMetadata::Event event;
+    bool flag; /* has named args for Log records, run periodic tasks for Flush records */
+  };
+
+  /** Storage for a copied MacroMetadata, the metadata points into the strings **/
+  struct MetadataCopy
+  {
+    std::string source_location;
+    std::string caller_function;
+    std::string message_format;
+    std::string tags;
+    MacroMetadata metadata;
+  };
+
+  /***/
+  QUILL_NODISCARD static std::string_view _tags(MacroMetadata const* metadata) noexcept
+  {
+    return metadata->tags() ? std::string_view{metadata->tags()} : std::string_view{};
+  }
+
+  /***/
+  QUILL_NODISCARD static size_t _encoded_size(std::string_view str) noexcept
+  {
+    return sizeof(uint32_t) + str.size();
+  }
+
+  /***/
+  static std::byte* _encode(std::byte* write_pos, std::string_view str) noexcept
+  {
+    auto const length = static_cast<uint32_t>(str.size());
+    std::memcpy(write_pos, &length, sizeof(uint32_t));
+    write_pos += sizeof(uint32_t);
+
+    if (length != 0)
+    {
+      std::memcpy(write_pos, str.data(), length);
+    }
+
+    return write_pos + length;
+  }
+
+  /***/
+  QUILL_NODISCARD static std::string_view _decode(std::byte const*& read_pos) noexcept
+  {
+    uint32_t length;
+    std::memcpy(&length, read_pos, sizeof(uint32_t));
+    read_pos += sizeof(uint32_t);
+
+    std::string_view const str{reinterpret_cast<char const*>(read_pos), length};
+    read_pos += length;
+    return str;
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT std::byte* _prepare_write(size_t record_size) noexcept
+  {
+    std::byte* write_pos = _queue.prepare_write(record_size);
+
+    while (QUILL_UNLIKELY(!write_pos))
+    {
+      // The worker is behind, wait for it to free up space
+      _wake_up();
+      yield_thread();
+      write_pos = _queue.prepare_write(record_size);
+    }
+
+    return write_pos;
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT void _commit_write(size_t record_size) noexcept
+  {
+    _queue.finish_and_commit_write(record_size);
+    ++_written_records;
+
+    // Pairs with the fence in _wait_for_records() so either the worker sees the new record or we
+    // see it going to sleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_is_sleeping.load(std::memory_order_relaxed))
+    {
+      _wake_up();
+    }
+  }
+
+  /***/
+  void _wake_up()
+  {
+    {
+      std::lock_guard<std::mutex> const lock{_wake_up_mutex};
+      _wake_up_flag = true;
+    }
+
+    _wake_up_cv.notify_one();
+  }
+
+  /**
+   * Worker thread main function
+   */
+  QUILL_ATTRIBUTE_COLD void _run()
+  {
+    LoggerBase::set_current_thread_is_backend_thread(true);
+
+    QUILL_TRY
+    {
+      if (!_options.cpu_affinity.empty())
+      {
+        set_cpu_affinity(_options.cpu_affinity);
+      }
+
+      set_thread_name(_options.thread_name.data());
+    }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    // The worker continues running without the affinity or the thread name
+    QUILL_CATCH(std::exception const& e) { _notify_error(std::string{"Quill WARNING: "} + e.what()); }
+    QUILL_CATCH_ALL() { _notify_error(std::string{"Quill WARNING: Caught unhandled exception."}); }
+#endif
+
+    while (true)
+    {
+      std::byte const* read_pos = _queue.prepare_read();
+
+      if (read_pos)
+      {
+        uint32_t const record_size = _process_record(read_pos);
+        _queue.finish_read(record_size);
+        _queue.commit_read();
+        _processed_records.fetch_add(1, std::memory_order_release);
+        continue;
+      }
+
+      if (!_is_running.load(std::memory_order_acquire))
+      {
+        // stop() is called after the final records are written, drain them before exiting
+        if (_queue.empty())
+        {
+          break;
+        }
+
+        continue;
+      }
+
+      _wait_for_records();
+    }
+
+    LoggerBase::set_current_thread_is_backend_thread(false);
+  }
+
+  /***/
+  void _wait_for_records()
+  {
+    if (_sleep_duration.count() == 0)
+    {
+      yield_thread();
+      return;
+    }
+
+    _is_sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_queue.empty() && _is_running.load(std::memory_order_acquire))
+    {
+      std::unique_lock<std::mutex> lock{_wake_up_mutex};
+      _wake_up_cv.wait_for(lock, _sleep_duration, [this] { return _wake_up_flag; });
+      _wake_up_flag = false;
+    }
+
+    _is_sleeping.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * Replays a single record
+   * @return the size of the record
+   */
+  QUILL_ATTRIBUTE_HOT uint32_t _process_record(std::byte const* read_pos)
+  {
+    RecordHeader header;
+    std::memcpy(&header, read_pos, sizeof(RecordHeader));
+    read_pos += sizeof(RecordHeader);
+
+    if (header.type == RecordType::Log)
+    {
+      std::string_view const thread_id = _decode(read_pos);
+      std::string_view const thread_name = _decode(read_pos);
+      std::string_view const logger_name = _decode(read_pos);
+      std::string_view const log_level_description = _decode(read_pos);
+      std::string_view const log_level_short_code = _decode(read_pos);
+      std::string_view const log_message = _decode(read_pos);
+      std::string_view const log_statement = _decode(read_pos);
+
+      if (header.flag)
+      {
+        uint32_t named_args_count;
+        std::memcpy(&named_args_count, read_pos, sizeof(uint32_t));
+        read_pos += sizeof(uint32_t);
+
+        _named_args.resize(named_args_count);
+
+        for (auto& [key, value] : _named_args)
+        {
+          key.assign(_decode(read_pos));
+          value.assign(_decode(read_pos));
+        }
+      }
+
+      auto const* log_metadata = static_cast<MacroMetadata const*>(header.metadata);
+
+      if (!log_metadata)
+      {
+        _metadata_copy.source_location.assign(_decode(read_pos));
+        _metadata_copy.caller_function.assign(_decode(read_pos));
+        _metadata_copy.message_format.assign(_decode(read_pos));
+        _metadata_copy.tags.assign(_decode(read_pos));
+
+        _metadata_copy.metadata = MacroMetadata{
+          _metadata_copy.source_location.data(), _metadata_copy.caller_function.data(),
+          _metadata_copy.message_format.data(),
+          _metadata_copy.tags.empty() ? nullptr : _metadata_copy.tags.data(),
+          header.metadata_log_level, header.event, true};
+
+        log_metadata = &_metadata_copy.metadata;
+      }
+
+      _process_log(header.sink, log_metadata, header.timestamp, thread_id, thread_name, logger_name,
+                   header.log_level, log_level_description, log_level_short_code,
+                   header.flag ? &_named_args : nullptr, log_message, log_statement);
+    }
+    else if (header.type == RecordType::Metric)
+    {
+      std::string_view const thread_id = _decode(read_pos);
+      std::string_view const thread_name = _decode(read_pos);
+      std::string_view const logger_name = _decode(read_pos);
+
+      _process_metric(header.sink, static_cast<MetricMetadata const*>(header.metadata),
+                      header.timestamp, thread_id, thread_name, logger_name, header.metric_value);
+    }
+    else if (header.type == RecordType::MetricHistogram)
+    {
+      std::string_view const thread_id = _decode(read_pos);
+      std::string_view const thread_name = _decode(read_pos);
+      std::string_view const logger_name = _decode(read_pos);
+
+      MetricHistogramData histogram;
+      MetricMetadata const* metric_metadata =
+        decode_metric_histogram(read_pos, histogram, _histogram_bucket_bounds, _histogram_bucket_counts);
+
+      _process_metric_histogram(header.sink, metric_metadata, header.timestamp, thread_id,
+                                thread_name, logger_name, histogram);
+    }
+    else
+    {
+      _process_flush(header.sink, header.type == RecordType::Flush, header.flag);
+    }
+
+    return header.size;
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT void _process_log(Sink* sink, MacroMetadata const* log_metadata, uint64_t log_timestamp,
+                                        std::string_view thread_id, std::string_view thread_name,
+                                        std::string_view logger_name, LogLevel log_level,
+                                        std::string_view log_level_description,
+                                        std::string_view log_level_short_code,
+                                        std::vector<std::pair<std::string, std::string>> const* named_args,
+                                        std::string_view log_message, std::string_view log_statement)
+  {
+    QUILL_TRY
+    {
+      if (sink->apply_all_filters(log_metadata, log_timestamp, thread_id, thread_name, logger_name,
+                                  log_level, log_message, log_statement))
+      {
+        sink->write_log(log_metadata, log_timestamp, thread_id, thread_name, _process_id, logger_name,
+                        log_level, log_level_description, log_level_short_code, named_args,
+                        log_message, log_statement);
+      }
+    }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH(std::exception const& e) { _notify_error(e.what()); }
+    QUILL_CATCH_ALL() { _notify_error(std::string{"Caught unhandled exception."}); }
+#endif
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT void _process_metric(Sink* sink, MetricMetadata const* metric_metadata,
+                                           uint64_t log_timestamp, std::string_view thread_id,
+                                           std::string_view thread_name,
+                                           std::string_view logger_name, double value)
+  {
+    QUILL_TRY
+    {
+      sink->write_metric(metric_metadata, log_timestamp, thread_id, thread_name, _process_id,
+                         logger_name, value);
+    }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH(std::exception const& e) { _notify_error(e.what()); }
+    QUILL_CATCH_ALL() { _notify_error(std::string{"Caught unhandled exception."}); }
+#endif
+  }
+
+  /***/
+  void _process_metric_histogram(Sink* sink, MetricMetadata const* metric_metadata, uint64_t log_timestamp,
+                                 std::string_view thread_id, std::string_view thread_name,
+                                 std::string_view logger_name, MetricHistogramData const& histogram)
+  {
+    QUILL_TRY
+    {
+      sink->write_metric_histogram(metric_metadata, log_timestamp, thread_id, thread_name,
+                                   _process_id, logger_name, histogram);
+    }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH(std::exception const& e) { _notify_error(e.what()); }
+    QUILL_CATCH_ALL() { _notify_error(std::string{"Caught unhandled exception."}); }
+#endif
+  }
+
+  /***/
+  void _process_flush(Sink* sink, bool flush, bool run_periodic_tasks)
+  {
+    if (flush)
+    {
+      QUILL_TRY { sink->flush_sink(); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH(std::exception const& e) { _notify_error(e.what()); }
+      QUILL_CATCH_ALL() { _notify_error(std::string{"Caught unhandled exception."}); }
+#endif
+    }
+
+    if (run_periodic_tasks)
+    {
+      QUILL_TRY { sink->run_periodic_tasks(); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH(std::exception const& e) { _notify_error(e.what()); }
+      QUILL_CATCH_ALL() { _notify_error(std::string{"Caught unhandled exception."}); }
+#endif
+    }
+  }
+
+  /***/
+  void _notify_error(std::string const& message) const
+  {
+    if (static_cast<bool>(_error_notifier))
+    {
+      QUILL_TRY { _error_notifier(message); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH_ALL()
+      {
+        // Swallow exceptions from the user-provided error_notifier
+      }
+#endif
+    }
+  }
+
+private:
+  SinkWorkerOptions _options;
+  BoundedSPSCQueue _queue;
+  std::function<void(std::string const&)> _error_notifier;
+  std::string _process_id;
+  std::chrono::nanoseconds _sleep_duration;
+  std::thread _thread;
+
+  /** Accessed by the backend thread only **/
+  std::vector<std::shared_ptr<Sink>> _sinks;
+  size_t _written_records{0};
+
+  /** Accessed by the worker thread only **/
+  std::vector<std::pair<std::string, std::string>> _named_args;
+  MetadataCopy _metadata_copy;
+  std::vector<double> _histogram_bucket_bounds;
+  std::vector<uint64_t> _histogram_bucket_counts;
+
+  alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<size_t> _processed_records{0};
+  alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<bool> _is_sleeping{false};
+  std::atomic<bool> _is_running{false};
+  std::mutex _wake_up_mutex;
+  std::condition_variable _wake_up_cv;
+  bool _wake_up_flag{false};
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
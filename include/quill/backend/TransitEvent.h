@@ -29,11 +29,19 @@ namespace detail
 {
 /** Forward declaration */
 class LoggerBase;
+struct ThreadIdentity;
 
 /***/
 struct TransitEvent
 {
-  using FormatBuffer = fmtquill::basic_memory_buffer<char, 88>;
+  /**
+   * The formatted message is stored inline in the event, so the events of a TransitEventBuffer
+   * are contiguous in memory and reusing a slot does not allocate. The inline size makes a
+   * TransitEvent 256 bytes on 64-bit platforms, longer messages allocate on the heap.
+   */
+  using FormatBuffer = fmtquill::basic_memory_buffer<char, 144>;
+
+  static constexpr size_t max_prefiltered_sinks{64};
 
   /***/
   TransitEvent() = default;
@@ -52,6 +60,9 @@ struct TransitEvent
     : timestamp(other.timestamp),
       macro_metadata(other.macro_metadata),
       logger_base(other.logger_base),
+      thread_identity(other.thread_identity),
+      accepted_sinks(other.accepted_sinks),
+      sinks_prefiltered(other.sinks_prefiltered),
       formatted_msg(std::move(other.formatted_msg)),
       extra_data(std::move(other.extra_data)),
       event_payload(std::move(other.event_payload))
@@ -74,6 +85,9 @@ struct TransitEvent
       timestamp = other.timestamp;
       macro_metadata = other.macro_metadata;
       logger_base = other.logger_base;
+      thread_identity = other.thread_identity;
+      accepted_sinks = other.accepted_sinks;
+      sinks_prefiltered = other.sinks_prefiltered;
       formatted_msg = std::move(other.formatted_msg);
       extra_data = std::move(other.extra_data);
       event_payload = std::move(other.event_payload);
@@ -95,16 +109,26 @@ struct TransitEvent
     other.timestamp = timestamp;
     other.macro_metadata = macro_metadata;
     other.logger_base = logger_base;
+    other.thread_identity = thread_identity;
+    other.accepted_sinks = accepted_sinks;
+    other.sinks_prefiltered = sinks_prefiltered;
     other.event_payload = event_payload;
 
     // manually copy the fmt::buffer
-    other.formatted_msg->clear();
-    other.formatted_msg->reserve(formatted_msg->size());
-    other.formatted_msg->append(*formatted_msg);
+    other.formatted_msg.clear();
+    other.formatted_msg.append(formatted_msg);
 
     if (extra_data)
     {
-      other.extra_data = std::make_unique<ExtraData>(*extra_data);
+      if (other.extra_data)
+      {
+        // Reuse the allocations of the other event
+        *other.extra_data = *extra_data;
+      }
+      else
+      {
+        other.extra_data = std::make_unique<ExtraData>(*extra_data);
+      }
 
       if (other.extra_data->runtime_metadata.has_runtime_metadata)
       {
@@ -112,6 +136,12 @@ struct TransitEvent
         other.macro_metadata = &other.extra_data->runtime_metadata.macro_metadata;
       }
     }
+    else if (other.extra_data)
+    {
+      other.extra_data->named_args.clear();
+      other.extra_data->mdc.clear();
+      other.extra_data->runtime_metadata.has_runtime_metadata = false;
+    }
   }
 
   /***/
@@ -181,6 +211,41 @@ struct TransitEvent
     return std::get<double>(event_payload);
   }
 
+  /**
+   * Marks formatted_msg as holding the encoded arguments of a backtrace log statement, which are
+   * decoded with decoder and formatted only when the backtrace is flushed
+   */
+  QUILL_ATTRIBUTE_HOT void set_backtrace_decoder(FormatArgsDecoder decoder) noexcept
+  {
+    event_payload = decoder;
+  }
+
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool has_backtrace_decoder() const noexcept
+  {
+    return std::holds_alternative<FormatArgsDecoder>(event_payload);
+  }
+
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT FormatArgsDecoder backtrace_decoder() const noexcept
+  {
+    QUILL_ASSERT(has_backtrace_decoder(),
+                 "Attempted to read a backtrace decoder from a TransitEvent without one");
+    return std::get<FormatArgsDecoder>(event_payload);
+  }
+
+  /**
+   * Marks formatted_msg as holding the arguments serialized with serialize_format_args() instead
+   * of the formatted message, for sinks that format the message outside of the backend
+   */
+  QUILL_ATTRIBUTE_HOT void set_serialized_format_args() noexcept
+  {
+    event_payload = SerializedFormatArgs{};
+  }
+
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool has_serialized_format_args() const noexcept
+  {
+    return std::holds_alternative<SerializedFormatArgs>(event_payload);
+  }
+
   struct RuntimeMetadata
   {
     RuntimeMetadata() = default;
@@ -192,7 +257,7 @@ struct TransitEvent
         function_name(_safe_string(function)),
         tags(_safe_string(in_tags)),
         macro_metadata(source_location.data(), function_name.data(), fmt.data(),
-                       tags.empty() ? nullptr : tags.data(), log_level, MacroMetadata::Event::Log),
+                       tags.empty() ? nullptr : tags.data(), log_level, MacroMetadata::Event::Log, true),
         has_runtime_metadata(true)
     {
     }
@@ -204,7 +269,7 @@ struct TransitEvent
         tags(other.tags),
         macro_metadata(source_location.data(), function_name.data(), fmt.data(),
                        tags.empty() ? nullptr : tags.data(), other.macro_metadata.log_level(),
-                       MacroMetadata::Event::Log),
+                       MacroMetadata::Event::Log, true),
         has_runtime_metadata(other.has_runtime_metadata)
     {
       // Recreate macro_metadata to point to our own strings
@@ -223,7 +288,7 @@ struct TransitEvent
         // Recreate macro_metadata to point to our own strings
         macro_metadata = MacroMetadata(source_location.data(), function_name.data(), fmt.data(),
                                        tags.empty() ? nullptr : tags.data(),
-                                       other.macro_metadata.log_level(), MacroMetadata::Event::Log);
+                                       other.macro_metadata.log_level(), MacroMetadata::Event::Log, true);
       }
       return *this;
     }
@@ -266,6 +331,11 @@ struct TransitEvent
     }
   };
 
+  /** Tag stored in event_payload by set_serialized_format_args() **/
+  struct SerializedFormatArgs
+  {
+  };
+
   struct ExtraData
   {
     // Additional fields that are used for some features as a separate structure to keep
@@ -278,10 +348,13 @@ struct TransitEvent
   uint64_t timestamp{0};
   MacroMetadata const* macro_metadata{nullptr};
   LoggerBase* logger_base{nullptr};
-  std::unique_ptr<FormatBuffer> formatted_msg{std::make_unique<FormatBuffer>()}; /** buffer for message **/
+  ThreadIdentity const* thread_identity{nullptr}; /** Set only for events read from a shared queue **/
+  uint64_t accepted_sinks{0}; /** Bit i is set when the i-th sink passed its pre-format filters **/
+  bool sinks_prefiltered{false}; /** accepted_sinks is valid for the first max_prefiltered_sinks sinks **/
+  FormatBuffer formatted_msg; /** buffer for message, only messages longer than the inline storage allocate **/
   std::unique_ptr<ExtraData> extra_data; /** A unique ptr to save space as these fields not always used */
-  std::variant<std::monostate, std::atomic<bool>*, double> event_payload{
-    std::monostate{}}; /** This is only used in the case of Event::Flush or Event::Metric **/
+  std::variant<std::monostate, std::atomic<bool>*, double, FormatArgsDecoder, SerializedFormatArgs> event_payload{
+    std::monostate{}}; /** Used by Event::Flush, Event::Metric, stored backtrace statements and serialized arguments **/
 };
 } // namespace detail
 
@@ -9,6 +9,7 @@
 #include "quill/backend/TransitEvent.h"
 #include "quill/bundled/fmt/format.h" // for assert_fail
 #include "quill/core/Attributes.h"
+#include "quill/core/Common.h"
 #include "quill/core/MathUtilities.h"
 #include "quill/core/QuillError.h"
 
@@ -92,6 +93,16 @@ public:
 
   QUILL_ATTRIBUTE_HOT void push_back() noexcept { ++_writer_pos; }
 
+  /**
+   * Returns the event at index positions after the front. Unlike a pointer to the event, the
+   * index stays valid when the buffer expands as long as no event is popped
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT TransitEvent* at(size_t index) noexcept
+  {
+    QUILL_ASSERT(index <= size(), "index is out of range in TransitEventBuffer::at()");
+    return &_storage[(_reader_pos + index) & _mask];
+  }
+
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT size_t size() const noexcept
   {
     return _writer_pos - _reader_pos;
@@ -133,10 +144,10 @@ private:
     new_storage.reserve(new_capacity);
 
     // Move-construct the existing elements into the new storage instead of default-constructing
-    // every slot and move-assigning over it; each default-constructed TransitEvent heap-allocates
-    // a FormatBuffer that the move-assignment would immediately destroy. Since the buffer is
-    // full, this moves all the previous TransitEvents, preserving their order. The reader
-    // position and mask are used to handle the circular buffer's wraparound.
+    // every slot and move-assigning over it. Since the buffer is full, this moves all the previous
+    // TransitEvents, preserving their order. The reader position and mask are used to handle the
+    // circular buffer's wraparound. Moving an event copies its formatted message when it is
+    // stored inline, so any pointer to an event or its message is invalidated.
     for (size_t i = 0; i < current_size; ++i)
     {
       new_storage.emplace_back(std::move(_storage[(_reader_pos + i) & _mask]));
@@ -0,0 +1,152 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+/**
+ * Min-heap used by the backend to merge the per-thread transit event buffers in timestamp order.
+ *
+ * Each entry is a transit event buffer owner keyed on the timestamp of the event at the front of
+ * its buffer. An owner is pushed when its buffer becomes non-empty and stays in the heap until its
+ * buffer is drained, so finding the next event to process costs O(log n) instead of scanning every
+ * thread context.
+ *
+ * Entries with equal timestamps are popped in the order they were pushed.
+ */
+template <typename TValue>
+class TransitEventHeap
+{
+public:
+  /***/
+  QUILL_NODISCARD bool empty() const noexcept { return _entries.empty(); }
+
+  /***/
+  QUILL_NODISCARD size_t size() const noexcept { return _entries.size(); }
+
+  /***/
+  QUILL_NODISCARD TValue top() const noexcept { return _entries.front().value; }
+
+  /***/
+  QUILL_NODISCARD uint64_t top_timestamp() const noexcept { return _entries.front().timestamp; }
+
+  /***/
+  void push(uint64_t timestamp, TValue value)
+  {
+    _entries.push_back(Entry{timestamp, _sequence++, value});
+    _sift_up(_entries.size() - 1);
+  }
+
+  /***/
+  void pop() noexcept
+  {
+    _entries.front() = _entries.back();
+    _entries.pop_back();
+
+    if (!_entries.empty())
+    {
+      _sift_down(0);
+    }
+  }
+
+  /**
+   * Equivalent to pop() followed by push() but with a single sift, used when the owner of the top
+   * entry still has events after processing its front event
+   */
+  void replace_top(uint64_t timestamp, TValue value) noexcept
+  {
+    _entries.front() = Entry{timestamp, _sequence++, value};
+    _sift_down(0);
+  }
+
+  /***/
+  void reserve(size_t capacity) { _entries.reserve(capacity); }
+
+private:
+  struct Entry
+  {
+    uint64_t timestamp;
+    uint64_t sequence;
+    TValue value;
+  };
+
+  /***/
+  QUILL_NODISCARD static bool _less(Entry const& lhs, Entry const& rhs) noexcept
+  {
+    return (lhs.timestamp < rhs.timestamp) ||
+      ((lhs.timestamp == rhs.timestamp) && (lhs.sequence < rhs.sequence));
+  }
+
+  /***/
+  void _sift_up(size_t index) noexcept
+  {
+    Entry const entry = _entries[index];
+
+    while (index > 0)
+    {
+      size_t const parent = (index - 1) / 2;
+
+      if (!_less(entry, _entries[parent]))
+      {
+        break;
+      }
+
+      _entries[index] = _entries[parent];
+      index = parent;
+    }
+
+    _entries[index] = entry;
+  }
+
+  /***/
+  void _sift_down(size_t index) noexcept
+  {
+    Entry const entry = _entries[index];
+    size_t const count = _entries.size();
+
+    while (true)
+    {
+      size_t child = 2 * index + 1;
+
+      if (child >= count)
+      {
+        break;
+      }
+
+      if ((child + 1 < count) && _less(_entries[child + 1], _entries[child]))
+      {
+        ++child;
+      }
+
+      if (!_less(_entries[child], entry))
+      {
+        break;
+      }
+
+      _entries[index] = _entries[child];
+      index = child;
+    }
+
+    _entries[index] = entry;
+  }
+
+private:
+  std::vector<Entry> _entries;
+  uint64_t _sequence{0};
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
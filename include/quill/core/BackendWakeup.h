@@ -0,0 +1,219 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Futex.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if !defined(QUILL_HAS_FUTEX)
+  #include <condition_variable>
+  #include <mutex>
+#endif
+
+#if defined(__linux__) && defined(SYS_membarrier)
+  #define QUILL_HAS_MEMBARRIER 1
+#endif
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * The word the idle backend thread parks on.
+ *
+ * The backend calls prepare_park(), checks the frontend queues one last time and then park().
+ * notify() is lock free and makes the system call only when the backend is parked. A notify()
+ * that arrives while the backend is awake is remembered and makes the next prepare_park() fail.
+ *
+ * When the frontend wake up is enabled, the backend also sets a flag in every thread context
+ * before it parks and the frontend threads call notify() when they find it set. The frontend
+ * threads do not pay for a fence after each message, the backend issues a process wide barrier
+ * with membarrier() before it parks instead. Where membarrier() is not available the flag also
+ * asks the frontend threads for a fence.
+ *
+ * On Linux the backend parks on a futex, other platforms fall back to a condition variable.
+ */
+class BackendWakeup
+{
+public:
+  /***/
+  QUILL_EXPORT static BackendWakeup& instance() noexcept
+  {
+    static BackendWakeup instance;
+    return instance;
+  }
+
+  /***/
+  BackendWakeup(BackendWakeup const&) = delete;
+  BackendWakeup& operator=(BackendWakeup const&) = delete;
+
+  /**
+   * Enabled by the backend when the frontend threads wake it up as soon as they log
+   */
+  void set_frontend_wake_up_enabled(bool enabled) noexcept
+  {
+    if (enabled && !_process_barrier_registered.load(std::memory_order_relaxed))
+    {
+      _process_barrier_registered.store(_register_process_barrier(), std::memory_order_relaxed);
+    }
+
+    _frontend_wake_up_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  /***/
+  QUILL_NODISCARD bool is_frontend_wake_up_enabled() const noexcept
+  {
+    return _frontend_wake_up_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @param parked whether the backend is parked
+   * @return the value of ThreadContext::backend_wake_up_state(), 0 when the frontend wake up is
+   * disabled
+   */
+  QUILL_NODISCARD uint8_t thread_context_wake_up_state(bool parked) const noexcept
+  {
+    if (!is_frontend_wake_up_enabled())
+    {
+      return 0;
+    }
+
+    return static_cast<uint8_t>((parked ? ContextParked : 0u) |
+                                (_process_barrier_registered.load(std::memory_order_relaxed)
+                                   ? 0u
+                                   : ContextFenceRequired));
+  }
+
+  /**
+   * Called by the backend between setting the flags of the thread contexts and the last check of
+   * the queues before it parks. Pairs with the compiler fence of the frontend threads after their
+   * queue commit: either the frontend thread sees the flag or the backend sees the message.
+   */
+  void process_barrier() noexcept
+  {
+#if defined(QUILL_HAS_MEMBARRIER)
+    if (_process_barrier_registered.load(std::memory_order_relaxed))
+    {
+      ::syscall(SYS_membarrier, MembarrierCmdPrivateExpedited, 0);
+    }
+#endif
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /**
+   * Thread safe to be called from any thread
+   */
+  QUILL_ATTRIBUTE_COLD QUILL_NOINLINE void notify() noexcept
+  {
+    if (_state.exchange(Notified, std::memory_order_seq_cst) != Parked)
+    {
+      // The backend is awake, it sees the notification before it parks again
+      return;
+    }
+
+#if defined(QUILL_HAS_FUTEX)
+    futex_wake(_state, 1);
+#elif defined(__MINGW32__)
+    // MinGW can deadlock if the mutex is released before cv.notify_one(),
+    // so keep notify_one() inside the lock for MinGW
+    std::lock_guard<std::mutex> const lock{_mutex};
+    _cv.notify_one();
+#else
+    {
+      // Synchronise with the backend between checking the state and waiting on the cv
+      std::lock_guard<std::mutex> const lock{_mutex};
+    }
+
+    _cv.notify_one();
+#endif
+  }
+
+  /**
+   * Announces that the backend is about to park. Must be followed by park() or finish_park().
+   * @return false when a notification arrived since the last park, the backend must not park
+   */
+  QUILL_NODISCARD bool prepare_park() noexcept
+  {
+    uint32_t expected{Awake};
+
+    if (!_state.compare_exchange_strong(expected, Parked, std::memory_order_seq_cst))
+    {
+      // Consume the notification
+      _state.store(Awake, std::memory_order_relaxed);
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Blocks until notify() is called or the timeout expires.
+   */
+  void park(std::chrono::nanoseconds timeout) noexcept
+  {
+#if defined(QUILL_HAS_FUTEX)
+    futex_wait(_state, Parked, static_cast<uint64_t>(timeout.count()));
+#else
+    std::unique_lock<std::mutex> lock{_mutex};
+    _cv.wait_for(lock, timeout,
+                 [this] { return _state.load(std::memory_order_relaxed) != Parked; });
+#endif
+
+    finish_park();
+  }
+
+  /**
+   * Marks the backend awake after park(), or when it decided not to park after prepare_park()
+   */
+  void finish_park() noexcept { _state.store(Awake, std::memory_order_relaxed); }
+
+  /** Bits of ThreadContext::backend_wake_up_state() */
+  static constexpr uint8_t ContextParked{1};
+  static constexpr uint8_t ContextFenceRequired{2};
+
+private:
+  BackendWakeup() = default;
+  ~BackendWakeup() = default;
+
+  /***/
+  QUILL_NODISCARD static bool _register_process_barrier() noexcept
+  {
+#if defined(QUILL_HAS_MEMBARRIER)
+    return ::syscall(SYS_membarrier, MembarrierCmdRegisterPrivateExpedited, 0) == 0;
+#else
+    return false;
+#endif
+  }
+
+private:
+#if defined(QUILL_HAS_MEMBARRIER)
+  // From <linux/membarrier.h>, not included as older kernel headers lack them
+  static constexpr int MembarrierCmdPrivateExpedited{1 << 3};
+  static constexpr int MembarrierCmdRegisterPrivateExpedited{1 << 4};
+#endif
+
+  static constexpr uint32_t Awake{0};
+  static constexpr uint32_t Parked{1};
+  static constexpr uint32_t Notified{2};
+
+  std::atomic<uint32_t> _state{Awake};
+  std::atomic<bool> _frontend_wake_up_enabled{false};
+  std::atomic<bool> _process_barrier_registered{false}; /**< membarrier() can be used */
+
+#if !defined(QUILL_HAS_FUTEX)
+  std::mutex _mutex;
+  std::condition_variable _cv;
+#endif
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
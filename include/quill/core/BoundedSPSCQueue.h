@@ -4,6 +4,7 @@
 #include "quill/core/Common.h"
 #include "quill/core/MathUtilities.h"
 #include "quill/core/QuillError.h"
+#include "quill/core/Futex.h"
 
 #include <atomic>
 #include <cerrno>
@@ -76,16 +77,22 @@ public:
     BoundedSPSCQueueImpl* bounded_queue{nullptr};
   };
 
+  /**
+   * @param producer_futex_wait enables wait_for_space(). Only then does commit_read() pay for
+   * the seq_cst handshake with a waiting producer, see FrontendOptions::blocking_queue_futex_wait
+   */
   QUILL_ATTRIBUTE_HOT explicit BoundedSPSCQueueImpl(integer_type capacity,
                                                     HugePagesPolicy huge_pages_policy = HugePagesPolicy::Never,
-                                                    integer_type reader_store_percent = 5)
+                                                    integer_type reader_store_percent = 5,
+                                                    bool producer_futex_wait = false)
     : _capacity(_validate_capacity(capacity)),
       _mask(_capacity - 1),
       _bytes_per_batch(static_cast<integer_type>(
         (static_cast<double>(_capacity) * static_cast<double>(reader_store_percent)) / 100.0)),
       _storage(static_cast<std::byte*>(_alloc_aligned(
         2u * static_cast<size_t>(_capacity), QUILL_CACHE_LINE_ALIGNED, huge_pages_policy))),
-      _huge_pages_policy(huge_pages_policy)
+      _huge_pages_policy(huge_pages_policy),
+      _producer_futex_wait(producer_futex_wait)
   {
     size_t const storage_size = 2u * static_cast<size_t>(_capacity);
     std::memset(_storage, 0, storage_size);
@@ -216,7 +223,22 @@ public:
     if ((static_cast<integer_type>(_reader_pos - _atomic_reader_pos.load(std::memory_order_relaxed)) >= _bytes_per_batch) ||
         (_writer_pos_cache == _reader_pos))
     {
-      _atomic_reader_pos.store(_reader_pos, std::memory_order_release);
+#if defined(QUILL_HAS_FUTEX)
+      if (_producer_futex_wait)
+      {
+        // seq_cst orders the publish before the load of _producer_waiting, see wait_for_space()
+        _atomic_reader_pos.exchange(_reader_pos, std::memory_order_seq_cst);
+
+        if (QUILL_UNLIKELY(_producer_waiting.load(std::memory_order_seq_cst) != 0))
+        {
+          _wake_up_producer();
+        }
+      }
+      else
+#endif
+      {
+        _atomic_reader_pos.store(_reader_pos, std::memory_order_release);
+      }
 
 #if defined(QUILL_X86ARCH)
       _flush_cachelines(_last_flushed_reader_pos, _reader_pos);
@@ -224,6 +246,34 @@ public:
     }
   }
 
+#if defined(QUILL_HAS_FUTEX)
+  /**
+   * Blocks the producer until the reader frees space for n bytes or the timeout expires. Spurious
+   * wake ups are possible, the caller retries prepare_write() afterwards.
+   * @param n the bytes the writer needs
+   * @param timeout_ns the longest wait, so the writer still retries when the reader stops
+   * reading or a wake up is missed. Must not be 0
+   * @note Only meant to be called by the writer, when prepare_write(n) failed, on a queue
+   * constructed with producer_futex_wait
+   */
+  QUILL_ATTRIBUTE_COLD void wait_for_space(integer_type n, uint64_t timeout_ns) noexcept
+  {
+    QUILL_ASSERT(timeout_ns != 0, "wait_for_space() requires a timeout");
+    QUILL_ASSERT(_producer_futex_wait,
+                 "wait_for_space() requires a queue constructed with producer_futex_wait");
+
+    _producer_waiting.store(1, std::memory_order_seq_cst);
+
+    // Check again after registering, the reader may have freed space before it saw the flag
+    if (static_cast<integer_type>(_atomic_reader_pos.load(std::memory_order_seq_cst) + _capacity - _writer_pos) < n)
+    {
+      futex_wait(_producer_waiting, 1, timeout_ns);
+    }
+
+    _producer_waiting.store(0, std::memory_order_relaxed);
+  }
+#endif
+
   /**
    * Only meant to be called by the reader
    * @return true if the queue is empty
@@ -249,9 +299,46 @@ public:
     return static_cast<integer_type>(_capacity);
   }
 
+  /**
+   * Calls the callback with the address of the bytes written but not yet read. The callback
+   * returns how many bytes it consumed at that address, or 0 to stop.
+   * @note Only meant for diagnostics when the reader is no longer running, e.g. from a signal
+   * handler. The reader position is not synchronised and nothing is marked as read.
+   */
+  template <typename TCallback>
+  void for_each_unread(TCallback&& callback) const noexcept
+  {
+    integer_type const writer_pos = _atomic_writer_pos.load(std::memory_order_acquire);
+    integer_type pos = _reader_pos;
+
+    while (static_cast<integer_type>(writer_pos - pos) != 0)
+    {
+      size_t const consumed =
+        callback(_storage + (pos & _mask), static_cast<size_t>(writer_pos - pos));
+
+      if ((consumed == 0) || (consumed > static_cast<size_t>(writer_pos - pos)))
+      {
+        break;
+      }
+
+      pos += static_cast<integer_type>(consumed);
+    }
+  }
+
   QUILL_NODISCARD HugePagesPolicy huge_pages_policy() const noexcept { return _huge_pages_policy; }
 
+  QUILL_NODISCARD bool producer_futex_wait() const noexcept { return _producer_futex_wait; }
+
 private:
+#if defined(QUILL_HAS_FUTEX)
+  /***/
+  QUILL_ATTRIBUTE_COLD QUILL_NOINLINE void _wake_up_producer() noexcept
+  {
+    _producer_waiting.store(0, std::memory_order_relaxed);
+    futex_wake(_producer_waiting, 1);
+  }
+#endif
+
 #if defined(QUILL_X86ARCH)
   QUILL_ATTRIBUTE_HOT void _flush_cachelines(integer_type& last, integer_type offset)
   {
@@ -452,6 +539,7 @@ private:
   integer_type const _bytes_per_batch;
   std::byte* const _storage{nullptr};
   HugePagesPolicy const _huge_pages_policy;
+  bool const _producer_futex_wait;
 
   alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<integer_type> _atomic_writer_pos{0};
   alignas(QUILL_CACHE_LINE_ALIGNED) integer_type _writer_pos{0};
@@ -459,6 +547,7 @@ private:
   integer_type _last_flushed_writer_pos{0};
 
   alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<integer_type> _atomic_reader_pos{0};
+  std::atomic<uint32_t> _producer_waiting{0}; /**< futex word, set while the writer waits for space */
   alignas(QUILL_CACHE_LINE_ALIGNED) integer_type _reader_pos{0};
   mutable integer_type _writer_pos_cache{0};
   integer_type _last_flushed_reader_pos{0};
@@ -0,0 +1,86 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/MacroMetadata.h"
+#include "quill/core/QuillError.h"
+
+#include <unordered_map>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * Caches data derived from the MacroMetadata of a call site, such as pre-rendered fragments of
+ * the formatted output, keyed by the address of the MacroMetadata.
+ *
+ * The MacroMetadata of a log statement has static storage, so its address identifies the call
+ * site for the lifetime of the process. Runtime metadata is never cached.
+ */
+template <typename TValue>
+class CallSiteCache
+{
+public:
+  /**
+   * Returns the cached value of the call site, build(TValue&) creates it on the first use
+   * @return nullptr for runtime metadata
+   */
+  template <typename TBuild>
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT TValue const* get(MacroMetadata const* macro_metadata, TBuild&& build)
+  {
+    if (QUILL_UNLIKELY(macro_metadata->is_runtime_metadata()))
+    {
+      return nullptr;
+    }
+
+    if (macro_metadata == _last_macro_metadata)
+    {
+      // consecutive log statements from the same call site skip the lookup
+      return _last_value;
+    }
+
+    auto [it, inserted] = _values.try_emplace(macro_metadata);
+
+    if (inserted)
+    {
+      QUILL_TRY { build(it->second); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH_ALL()
+      {
+        _values.erase(it);
+        throw;
+      }
+#endif
+    }
+
+    // the nodes of the map are stable, the pointer stays valid until clear()
+    _last_macro_metadata = macro_metadata;
+    _last_value = &it->second;
+    return _last_value;
+  }
+
+  /***/
+  void clear() noexcept
+  {
+    _values.clear();
+    _last_macro_metadata = nullptr;
+    _last_value = nullptr;
+  }
+
+  /***/
+  QUILL_NODISCARD size_t size() const noexcept { return _values.size(); }
+
+private:
+  std::unordered_map<MacroMetadata const*, TValue> _values;
+  MacroMetadata const* _last_macro_metadata{nullptr};
+  TValue* _last_value{nullptr};
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
@@ -134,6 +134,22 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_HOT inline uint32_t clamp_encoded_string_length(
   constexpr uint32_t max_val = UINT32_MAX - 1u;
   return (len > max_val) ? max_val : static_cast<uint32_t>(len);
 }
+
+/***/
+template <typename Arg>
+QUILL_NODISCARD constexpr size_t default_codec_fixed_encoded_size() noexcept
+{
+  if constexpr (std::disjunction_v<std::is_arithmetic<Arg>, std::is_enum<Arg>,
+                                   std::is_same<Arg, void const*>, std::is_same<Arg, void*>>)
+  {
+    return sizeof(Arg);
+  }
+  else
+  {
+    return 0;
+  }
+}
+
 /** std string detection, ignoring the Allocator type **/
 template <typename T>
 struct is_std_string : std::false_type
@@ -166,6 +182,12 @@ QUILL_BEGIN_EXPORT
 template <typename Arg, typename = void>
 struct Codec
 {
+  /**
+   * Number of bytes this codec encodes when that is known at compile time, otherwise 0.
+   * Only the default codec defines this; a user specialization is always sized at runtime.
+   */
+  static constexpr size_t fixed_encoded_size = detail::default_codec_fixed_encoded_size<Arg>();
+
   /***/
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT static size_t compute_encoded_size(
     QUILL_MAYBE_UNUSED detail::SizeCacheVector& conditional_arg_size_cache, QUILL_MAYBE_UNUSED Arg const& arg) noexcept
@@ -358,6 +380,33 @@ struct Codec
 
 namespace detail
 {
+/***/
+template <typename Arg, typename = void>
+struct codec_fixed_encoded_size : std::integral_constant<size_t, 0>
+{
+};
+
+/***/
+template <typename Arg>
+struct codec_fixed_encoded_size<Arg, std::void_t<decltype(Codec<Arg>::fixed_encoded_size)>>
+  : std::integral_constant<size_t, Codec<Arg>::fixed_encoded_size>
+{
+};
+
+/**
+ * True when every argument is encoded by the default codec as a fixed number of bytes, e.g.
+ * arithmetic types, enums and pointers. Such argument packs never use the SizeCacheVector.
+ */
+template <typename... Args>
+inline constexpr bool has_fixed_encoded_size_v =
+  std::conjunction_v<std::bool_constant<codec_fixed_encoded_size<remove_cvref_t<Args>>::value != 0>...>;
+
+/**
+ * Total encoded size of an argument pack for which has_fixed_encoded_size_v is true
+ */
+template <typename... Args>
+inline constexpr size_t fixed_encoded_size_v = (size_t{0} + ... + codec_fixed_encoded_size<remove_cvref_t<Args>>::value);
+
 /**
  * @brief Calculates the total size required to encode the provided arguments
 
@@ -402,6 +451,24 @@ QUILL_ATTRIBUTE_HOT void encode(std::byte*& buffer,
    ...);
 }
 
+/**
+ * @brief Encodes arguments of a fixed encoded size as a straight sequence of stores.
+ * Produces the same bytes as encode() but does not require a SizeCacheVector.
+ * @param buffer Pointer to the buffer for encoding.
+ * @param args The arguments to be encoded.
+ */
+template <typename... Args>
+QUILL_ATTRIBUTE_HOT void encode_fixed_size(std::byte*& buffer, Args const&... args) noexcept
+{
+  static_assert(has_fixed_encoded_size_v<Args...>,
+                "encode_fixed_size() requires arguments with a fixed encoded size");
+
+  // Local copy improves generated code (avoids aliasing penalties)
+  QUILL_MAYBE_UNUSED std::byte* buf_ptr = buffer;
+  ((std::memcpy(buf_ptr, &args, sizeof(remove_cvref_t<Args>)), buf_ptr += sizeof(remove_cvref_t<Args>)), ...);
+  buffer = buf_ptr;
+}
+
 template <typename... Args>
 void decode_and_store_arg(std::byte*& buffer, QUILL_MAYBE_UNUSED DynamicFormatArgStore* args_store)
 {
@@ -87,7 +87,9 @@ enum class QueueType : uint8_t
   UnboundedBlocking,
   UnboundedDropping,
   BoundedBlocking,
-  BoundedDropping
+  BoundedDropping,
+  SharedBoundedBlocking,
+  SharedBoundedDropping
 };
 
 /**
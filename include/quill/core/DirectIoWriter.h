@@ -0,0 +1,242 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/QuillError.h"
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+
+  #if defined(O_DIRECT)
+    #define QUILL_HAS_DIRECT_IO 1
+  #endif
+#endif
+
+#if defined(QUILL_HAS_DIRECT_IO)
+  #include <algorithm>
+  #include <cerrno>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstdlib>
+  #include <cstring>
+  #include <memory>
+  #include <string>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * Writes a file opened with O_DIRECT, bypassing the page cache.
+ *
+ * The data is accumulated in an aligned buffer and written in whole blocks at aligned offsets.
+ * flush() also writes the unaligned tail, padded to a whole block, and truncates the file back to
+ * its logical size. The tail stays in the buffer and is written again with the next block.
+ */
+class DirectIoWriter
+{
+public:
+  /** Covers the logical block size of all the common devices */
+  static constexpr size_t alignment{4096};
+
+  /**
+   * Opens the file with O_DIRECT. The last partial block of an existing file is read into the
+   * buffer, so the next writes append to it.
+   * @return nullptr when the file system does not support O_DIRECT
+   */
+  QUILL_NODISCARD static std::unique_ptr<DirectIoWriter> create(fs::path const& filename, size_t buffer_size)
+  {
+    int fd{-1};
+    do
+    {
+      fd = ::open(filename.string().data(), O_RDWR | O_DIRECT | O_CLOEXEC);
+    } while ((fd == -1) && (errno == EINTR));
+
+    if (fd == -1)
+    {
+      return nullptr;
+    }
+
+    std::unique_ptr<DirectIoWriter> writer{new DirectIoWriter{fd, buffer_size}};
+    writer->_read_tail();
+    return writer;
+  }
+
+  /***/
+  ~DirectIoWriter()
+  {
+    ::close(_fd);
+    std::free(_buffer);
+  }
+
+  DirectIoWriter(DirectIoWriter const&) = delete;
+  DirectIoWriter& operator=(DirectIoWriter const&) = delete;
+
+  /**
+   * @return the logical file size, including the data not written yet
+   */
+  QUILL_NODISCARD uint64_t offset() const noexcept { return _buffer_offset + _buffer_pos; }
+
+  /**
+   * Copies the data to the buffer and writes the buffer each time it becomes full
+   */
+  void write(char const* data, size_t size)
+  {
+    while (size != 0)
+    {
+      size_t const bytes = (std::min)(size, _buffer_capacity - _buffer_pos);
+      std::memcpy(_buffer + _buffer_pos, data, bytes);
+      _buffer_pos += bytes;
+      data += bytes;
+      size -= bytes;
+
+      if (_buffer_pos == _buffer_capacity)
+      {
+        _write_blocks(_buffer_capacity);
+        _buffer_offset += _buffer_capacity;
+        _buffer_pos = 0;
+      }
+    }
+  }
+
+  /**
+   * Writes the buffered data. An unaligned tail is padded with zeros to a whole block and the file
+   * is truncated back to its logical size
+   */
+  void flush()
+  {
+    if (_buffer_pos == 0)
+    {
+      return;
+    }
+
+    size_t const aligned_size = ((_buffer_pos + alignment - 1) / alignment) * alignment;
+    std::memset(_buffer + _buffer_pos, 0, aligned_size - _buffer_pos);
+    _write_blocks(aligned_size);
+
+    if (aligned_size != _buffer_pos)
+    {
+      _truncate(offset());
+    }
+
+    // Only the partial block has to be written again, keep it at the start of the buffer
+    size_t const full_blocks_size = (_buffer_pos / alignment) * alignment;
+
+    if (full_blocks_size != 0)
+    {
+      std::memmove(_buffer, _buffer + full_blocks_size, _buffer_pos - full_blocks_size);
+      _buffer_offset += full_blocks_size;
+      _buffer_pos -= full_blocks_size;
+    }
+  }
+
+private:
+  /***/
+  DirectIoWriter(int fd, size_t buffer_size) : _fd(fd)
+  {
+    _buffer_capacity = (std::max)(((buffer_size + alignment - 1) / alignment) * alignment, alignment);
+
+    void* buffer{nullptr};
+    if (::posix_memalign(&buffer, alignment, _buffer_capacity) != 0)
+    {
+      ::close(_fd);
+      QUILL_THROW(QuillError{"posix_memalign failed to allocate the direct I/O buffer"});
+    }
+
+    _buffer = static_cast<char*>(buffer);
+  }
+
+  /***/
+  void _read_tail()
+  {
+    struct stat file_stat;
+    if (::fstat(_fd, &file_stat) != 0)
+    {
+      _throw_errno("fstat");
+    }
+
+    auto const file_size = static_cast<uint64_t>(file_stat.st_size);
+    _buffer_offset = (file_size / alignment) * alignment;
+    _buffer_pos = static_cast<size_t>(file_size - _buffer_offset);
+
+    size_t bytes_read{0};
+    while (bytes_read < _buffer_pos)
+    {
+      // The read size and the offset are aligned, the kernel stops at the end of the file
+      ssize_t const ret = ::pread(_fd, _buffer + bytes_read, alignment - bytes_read,
+                                  static_cast<off_t>(_buffer_offset + bytes_read));
+
+      if (ret > 0)
+      {
+        bytes_read += static_cast<size_t>(ret);
+      }
+      else if ((ret == 0) || (errno != EINTR))
+      {
+        _throw_errno("pread");
+      }
+    }
+  }
+
+  /***/
+  void _write_blocks(size_t size)
+  {
+    size_t written{0};
+
+    while (written < size)
+    {
+      ssize_t const ret = ::pwrite(_fd, _buffer + written, size - written,
+                                   static_cast<off_t>(_buffer_offset + written));
+
+      if (ret > 0)
+      {
+        written += static_cast<size_t>(ret);
+      }
+      else if ((ret == 0) || (errno != EINTR))
+      {
+        _throw_errno("pwrite");
+      }
+    }
+  }
+
+  /***/
+  void _truncate(uint64_t size)
+  {
+    int ret{0};
+    do
+    {
+      ret = ::ftruncate(_fd, static_cast<off_t>(size));
+    } while ((ret != 0) && (errno == EINTR));
+
+    if (ret != 0)
+    {
+      _throw_errno("ftruncate");
+    }
+  }
+
+  /***/
+  static void _throw_errno(char const* function)
+  {
+    int const saved_errno = errno;
+    QUILL_THROW(QuillError{std::string{function} + " failed errno: " + std::to_string(saved_errno) +
+                           " error: " + std::strerror(saved_errno)});
+  }
+
+private:
+  char* _buffer{nullptr};
+  size_t _buffer_capacity{0};
+  size_t _buffer_pos{0};        /**< Bytes in the buffer */
+  uint64_t _buffer_offset{0};   /**< The file offset of the start of the buffer, always aligned */
+  int _fd{-1};
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
+#endif
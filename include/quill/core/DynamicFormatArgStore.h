@@ -86,6 +86,7 @@ private:
   // without relocation because items in data_ refer to it.
   detail::DynamicArgList _dynamic_arg_list;
   bool _has_string_related_type{false};
+  bool _has_custom_type{false};
 
   template <typename T>
   void emplace_arg(T&& arg)
@@ -143,17 +144,32 @@ public:
     {
       _has_string_related_type = true;
     }
+
+    if constexpr (mapped_type == fmtquill::detail::type::custom_type)
+    {
+      _has_custom_type = true;
+    }
   }
 
+  /** Reserves space for the given number of arguments */
+  void reserve(size_t capacity) { _data.reserve(capacity); }
+
   /** Erase all elements from the store */
   void clear()
   {
     _data.clear();
     _dynamic_arg_list = detail::DynamicArgList{};
     _has_string_related_type = false;
+    _has_custom_type = false;
   }
 
   QUILL_NODISCARD bool has_string_related_type() const noexcept { return _has_string_related_type; }
+
+  /**
+   * True when an argument is a user defined or library type with its own formatter, rather than
+   * a built-in type or a string
+   */
+  QUILL_NODISCARD bool has_custom_type() const noexcept { return _has_custom_type; }
 };
 
 QUILL_END_EXPORT
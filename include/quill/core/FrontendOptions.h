@@ -45,6 +45,15 @@ struct FrontendOptions
    *   limit is reached. A single message larger than the fixed queue capacity cannot fit and fails
    *   instead of blocking forever.
    * - BoundedDropping: Starts with initial_queue_capacity and never reallocates; drops log messages when the limit is reached.
+   * - SharedBoundedBlocking: Threads share a fixed set of shared_queue_count bounded queues instead
+   *   of owning one each, selected by a hash of the thread id. Producers of the same shard
+   *   serialize on a lock. Blocks when the shard is full.
+   * - SharedBoundedDropping: As SharedBoundedBlocking but drops log messages when the shard is full.
+   *
+   * The shared queue types trade a small amount of hot path latency for a memory footprint and
+   * backend poll cost that no longer grow with the number of threads. They are intended for
+   * applications with hundreds of short-lived or mostly idle threads. MDC is not supported with
+   * the shared queue types.
    *
    * By default, the library uses an UnboundedBlocking queue, which starts with initial_queue_capacity.
    */
@@ -61,6 +70,17 @@ struct FrontendOptions
    */
   static constexpr uint32_t blocking_queue_retry_interval_ns = 800;
 
+  /**
+   * When a BoundedBlocking, UnboundedBlocking or SharedBoundedBlocking queue is full, the frontend
+   * thread sleeps on a futex until the backend frees space in the queue, instead of polling every
+   * blocking_queue_retry_interval_ns. Blocked threads then use no CPU during a burst, at the cost
+   * of a system call for the wake up. Writing to a queue that is not full is unaffected, but the
+   * backend publishes its read position of these queues with a seq_cst exchange instead of a
+   * release store. A blocked thread still checks the queue after blocking_queue_retry_interval_ns,
+   * or 1 ms when shorter. Available only for Linux, other platforms keep polling.
+   */
+  static constexpr bool blocking_queue_futex_wait = false;
+
   /**
    * Maximum capacity for unbounded queues (UnboundedBlocking, UnboundedDropping).
    * This defines the maximum size to which the queue can grow before blocking or dropping messages.
@@ -69,6 +89,13 @@ struct FrontendOptions
    */
   static constexpr size_t unbounded_queue_max_capacity = 2ull * 1024u * 1024u * 1024u; // 2 GiB
 
+  /**
+   * Number of queues shared by all frontend threads when using SharedBoundedBlocking or
+   * SharedBoundedDropping. Each of them is allocated with initial_queue_capacity.
+   * Applicable only to the shared queue types.
+   */
+  static constexpr size_t shared_queue_count = 4;
+
   /**
    * Enables huge pages on the frontend queues to reduce TLB misses. Available only for Linux.
    */
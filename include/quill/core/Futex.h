@@ -0,0 +1,68 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * The futex helpers, kept out of ThreadPrimitives.h so that only the code that waits on a futex
+ * pulls in the Linux system call headers
+ */
+
+#if defined(__linux__)
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <time.h>
+  #include <unistd.h>
+#endif
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+#if defined(__linux__)
+  #define QUILL_HAS_FUTEX 1
+
+/**
+ * Blocks the calling thread while `word` holds `expected`, until futex_wake() is called on the
+ * same word or the timeout expires. Spurious wake ups are possible, the caller re-checks the word.
+ * A timeout of 0 waits without a timeout.
+ */
+inline void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, uint64_t timeout_ns) noexcept
+{
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                "std::atomic<uint32_t> must have the size of uint32_t to be used as a futex word");
+
+  struct timespec ts;
+  struct timespec* timeout{nullptr};
+
+  if (timeout_ns != 0)
+  {
+    ts.tv_sec = static_cast<time_t>(timeout_ns / 1'000'000'000ull);
+    ts.tv_nsec = static_cast<long>(timeout_ns % 1'000'000'000ull);
+    timeout = &ts;
+  }
+
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, timeout,
+            nullptr, 0);
+}
+
+/**
+ * Wakes up to `count` threads blocked in futex_wait() on `word`.
+ */
+inline void futex_wake(std::atomic<uint32_t>& word, uint32_t count) noexcept
+{
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, static_cast<int>(count), nullptr,
+            nullptr, 0);
+}
+#endif
+} // namespace detail
+
+QUILL_END_NAMESPACE
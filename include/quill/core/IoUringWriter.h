@@ -0,0 +1,552 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/QuillError.h"
+
+#if defined(__linux__) && defined(__has_include)
+  #if __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+
+    #if defined(__NR_io_uring_setup) && defined(IORING_FEAT_RW_CUR_POS)
+      #define QUILL_HAS_IO_URING 1
+    #endif
+  #endif
+#endif
+
+#if defined(QUILL_HAS_IO_URING)
+  #include <algorithm>
+  #include <cerrno>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstdlib>
+  #include <cstring>
+  #include <memory>
+  #include <string>
+  #include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * Writes to a file descriptor through an io_uring instance.
+ *
+ * The data is copied into a pool of buffers registered with the kernel. A full buffer is submitted
+ * as a write at an explicit file offset and the next free buffer is used, so the calling thread
+ * only blocks when every buffer is still in flight. Completions are processed by reap().
+ *
+ * The io_uring instance is created with raw system calls, liburing is not required.
+ */
+class IoUringWriter
+{
+public:
+  /**
+   * Creates the io_uring instance and the buffer pool
+   * @return nullptr when io_uring is not available, e.g. old kernel or disabled by the system
+   */
+  QUILL_NODISCARD static std::unique_ptr<IoUringWriter> create(size_t buffer_size, uint32_t buffer_count)
+  {
+    std::unique_ptr<IoUringWriter> writer{new IoUringWriter{}};
+
+    if (!writer->_init(buffer_size, buffer_count))
+    {
+      return nullptr;
+    }
+
+    return writer;
+  }
+
+  /***/
+  ~IoUringWriter()
+  {
+    QUILL_TRY { wait(); }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH_ALL() {}
+  #endif
+
+    if (_sqes)
+    {
+      ::munmap(_sqes, _sqes_size);
+    }
+
+    if (_cq_ring && (_cq_ring != _sq_ring))
+    {
+      ::munmap(_cq_ring, _cq_ring_size);
+    }
+
+    if (_sq_ring)
+    {
+      ::munmap(_sq_ring, _sq_ring_size);
+    }
+
+    if (_ring_fd != -1)
+    {
+      ::close(_ring_fd);
+    }
+
+    std::free(_buffer_memory);
+  }
+
+  IoUringWriter(IoUringWriter const&) = delete;
+  IoUringWriter& operator=(IoUringWriter const&) = delete;
+
+  /**
+   * Sets the file the next writes go to. Must be called when no writes are in flight.
+   * @param fd file descriptor, must not be opened with O_APPEND
+   * @param offset the file offset of the next write
+   */
+  void attach(int fd, uint64_t offset) noexcept
+  {
+    _fd = fd;
+    _offset = offset;
+  }
+
+  /**
+   * @return the file offset after all the written data, including data not submitted yet
+   */
+  QUILL_NODISCARD uint64_t offset() const noexcept
+  {
+    return (_current == no_buffer) ? _offset : _offset + _buffers[_current].size;
+  }
+
+  /**
+   * Copies the data to the current buffer and submits each buffer that becomes full
+   */
+  void write(char const* data, size_t size)
+  {
+    while (size != 0)
+    {
+      if (_current == no_buffer)
+      {
+        _acquire_buffer();
+      }
+
+      Buffer& buffer = _buffers[_current];
+      size_t const bytes = (std::min)(size, _buffer_size - buffer.size);
+      std::memcpy(buffer.data + buffer.size, data, bytes);
+      buffer.size += bytes;
+      data += bytes;
+      size -= bytes;
+
+      if (buffer.size == _buffer_size)
+      {
+        submit();
+      }
+    }
+  }
+
+  /**
+   * Submits the current buffer without waiting for the write to complete
+   */
+  void submit()
+  {
+    if ((_current == no_buffer) || (_buffers[_current].size == 0))
+    {
+      return;
+    }
+
+    Buffer& buffer = _buffers[_current];
+    buffer.offset = _offset;
+    buffer.written = 0;
+    _offset += buffer.size;
+
+    uint32_t const index = _current;
+    _current = no_buffer;
+
+    _queue_write(index);
+    _enter(0, 0);
+  }
+
+  /**
+   * Queues an fsync that starts after all the submitted writes have completed. When an fsync is
+   * already in flight, another one is queued after it completes.
+   */
+  void fsync()
+  {
+    if (_fsync_in_flight)
+    {
+      _fsync_pending = true;
+      return;
+    }
+
+    _queue_fsync();
+    _enter(0, 0);
+  }
+
+  /**
+   * Processes the completed operations without blocking
+   * @throws QuillError when a write or an fsync failed
+   */
+  void reap()
+  {
+    unsigned head = *_cq_head;
+    unsigned const tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+    int error{0};
+
+    while (head != tail)
+    {
+      io_uring_cqe const& cqe = _cqes[head & *_cq_mask];
+      ++head;
+
+      if (cqe.user_data == fsync_user_data)
+      {
+        _fsync_in_flight = false;
+
+        if (cqe.res < 0)
+        {
+          error = -cqe.res;
+        }
+
+        if (_fsync_pending)
+        {
+          _fsync_pending = false;
+          _queue_fsync();
+        }
+
+        continue;
+      }
+
+      auto const index = static_cast<uint32_t>(cqe.user_data);
+      Buffer& buffer = _buffers[index];
+      --_in_flight;
+
+      if ((cqe.res == -EAGAIN) || (cqe.res == -EINTR))
+      {
+        _queue_write(index);
+        continue;
+      }
+
+      if (cqe.res <= 0)
+      {
+        // The data of this buffer is lost
+        error = (cqe.res == 0) ? ENOSPC : -cqe.res;
+        _release_buffer(index);
+        continue;
+      }
+
+      buffer.written += static_cast<size_t>(cqe.res);
+
+      if (buffer.written < buffer.size)
+      {
+        // Short write, submit the remaining bytes
+        _queue_write(index);
+        continue;
+      }
+
+      _release_buffer(index);
+    }
+
+    __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+
+    if ((_unpublished != 0) || (_unsubmitted != 0))
+    {
+      _enter(0, 0);
+    }
+
+    if (QUILL_UNLIKELY(error != 0))
+    {
+      QUILL_THROW(QuillError{std::string{"io_uring write failed errno: "} + std::to_string(error) +
+                             " error: " + std::strerror(error)});
+    }
+  }
+
+  /**
+   * Blocks until all the submitted writes and the fsync have completed
+   */
+  void wait()
+  {
+    while ((_in_flight != 0) || _fsync_in_flight)
+    {
+      _enter(1, IORING_ENTER_GETEVENTS);
+      reap();
+    }
+  }
+
+  /**
+   * @return true when writes or an fsync are in flight
+   */
+  QUILL_NODISCARD bool has_pending_operations() const noexcept
+  {
+    return (_in_flight != 0) || _fsync_in_flight;
+  }
+
+private:
+  struct Buffer
+  {
+    char* data{nullptr};
+    size_t size{0};
+    size_t written{0};
+    uint64_t offset{0};
+  };
+
+  IoUringWriter() = default;
+
+  /***/
+  QUILL_NODISCARD bool _init(size_t buffer_size, uint32_t buffer_count)
+  {
+    static constexpr size_t alignment{4096};
+
+    // One entry per buffer and one for the fsync, so a submission entry is always available
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    _ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, buffer_count + 1, &params));
+
+    if ((_ring_fd < 0) || !(params.features & IORING_FEAT_RW_CUR_POS))
+    {
+      // IORING_OP_WRITE requires Linux 5.6, which also introduced IORING_FEAT_RW_CUR_POS
+      return false;
+    }
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+      _sq_ring_size = (std::max)(_sq_ring_size, _cq_ring_size);
+      _cq_ring_size = _sq_ring_size;
+    }
+
+    _sq_ring = _mmap(_sq_ring_size, IORING_OFF_SQ_RING);
+    if (!_sq_ring)
+    {
+      return false;
+    }
+
+    _cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP) ? _sq_ring : _mmap(_cq_ring_size, IORING_OFF_CQ_RING);
+    if (!_cq_ring)
+    {
+      return false;
+    }
+
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = static_cast<io_uring_sqe*>(_mmap(_sqes_size, IORING_OFF_SQES));
+    if (!_sqes)
+    {
+      return false;
+    }
+
+    auto* sq_ring = static_cast<char*>(_sq_ring);
+    _sq_tail = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.array);
+
+    auto* cq_ring = static_cast<char*>(_cq_ring);
+    _cq_head = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+
+    // The buffers are page aligned so they can also be used for direct I/O
+    _buffer_size = ((buffer_size + alignment - 1) / alignment) * alignment;
+
+    if (::posix_memalign(&_buffer_memory, alignment, _buffer_size * buffer_count) != 0)
+    {
+      _buffer_memory = nullptr;
+      return false;
+    }
+
+    _buffers.resize(buffer_count);
+    _free_buffers.reserve(buffer_count);
+    std::vector<iovec> iovecs(buffer_count);
+
+    for (uint32_t i = 0; i < buffer_count; ++i)
+    {
+      _buffers[i].data = static_cast<char*>(_buffer_memory) + (static_cast<size_t>(i) * _buffer_size);
+      iovecs[i].iov_base = _buffers[i].data;
+      iovecs[i].iov_len = _buffer_size;
+
+      // Acquired from the back, start with the first buffer
+      _free_buffers.push_back(buffer_count - 1 - i);
+    }
+
+    // Registered buffers avoid mapping the user pages on every write. The registration counts
+    // against RLIMIT_MEMLOCK, when it fails the buffers are written as regular buffers
+    _registered_buffers = ::syscall(__NR_io_uring_register, _ring_fd, IORING_REGISTER_BUFFERS,
+                                    iovecs.data(), buffer_count) == 0;
+
+    return true;
+  }
+
+  /***/
+  QUILL_NODISCARD void* _mmap(size_t size, uint64_t offset) const noexcept
+  {
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                       static_cast<off_t>(offset));
+    return (ptr == MAP_FAILED) ? nullptr : ptr;
+  }
+
+  /***/
+  void _acquire_buffer()
+  {
+    if (_free_buffers.empty())
+    {
+      reap();
+
+      while (_free_buffers.empty())
+      {
+        // Every buffer is in flight, wait for one of the writes to complete
+        _enter(1, IORING_ENTER_GETEVENTS);
+        reap();
+      }
+    }
+
+    _current = _free_buffers.back();
+    _free_buffers.pop_back();
+  }
+
+  /***/
+  void _release_buffer(uint32_t index)
+  {
+    _buffers[index].size = 0;
+    _buffers[index].written = 0;
+    _free_buffers.push_back(index);
+  }
+
+  /***/
+  QUILL_NODISCARD io_uring_sqe* _next_sqe() noexcept
+  {
+    unsigned const index = (*_sq_tail + _unpublished) & *_sq_mask;
+
+    io_uring_sqe* sqe = &_sqes[index];
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    _sq_array[index] = index;
+
+    // Published by _enter() once the entry is filled
+    ++_unpublished;
+    return sqe;
+  }
+
+  /***/
+  void _queue_write(uint32_t index) noexcept
+  {
+    Buffer const& buffer = _buffers[index];
+
+    io_uring_sqe* sqe = _next_sqe();
+    sqe->opcode = _registered_buffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = _fd;
+    sqe->off = buffer.offset + buffer.written;
+    sqe->addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(buffer.data + buffer.written));
+    sqe->len = static_cast<uint32_t>(buffer.size - buffer.written);
+    sqe->buf_index = static_cast<uint16_t>(_registered_buffers ? index : 0);
+    sqe->user_data = index;
+
+    ++_in_flight;
+  }
+
+  /***/
+  void _queue_fsync() noexcept
+  {
+    io_uring_sqe* sqe = _next_sqe();
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = _fd;
+
+    // Starts after all the previously submitted writes have completed
+    sqe->flags = IOSQE_IO_DRAIN;
+    sqe->user_data = fsync_user_data;
+
+    _fsync_in_flight = true;
+  }
+
+  /**
+   * Publishes the queued submission entries and optionally waits for completions
+   */
+  void _enter(unsigned min_complete, unsigned flags)
+  {
+    if (_unpublished != 0)
+    {
+      __atomic_store_n(_sq_tail, *_sq_tail + _unpublished, __ATOMIC_RELEASE);
+      _unsubmitted += _unpublished;
+      _unpublished = 0;
+    }
+
+    while (true)
+    {
+      if ((_unsubmitted == 0) && (min_complete == 0))
+      {
+        return;
+      }
+
+      long const ret = ::syscall(__NR_io_uring_enter, _ring_fd, _unsubmitted, min_complete, flags, nullptr, 0);
+
+      if (ret >= 0)
+      {
+        _unsubmitted -= static_cast<uint32_t>(ret);
+
+        if (_unsubmitted == 0)
+        {
+          return;
+        }
+
+        // Not everything was consumed, submit the rest without waiting again
+        min_complete = 0;
+        flags = 0;
+        continue;
+      }
+
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      if ((errno == EAGAIN) || (errno == EBUSY))
+      {
+        // The completion queue is full, the entries are submitted by the next call
+        return;
+      }
+
+      int const saved_errno = errno;
+      QUILL_THROW(QuillError{std::string{"io_uring_enter failed errno: "} +
+                             std::to_string(saved_errno) + " error: " + std::strerror(saved_errno)});
+    }
+  }
+
+private:
+  static constexpr uint32_t no_buffer{UINT32_MAX};
+  static constexpr uint64_t fsync_user_data{UINT64_MAX};
+
+  std::vector<Buffer> _buffers;
+  std::vector<uint32_t> _free_buffers;
+  void* _buffer_memory{nullptr};
+  size_t _buffer_size{0};
+  uint32_t _current{no_buffer};
+  uint32_t _in_flight{0};
+  uint32_t _unpublished{0}; /**< Queued submission entries the kernel can not see yet */
+  uint32_t _unsubmitted{0}; /**< Published submission entries the kernel has not consumed yet */
+
+  int _ring_fd{-1};
+  int _fd{-1};
+  uint64_t _offset{0};
+
+  void* _sq_ring{nullptr};
+  void* _cq_ring{nullptr};
+  io_uring_sqe* _sqes{nullptr};
+  size_t _sq_ring_size{0};
+  size_t _cq_ring_size{0};
+  size_t _sqes_size{0};
+
+  unsigned* _sq_tail{nullptr};
+  unsigned* _sq_mask{nullptr};
+  unsigned* _sq_array{nullptr};
+  unsigned* _cq_head{nullptr};
+  unsigned* _cq_tail{nullptr};
+  unsigned* _cq_mask{nullptr};
+  io_uring_cqe* _cqes{nullptr};
+
+  bool _registered_buffers{false};
+  bool _fsync_in_flight{false};
+  bool _fsync_pending{false};
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
+#endif
@@ -0,0 +1,207 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+
+#include "quill/bundled/fmt/format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define QUILL_JSON_ESCAPE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+  #include <emmintrin.h>
+  #define QUILL_JSON_ESCAPE_SSE2
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(QUILL_JSON_ESCAPE_AVX2) || defined(QUILL_JSON_ESCAPE_SSE2))
+  #include <intrin.h>
+#endif
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * Returns true for the bytes that stop the bulk copy of a JSON string: the quote, the backslash,
+ * the control characters and 0xE2, the lead byte of the U+2028 and U+2029 separators.
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_HOT inline bool is_json_escape_candidate(unsigned char c) noexcept
+{
+  return (c < 0x20) || (c == '"') || (c == '\\') || (c == 0xE2);
+}
+
+#if defined(QUILL_JSON_ESCAPE_AVX2) || defined(QUILL_JSON_ESCAPE_SSE2)
+/***/
+QUILL_NODISCARD QUILL_ATTRIBUTE_HOT inline uint32_t count_trailing_zeros(uint32_t mask) noexcept
+{
+  #if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<uint32_t>(index);
+  #else
+  return static_cast<uint32_t>(__builtin_ctz(mask));
+  #endif
+}
+#endif
+
+/**
+ * Returns a pointer to the first byte in [begin, end) for which is_json_escape_candidate() is
+ * true, or end. Scans 32 or 16 bytes at a time when AVX2 or SSE2 is enabled at compile time.
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_HOT inline char const* find_json_escape_candidate(char const* begin,
+                                                                                  char const* end) noexcept
+{
+  char const* it = begin;
+
+#if defined(QUILL_JSON_ESCAPE_AVX2)
+  __m256i const quote_256 = _mm256_set1_epi8('"');
+  __m256i const backslash_256 = _mm256_set1_epi8('\\');
+  __m256i const separator_256 = _mm256_set1_epi8(static_cast<char>(0xE2));
+  __m256i const max_control_256 = _mm256_set1_epi8(0x1F);
+
+  while (end - it >= 32)
+  {
+    __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(it));
+
+    // min(c, 0x1F) == c only for the control characters
+    __m256i const matches = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote_256), _mm256_cmpeq_epi8(chunk, backslash_256)),
+      _mm256_or_si256(_mm256_cmpeq_epi8(chunk, separator_256),
+                      _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, max_control_256), chunk)));
+
+    auto const mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+
+    if (mask != 0)
+    {
+      return it + count_trailing_zeros(mask);
+    }
+
+    it += 32;
+  }
+#endif
+
+#if defined(QUILL_JSON_ESCAPE_AVX2) || defined(QUILL_JSON_ESCAPE_SSE2)
+  __m128i const quote = _mm_set1_epi8('"');
+  __m128i const backslash = _mm_set1_epi8('\\');
+  __m128i const separator = _mm_set1_epi8(static_cast<char>(0xE2));
+  __m128i const max_control = _mm_set1_epi8(0x1F);
+
+  while (end - it >= 16)
+  {
+    __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(it));
+
+    __m128i const matches =
+      _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                   _mm_or_si128(_mm_cmpeq_epi8(chunk, separator),
+                                _mm_cmpeq_epi8(_mm_min_epu8(chunk, max_control), chunk)));
+
+    auto const mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+
+    if (mask != 0)
+    {
+      return it + count_trailing_zeros(mask);
+    }
+
+    it += 16;
+  }
+#endif
+
+  // The tail, or the whole input without SIMD
+  while ((it != end) && !is_json_escape_candidate(static_cast<unsigned char>(*it)))
+  {
+    ++it;
+  }
+
+  return it;
+}
+
+/**
+ * Appends value to out as the contents of a JSON string. Runs of bytes that need no escaping are
+ * copied in bulk, only the candidate bytes go through the per character escaping.
+ *
+ * U+2028 (LINE SEPARATOR) and U+2029 (PARAGRAPH SEPARATOR) are valid JSON characters but they
+ * break some JavaScript consumers that treat JSON as JS source, so they are escaped too.
+ */
+QUILL_ATTRIBUTE_HOT inline void append_json_escaped(fmtquill::memory_buffer& out, std::string_view value)
+{
+  // Pre-computed escape table for control characters (0x00..0x1F). Each entry is the 6-byte
+  // \uXXXX form. Faster and locale-safe compared to per-byte snprintf.
+  static constexpr char control_escape_table[32][7] = {
+    "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+    "\\u0008", "\\u0009", "\\u000A", "\\u000B", "\\u000C", "\\u000D", "\\u000E", "\\u000F",
+    "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+    "\\u0018", "\\u0019", "\\u001A", "\\u001B", "\\u001C", "\\u001D", "\\u001E", "\\u001F"};
+
+  char const* it = value.data();
+  char const* const end = it + value.size();
+
+  while (it != end)
+  {
+    char const* const run_end = find_json_escape_candidate(it, end);
+    out.append(it, run_end);
+
+    if (run_end == end)
+    {
+      break;
+    }
+
+    it = run_end;
+    unsigned char const c = static_cast<unsigned char>(*it);
+
+    switch (c)
+    {
+    case '"':
+      out.append(std::string_view{"\\\""});
+      break;
+    case '\\':
+      out.append(std::string_view{"\\\\"});
+      break;
+    case '\b':
+      out.append(std::string_view{"\\b"});
+      break;
+    case '\f':
+      out.append(std::string_view{"\\f"});
+      break;
+    case '\n':
+      out.append(std::string_view{"\\n"});
+      break;
+    case '\r':
+      out.append(std::string_view{"\\r"});
+      break;
+    case '\t':
+      out.append(std::string_view{"\\t"});
+      break;
+    case 0xE2:
+      // E2 80 A8 and E2 80 A9 are the UTF-8 sequences of U+2028 and U+2029
+      if ((end - it > 2) && (static_cast<unsigned char>(it[1]) == 0x80) &&
+          ((static_cast<unsigned char>(it[2]) == 0xA8) || (static_cast<unsigned char>(it[2]) == 0xA9)))
+      {
+        out.append(static_cast<unsigned char>(it[2]) == 0xA8 ? std::string_view{"\\u2028"}
+                                                             : std::string_view{"\\u2029"});
+        it += 2;
+      }
+      else
+      {
+        out.push_back(static_cast<char>(c));
+      }
+      break;
+    default:
+      out.append(std::string_view{control_escape_table[c], 6});
+      break;
+    }
+
+    ++it;
+  }
+}
+} // namespace detail
+
+QUILL_END_NAMESPACE
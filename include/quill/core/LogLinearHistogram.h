@@ -0,0 +1,250 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Common.h"
+#include "quill/core/Metric.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * @brief A histogram of double values with HDR-style log-linear buckets and fixed memory.
+ *
+ * Each power of two between 2^min_exponent and 2^max_exponent is split in sub_bucket_count
+ * linear buckets, so the value reported for a quantile is within half a bucket, about 1.6%, of
+ * the recorded values. The bucket of a value is found from the bits of the double, without a
+ * search.
+ *
+ * Values below 2^min_exponent, including zero and negative values, are counted in an underflow
+ * bucket and values from 2^max_exponent in an overflow bucket. Quantiles in these buckets are
+ * reported as the min and the max. count, sum, min and max are exact.
+ *
+ * Histograms can be merged, which gives the same result as recording all the values in one.
+ */
+class LogLinearHistogram
+{
+public:
+  static constexpr uint32_t sub_bucket_bits = 5;
+  static constexpr uint32_t sub_bucket_count = uint32_t{1} << sub_bucket_bits;
+  static constexpr int32_t min_exponent = -32;
+  static constexpr int32_t max_exponent = 48;
+  static constexpr size_t bucket_count =
+    2 + (static_cast<size_t>(max_exponent - min_exponent) * sub_bucket_count);
+
+  /**
+   * Records a value. NaN values are ignored.
+   * @param value the value
+   * @param count the number of times the value is recorded
+   */
+  void record(double value, uint64_t count = 1) noexcept
+  {
+    if ((count == 0) || std::isnan(value))
+    {
+      return;
+    }
+
+    _counts[_bucket_index(value)] += count;
+    _update_min_max(value, value);
+    _count += count;
+    _sum += value * static_cast<double>(count);
+  }
+
+  /**
+   * Adds the values recorded in another histogram
+   */
+  void merge(LogLinearHistogram const& other) noexcept
+  {
+    if (other._count == 0)
+    {
+      return;
+    }
+
+    for (size_t i = 0; i < bucket_count; ++i)
+    {
+      _counts[i] += other._counts[i];
+    }
+
+    _update_min_max(other._min, other._max);
+    _count += other._count;
+    _sum += other._sum;
+  }
+
+  /**
+   * Adds a histogram with fixed buckets, e.g. published by MetricHistogram. The values of each
+   * bucket are recorded as its upper bound, limited to the min and the max, so the quantiles are
+   * only as precise as the fixed buckets. count, sum, min and max remain exact.
+   */
+  void merge(MetricHistogramData const& histogram) noexcept
+  {
+    if (histogram.count == 0)
+    {
+      return;
+    }
+
+    for (size_t i = 0; i <= histogram.bucket_bounds_count; ++i)
+    {
+      if (histogram.bucket_counts[i] == 0)
+      {
+        continue;
+      }
+
+      double const upper_bound =
+        (i < histogram.bucket_bounds_count) ? histogram.bucket_bounds[i] : histogram.max;
+      double const value = (std::min)((std::max)(upper_bound, histogram.min), histogram.max);
+      _counts[_bucket_index(value)] += histogram.bucket_counts[i];
+    }
+
+    _update_min_max(histogram.min, histogram.max);
+    _count += histogram.count;
+    _sum += histogram.sum;
+  }
+
+  /**
+   * @param quantile between 0 and 1, e.g. 0.99. 0 and 1 return the exact min and max
+   * @return the value below or at which the given fraction of the recorded values are, or 0 if
+   * nothing was recorded
+   */
+  QUILL_NODISCARD double value_at_quantile(double quantile) const noexcept
+  {
+    if (_count == 0)
+    {
+      return 0;
+    }
+
+    // The extremes are exact
+    if (!(quantile > 0.0))
+    {
+      return _min;
+    }
+
+    if (quantile >= 1.0)
+    {
+      return _max;
+    }
+
+    auto rank = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(_count)));
+    rank = (std::max)(rank, uint64_t{1});
+
+    uint64_t cumulative_count{0};
+    size_t index{0};
+
+    for (; index < bucket_count; ++index)
+    {
+      cumulative_count += _counts[index];
+
+      if (cumulative_count >= rank)
+      {
+        break;
+      }
+    }
+
+    if (index == 0)
+    {
+      return _min;
+    }
+
+    if (index >= bucket_count - 1)
+    {
+      return _max;
+    }
+
+    return (std::min)((std::max)(_bucket_midpoint(index), _min), _max);
+  }
+
+  /**
+   * Clears the recorded values
+   */
+  void reset() noexcept
+  {
+    if (_count == 0)
+    {
+      return;
+    }
+
+    _counts.fill(0);
+    _count = 0;
+    _sum = 0;
+    _min = 0;
+    _max = 0;
+  }
+
+  QUILL_NODISCARD uint64_t count() const noexcept { return _count; }
+  QUILL_NODISCARD double sum() const noexcept { return _sum; }
+  QUILL_NODISCARD double min() const noexcept { return _min; }
+  QUILL_NODISCARD double max() const noexcept { return _max; }
+
+private:
+  /***/
+  QUILL_NODISCARD static size_t _bucket_index(double value) noexcept
+  {
+    static constexpr double lowest_trackable_value =
+      1.0 / static_cast<double>(uint64_t{1} << static_cast<uint32_t>(-min_exponent));
+
+    if (!(value >= lowest_trackable_value))
+    {
+      return 0;
+    }
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    int32_t const exponent = static_cast<int32_t>((bits >> 52) & 0x7ff) - 1023;
+
+    if (exponent >= max_exponent)
+    {
+      return bucket_count - 1;
+    }
+
+    auto const sub_bucket = static_cast<size_t>((bits >> (52 - sub_bucket_bits)) & (sub_bucket_count - 1));
+    return 1 + (static_cast<size_t>(exponent - min_exponent) * sub_bucket_count) + sub_bucket;
+  }
+
+  /***/
+  QUILL_NODISCARD static double _bucket_midpoint(size_t index) noexcept
+  {
+    size_t const bucket = index - 1;
+    int const exponent = static_cast<int>(bucket / sub_bucket_count) + min_exponent;
+    double const sub_bucket = static_cast<double>(bucket % sub_bucket_count);
+    return std::ldexp(1.0 + ((sub_bucket + 0.5) / sub_bucket_count), exponent);
+  }
+
+  /***/
+  void _update_min_max(double min, double max) noexcept
+  {
+    if (_count == 0)
+    {
+      _min = min;
+      _max = max;
+    }
+    else
+    {
+      _min = (std::min)(_min, min);
+      _max = (std::max)(_max, max);
+    }
+  }
+
+private:
+  std::array<uint64_t, bucket_count> _counts{};
+  uint64_t _count{0};
+  double _sum{0};
+  double _min{0};
+  double _max{0};
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
@@ -33,7 +33,9 @@ namespace detail
 {
 class BackendWorker;
 class BacktraceStorage;
+class FormatterPool;
 class LoggerManager;
+class SinkWorker;
 
 /***/
 class LoggerBase
@@ -196,6 +198,8 @@ public:
 
 protected:
   friend class BackendWorker;
+  friend class FormatterPool;
+  friend class SinkWorker;
   friend class LoggerManager;
 
   /***/
@@ -38,13 +38,15 @@ public:
     Metric,
     MdcSet,
     MdcErase,
-    MdcClear
+    MdcClear,
+    MetricHistogram
   };
 
   constexpr MacroMetadata() = default;
 
   constexpr MacroMetadata(char const* source_location, char const* caller_function,
-                          char const* message_format, char const* tags, LogLevel log_level, Event event) noexcept
+                          char const* message_format, char const* tags, LogLevel log_level,
+                          Event event, bool runtime_metadata = false) noexcept
     : _source_location(source_location),
       _caller_function(caller_function),
       _message_format(message_format),
@@ -52,7 +54,8 @@ public:
       _colon_separator_pos(_calc_colon_separator_pos()),
       _file_name_pos(_calc_file_name_pos()),
       _log_level(log_level),
-      _event(event)
+      _event(event),
+      _runtime_metadata(runtime_metadata)
   {
   }
 
@@ -99,6 +102,13 @@ public:
 
   QUILL_NODISCARD Event event() const noexcept { return _event; }
 
+  /**
+   * True for the metadata the backend creates for the runtime metadata log statements. Unlike
+   * the metadata of the log macros it has no static storage and its address is reused for
+   * different call sites
+   */
+  QUILL_NODISCARD bool is_runtime_metadata() const noexcept { return _runtime_metadata; }
+
   /***/
   QUILL_NODISCARD static constexpr bool contains_named_args(std::string_view fmt) noexcept
   {
@@ -212,6 +222,7 @@ private:
   uint16_t _file_name_pos{0};
   LogLevel _log_level{LogLevel::None};
   Event _event{Event::None};
+  bool _runtime_metadata{false};
 };
 
 QUILL_END_EXPORT
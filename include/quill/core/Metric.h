@@ -9,6 +9,9 @@
 #include "quill/core/Common.h"
 #include "quill/core/MacroMetadata.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -55,6 +58,123 @@ private:
   std::vector<MetricLabel> _labels;
 };
 
+/**
+ * A histogram with fixed buckets aggregated on the frontend by MetricHistogram and delivered to
+ * Sink::write_metric_histogram().
+ *
+ * `bucket_counts` has one more element than `bucket_bounds`. `bucket_counts[i]` counts the values
+ * less than or equal to `bucket_bounds[i]` and greater than the previous bound, the last element
+ * counts the values greater than the last bound. The counts are for the values recorded since the
+ * previous histogram of the same thread was published, not cumulative.
+ */
+struct MetricHistogramData
+{
+  double const* bucket_bounds{nullptr};
+  uint64_t const* bucket_counts{nullptr};
+  size_t bucket_bounds_count{0};
+  uint64_t count{0};
+  double sum{0};
+  double min{0};
+  double max{0};
+};
+
+class LogLinearHistogram;
+
+/**
+ * The samples of a metric aggregated by the backend over one
+ * BackendOptions::metric_snapshot_interval, delivered to Sink::write_metric_snapshot().
+ *
+ * `quantile_values[i]` is the value at `quantiles[i]`, as configured by
+ * BackendOptions::metric_snapshot_quantiles. The histogram is only valid during the call, a sink
+ * can merge it into its own LogLinearHistogram to aggregate over longer periods.
+ */
+struct MetricSnapshot
+{
+  LogLinearHistogram const* histogram{nullptr};
+  double const* quantiles{nullptr};
+  double const* quantile_values{nullptr};
+  size_t quantiles_count{0};
+  uint64_t first_timestamp{0};
+  uint64_t last_timestamp{0};
+};
+
 QUILL_END_EXPORT
 
+namespace detail
+{
+/**
+ * The histogram is encoded in the frontend queue after the header as the MetricMetadata pointer,
+ * the number of bounds, the count, sum, min and max followed by the bounds and the bucket counts
+ */
+QUILL_NODISCARD constexpr size_t metric_histogram_encoded_size(size_t bucket_bounds_count) noexcept
+{
+  return sizeof(uintptr_t) + (5 * sizeof(uint64_t)) + (bucket_bounds_count * sizeof(double)) +
+    ((bucket_bounds_count + 1) * sizeof(uint64_t));
+}
+
+/***/
+inline void encode_metric_histogram(std::byte*& buffer, MetricMetadata const* metric_metadata,
+                                    MetricHistogramData const& histogram) noexcept
+{
+  auto const metric_metadata_ptr = reinterpret_cast<uintptr_t>(metric_metadata);
+  auto const bucket_bounds_count = static_cast<uint64_t>(histogram.bucket_bounds_count);
+
+  std::memcpy(buffer, &metric_metadata_ptr, sizeof(metric_metadata_ptr));
+  buffer += sizeof(metric_metadata_ptr);
+  std::memcpy(buffer, &bucket_bounds_count, sizeof(bucket_bounds_count));
+  buffer += sizeof(bucket_bounds_count);
+  std::memcpy(buffer, &histogram.count, sizeof(histogram.count));
+  buffer += sizeof(histogram.count);
+  std::memcpy(buffer, &histogram.sum, sizeof(histogram.sum));
+  buffer += sizeof(histogram.sum);
+  std::memcpy(buffer, &histogram.min, sizeof(histogram.min));
+  buffer += sizeof(histogram.min);
+  std::memcpy(buffer, &histogram.max, sizeof(histogram.max));
+  buffer += sizeof(histogram.max);
+  std::memcpy(buffer, histogram.bucket_bounds, histogram.bucket_bounds_count * sizeof(double));
+  buffer += histogram.bucket_bounds_count * sizeof(double);
+  std::memcpy(buffer, histogram.bucket_counts, (histogram.bucket_bounds_count + 1) * sizeof(uint64_t));
+  buffer += (histogram.bucket_bounds_count + 1) * sizeof(uint64_t);
+}
+
+/**
+ * Decodes a histogram encoded by encode_metric_histogram(). The bounds and the bucket counts are
+ * copied to the given vectors, as the encoded buffer is not aligned
+ * @return the MetricMetadata of the histogram
+ */
+inline MetricMetadata const* decode_metric_histogram(std::byte const* buffer, MetricHistogramData& histogram,
+                                                     std::vector<double>& bucket_bounds,
+                                                     std::vector<uint64_t>& bucket_counts)
+{
+  uintptr_t metric_metadata_ptr;
+  uint64_t bucket_bounds_count;
+
+  std::memcpy(&metric_metadata_ptr, buffer, sizeof(metric_metadata_ptr));
+  buffer += sizeof(metric_metadata_ptr);
+  std::memcpy(&bucket_bounds_count, buffer, sizeof(bucket_bounds_count));
+  buffer += sizeof(bucket_bounds_count);
+  std::memcpy(&histogram.count, buffer, sizeof(histogram.count));
+  buffer += sizeof(histogram.count);
+  std::memcpy(&histogram.sum, buffer, sizeof(histogram.sum));
+  buffer += sizeof(histogram.sum);
+  std::memcpy(&histogram.min, buffer, sizeof(histogram.min));
+  buffer += sizeof(histogram.min);
+  std::memcpy(&histogram.max, buffer, sizeof(histogram.max));
+  buffer += sizeof(histogram.max);
+
+  bucket_bounds.resize(static_cast<size_t>(bucket_bounds_count));
+  bucket_counts.resize(static_cast<size_t>(bucket_bounds_count) + 1);
+
+  std::memcpy(bucket_bounds.data(), buffer, bucket_bounds.size() * sizeof(double));
+  buffer += bucket_bounds.size() * sizeof(double);
+  std::memcpy(bucket_counts.data(), buffer, bucket_counts.size() * sizeof(uint64_t));
+
+  histogram.bucket_bounds = bucket_bounds.data();
+  histogram.bucket_counts = bucket_counts.data();
+  histogram.bucket_bounds_count = bucket_bounds.size();
+
+  return reinterpret_cast<MetricMetadata const*>(metric_metadata_ptr);
+}
+} // namespace detail
+
 QUILL_END_NAMESPACE
@@ -0,0 +1,63 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+
+#include "quill/bundled/fmt/format.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * A growable buffer the backend can format the log statements into, owned by the sinks that
+ * write their output from a contiguous buffer.
+ *
+ * It is the fmt buffer type PatternFormatter::format_to() appends to.
+ */
+class OutputBuffer final : public fmtquill::detail::buffer<char>
+{
+public:
+  OutputBuffer() : fmtquill::detail::buffer<char>(_grow) {}
+
+  OutputBuffer(OutputBuffer const&) = delete;
+  OutputBuffer& operator=(OutputBuffer const&) = delete;
+
+  /**
+   * Ensures the buffer can hold capacity bytes without growing
+   */
+  void reserve(size_t capacity) { try_reserve(capacity); }
+
+private:
+  /***/
+  static void _grow(fmtquill::detail::buffer<char>& buffer, size_t capacity)
+  {
+    auto& self = static_cast<OutputBuffer&>(buffer);
+
+    size_t const new_capacity = (std::max)(capacity, self.capacity() + self.capacity() / 2);
+    std::unique_ptr<char[]> storage{new char[new_capacity]};
+
+    if (self.size() != 0)
+    {
+      std::memcpy(storage.get(), self.data(), self.size());
+    }
+
+    self._storage = std::move(storage);
+    self.set(self._storage.get(), new_capacity);
+  }
+
+  std::unique_ptr<char[]> _storage;
+};
+} // namespace detail
+
+QUILL_END_NAMESPACE
@@ -38,6 +38,13 @@ public:
     } while (_flag.exchange(State::Locked, std::memory_order_acquire) == State::Locked);
   }
 
+  /***/
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool try_lock() noexcept
+  {
+    return (_flag.load(std::memory_order_relaxed) == State::Free) &&
+      (_flag.exchange(State::Locked, std::memory_order_acquire) == State::Free);
+  }
+
   /***/
   QUILL_ATTRIBUTE_HOT void unlock() noexcept
   {
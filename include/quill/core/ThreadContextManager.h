@@ -7,10 +7,12 @@
 #pragma once
 
 #include "quill/core/Attributes.h"
+#include "quill/core/BackendWakeup.h"
 #include "quill/core/BoundedSPSCQueue.h"
 #include "quill/core/Common.h"
 #include "quill/core/InlinedVector.h"
 #include "quill/core/Spinlock.h"
+#include "quill/core/ThreadPrimitives.h"
 #include "quill/core/UnboundedSPSCQueue.h"
 
 #include <atomic>
@@ -21,6 +23,7 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 QUILL_BEGIN_NAMESPACE
@@ -51,6 +54,96 @@ QUILL_NODISCARD QUILL_EXPORT QUILL_ATTRIBUTE_USED extern uint32_t get_thread_id(
   #pragma GCC diagnostic pop
 #endif
 
+/***/
+QUILL_NODISCARD constexpr bool is_shared_queue_type(QueueType queue_type) noexcept
+{
+  return (queue_type == QueueType::SharedBoundedBlocking) || (queue_type == QueueType::SharedBoundedDropping);
+}
+
+/***/
+QUILL_NODISCARD constexpr bool is_blocking_queue_type(QueueType queue_type) noexcept
+{
+  return (queue_type == QueueType::UnboundedBlocking) || (queue_type == QueueType::BoundedBlocking) ||
+    (queue_type == QueueType::SharedBoundedBlocking);
+}
+
+/**
+ * Whether the queues of TFrontendOptions need the futex handshake between the producer and the
+ * backend, see FrontendOptions::blocking_queue_futex_wait
+ */
+template <typename TFrontendOptions>
+QUILL_NODISCARD constexpr bool use_producer_futex_wait() noexcept
+{
+  return TFrontendOptions::blocking_queue_futex_wait && is_blocking_queue_type(TFrontendOptions::queue_type);
+}
+
+/**
+ * Identity of a frontend thread logging through a shared queue. The shared queue is not owned by a
+ * single thread, so each record carries a pointer to the identity of the thread that produced it.
+ * Identities are interned by ThreadIdentityTable and are never released.
+ */
+struct ThreadIdentity
+{
+  std::string thread_id;
+  std::string thread_name;
+};
+
+/**
+ * Interns the identities of the threads logging through the shared queues.
+ *
+ * The backend holds the identity pointer of a record for as long as the message is in a queue, a
+ * transit event or a backtrace, so identities are never released. They are interned by thread id
+ * and thread name instead. Thread ids are recycled by the OS, so an application that keeps
+ * creating threads with the same few names keeps reusing the same identities.
+ *
+ * The table is bounded by max_size. Once full, a thread without an identity of its own gets none
+ * and ThreadContextManager gives it a queue of its own instead of a shared one.
+ */
+class ThreadIdentityTable
+{
+public:
+  static constexpr size_t default_max_size{65536};
+
+  /***/
+  explicit ThreadIdentityTable(size_t max_size = default_max_size) : _max_size(max_size) {}
+
+  /**
+   * @return the identity of the thread, valid for the lifetime of the table, or nullptr when the
+   * table is full
+   * @note Not thread safe
+   */
+  QUILL_NODISCARD ThreadIdentity const* intern(uint32_t thread_id, std::string_view thread_name)
+  {
+    auto& identities = _identities[thread_id];
+
+    for (auto const& identity : identities)
+    {
+      if (identity->thread_name == thread_name)
+      {
+        return identity.get();
+      }
+    }
+
+    if (_size >= _max_size)
+    {
+      return nullptr;
+    }
+
+    identities.push_back(
+      std::make_unique<ThreadIdentity>(ThreadIdentity{std::to_string(thread_id), std::string{thread_name}}));
+    ++_size;
+    return identities.back().get();
+  }
+
+  /***/
+  QUILL_NODISCARD size_t size() const noexcept { return _size; }
+
+private:
+  std::unordered_map<uint32_t, std::vector<std::unique_ptr<ThreadIdentity>>> _identities;
+  size_t _max_size;
+  size_t _size{0};
+};
+
 class ThreadContext
 {
 private:
@@ -66,20 +159,34 @@ private:
 public:
   /***/
   ThreadContext(QueueType queue_type, size_t initial_queue_capacity,
-                QUILL_MAYBE_UNUSED size_t unbounded_queue_max_capacity, HugePagesPolicy huge_pages_policy)
+                QUILL_MAYBE_UNUSED size_t unbounded_queue_max_capacity,
+                HugePagesPolicy huge_pages_policy, bool producer_futex_wait = false)
     : _queue_type(queue_type)
   {
     if (has_unbounded_queue_type())
     {
-      new (&_spsc_queue_union.unbounded_spsc_queue)
-        UnboundedSPSCQueue{initial_queue_capacity, unbounded_queue_max_capacity, huge_pages_policy};
+      new (&_spsc_queue_union.unbounded_spsc_queue) UnboundedSPSCQueue{
+        initial_queue_capacity, unbounded_queue_max_capacity, huge_pages_policy, producer_futex_wait};
     }
     else if (has_bounded_queue_type())
     {
-      new (&_spsc_queue_union.bounded_spsc_queue) BoundedSPSCQueue{initial_queue_capacity, huge_pages_policy};
+      new (&_spsc_queue_union.bounded_spsc_queue)
+        BoundedSPSCQueue{initial_queue_capacity, huge_pages_policy, 5, producer_futex_wait};
     }
   }
 
+  /**
+   * Constructs one of the queues shared by many frontend threads, see QueueType::SharedBoundedBlocking
+   */
+  ThreadContext(QueueType queue_type, size_t queue_capacity, HugePagesPolicy huge_pages_policy,
+                std::string const& shared_queue_name, bool producer_futex_wait = false)
+    : _thread_id(shared_queue_name), _thread_name(shared_queue_name), _queue_type(queue_type)
+  {
+    QUILL_ASSERT(has_shared_queue_type(), "ThreadContext expected a shared queue type");
+    new (&_spsc_queue_union.bounded_spsc_queue)
+      BoundedSPSCQueue{queue_capacity, huge_pages_policy, 5, producer_futex_wait};
+  }
+
   /***/
   ThreadContext(ThreadContext const&) = delete;
   ThreadContext& operator=(ThreadContext const&) = delete;
@@ -140,7 +247,14 @@ public:
   /***/
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool has_bounded_queue_type() const noexcept
   {
-    return (_queue_type == QueueType::BoundedBlocking) || (_queue_type == QueueType::BoundedDropping);
+    return (_queue_type == QueueType::BoundedBlocking) || (_queue_type == QueueType::BoundedDropping) ||
+      has_shared_queue_type();
+  }
+
+  /***/
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool has_shared_queue_type() const noexcept
+  {
+    return is_shared_queue_type(_queue_type);
   }
 
   /***/
@@ -152,13 +266,14 @@ public:
   /***/
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool has_dropping_queue() const noexcept
   {
-    return (_queue_type == QueueType::UnboundedDropping) || (_queue_type == QueueType::BoundedDropping);
+    return (_queue_type == QueueType::UnboundedDropping) || (_queue_type == QueueType::BoundedDropping) ||
+      (_queue_type == QueueType::SharedBoundedDropping);
   }
 
   /***/
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool has_blocking_queue() const noexcept
   {
-    return (_queue_type == QueueType::UnboundedBlocking) || (_queue_type == QueueType::BoundedBlocking);
+    return is_blocking_queue_type(_queue_type);
   }
 
   /***/
@@ -173,6 +288,14 @@ public:
     return _spsc_queue_union;
   }
 
+  /**
+   * Serializes the producers of a shared queue. Unused by the thread local queue types.
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT Spinlock& shared_queue_lock() noexcept
+  {
+    return _shared_queue_lock;
+  }
+
   /***/
   QUILL_NODISCARD std::string_view thread_id() const noexcept { return _thread_id; }
 
@@ -190,6 +313,34 @@ public:
   /***/
   QUILL_NODISCARD bool is_valid() const noexcept { return _valid.load(std::memory_order_acquire); }
 
+  /**
+   * Set by the backend thread, see BackendWakeup::thread_context_wake_up_state(). The frontend
+   * thread wakes up the backend when it finds BackendWakeup::ContextParked set after writing to
+   * its queue.
+   */
+  void set_backend_wake_up_state(uint8_t state) noexcept
+  {
+    _backend_wake_up_state.store(state, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return 0 unless the frontend thread has to check whether the backend is parked
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT uint8_t backend_wake_up_state() const noexcept
+  {
+    return _backend_wake_up_state.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return true if BackendWakeup::ContextParked was set
+   */
+  QUILL_NODISCARD bool clear_backend_parked() noexcept
+  {
+    return (_backend_wake_up_state.fetch_and(static_cast<uint8_t>(~BackendWakeup::ContextParked),
+                                             std::memory_order_relaxed) &
+            BackendWakeup::ContextParked) != 0;
+  }
+
   /***/
   void increment_failure_counter() noexcept
   {
@@ -217,9 +368,38 @@ private:
   std::shared_ptr<BackendMdcState> _backend_mdc_state; /**< backend-owned MDC state. shared_ptr keeps the forward declaration lightweight */
   QueueType _queue_type;
   std::atomic<bool> _valid{true}; /**< is this context valid, set by the frontend, read by the backend thread */
+  std::atomic<uint8_t> _backend_wake_up_state{BackendWakeup::instance().thread_context_wake_up_state(true)}; /**< set by the backend before it parks, initially parked with the frontend wake up enabled so the first message of a new thread wakes up the backend */
+  Spinlock _shared_queue_lock;    /**< held by the producers of a shared queue */
   alignas(QUILL_CACHE_LINE_ALIGNED) std::atomic<size_t> _failure_counter{0};
 };
 
+/**
+ * What a frontend thread needs to log through a shared queue
+ */
+struct SharedQueueProducer
+{
+  SharedQueueProducer() = default;
+  SharedQueueProducer(SharedQueueProducer const&) = delete;
+  SharedQueueProducer& operator=(SharedQueueProducer const&) = delete;
+  SharedQueueProducer(SharedQueueProducer&&) = default;
+  SharedQueueProducer& operator=(SharedQueueProducer&&) = default;
+
+  /**
+   * Invalidates the dedicated thread context, if any, when the thread exits
+   */
+  ~SharedQueueProducer();
+
+  ThreadContext* thread_context{nullptr};
+
+  /** nullptr when the thread logs through dedicated_thread_context, the backend then reads the
+   * thread id and name of the ThreadContext */
+  ThreadIdentity const* thread_identity{nullptr};
+
+  /** Set when the thread identities are exhausted, a queue of the same type used only by this
+   * thread */
+  std::shared_ptr<ThreadContext> dedicated_thread_context;
+};
+
 class ThreadContextManager
 {
 public:
@@ -246,6 +426,98 @@ public:
     }
   }
 
+  /**
+   * Same as for_each_thread_context() but gives up when the lock can not be taken after a bounded
+   * number of attempts, e.g. when it is held by the thread running a signal handler
+   * @return false if the lock could not be taken
+   */
+  template <typename TCallback>
+  QUILL_NODISCARD bool try_for_each_thread_context(TCallback cb)
+  {
+    static constexpr uint32_t max_attempts{1'000'000};
+
+    for (uint32_t attempt = 0; attempt < max_attempts; ++attempt)
+    {
+      if (_spinlock.try_lock())
+      {
+        for (auto const& elem : _thread_contexts)
+        {
+          cb(elem.get());
+        }
+
+        _spinlock.unlock();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Asks the backend thread to stop reading the frontend queues and waits until it is outside of
+   * begin_consume() and end_consume(), so the calling thread can read their unread part. Only
+   * uses atomics and nanosleep, it can be called from a signal handler but not from the backend
+   * thread
+   * @param timeout_ns how long to wait for the backend to stop
+   * @return true when the backend does not read the queues until resume_consumer() is called
+   */
+  QUILL_NODISCARD bool pause_consumer(uint64_t timeout_ns) noexcept
+  {
+    static constexpr uint64_t poll_interval_ns{1'000'000};
+
+    // Pairs with begin_consume(), either the backend sees the request or we see it consuming
+    _consumer_pause_requested.store(true, std::memory_order_seq_cst);
+
+    for (uint64_t waited_ns = 0;; waited_ns += poll_interval_ns)
+    {
+      if (!_consumer_active.load(std::memory_order_seq_cst))
+      {
+        return true;
+      }
+
+      if (waited_ns >= timeout_ns)
+      {
+        _consumer_pause_requested.store(false, std::memory_order_release);
+        return false;
+      }
+
+      sleep_for_ns(poll_interval_ns);
+    }
+  }
+
+  /**
+   * Lets the backend thread read the frontend queues again after pause_consumer()
+   */
+  void resume_consumer() noexcept
+  {
+    _consumer_pause_requested.store(false, std::memory_order_release);
+  }
+
+  /**
+   * Called by the backend thread before it reads and releases the frontend queues, blocks while
+   * another thread paused it with pause_consumer()
+   */
+  QUILL_ATTRIBUTE_HOT void begin_consume() noexcept
+  {
+    _consumer_active.store(true, std::memory_order_seq_cst);
+
+    while (QUILL_UNLIKELY(_consumer_pause_requested.load(std::memory_order_seq_cst)))
+    {
+      _consumer_active.store(false, std::memory_order_release);
+      sleep_for_ns(1'000'000);
+      _consumer_active.store(true, std::memory_order_seq_cst);
+    }
+  }
+
+  /**
+   * Called by the backend thread once it no longer reads the frontend queues, publishes their
+   * consumer state to pause_consumer()
+   */
+  QUILL_ATTRIBUTE_HOT void end_consume() noexcept
+  {
+    _consumer_active.store(false, std::memory_order_release);
+  }
+
   /***/
   void register_thread_context(std::shared_ptr<ThreadContext> const& thread_context)
   {
@@ -254,6 +526,56 @@ public:
     _new_thread_context_flag.store(true, std::memory_order_release);
   }
 
+  /**
+   * Assigns the calling thread to one of the shared queues, creating them on first use.
+   * The shared queues are registered like any other ThreadContext but are never invalidated, so
+   * the backend keeps polling a fixed number of queues regardless of how many threads log.
+   */
+  QUILL_NODISCARD SharedQueueProducer register_shared_queue_producer(QueueType queue_type, size_t queue_capacity,
+                                                                     size_t shared_queue_count,
+                                                                     HugePagesPolicy huge_pages_policy,
+                                                                     bool producer_futex_wait = false)
+  {
+    uint32_t const tid = get_thread_id();
+    std::string const thread_name = get_thread_name();
+
+    LockGuard const lock{_spinlock};
+
+    if (_shared_thread_contexts.empty())
+    {
+      for (size_t i = 0; i < shared_queue_count; ++i)
+      {
+        auto thread_context = std::make_shared<ThreadContext>(
+          queue_type, queue_capacity, huge_pages_policy, "shared_queue_" + std::to_string(i),
+          producer_futex_wait);
+        _shared_thread_contexts.push_back(thread_context.get());
+        _thread_contexts.push_back(static_cast<std::shared_ptr<ThreadContext>&&>(thread_context));
+      }
+
+      _new_thread_context_flag.store(true, std::memory_order_release);
+    }
+
+    SharedQueueProducer producer;
+    producer.thread_identity = _thread_identities.intern(tid, thread_name);
+
+    if (producer.thread_identity)
+    {
+      producer.thread_context = _shared_thread_contexts[tid % _shared_thread_contexts.size()];
+    }
+    else
+    {
+      // Reusing the identity of another thread would show the wrong thread in the log, the thread
+      // gets a queue of its own instead. It is removed once the thread exits and it is empty
+      producer.dedicated_thread_context = std::make_shared<ThreadContext>(
+        queue_type, queue_capacity, queue_capacity, huge_pages_policy, producer_futex_wait);
+      producer.thread_context = producer.dedicated_thread_context.get();
+      _thread_contexts.push_back(producer.dedicated_thread_context);
+      _new_thread_context_flag.store(true, std::memory_order_release);
+    }
+
+    return producer;
+  }
+
   /***/
   void add_invalid_thread_context() noexcept
   {
@@ -341,9 +663,13 @@ private:
 
 private:
   std::vector<std::shared_ptr<ThreadContext>> _thread_contexts; /**< The registered contexts */
+  std::vector<ThreadContext*> _shared_thread_contexts; /**< The shared queues, also in _thread_contexts */
+  ThreadIdentityTable _thread_identities; /**< Interned identities of the threads using the shared queues */
   Spinlock _spinlock; /**< Protect access when register contexts or removing contexts */
   std::atomic<bool> _new_thread_context_flag{false};
   std::atomic<uint32_t> _invalid_thread_context_count{0};
+  std::atomic<bool> _consumer_active{false}; /**< The backend thread reads the frontend queues */
+  std::atomic<bool> _consumer_pause_requested{false}; /**< Set by pause_consumer() */
 };
 
 class ScopedThreadContext
@@ -351,9 +677,11 @@ class ScopedThreadContext
 public:
   /***/
   ScopedThreadContext(QueueType queue_type, size_t initial_queue_capacity,
-                      size_t unbounded_queue_max_capacity, HugePagesPolicy huge_pages_policy)
-    : _thread_context(std::make_shared<ThreadContext>(
-        queue_type, initial_queue_capacity, unbounded_queue_max_capacity, huge_pages_policy))
+                      size_t unbounded_queue_max_capacity, HugePagesPolicy huge_pages_policy,
+                      bool producer_futex_wait = false)
+    : _thread_context(std::make_shared<ThreadContext>(queue_type, initial_queue_capacity,
+                                                      unbounded_queue_max_capacity,
+                                                      huge_pages_policy, producer_futex_wait))
   {
 #if defined(QUILL_ENABLE_ASSERTIONS) || !defined(NDEBUG)
     // Thread-local flag to track if an instance has been created for this thread.
@@ -407,6 +735,17 @@ private:
   std::shared_ptr<ThreadContext> _thread_context;
 };
 
+/***/
+inline SharedQueueProducer::~SharedQueueProducer()
+{
+  if (dedicated_thread_context)
+  {
+    // Same as ~ScopedThreadContext(), the backend removes it once its queue is empty
+    dedicated_thread_context->mark_invalid();
+    ThreadContextManager::instance().add_invalid_thread_context();
+  }
+}
+
 /**
  * Non-template implementation that owns the thread local context. This ensures that when building
  * with shared libraries, the thread-local context is shared accross all shared libraries
@@ -416,14 +755,51 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_HOT QUILL_EXPORT
   inline
 #endif
   ThreadContext* get_scoped_thread_context_impl(QueueType queue_type, size_t initial_queue_capacity,
-                                                size_t unbounded_queue_max_capacity, HugePagesPolicy huge_pages_policy)
+                                                size_t unbounded_queue_max_capacity,
+                                                HugePagesPolicy huge_pages_policy, bool producer_futex_wait)
 {
   thread_local ScopedThreadContext scoped_thread_context{
-    queue_type, initial_queue_capacity, unbounded_queue_max_capacity, huge_pages_policy};
+    queue_type, initial_queue_capacity, unbounded_queue_max_capacity, huge_pages_policy, producer_futex_wait};
 
   return scoped_thread_context.get_thread_context();
 }
 
+/**
+ * Non-template implementation that owns the thread local assignment to a shared queue, see
+ * get_scoped_thread_context_impl()
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_HOT QUILL_EXPORT
+#ifndef QUILL_MODULE
+  inline
+#endif
+  SharedQueueProducer const& get_shared_queue_producer_impl(QueueType queue_type, size_t queue_capacity,
+                                                            size_t shared_queue_count,
+                                                            HugePagesPolicy huge_pages_policy,
+                                                            bool producer_futex_wait)
+{
+  thread_local SharedQueueProducer const shared_queue_producer =
+    ThreadContextManager::instance().register_shared_queue_producer(
+      queue_type, queue_capacity, shared_queue_count, huge_pages_policy, producer_futex_wait);
+
+  return shared_queue_producer;
+}
+
+/***/
+template <typename TFrontendOptions>
+QUILL_NODISCARD QUILL_ATTRIBUTE_HOT SharedQueueProducer const& get_local_shared_queue_producer()
+{
+  static_assert(is_shared_queue_type(TFrontendOptions::queue_type),
+                "get_local_shared_queue_producer() requires a shared queue type");
+
+  static_assert(TFrontendOptions::shared_queue_count > 0,
+                "FrontendOptions::shared_queue_count must be greater than zero");
+
+  return get_shared_queue_producer_impl(TFrontendOptions::queue_type, TFrontendOptions::initial_queue_capacity,
+                                        TFrontendOptions::shared_queue_count,
+                                        TFrontendOptions::huge_pages_policy,
+                                        use_producer_futex_wait<TFrontendOptions>());
+}
+
 /***/
 template <typename TFrontendOptions>
 QUILL_NODISCARD QUILL_ATTRIBUTE_HOT ThreadContext* get_local_thread_context()
@@ -432,9 +808,17 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_HOT ThreadContext* get_local_thread_context()
                 "FrontendOptions::unbounded_queue_max_capacity must be greater than or equal to "
                 "FrontendOptions::initial_queue_capacity");
 
-  return get_scoped_thread_context_impl(
-    TFrontendOptions::queue_type, TFrontendOptions::initial_queue_capacity,
-    TFrontendOptions::unbounded_queue_max_capacity, TFrontendOptions::huge_pages_policy);
+  if constexpr (is_shared_queue_type(TFrontendOptions::queue_type))
+  {
+    return get_local_shared_queue_producer<TFrontendOptions>().thread_context;
+  }
+  else
+  {
+    return get_scoped_thread_context_impl(
+      TFrontendOptions::queue_type, TFrontendOptions::initial_queue_capacity,
+      TFrontendOptions::unbounded_queue_max_capacity, TFrontendOptions::huge_pages_policy,
+      use_producer_futex_wait<TFrontendOptions>());
+  }
 }
 
 #if defined(_WIN32) && defined(_MSC_VER) && !defined(__GNUC__)
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "quill/core/Attributes.h"
+
+#include <atomic>
 #include <cstdint>
 
 /**
@@ -32,6 +34,10 @@ extern "C"
   #include <time.h>
 #endif
 
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+#endif
+
 QUILL_BEGIN_NAMESPACE
 
 namespace detail
@@ -76,6 +82,22 @@ QUILL_ATTRIBUTE_HOT inline void yield_thread() noexcept
   ::sched_yield();
 #endif
 }
+
+/**
+ * Hints the cpu that the calling thread is spinning, e.g. the x86 pause instruction.
+ */
+QUILL_ATTRIBUTE_HOT inline void cpu_pause() noexcept
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+  __asm__ __volatile__("yield" ::: "memory");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+  __yield();
+#endif
+}
 } // namespace detail
 
 QUILL_END_NAMESPACE
@@ -53,9 +53,10 @@ private:
      * Constructor
      * @param bounded_queue_capacity the capacity of the fixed buffer
      * @param huge_pages_policy enables huge pages
+     * @param producer_futex_wait enables wait_for_space()
      */
-    explicit Node(size_t bounded_queue_capacity, HugePagesPolicy huge_pages_policy)
-      : bounded_queue(bounded_queue_capacity, huge_pages_policy)
+    explicit Node(size_t bounded_queue_capacity, HugePagesPolicy huge_pages_policy, bool producer_futex_wait)
+      : bounded_queue(bounded_queue_capacity, huge_pages_policy, 5, producer_futex_wait)
     {
     }
 
@@ -86,9 +87,10 @@ public:
    * Constructor
    */
   UnboundedSPSCQueue(size_t initial_bounded_queue_capacity, size_t max_capacity,
-                     HugePagesPolicy huge_pages_policy = quill::HugePagesPolicy::Never)
+                     HugePagesPolicy huge_pages_policy = quill::HugePagesPolicy::Never,
+                     bool producer_futex_wait = false)
     : _max_capacity(next_power_of_two(max_capacity)),
-      _producer(new Node(initial_bounded_queue_capacity, huge_pages_policy)),
+      _producer(new Node(initial_bounded_queue_capacity, huge_pages_policy, producer_futex_wait)),
       _consumer(_producer)
   {
   }
@@ -169,6 +171,18 @@ public:
     _producer->bounded_queue.finish_and_commit_write_reservation(new_writer_pos);
   }
 
+#if defined(QUILL_HAS_FUTEX)
+  /**
+   * Blocks the producer until the reader frees space for nbytes in the current buffer, see
+   * BoundedSPSCQueue::wait_for_space()
+   * @note: producer only, when prepare_write() failed because the maximum capacity is reached
+   */
+  QUILL_ATTRIBUTE_COLD void wait_for_space(size_t nbytes, uint64_t timeout_ns) noexcept
+  {
+    _producer->bounded_queue.wait_for_space(nbytes, timeout_ns);
+  }
+#endif
+
   /**
    * Return the current buffer's capacity
    * @note: producer only
@@ -194,7 +208,8 @@ public:
 
     // We want to shrink the queue, we will create a new queue with a smaller size
     // the consumer will switch to the newer queue after emptying and deallocating the older queue
-    auto const next_node = new Node{capacity, _producer->bounded_queue.huge_pages_policy()};
+    auto const next_node = new Node{capacity, _producer->bounded_queue.huge_pages_policy(),
+                                   _producer->bounded_queue.producer_futex_wait()};
 
     // store the new node pointer as next in the current node
     _producer->next.store(next_node, std::memory_order_release);
@@ -242,6 +257,16 @@ public:
    */
   QUILL_ATTRIBUTE_HOT void commit_read() noexcept { _consumer->bounded_queue.commit_read(); }
 
+  /**
+   * Prepare to read from the current buffer only. Unlike prepare_read() it never switches to a
+   * newer buffer, so the memory of the current buffer stays valid.
+   * @note consumer only
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT std::byte* prepare_read_current_buffer() noexcept
+  {
+    return _consumer->bounded_queue.prepare_read();
+  }
+
   /**
    * Return the current buffer's capacity
    * @note: consumer only
@@ -259,6 +284,19 @@ public:
     return _consumer->bounded_queue.empty() && (_consumer->next.load(std::memory_order_relaxed) == nullptr);
   }
 
+  /**
+   * Calls BoundedSPSCQueue::for_each_unread() on each buffer, from the oldest to the newest
+   * @note Only meant for diagnostics when the consumer is no longer running
+   */
+  template <typename TCallback>
+  void for_each_unread(TCallback&& callback) const noexcept
+  {
+    for (Node const* node = _consumer; node != nullptr; node = node->next.load(std::memory_order_acquire))
+    {
+      node->bounded_queue.for_each_unread(callback);
+    }
+  }
+
 private:
   /***/
   QUILL_NODISCARD std::byte* _handle_full_queue(size_t nbytes)
@@ -307,7 +345,8 @@ private:
     _producer->bounded_queue.commit_write();
 
     // We failed to reserve because the queue was full, create a new node with a new queue
-    auto const next_node = new Node{capacity, _producer->bounded_queue.huge_pages_policy()};
+    auto const next_node = new Node{capacity, _producer->bounded_queue.huge_pages_policy(),
+                                   _producer->bounded_queue.producer_futex_wait()};
 
     // store the new node pointer as next in the current node
     _producer->next.store(next_node, std::memory_order_release);
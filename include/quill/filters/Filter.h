@@ -58,6 +58,19 @@ public:
                                       std::string_view logger_name, LogLevel log_level, std::string_view log_message,
                                       std::string_view log_statement) noexcept = 0;
 
+  /**
+   * @brief Opts the filter into the pre-format filtering stage.
+   *
+   * A metadata only filter decides using the log metadata, timestamp, thread, logger and log level
+   * only. The backend then calls it once per log statement before formatting, with an empty
+   * log_message and log_statement, and skips formatting the log statement when no sink of the
+   * logger accepts it. Metadata only filters run before the other filters of the sink.
+   *
+   * @note Read once when the filter is added to the sink.
+   * @return true if filter() does not use log_message and log_statement, false by default
+   */
+  QUILL_NODISCARD virtual bool is_metadata_only() const noexcept { return false; }
+
   /**
    * Gets the name of the filter. Only useful if an existing filter is needed to be looked up
    * @return the name of the filter
@@ -0,0 +1,367 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/bundled/fmt/format.h"
+#include "quill/core/Attributes.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/LogLevel.h"
+#include "quill/core/MacroMetadata.h"
+#include "quill/core/PatternFormatterOptions.h"
+#include "quill/sinks/FileSink.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * On-disk layout shared by BinaryFileSink and BinaryLogReader.
+ *
+ * The file is a sequence of records, each starting with a one byte BinaryRecordType.
+ * Integers are stored in the byte order of the writing host, strings as a uint32_t length
+ * followed by the raw bytes.
+ *
+ * - FileHeader : magic[8] | version u32 | byte_order_mark u32 | process_id str
+ * - CallSite   : id u32 | log_level u8 | source_location str | caller_function str | message_format str | tags str
+ * - String     : id u32 | value str
+ * - LogEvent   : timestamp u64 | call_site_id u32 | log_level u8 | logger_name_id u32 | thread_id_id u32 |
+ *                thread_name_id u32 | log_level_description_id u32 | log_level_short_code_id u32 |
+ *                message_kind u8 | message
+ *
+ * The message of a LogEvent depends on its BinaryMessageKind
+ * - FormatArgs : format_args str, the arguments as written by serialize_format_args(). They are
+ *                formatted with the message_format of the call site when the file is read
+ * - Formatted  : message str | named_args_count u32 | (key str | value str) * named_args_count,
+ *                used when an argument has a user defined codec or formatter
+ *
+ * A FileHeader resets all previously defined ids, which makes appending to an existing file or
+ * reopening a deleted one safe.
+ */
+enum class BinaryRecordType : uint8_t
+{
+  FileHeader = 1,
+  CallSite = 2,
+  String = 3,
+  LogEvent = 4
+};
+
+enum class BinaryMessageKind : uint8_t
+{
+  FormatArgs = 1,
+  Formatted = 2
+};
+
+static constexpr char BinaryFileMagic[8] = {'Q', 'U', 'I', 'L', 'L', 'B', 'I', 'N'};
+static constexpr uint32_t BinaryFileVersion{2};
+static constexpr uint32_t BinaryFileByteOrderMark{0x01020304};
+
+/** Call site id used for metadata that is not stable for the lifetime of the process, e.g. runtime metadata **/
+static constexpr uint32_t BinaryTransientCallSiteId{0xFFFFFFFF};
+} // namespace detail
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * A FileSink that writes compact binary records instead of text.
+ *
+ * Each call site is written once as a dictionary entry holding the format string, source
+ * location, function, tags and log level. Logger names, thread ids and thread names are interned
+ * in the same way. Every log statement then only stores the timestamp, the dictionary ids and the
+ * type tagged values of its arguments.
+ *
+ * Neither the message nor the PatternFormatter are formatted on the backend thread, both are
+ * deferred to the offline decoder, see `BinaryLogReader` and the `quill_decode` tool. Arguments
+ * of a user defined type can not be decoded outside of the writing process, log statements with
+ * such an argument store the message formatted by the backend instead.
+ *
+ * The backend only serializes the arguments when every sink of the logger is a BinaryFileSink
+ * without filters that need the formatted message, otherwise the formatted message is stored.
+ *
+ * @note The file is only readable on a host with the same byte order as the writer.
+ */
+class BinaryFileSink : public FileSink
+{
+public:
+  explicit BinaryFileSink(fs::path const& filename, FileSinkConfig const& config = FileSinkConfig{},
+                          FileEventNotifier file_event_notifier = FileEventNotifier{}, bool do_fopen = true,
+                          std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now())
+    : FileSink(filename, _make_binary_config(config), std::move(file_event_notifier), do_fopen, start_time)
+  {
+  }
+
+  ~BinaryFileSink() override = default;
+
+  /**
+   * @brief Writes a binary record for the log statement with the message formatted by the backend.
+   * @note The PatternFormatter is disabled for this sink so log_statement is always empty
+   */
+  QUILL_ATTRIBUTE_HOT void write_log(MacroMetadata const* log_metadata, uint64_t log_timestamp,
+                                     std::string_view thread_id, std::string_view thread_name,
+                                     std::string const& process_id, std::string_view logger_name,
+                                     LogLevel log_level, std::string_view log_level_description,
+                                     std::string_view log_level_short_code,
+                                     std::vector<std::pair<std::string, std::string>> const* named_args,
+                                     std::string_view log_message, std::string_view /* log_statement */) override
+  {
+    _append_log_event(log_metadata, log_timestamp, thread_id, thread_name, process_id, logger_name,
+                      log_level, log_level_description, log_level_short_code,
+                      detail::BinaryMessageKind::Formatted);
+    _append_string(log_message);
+
+    if (named_args)
+    {
+      _append_integral(static_cast<uint32_t>(named_args->size()));
+
+      for (auto const& [key, value] : *named_args)
+      {
+        _append_string(key);
+        _append_string(value);
+      }
+    }
+    else
+    {
+      _append_integral(uint32_t{0});
+    }
+
+    FileSink::write_log(log_metadata, log_timestamp, thread_id, thread_name, process_id,
+                        logger_name, log_level, log_level_description, log_level_short_code,
+                        named_args, log_message, std::string_view{_record.data(), _record.size()});
+  }
+
+  /***/
+  QUILL_NODISCARD bool supports_format_args() const noexcept override { return true; }
+
+  /**
+   * @brief Writes a binary record for the log statement with its serialized arguments, the
+   * message is formatted when the file is read
+   */
+  QUILL_ATTRIBUTE_HOT void write_log_format_args(MacroMetadata const* log_metadata, uint64_t log_timestamp,
+                                                 std::string_view thread_id, std::string_view thread_name,
+                                                 std::string const& process_id, std::string_view logger_name,
+                                                 LogLevel log_level, std::string_view log_level_description,
+                                                 std::string_view log_level_short_code,
+                                                 std::string_view format_args) override
+  {
+    _append_log_event(log_metadata, log_timestamp, thread_id, thread_name, process_id, logger_name,
+                      log_level, log_level_description, log_level_short_code,
+                      detail::BinaryMessageKind::FormatArgs);
+    _append_string(format_args);
+
+    FileSink::write_log(log_metadata, log_timestamp, thread_id, thread_name, process_id,
+                        logger_name, log_level, log_level_description, log_level_short_code,
+                        nullptr, std::string_view{}, std::string_view{_record.data(), _record.size()});
+  }
+
+  /**
+   * Flushes the file. When the underlying file was deleted and reopened, the dictionary is
+   * written again before the next record
+   */
+  QUILL_ATTRIBUTE_HOT void flush_sink() override
+  {
+    size_t const file_size_before_flush = _file_size;
+
+    FileSink::flush_sink();
+
+    if (QUILL_UNLIKELY(_file_size != file_size_before_flush))
+    {
+      // FileSink only resyncs the file size when it had to reopen the file
+      _reset_dictionary();
+    }
+  }
+
+private:
+  /***/
+  QUILL_NODISCARD static FileSinkConfig _make_binary_config(FileSinkConfig config)
+  {
+    // An empty pattern makes the backend skip the PatternFormatter for this sink
+    config.set_override_pattern_formatter_options(
+      PatternFormatterOptions{"", "%H:%M:%S.%Qns", Timezone::LocalTime, false, PatternFormatterOptions::NO_SUFFIX});
+
+    // The records are encoded one by one in write_log()
+    config.set_batch_write(false);
+    config.set_zero_copy_write(false);
+
+    // Binary output must not go through newline translation
+    if (config.open_mode().find('b') == std::string::npos)
+    {
+      std::string open_mode = config.open_mode();
+      open_mode.push_back('b');
+      config.set_open_mode(open_mode);
+    }
+
+    return config;
+  }
+
+  /***/
+  template <typename T>
+  QUILL_ATTRIBUTE_HOT void _append_integral(T value)
+  {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    _record.append(bytes, bytes + sizeof(T));
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT void _append_string(std::string_view value)
+  {
+    _append_integral(static_cast<uint32_t>(value.size()));
+    _record.append(value.data(), value.data() + value.size());
+  }
+
+  /**
+   * Starts a new record with the dictionary entries the log statement needs and the fields of
+   * the LogEvent up to its message
+   */
+  QUILL_ATTRIBUTE_HOT void _append_log_event(MacroMetadata const* log_metadata, uint64_t log_timestamp,
+                                             std::string_view thread_id, std::string_view thread_name,
+                                             std::string const& process_id, std::string_view logger_name,
+                                             LogLevel log_level, std::string_view log_level_description,
+                                             std::string_view log_level_short_code,
+                                             detail::BinaryMessageKind message_kind)
+  {
+    _record.clear();
+
+    if (QUILL_UNLIKELY(!_file_header_written))
+    {
+      _append_file_header(process_id);
+    }
+
+    uint32_t const call_site_id = _get_or_append_call_site(log_metadata);
+    uint32_t const logger_name_id = _get_or_append_string(logger_name, _last_logger_name);
+    uint32_t const thread_id_id = _get_or_append_string(thread_id, _last_thread_id);
+    uint32_t const thread_name_id = _get_or_append_string(thread_name, _last_thread_name);
+    uint32_t const log_level_description_id =
+      _get_or_append_string(log_level_description, _last_log_level_description);
+    uint32_t const log_level_short_code_id =
+      _get_or_append_string(log_level_short_code, _last_log_level_short_code);
+
+    _append_integral(static_cast<uint8_t>(detail::BinaryRecordType::LogEvent));
+    _append_integral(log_timestamp);
+    _append_integral(call_site_id);
+    _append_integral(static_cast<uint8_t>(log_level));
+    _append_integral(logger_name_id);
+    _append_integral(thread_id_id);
+    _append_integral(thread_name_id);
+    _append_integral(log_level_description_id);
+    _append_integral(log_level_short_code_id);
+    _append_integral(static_cast<uint8_t>(message_kind));
+  }
+
+  /***/
+  void _append_file_header(std::string const& process_id)
+  {
+    _append_integral(static_cast<uint8_t>(detail::BinaryRecordType::FileHeader));
+    _record.append(detail::BinaryFileMagic, detail::BinaryFileMagic + sizeof(detail::BinaryFileMagic));
+    _append_integral(detail::BinaryFileVersion);
+    _append_integral(detail::BinaryFileByteOrderMark);
+    _append_string(process_id);
+    _file_header_written = true;
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT uint32_t _get_or_append_call_site(MacroMetadata const* log_metadata)
+  {
+    uint32_t call_site_id{detail::BinaryTransientCallSiteId};
+
+    // Only the metadata of regular log statements has static storage, runtime metadata
+    // lives inside the transit event and its address is reused for different call sites
+    bool const is_static_metadata =
+      (log_metadata->event() == MacroMetadata::Event::Log) && !log_metadata->is_runtime_metadata();
+
+    if (is_static_metadata)
+    {
+      auto const search = _call_sites.find(log_metadata);
+
+      if (search != _call_sites.end())
+      {
+        return search->second;
+      }
+
+      call_site_id = static_cast<uint32_t>(_call_sites.size());
+      _call_sites.emplace(log_metadata, call_site_id);
+    }
+
+    _append_integral(static_cast<uint8_t>(detail::BinaryRecordType::CallSite));
+    _append_integral(call_site_id);
+    _append_integral(static_cast<uint8_t>(log_metadata->log_level()));
+    _append_string(log_metadata->source_location());
+    _append_string(log_metadata->caller_function());
+    _append_string(log_metadata->message_format());
+    _append_string(log_metadata->tags() ? std::string_view{log_metadata->tags()} : std::string_view{});
+
+    return call_site_id;
+  }
+
+  /***/
+  QUILL_ATTRIBUTE_HOT uint32_t _get_or_append_string(std::string_view value,
+                                                     std::pair<std::string, uint32_t>& last_value)
+  {
+    // Consecutive records almost always share the same logger and thread, avoid the hash lookup
+    if (QUILL_LIKELY((last_value.second != InvalidStringId) && (last_value.first == value)))
+    {
+      return last_value.second;
+    }
+
+    last_value.first.assign(value.data(), value.size());
+
+    auto const search = _strings.find(last_value.first);
+
+    if (search != _strings.end())
+    {
+      last_value.second = search->second;
+      return last_value.second;
+    }
+
+    last_value.second = static_cast<uint32_t>(_strings.size());
+    _strings.emplace(last_value.first, last_value.second);
+
+    _append_integral(static_cast<uint8_t>(detail::BinaryRecordType::String));
+    _append_integral(last_value.second);
+    _append_string(value);
+
+    return last_value.second;
+  }
+
+  /***/
+  void _reset_dictionary()
+  {
+    _call_sites.clear();
+    _strings.clear();
+    _last_logger_name.second = InvalidStringId;
+    _last_thread_id.second = InvalidStringId;
+    _last_thread_name.second = InvalidStringId;
+    _last_log_level_description.second = InvalidStringId;
+    _last_log_level_short_code.second = InvalidStringId;
+    _file_header_written = false;
+  }
+
+private:
+  static constexpr uint32_t InvalidStringId{0xFFFFFFFF};
+
+  fmtquill::memory_buffer _record;
+  std::unordered_map<MacroMetadata const*, uint32_t> _call_sites;
+  std::unordered_map<std::string, uint32_t> _strings;
+  std::pair<std::string, uint32_t> _last_logger_name{std::string{}, InvalidStringId};
+  std::pair<std::string, uint32_t> _last_thread_id{std::string{}, InvalidStringId};
+  std::pair<std::string, uint32_t> _last_thread_name{std::string{}, InvalidStringId};
+  std::pair<std::string, uint32_t> _last_log_level_description{std::string{}, InvalidStringId};
+  std::pair<std::string, uint32_t> _last_log_level_short_code{std::string{}, InvalidStringId};
+  bool _file_header_written{false};
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
@@ -0,0 +1,190 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/LogLevel.h"
+#include "quill/sinks/FileSink.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * @brief The configuration options for the CompressedFileSink, the FileSinkConfig options plus
+ * the compression level
+ */
+class CompressedFileSinkConfig : public FileSinkConfig
+{
+public:
+  CompressedFileSinkConfig() = default;
+
+  /**
+   * @brief Copies the FileSinkConfig options, the compression level keeps its default value
+   */
+  explicit CompressedFileSinkConfig(FileSinkConfig const& config) : FileSinkConfig(config) {}
+
+  /**
+   * @brief Sets the compression level of the compressor.
+   * @param value The compression level of the compressor, 0 selects its default level. The default
+   * value is 0.
+   */
+  QUILL_ATTRIBUTE_COLD void set_compression_level(int32_t value) { _compression_level = value; }
+
+  /** Getters **/
+  QUILL_NODISCARD int32_t compression_level() const noexcept { return _compression_level; }
+
+private:
+  int32_t _compression_level{0};
+};
+
+/**
+ * A FileSink that compresses the log statements on the backend thread before writing them.
+ *
+ * TCompressor is a streaming compressor, e.g. ZstdCompressor, Lz4Compressor or GzipCompressor
+ * from quill/sinks/compression. It is constructed with CompressedFileSinkConfig::compression_level().
+ *
+ * Each flush of the sink completes a compressed frame, so the file can be decoded up to the last
+ * flush even when the process crashes. Appending to an existing file or rotating it with
+ * RotatingSink, e.g. `RotatingCompressedFileSink<ZstdCompressor>`, always leaves a complete
+ * compressed stream in each file.
+ *
+ * @note The backend flushes its sinks whenever it runs out of messages to process. At low log
+ * rates the frames are small and compress less well.
+ * @note The before_write callback of the FileEventNotifier receives the uncompressed statement.
+ * @note The size based rotation of RotatingSink uses the compressed size of the file.
+ */
+template <typename TCompressor>
+class CompressedFileSink : public FileSink
+{
+public:
+  explicit CompressedFileSink(fs::path const& filename,
+                              CompressedFileSinkConfig const& config = CompressedFileSinkConfig{},
+                              FileEventNotifier file_event_notifier = FileEventNotifier{}, bool do_fopen = true,
+                              std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now())
+    : FileSink(filename, config, _without_before_write(file_event_notifier), do_fopen, start_time),
+      _before_write(std::move(file_event_notifier.before_write)),
+      _compressor(config.compression_level())
+  {
+  }
+
+  ~CompressedFileSink() override { _close_file_noexcept(); }
+
+  /**
+   * @brief The log statements are compressed one by one, they are not written in batches
+   */
+  QUILL_NODISCARD bool supports_batch_write() const noexcept override { return false; }
+
+  /**
+   * @brief The log statements are compressed, they are not formatted into the output buffer
+   */
+  QUILL_NODISCARD fmtquill::detail::buffer<char>* reserve_log_statement() override { return nullptr; }
+
+  /**
+   * @brief Compresses the log statement, the compressed output is written to the file
+   */
+  QUILL_ATTRIBUTE_HOT void write_log(MacroMetadata const* /* log_metadata */,
+                                     uint64_t /* log_timestamp */, std::string_view /* thread_id */,
+                                     std::string_view /* thread_name */, std::string const& /* process_id */,
+                                     std::string_view /* logger_name */, LogLevel /* log_level */,
+                                     std::string_view /* log_level_description */,
+                                     std::string_view /* log_level_short_code */,
+                                     std::vector<std::pair<std::string, std::string>> const* /* named_args */,
+                                     std::string_view /* log_message */, std::string_view log_statement) override
+  {
+    if (QUILL_UNLIKELY(!is_open()))
+    {
+      return;
+    }
+
+    if (_before_write)
+    {
+      std::string const user_log_statement = _before_write(log_statement);
+      _compressor.compress(user_log_statement, _compressed_writer());
+    }
+    else
+    {
+      _compressor.compress(log_statement, _compressed_writer());
+    }
+  }
+
+  /**
+   * @brief Completes the compressed frame and flushes the file
+   */
+  QUILL_ATTRIBUTE_HOT void flush_sink() override
+  {
+    if (is_open())
+    {
+      _compressor.end_frame(_compressed_writer());
+    }
+
+    FileSink::flush_sink();
+  }
+
+protected:
+  /**
+   * Completes the compressed frame before closing the file
+   */
+  void close_file()
+  {
+    if (is_open())
+    {
+      _compressor.end_frame(_compressed_writer());
+    }
+
+    FileSink::close_file();
+  }
+
+  void _close_file_noexcept() noexcept
+  {
+    QUILL_TRY { close_file(); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH_ALL() {}
+#endif
+  }
+
+private:
+  /**
+   * The FileSink must not call before_write with the compressed data, it is called by this sink
+   */
+  QUILL_NODISCARD static FileEventNotifier _without_before_write(FileEventNotifier const& file_event_notifier)
+  {
+    FileEventNotifier notifier = file_event_notifier;
+    notifier.before_write = nullptr;
+    return notifier;
+  }
+
+  /***/
+  QUILL_NODISCARD auto _compressed_writer()
+  {
+    return [this](char const* data, size_t size)
+    {
+      static std::string const process_id;
+      FileSink::write_log(nullptr, 0, std::string_view{}, std::string_view{}, process_id,
+                          std::string_view{}, LogLevel::None, std::string_view{}, std::string_view{},
+                          nullptr, std::string_view{}, std::string_view{data, size});
+    };
+  }
+
+private:
+  std::function<std::string(std::string_view)> _before_write;
+  TCompressor _compressor;
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
@@ -8,7 +8,10 @@
 
 #include "quill/core/Attributes.h"
 #include "quill/core/Common.h"
+#include "quill/core/DirectIoWriter.h"
 #include "quill/core/Filesystem.h"
+#include "quill/core/IoUringWriter.h"
+#include "quill/core/OutputBuffer.h"
 #include "quill/core/QuillError.h"
 #include "quill/core/ThreadPrimitives.h"
 #include "quill/core/TimeUtilities.h"
@@ -185,6 +188,92 @@ public:
     _minimum_fsync_interval = value;
   }
 
+  /**
+   * @brief Sets whether the file is written through io_uring.
+   *
+   * The log statements are copied into a pool of buffers, and each full buffer is written
+   * asynchronously. When fsync is enabled, the fsync is submitted asynchronously too. The
+   * backend thread reaps the completions in run_periodic_tasks() and does not wait for the writes
+   * or the fsync to complete.
+   *
+   * Each buffer has the size set by set_write_buffer_size(), or 64 KB when it is 0.
+   *
+   * @note Only available on Linux 5.6 or later. The sink falls back to the default write path
+   * when io_uring is not available or is disabled by the system.
+   * @note flush_log() returns after the writes are submitted to the kernel, not after they have
+   * completed.
+   * @note The file is written at explicit offsets, so other processes must not append to it.
+   *
+   * @param value True to write through io_uring, false otherwise. The default value is false.
+   */
+  QUILL_ATTRIBUTE_COLD void set_io_uring_enabled(bool value) { _io_uring_enabled = value; }
+
+  /**
+   * @brief Sets the number of buffers used by the io_uring write path.
+   * The writes block only when all the buffers are in flight. The default value is 8.
+   * @param value The number of buffers, must be greater than zero.
+   */
+  QUILL_ATTRIBUTE_COLD void set_io_uring_buffer_count(uint32_t value)
+  {
+    if (value == 0)
+    {
+      QUILL_THROW(QuillError{"io_uring_buffer_count must be greater than zero"});
+    }
+
+    _io_uring_buffer_count = value;
+  }
+
+  /**
+   * @brief Sets whether the file is written with O_DIRECT, bypassing the page cache.
+   *
+   * The log statements are accumulated in a 4 KiB aligned buffer of the size set by
+   * set_write_buffer_size(), or 64 KB when it is 0, and written in whole blocks. On flush, the
+   * unaligned tail is written padded to a whole block and the file is truncated back to its
+   * logical size. The tail is kept in the buffer and written again together with the next data.
+   *
+   * @note Only available on systems that support O_DIRECT, e.g. Linux. The sink falls back to the
+   * default write path when the file system does not support O_DIRECT.
+   * @note Can not be combined with set_io_uring_enabled().
+   *
+   * @param value True to write with O_DIRECT, false otherwise. The default value is false.
+   */
+  QUILL_ATTRIBUTE_COLD void set_direct_io(bool value) { _direct_io_enabled = value; }
+
+  /**
+   * @brief Sets whether the backend writes the log statements in batches.
+   *
+   * When the backend processes many log statements at once, it collects the log statements of
+   * the sink and passes them to Sink::write_log_batch(). Batches of at least 16 KB are written with
+   * a single writev() call instead of being copied to the stdio buffer one by one.
+   *
+   * @note Has no effect on Windows, or when io_uring or direct I/O is used.
+   * @note Sinks derived from FileSink that override write_log() must also override
+   * supports_batch_write() to return false.
+   *
+   * @param value True to write the log statements in batches, false otherwise. The default value
+   * is false.
+   */
+  QUILL_ATTRIBUTE_COLD void set_batch_write(bool value) { _batch_write_enabled = value; }
+
+  /**
+   * @brief Sets whether the backend formats the log statements directly into the output buffer
+   * of the sink.
+   *
+   * The sink owns a buffer of the size set by set_write_buffer_size(), or 64 KB when it is 0, and
+   * writes it to the unbuffered FILE* when it is full and on flush. The backend formats the log
+   * statement into it, so the log statement is not copied from the PatternFormatter buffer to the
+   * stdio buffer. It is only used when the sink is the only sink of the logger or has its own
+   * pattern formatter, otherwise the log statement is copied into the buffer.
+   *
+   * @note Only available on POSIX systems, it has no effect on Windows.
+   * @note Can not be combined with set_io_uring_enabled() or set_direct_io(), and it is not used
+   * when a before_write callback is set.
+   *
+   * @param value True to format into the output buffer of the sink, false otherwise. The default
+   * value is false.
+   */
+  QUILL_ATTRIBUTE_COLD void set_zero_copy_write(bool value) { _zero_copy_write_enabled = value; }
+
   /**
    * @brief Sets custom pattern formatter options for this sink.
    *
@@ -201,6 +290,11 @@ public:
 
   /** Getters **/
   QUILL_NODISCARD bool fsync_enabled() const noexcept { return _fsync_enabled; }
+  QUILL_NODISCARD bool io_uring_enabled() const noexcept { return _io_uring_enabled; }
+  QUILL_NODISCARD bool direct_io_enabled() const noexcept { return _direct_io_enabled; }
+  QUILL_NODISCARD bool batch_write_enabled() const noexcept { return _batch_write_enabled; }
+  QUILL_NODISCARD bool zero_copy_write_enabled() const noexcept { return _zero_copy_write_enabled; }
+  QUILL_NODISCARD uint32_t io_uring_buffer_count() const noexcept { return _io_uring_buffer_count; }
   QUILL_NODISCARD Timezone timezone() const noexcept { return _time_zone; }
   QUILL_NODISCARD FilenameAppendOption filename_append_option() const noexcept
   {
@@ -229,7 +323,12 @@ private:
   std::optional<PatternFormatterOptions> _override_pattern_formatter_options;
   Timezone _time_zone{Timezone::LocalTime};
   FilenameAppendOption _filename_append_option{FilenameAppendOption::None};
+  uint32_t _io_uring_buffer_count{8};
   bool _fsync_enabled{false};
+  bool _io_uring_enabled{false};
+  bool _direct_io_enabled{false};
+  bool _batch_write_enabled{false};
+  bool _zero_copy_write_enabled{false};
 };
 
 /**
@@ -669,6 +768,20 @@ public:
         QuillError{"Cannot set a non-zero minimum fsync interval when fsync is disabled."});
     }
 
+    if (_config.io_uring_enabled() && _config.direct_io_enabled())
+    {
+      QUILL_THROW(QuillError{"Cannot enable both io_uring and direct I/O for the same FileSink."});
+    }
+
+    if (_config.zero_copy_write_enabled() && (_config.io_uring_enabled() || _config.direct_io_enabled()))
+    {
+      QUILL_THROW(
+        QuillError{"Cannot enable zero copy write together with io_uring or direct I/O for the "
+                   "same FileSink."});
+    }
+
+    _zero_copy_write = _config.zero_copy_write_enabled() && !_file_event_notifier.before_write && !is_null();
+
     if (do_fopen)
     {
       open_file(_filename, _config.open_mode());
@@ -684,7 +797,31 @@ public:
       return;
     }
 
-    StreamSink::flush_sink();
+    if (_zero_copy_write)
+    {
+      _write_output_buffer();
+    }
+
+#if defined(QUILL_HAS_DIRECT_IO)
+    if (_direct_io_writer)
+    {
+      _direct_io_writer->flush();
+      _write_occurred = false;
+    }
+    else
+#endif
+#if defined(QUILL_HAS_IO_URING)
+    if (_io_uring_writer)
+    {
+      // Submitted without waiting, the completions are reaped in run_periodic_tasks()
+      _io_uring_writer->submit();
+      _write_occurred = false;
+    }
+    else
+#endif
+    {
+      StreamSink::flush_sink();
+    }
 
     if (_config.fsync_enabled())
     {
@@ -704,6 +841,125 @@ public:
     }
   }
 
+  /**
+   * @brief The log statements are written in batches when enabled in the config and the native
+   * io_uring or direct I/O writers are not used
+   */
+  QUILL_NODISCARD bool supports_batch_write() const noexcept override
+  {
+    return _config.batch_write_enabled() && !_zero_copy_write && !_has_native_writer();
+  }
+
+  /**
+   * @brief Returns the output buffer of the sink when zero copy write is enabled
+   */
+  QUILL_NODISCARD fmtquill::detail::buffer<char>* reserve_log_statement() override
+  {
+    if (!_zero_copy_write || QUILL_UNLIKELY(!_file))
+    {
+      return nullptr;
+    }
+
+    _discard_uncommitted_log_statement();
+
+    if (_output_committed_size >= _output_buffer_capacity())
+    {
+      _write_output_buffer();
+    }
+
+    return &_output_buffer;
+  }
+
+  /**
+   * @brief Commits the log statement formatted at the end of the output buffer
+   */
+  QUILL_ATTRIBUTE_HOT void commit_log_statement(LogRecordView const& /* record */,
+                                                std::string const& /* process_id */) override
+  {
+    _file_size += _output_buffer.size() - _output_committed_size;
+    _output_committed_size = _output_buffer.size();
+    _write_occurred = true;
+  }
+
+  QUILL_ATTRIBUTE_HOT void write_log(MacroMetadata const* log_metadata, uint64_t log_timestamp,
+                                     std::string_view thread_id, std::string_view thread_name,
+                                     std::string const& process_id, std::string_view logger_name,
+                                     LogLevel log_level, std::string_view log_level_description,
+                                     std::string_view log_level_short_code,
+                                     std::vector<std::pair<std::string, std::string>> const* named_args,
+                                     std::string_view log_message, std::string_view log_statement) override
+  {
+    if (_zero_copy_write)
+    {
+      // The log statement was formatted for another sink, it is copied to the output buffer
+      if (fmtquill::detail::buffer<char>* output_buffer = reserve_log_statement())
+      {
+        output_buffer->append(log_statement.data(), log_statement.data() + log_statement.size());
+        commit_log_statement(LogRecordView{}, process_id);
+      }
+
+      return;
+    }
+
+#if !defined(QUILL_HAS_IO_URING) && !defined(QUILL_HAS_DIRECT_IO)
+    StreamSink::write_log(log_metadata, log_timestamp, thread_id, thread_name, process_id,
+                          logger_name, log_level, log_level_description, log_level_short_code,
+                          named_args, log_message, log_statement);
+#else
+    if (!_has_native_writer())
+    {
+      StreamSink::write_log(log_metadata, log_timestamp, thread_id, thread_name, process_id,
+                            logger_name, log_level, log_level_description, log_level_short_code,
+                            named_args, log_message, log_statement);
+      return;
+    }
+
+    if (QUILL_UNLIKELY(!_file))
+    {
+      return;
+    }
+
+    std::string_view statement = log_statement;
+    std::string user_log_statement;
+
+    if (_file_event_notifier.before_write)
+    {
+      user_log_statement = _file_event_notifier.before_write(log_statement);
+      statement = user_log_statement;
+    }
+
+  #if defined(QUILL_HAS_DIRECT_IO)
+    if (_direct_io_writer)
+    {
+      _direct_io_writer->write(statement.data(), statement.size());
+    }
+  #endif
+
+  #if defined(QUILL_HAS_IO_URING)
+    if (_io_uring_writer)
+    {
+      _io_uring_writer->write(statement.data(), statement.size());
+    }
+  #endif
+
+    _file_size += statement.size();
+    _write_occurred = true;
+#endif
+  }
+
+#if defined(QUILL_HAS_IO_URING)
+  /**
+   * Processes the completed io_uring writes and fsync
+   */
+  QUILL_ATTRIBUTE_HOT void run_periodic_tasks() override
+  {
+    if (_io_uring_writer)
+    {
+      _io_uring_writer->reap();
+    }
+  }
+#endif
+
 private:
   struct OpenedFileGuard
   {
@@ -833,7 +1089,27 @@ protected:
                              " errno: " + std::to_string(errno) + " error: " + std::strerror(errno)});
     }
 
-    if (_config.write_buffer_size() != 0)
+#if defined(QUILL_HAS_IO_URING)
+    if (_config.io_uring_enabled() && !_io_uring_writer)
+    {
+      // Stays null when io_uring is not available and the FILE* is used instead
+      _io_uring_writer = detail::IoUringWriter::create(
+        (_config.write_buffer_size() == 0) ? default_io_uring_buffer_size : _config.write_buffer_size(),
+        _config.io_uring_buffer_count());
+    }
+#endif
+
+    if (_zero_copy_write)
+    {
+      // The sink buffers the log statements itself, fwrite writes them straight to the file
+      if (setvbuf(opened_file_guard.file, nullptr, _IONBF, 0) != 0)
+      {
+        QUILL_THROW(QuillError{std::string{"setvbuf failed error: "} + std::strerror(errno)});
+      }
+
+      _output_buffer.reserve(_output_buffer_capacity());
+    }
+    else if (_config.write_buffer_size() != 0)
     {
       write_buffer = std::make_unique<char[]>(_config.write_buffer_size());
 
@@ -850,6 +1126,20 @@ protected:
 
     _file = opened_file_guard.release();
     _write_buffer = std::move(write_buffer);
+
+#if defined(QUILL_HAS_IO_URING)
+    if (_io_uring_writer)
+    {
+      _attach_io_uring_writer();
+    }
+#endif
+
+#if defined(QUILL_HAS_DIRECT_IO)
+    if (_config.direct_io_enabled() && !is_null())
+    {
+      _attach_direct_io_writer(filename);
+    }
+#endif
   }
 
   void close_file()
@@ -859,6 +1149,52 @@ protected:
       return;
     }
 
+#if defined(QUILL_HAS_IO_URING)
+    if (_io_uring_writer)
+    {
+      QUILL_TRY { _detach_io_uring_writer(); }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH_ALL()
+      {
+        FILE* file = _file;
+        _file = nullptr;
+        std::fclose(file);
+        throw;
+      }
+  #endif
+    }
+#endif
+
+#if defined(QUILL_HAS_DIRECT_IO)
+    if (_direct_io_writer)
+    {
+      QUILL_TRY { _detach_direct_io_writer(); }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH_ALL()
+      {
+        FILE* file = _file;
+        _file = nullptr;
+        std::fclose(file);
+        throw;
+      }
+  #endif
+    }
+#endif
+
+    if (_zero_copy_write)
+    {
+      QUILL_TRY { _write_output_buffer(); }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH_ALL()
+      {
+        FILE* file = _file;
+        _file = nullptr;
+        std::fclose(file);
+        throw;
+      }
+  #endif
+    }
+
     if (_file_event_notifier.before_close)
     {
       QUILL_TRY { _file_event_notifier.before_close(_filename, _file); }
@@ -915,6 +1251,22 @@ protected:
       }
     }
 
+#if defined(QUILL_HAS_IO_URING)
+    if (_io_uring_writer)
+    {
+      if (!force_fsync)
+      {
+        // Runs after the submitted writes complete, a failure is reported by run_periodic_tasks()
+        _io_uring_writer->fsync();
+        _last_fsync_timestamp = fsync_timestamp;
+        return;
+      }
+
+      _io_uring_writer->submit();
+      _io_uring_writer->wait();
+    }
+#endif
+
     // Retry on EINTR — a signal delivered during fsync() causes it to fail transiently.
     int ret{0};
     do
@@ -939,6 +1291,119 @@ protected:
   QUILL_NODISCARD bool is_open() const noexcept { return _file != nullptr; }
 
 private:
+#if defined(QUILL_HAS_IO_URING)
+  /***/
+  void _attach_io_uring_writer()
+  {
+    // Anything the after_open callback wrote to the FILE* goes first
+    flush();
+
+    int const fd = fileno(_file);
+
+    // The writes use explicit offsets, which O_APPEND would ignore
+    int const flags = ::fcntl(fd, F_GETFL);
+    if ((flags != -1) && (flags & O_APPEND))
+    {
+      ::fcntl(fd, F_SETFL, flags & ~O_APPEND);
+    }
+
+    off_t const offset = ::lseek(fd, 0, SEEK_END);
+
+    if (offset == -1)
+    {
+      int const saved_errno = errno;
+      QUILL_THROW(QuillError{std::string{"lseek failed errno: "} + std::to_string(saved_errno) +
+                             " error: " + std::strerror(saved_errno)});
+    }
+
+    _io_uring_writer->attach(fd, static_cast<uint64_t>(offset));
+  }
+
+  /***/
+  void _detach_io_uring_writer()
+  {
+    _io_uring_writer->submit();
+    _io_uring_writer->wait();
+
+    // Anything the before_close callback writes to the FILE* goes after the submitted data
+    ::lseek(fileno(_file), static_cast<off_t>(_io_uring_writer->offset()), SEEK_SET);
+  }
+#endif
+
+#if defined(QUILL_HAS_DIRECT_IO)
+  /***/
+  void _attach_direct_io_writer(fs::path const& filename)
+  {
+    // Anything the after_open callback wrote to the FILE* goes first
+    flush();
+
+    // Stays null when the file system does not support O_DIRECT and the FILE* is used instead
+    _direct_io_writer = detail::DirectIoWriter::create(
+      filename, (_config.write_buffer_size() == 0) ? default_direct_io_buffer_size : _config.write_buffer_size());
+  }
+
+  /***/
+  void _detach_direct_io_writer()
+  {
+    std::unique_ptr<detail::DirectIoWriter> direct_io_writer = std::move(_direct_io_writer);
+    direct_io_writer->flush();
+
+    // Anything the before_close callback writes to the FILE* goes after the written data
+    ::lseek(fileno(_file), static_cast<off_t>(direct_io_writer->offset()), SEEK_SET);
+  }
+#endif
+
+  /**
+   * Writes the committed log statements of the output buffer to the file. A log statement that
+   * is formatted but not committed yet is moved to the start of the buffer
+   */
+  void _write_output_buffer()
+  {
+    if ((_output_committed_size == 0) || !_file)
+    {
+      return;
+    }
+
+    safe_fwrite(_output_buffer.data(), sizeof(char), _output_committed_size, _file);
+
+    size_t const uncommitted_size = _output_buffer.size() - _output_committed_size;
+    std::memmove(_output_buffer.data(), _output_buffer.data() + _output_committed_size, uncommitted_size);
+    _output_buffer.try_resize(uncommitted_size);
+    _output_committed_size = 0;
+  }
+
+  /***/
+  void _discard_uncommitted_log_statement() noexcept
+  {
+    _output_buffer.try_resize(_output_committed_size);
+  }
+
+  /***/
+  QUILL_NODISCARD size_t _output_buffer_capacity() const noexcept
+  {
+    return (_config.write_buffer_size() == 0) ? default_output_buffer_size : _config.write_buffer_size();
+  }
+
+  /***/
+  QUILL_NODISCARD bool _has_native_writer() const noexcept
+  {
+#if defined(QUILL_HAS_DIRECT_IO)
+    if (_direct_io_writer)
+    {
+      return true;
+    }
+#endif
+
+#if defined(QUILL_HAS_IO_URING)
+    if (_io_uring_writer)
+    {
+      return true;
+    }
+#endif
+
+    return false;
+  }
+
   QUILL_NODISCARD static fs::path _get_updated_filename_with_appended_datetime(
     fs::path const& filename, FilenameAppendOption append_to_filename_option,
     std::string const& append_filename_format_pattern, Timezone time_zone,
@@ -963,6 +1428,21 @@ protected:
   FileSinkConfig _config;
   std::chrono::steady_clock::time_point _last_fsync_timestamp{};
   std::unique_ptr<char[]> _write_buffer;
+
+  static constexpr size_t default_output_buffer_size{64 * 1024};
+  detail::OutputBuffer _output_buffer; /** The log statements when zero copy write is enabled **/
+  size_t _output_committed_size{0};    /** The size of _output_buffer up to the last commit **/
+  bool _zero_copy_write{false};
+
+#if defined(QUILL_HAS_IO_URING)
+  static constexpr size_t default_io_uring_buffer_size{64 * 1024};
+  std::unique_ptr<detail::IoUringWriter> _io_uring_writer;
+#endif
+
+#if defined(QUILL_HAS_DIRECT_IO)
+  static constexpr size_t default_direct_io_buffer_size{64 * 1024};
+  std::unique_ptr<detail::DirectIoWriter> _direct_io_writer;
+#endif
 };
 #endif
 
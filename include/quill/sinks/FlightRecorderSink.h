@@ -0,0 +1,424 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/LogLevel.h"
+#include "quill/core/PatternFormatterOptions.h"
+#include "quill/core/QuillError.h"
+#include "quill/sinks/Sink.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+  #include <algorithm>
+  #include <atomic>
+  #include <cerrno>
+
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+QUILL_BEGIN_NAMESPACE
+
+namespace detail
+{
+/**
+ * On-disk layout shared by FlightRecorderSink and FlightRecorderReader.
+ *
+ * The file is a FlightRecorderFileHeader followed by a data region of `capacity` bytes that is
+ * used as a circular buffer of records. Each record is a FlightRecorderRecordHeader followed by
+ * the log statement, padded to a multiple of FlightRecorderRecordAlignment. A record is never split
+ * at the end of the data region, the writer starts a new lap at offset 0 instead.
+ *
+ * The records in order are [oldest_offset, lap_end) of the previous lap followed by
+ * [0, write_offset) of the current lap. Integers are stored in the byte order of the writing host.
+ */
+struct FlightRecorderFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+  uint64_t capacity;      /**< The size of the data region */
+  uint64_t write_offset;  /**< The data offset of the next record of the current lap */
+  uint64_t lap_end;       /**< The data offset where the previous lap ended, 0 before the first lap */
+  uint64_t oldest_offset; /**< The data offset of the oldest record of the previous lap that is still intact */
+  uint64_t next_sequence; /**< The sequence number of the next record */
+  uint64_t reserved;
+};
+
+/***/
+struct FlightRecorderRecordHeader
+{
+  uint64_t sequence;
+  uint64_t timestamp;
+  uint32_t size;   /**< The size of the record including this header and the padding */
+  uint32_t length; /**< The length of the log statement */
+};
+
+static_assert(sizeof(FlightRecorderFileHeader) == 64, "Unexpected FlightRecorderFileHeader size");
+static_assert(sizeof(FlightRecorderRecordHeader) == 24, "Unexpected FlightRecorderRecordHeader size");
+
+static constexpr char FlightRecorderMagic[8] = {'Q', 'U', 'I', 'L', 'L', 'F', 'R', 'C'};
+static constexpr uint32_t FlightRecorderVersion{1};
+static constexpr uint32_t FlightRecorderByteOrderMark{0x01020304};
+static constexpr uint64_t FlightRecorderRecordAlignment{8};
+static constexpr size_t FlightRecorderMinCapacity{4096};
+
+/**
+ * Returns true when the header was written by a compatible FlightRecorderSink and its offsets are
+ * within a data region of data_size bytes
+ */
+QUILL_NODISCARD inline bool is_valid_flight_recorder_header(FlightRecorderFileHeader const& header,
+                                                            uint64_t data_size) noexcept
+{
+  return (std::memcmp(header.magic, FlightRecorderMagic, sizeof(FlightRecorderMagic)) == 0) &&
+    (header.version == FlightRecorderVersion) && (header.byte_order_mark == FlightRecorderByteOrderMark) &&
+    (header.capacity <= data_size) && ((header.capacity % FlightRecorderRecordAlignment) == 0) &&
+    (header.write_offset <= header.capacity) &&
+    (header.lap_end <= header.capacity) && (header.oldest_offset <= header.lap_end) &&
+    ((header.lap_end == 0) || (header.write_offset <= header.oldest_offset));
+}
+} // namespace detail
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * @brief Holds the configuration options for a FlightRecorderSink
+ */
+class FlightRecorderSinkConfig
+{
+public:
+  /**
+   * @brief Sets the size of the circular buffer, the file is this many bytes plus a 64 byte header.
+   * The default value is 16 MB.
+   * @param value The size in bytes, must be at least 4096 and a multiple of 8.
+   */
+  QUILL_ATTRIBUTE_COLD void set_capacity(size_t value)
+  {
+    if (value < detail::FlightRecorderMinCapacity)
+    {
+      QUILL_THROW(QuillError{"FlightRecorderSink capacity must be at least " +
+                             std::to_string(detail::FlightRecorderMinCapacity) + " bytes"});
+    }
+
+    // The records are padded to the alignment, a record that fills the whole buffer must not end
+    // past the data region
+    if ((value % detail::FlightRecorderRecordAlignment) != 0)
+    {
+      QUILL_THROW(QuillError{"FlightRecorderSink capacity must be a multiple of " +
+                             std::to_string(detail::FlightRecorderRecordAlignment) + " bytes"});
+    }
+
+    _capacity = value;
+  }
+
+  /**
+   * @brief Sets what happens to the records of an existing file.
+   * 'a' keeps them and appends to the circular buffer, 'w' starts with an empty buffer.
+   * An existing file with a different capacity is always started empty. The default value is 'a'.
+   * @param open_mode 'a' or 'w'
+   */
+  QUILL_ATTRIBUTE_COLD void set_open_mode(char open_mode)
+  {
+    if ((open_mode != 'a') && (open_mode != 'w'))
+    {
+      QUILL_THROW(QuillError{"Invalid open mode for FlightRecorderSink"});
+    }
+
+    _open_mode = open_mode;
+  }
+
+  /**
+   * @brief Sets custom pattern formatter options for this sink.
+   * @param options The pattern formatter options to use
+   */
+  QUILL_ATTRIBUTE_COLD void set_override_pattern_formatter_options(std::optional<PatternFormatterOptions> const& options)
+  {
+    _override_pattern_formatter_options = options;
+  }
+
+  /** Getters **/
+  QUILL_NODISCARD size_t capacity() const noexcept { return _capacity; }
+  QUILL_NODISCARD char open_mode() const noexcept { return _open_mode; }
+  QUILL_NODISCARD std::optional<PatternFormatterOptions> const& override_pattern_formatter_options() const noexcept
+  {
+    return _override_pattern_formatter_options;
+  }
+
+private:
+  std::optional<PatternFormatterOptions> _override_pattern_formatter_options;
+  size_t _capacity{16u * 1024u * 1024u};
+  char _open_mode{'a'};
+};
+
+#if !defined(_WIN32)
+/**
+ * A sink that keeps the most recent log statements in a fixed size memory mapped file, laid out as
+ * a circular buffer of records with sequence numbers.
+ *
+ * The log statements are copied into a shared mapping of the file without any system call. The
+ * page cache owns the data, so the records survive when the process is killed, e.g. by SIGKILL or
+ * the OOM killer. The file is read back in order with FlightRecorderReader or the
+ * `quill_flight_recorder` tool.
+ *
+ * It is meant to keep a full history at a verbose level without paying for the disk I/O of it,
+ * e.g. a logger at LogLevel::Debug with a FileSink at LogLevel::Warning and a FlightRecorderSink.
+ *
+ * @note The data reaches the disk through the normal write back of the kernel, it is lost if the
+ * host itself crashes before that.
+ * @note Not available on Windows.
+ */
+class FlightRecorderSink : public Sink
+{
+public:
+  /**
+   * Opens or creates the file and maps it
+   * @param filename The path of the file
+   * @param config The configuration of the sink
+   * @throws QuillError if the file can not be created or mapped
+   */
+  explicit FlightRecorderSink(fs::path const& filename, FlightRecorderSinkConfig const& config = FlightRecorderSinkConfig{})
+    : Sink(config.override_pattern_formatter_options()), _filename(filename)
+  {
+    QUILL_TRY { _open(config); }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH_ALL()
+    {
+      _close();
+      throw;
+    }
+  #endif
+  }
+
+  ~FlightRecorderSink() override { _close(); }
+
+  /**
+   * @brief Copies the log statement into the circular buffer as a new record
+   */
+  QUILL_ATTRIBUTE_HOT void write_log(MacroMetadata const* /* log_metadata */, uint64_t log_timestamp,
+                                     std::string_view /* thread_id */, std::string_view /* thread_name */,
+                                     std::string const& /* process_id */, std::string_view /* logger_name */,
+                                     LogLevel /* log_level */, std::string_view /* log_level_description */,
+                                     std::string_view /* log_level_short_code */,
+                                     std::vector<std::pair<std::string, std::string>> const* /* named_args */,
+                                     std::string_view /* log_message */, std::string_view log_statement) override
+  {
+    // A log statement that does not fit in the buffer is truncated
+    uint64_t const max_length = (std::min)(
+      _header->capacity - sizeof(detail::FlightRecorderRecordHeader),
+      static_cast<uint64_t>((std::numeric_limits<uint32_t>::max)() - detail::FlightRecorderRecordAlignment -
+                            sizeof(detail::FlightRecorderRecordHeader)));
+
+    auto const length =
+      static_cast<uint32_t>((std::min)(static_cast<uint64_t>(log_statement.size()), max_length));
+
+    uint64_t const record_size = _align_record_size(sizeof(detail::FlightRecorderRecordHeader) + length);
+
+    uint64_t write_offset = _header->write_offset;
+    uint64_t lap_end = _header->lap_end;
+    uint64_t oldest_offset = _header->oldest_offset;
+
+    if (write_offset + record_size > _header->capacity)
+    {
+      // Start a new lap, the records of the lap before the previous one are dropped
+      lap_end = write_offset;
+      write_offset = 0;
+      oldest_offset = 0;
+    }
+
+    // Drop the records of the previous lap that the new record overwrites
+    while ((oldest_offset < lap_end) && (oldest_offset < write_offset + record_size))
+    {
+      uint32_t const size = _record_header(oldest_offset)->size;
+      oldest_offset = (size < sizeof(detail::FlightRecorderRecordHeader)) ? lap_end : oldest_offset + size;
+    }
+
+    if (oldest_offset >= lap_end)
+    {
+      // No record of the previous lap is left
+      lap_end = 0;
+      oldest_offset = 0;
+    }
+
+    // The process can die at any point, the header must not reference the record before it is
+    // complete or a record that is being overwritten. The signal fences keep the compiler from
+    // reordering the stores to the mapping
+    _header->lap_end = lap_end;
+    _header->oldest_offset = oldest_offset;
+    _header->write_offset = write_offset;
+    std::atomic_signal_fence(std::memory_order_release);
+
+    detail::FlightRecorderRecordHeader* record_header = _record_header(write_offset);
+    record_header->sequence = _header->next_sequence;
+    record_header->timestamp = log_timestamp;
+    record_header->size = static_cast<uint32_t>(record_size);
+    record_header->length = length;
+    std::memcpy(record_header + 1, log_statement.data(), length);
+    std::atomic_signal_fence(std::memory_order_release);
+
+    _header->write_offset = write_offset + record_size;
+    _header->next_sequence += 1;
+    _write_occurred = true;
+  }
+
+  /**
+   * @brief Starts the write back of the mapping without waiting for it. The records do not depend
+   * on it to survive the process
+   */
+  QUILL_ATTRIBUTE_HOT void flush_sink() override
+  {
+    if (!_write_occurred)
+    {
+      return;
+    }
+
+    _write_occurred = false;
+    ::msync(_mapping, _mapping_size, MS_ASYNC);
+  }
+
+  /**
+   * @return The path of the file
+   */
+  QUILL_NODISCARD fs::path const& get_filename() const noexcept { return _filename; }
+
+private:
+  /***/
+  void _open(FlightRecorderSinkConfig const& config)
+  {
+    int fd{-1};
+    do
+    {
+      fd = ::open(_filename.string().data(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    } while ((fd == -1) && (errno == EINTR));
+
+    if (fd == -1)
+    {
+      _throw_errno("open");
+    }
+
+    _fd = fd;
+
+    struct stat file_stat;
+    if (::fstat(_fd, &file_stat) != 0)
+    {
+      _throw_errno("fstat");
+    }
+
+    _mapping_size = sizeof(detail::FlightRecorderFileHeader) + config.capacity();
+    bool const existing_file = static_cast<size_t>(file_stat.st_size) >= sizeof(detail::FlightRecorderFileHeader);
+
+    if (static_cast<size_t>(file_stat.st_size) != _mapping_size)
+    {
+      if (::ftruncate(_fd, static_cast<off_t>(_mapping_size)) != 0)
+      {
+        _throw_errno("ftruncate");
+      }
+    }
+
+  #if !defined(__APPLE__)
+    // Allocating the blocks up front avoids a SIGBUS when the disk fills up while writing to the mapping
+    int ret{0};
+    do
+    {
+      ret = ::posix_fallocate(_fd, 0, static_cast<off_t>(_mapping_size));
+    } while (ret == EINTR);
+
+    if (ret != 0)
+    {
+      errno = ret;
+      _throw_errno("fallocate");
+    }
+  #endif
+
+    void* mapping = ::mmap(nullptr, _mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+      _throw_errno("mmap");
+    }
+
+    _mapping = static_cast<std::byte*>(mapping);
+    _header = reinterpret_cast<detail::FlightRecorderFileHeader*>(_mapping);
+
+    // The records of an existing file are kept when it was written with the same capacity
+    bool const keep_records = existing_file && (config.open_mode() == 'a') &&
+      detail::is_valid_flight_recorder_header(*_header, config.capacity()) &&
+      (_header->capacity == config.capacity());
+
+    if (!keep_records)
+    {
+      std::memset(_header, 0, sizeof(detail::FlightRecorderFileHeader));
+      std::memcpy(_header->magic, detail::FlightRecorderMagic, sizeof(detail::FlightRecorderMagic));
+      _header->version = detail::FlightRecorderVersion;
+      _header->byte_order_mark = detail::FlightRecorderByteOrderMark;
+      _header->capacity = config.capacity();
+    }
+  }
+
+  /***/
+  void _close() noexcept
+  {
+    if (_mapping)
+    {
+      ::munmap(_mapping, _mapping_size);
+      _mapping = nullptr;
+      _header = nullptr;
+    }
+
+    if (_fd != -1)
+    {
+      ::close(_fd);
+      _fd = -1;
+    }
+  }
+
+  /***/
+  QUILL_NODISCARD detail::FlightRecorderRecordHeader* _record_header(uint64_t data_offset) const noexcept
+  {
+    return reinterpret_cast<detail::FlightRecorderRecordHeader*>(
+      _mapping + sizeof(detail::FlightRecorderFileHeader) + data_offset);
+  }
+
+  /***/
+  QUILL_NODISCARD static uint64_t _align_record_size(uint64_t size) noexcept
+  {
+    return (size + detail::FlightRecorderRecordAlignment - 1) & ~(detail::FlightRecorderRecordAlignment - 1);
+  }
+
+  /***/
+  static void _throw_errno(char const* function)
+  {
+    int const saved_errno = errno;
+    QUILL_THROW(QuillError{std::string{function} + " failed errno: " + std::to_string(saved_errno) +
+                           " error: " + std::strerror(saved_errno)});
+  }
+
+private:
+  fs::path _filename;
+  std::byte* _mapping{nullptr};
+  detail::FlightRecorderFileHeader* _header{nullptr};
+  size_t _mapping_size{0};
+  int _fd{-1};
+  bool _write_occurred{false};
+};
+#endif
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
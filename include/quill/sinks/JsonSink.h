@@ -8,7 +8,9 @@
 
 #include "quill/bundled/fmt/base.h"
 #include "quill/core/Attributes.h"
+#include "quill/core/CallSiteCache.h"
 #include "quill/core/Filesystem.h"
+#include "quill/core/JsonEscape.h"
 #include "quill/core/LogLevel.h"
 #include "quill/core/MacroMetadata.h"
 #include "quill/sinks/FileSink.h"
@@ -41,6 +43,17 @@ public:
 
   ~JsonSink() override = default;
 
+  /**
+   * @brief The JSON message is generated for each log statement, they are not written in batches
+   */
+  QUILL_NODISCARD bool supports_batch_write() const noexcept override { return false; }
+
+  /**
+   * @brief The JSON message is written instead of the log statement, it is not formatted into the
+   * output buffer of the sink
+   */
+  QUILL_NODISCARD fmtquill::detail::buffer<char>* reserve_log_statement() override { return nullptr; }
+
   /**
    * @brief Logs a formatted log message to the sink.
    * @note Accessor for backend processing.
@@ -116,12 +129,33 @@ public:
     std::vector<std::pair<std::string, std::string>> const* named_args,
     std::string_view /** log_message **/, std::string_view /** log_statement **/, char const* message_format)
   {
+    // The escaped file name, line and message format are rendered once per call site
+    JsonCallSiteFragments const* call_site_fragments = _call_site_fragments.get(
+      log_metadata,
+      [log_metadata, message_format](JsonCallSiteFragments& fragments)
+      {
+        fragments.file_name_and_line = _json_escaped(log_metadata->file_name());
+        fragments.file_name_and_line.append("\",\"line\":\"");
+        fragments.file_name_and_line.append(_json_escaped(log_metadata->line()));
+        fragments.message = _json_escaped(message_format);
+      });
+
     _json_message.append(std::string_view{"{\"timestamp\":\""});
-    _append_json_escaped(_json_message, std::to_string(log_timestamp));
+    fmtquill::format_int const timestamp{log_timestamp};
+    _json_message.append(std::string_view{timestamp.data(), timestamp.size()});
     _json_message.append(std::string_view{"\",\"file_name\":\""});
-    _append_json_escaped(_json_message, log_metadata->file_name());
-    _json_message.append(std::string_view{"\",\"line\":\""});
-    _append_json_escaped(_json_message, log_metadata->line());
+
+    if (call_site_fragments)
+    {
+      _json_message.append(call_site_fragments->file_name_and_line);
+    }
+    else
+    {
+      _append_json_escaped(_json_message, log_metadata->file_name());
+      _json_message.append(std::string_view{"\",\"line\":\""});
+      _append_json_escaped(_json_message, log_metadata->line());
+    }
+
     _json_message.append(std::string_view{"\",\"thread_id\":\""});
     _append_json_escaped(_json_message, thread_id);
     _json_message.append(std::string_view{"\",\"logger\":\""});
@@ -129,7 +163,16 @@ public:
     _json_message.append(std::string_view{"\",\"log_level\":\""});
     _append_json_escaped(_json_message, log_level_description);
     _json_message.append(std::string_view{"\",\"message\":\""});
-    _append_json_escaped(_json_message, message_format);
+
+    if (call_site_fragments)
+    {
+      _json_message.append(call_site_fragments->message);
+    }
+    else
+    {
+      _append_json_escaped(_json_message, message_format);
+    }
+
     _json_message.append(std::string_view{"\""});
 
     // Add args as key-values
@@ -217,77 +260,27 @@ protected:
       (key == "thread_id") || (key == "logger") || (key == "log_level") || (key == "message");
   }
 
+  QUILL_NODISCARD static std::string _json_escaped(std::string_view value)
+  {
+    fmtquill::memory_buffer escaped;
+    _append_json_escaped(escaped, value);
+    return std::string{escaped.data(), escaped.size()};
+  }
+
   static void _append_json_escaped(fmtquill::memory_buffer& out, std::string_view value)
   {
-    // Pre-computed escape table for control characters (0x00..0x1F). Each entry is the 6-byte
-    // \uXXXX form. Faster and locale-safe compared to per-byte snprintf.
-    static constexpr char control_escape_table[32][7] = {
-      "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
-      "\\u0008", "\\u0009", "\\u000A", "\\u000B", "\\u000C", "\\u000D", "\\u000E", "\\u000F",
-      "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
-      "\\u0018", "\\u0019", "\\u001A", "\\u001B", "\\u001C", "\\u001D", "\\u001E", "\\u001F"};
-
-    size_t const size = value.size();
-    char const* const data = value.data();
-
-    for (size_t i = 0; i < size; ++i)
-    {
-      unsigned char const c = static_cast<unsigned char>(data[i]);
-      switch (c)
-      {
-      case '"':
-        out.append(std::string_view{"\\\""});
-        break;
-      case '\\':
-        out.append(std::string_view{"\\\\"});
-        break;
-      case '\b':
-        out.append(std::string_view{"\\b"});
-        break;
-      case '\f':
-        out.append(std::string_view{"\\f"});
-        break;
-      case '\n':
-        out.append(std::string_view{"\\n"});
-        break;
-      case '\r':
-        out.append(std::string_view{"\\r"});
-        break;
-      case '\t':
-        out.append(std::string_view{"\\t"});
-        break;
-      // U+2028 (LINE SEPARATOR) and U+2029 (PARAGRAPH SEPARATOR) are valid JSON characters
-      // but they break some JavaScript consumers that treat JSON as JS source. Escape the
-      // 3-byte UTF-8 sequences E2 80 A8 and E2 80 A9 when we see them.
-      case 0xE2:
-        if (i + 2 < size && static_cast<unsigned char>(data[i + 1]) == 0x80 &&
-            (static_cast<unsigned char>(data[i + 2]) == 0xA8 || static_cast<unsigned char>(data[i + 2]) == 0xA9))
-        {
-          out.append(static_cast<unsigned char>(data[i + 2]) == 0xA8 ? std::string_view{"\\u2028"}
-                                                                     : std::string_view{"\\u2029"});
-          i += 2;
-        }
-        else
-        {
-          out.push_back(static_cast<char>(c));
-        }
-        break;
-      default:
-        if (c < 0x20)
-        {
-          out.append(std::string_view{control_escape_table[c], 6});
-        }
-        else
-        {
-          out.push_back(static_cast<char>(c));
-        }
-        break;
-      }
-    }
+    detail::append_json_escaped(out, value);
   }
 
+  struct JsonCallSiteFragments
+  {
+    std::string file_name_and_line;
+    std::string message;
+  };
+
   fmtquill::memory_buffer _json_message;
   std::string _format;
+  CallSiteCache<JsonCallSiteFragments> _call_site_fragments;
   bool _json_message_ready{false};
 };
 } // namespace detail
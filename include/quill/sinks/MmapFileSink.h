@@ -0,0 +1,400 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/QuillError.h"
+#include "quill/sinks/FileSink.h"
+
+#if !defined(_WIN32)
+  #include <algorithm>
+  #include <cerrno>
+  #include <chrono>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstdio>
+  #include <cstring>
+  #include <string>
+  #include <string_view>
+  #include <system_error>
+  #include <utility>
+  #include <vector>
+
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * @brief The configuration options for the MmapFileSink
+ */
+class MmapFileSinkConfig : public FileSinkConfig
+{
+public:
+  static constexpr size_t default_mmap_window_size{16 * 1024 * 1024};
+
+  MmapFileSinkConfig() = default;
+
+  /**
+   * @brief Copies the FileSinkConfig options, the window size keeps its default value
+   */
+  explicit MmapFileSinkConfig(FileSinkConfig const& config) : FileSinkConfig(config) {}
+
+  /**
+   * @brief Sets the size of the memory mapped window.
+   *
+   * The file is extended and remapped by this many bytes at a time. The value is rounded up to a
+   * multiple of the page size. The default value is 16 MB.
+   *
+   * @param value The window size in bytes, must be greater than zero.
+   */
+  QUILL_ATTRIBUTE_COLD void set_mmap_window_size(size_t value)
+  {
+    if (value == 0)
+    {
+      QUILL_THROW(QuillError{"mmap_window_size must be greater than zero"});
+    }
+
+    _mmap_window_size = value;
+  }
+
+  /** Getters **/
+  QUILL_NODISCARD size_t mmap_window_size() const noexcept { return _mmap_window_size; }
+
+private:
+  size_t _mmap_window_size{default_mmap_window_size};
+};
+
+/**
+ * A FileSink that writes the log statements into a memory mapping of the file.
+ *
+ * The file is mapped in windows of MmapFileSinkConfig::mmap_window_size() bytes. The file is extended
+ * by a whole window with fallocate each time a new window is mapped, and the log statements are
+ * copied straight into the mapping, without any write system call or stdio lock. The dirty pages
+ * are handed to the kernel with an asynchronous msync in run_periodic_tasks(), and the file is
+ * truncated back to the size of the written data when it is closed or rotated.
+ *
+ * It can be used with RotatingSink, see RotatingMmapFileSink.
+ *
+ * @note While the file is open, it is larger than the written data and the end of it is filled
+ * with zeros. Readers such as `tail -f` see the data as soon as it is copied to the mapping.
+ * @note The io_uring, direct I/O, batch write and zero copy write options of FileSinkConfig do
+ * not apply to this sink.
+ * @note Not available on Windows.
+ */
+class MmapFileSink : public FileSink
+{
+public:
+  explicit MmapFileSink(fs::path const& filename, MmapFileSinkConfig const& config = MmapFileSinkConfig{},
+                        FileEventNotifier file_event_notifier = FileEventNotifier{}, bool do_fopen = true,
+                        std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now())
+    : FileSink(filename, _make_mmap_config(config), std::move(file_event_notifier), false, start_time),
+      _mmap_window_size(config.mmap_window_size())
+  {
+    if (do_fopen)
+    {
+      open_file(_filename, _config.open_mode());
+    }
+  }
+
+  ~MmapFileSink() override { _close_file_noexcept(); }
+
+  /**
+   * @brief Copies the log statement to the memory mapping of the file
+   */
+  QUILL_ATTRIBUTE_HOT void write_log(MacroMetadata const* /* log_metadata */,
+                                     uint64_t /* log_timestamp */, std::string_view /* thread_id */,
+                                     std::string_view /* thread_name */, std::string const& /* process_id */,
+                                     std::string_view /* logger_name */, LogLevel /* log_level */,
+                                     std::string_view /* log_level_description */,
+                                     std::string_view /* log_level_short_code */,
+                                     std::vector<std::pair<std::string, std::string>> const* /* named_args */,
+                                     std::string_view /* log_message */, std::string_view log_statement) override
+  {
+    if (QUILL_UNLIKELY(!_file || is_null()))
+    {
+      return;
+    }
+
+    if (_file_event_notifier.before_write)
+    {
+      std::string const user_log_statement = _file_event_notifier.before_write(log_statement);
+      _write_to_mapping(user_log_statement.data(), user_log_statement.size());
+    }
+    else
+    {
+      _write_to_mapping(log_statement.data(), log_statement.size());
+    }
+  }
+
+  /**
+   * @brief The data is already in the page cache, only the fsync is done when enabled
+   */
+  QUILL_ATTRIBUTE_HOT void flush_sink() override
+  {
+    if (!_write_occurred || !_file)
+    {
+      return;
+    }
+
+    _write_occurred = false;
+
+    if (_config.fsync_enabled())
+    {
+      fsync_file();
+    }
+
+    std::error_code ec;
+    if (!fs::exists(_filename, ec))
+    {
+      close_file();
+      open_file(_filename, _config.open_mode());
+
+      // Resync _file_size with the reopened file; RotatingSink relies on it for size-based rotation
+      _file_size = static_cast<size_t>(_write_offset);
+    }
+  }
+
+  /**
+   * @brief Starts the write back of the pages written since the last call without waiting for it
+   */
+  QUILL_ATTRIBUTE_HOT void run_periodic_tasks() override
+  {
+    if (!_window || (_synced_offset == _write_offset))
+    {
+      return;
+    }
+
+    // msync requires a page aligned address
+    uint64_t const sync_begin = (_synced_offset / _page_size) * _page_size;
+    ::msync(_window + (sync_begin - _window_offset), static_cast<size_t>(_write_offset - sync_begin), MS_ASYNC);
+    _synced_offset = _write_offset;
+  }
+
+protected:
+  /**
+   * Opens the file. The mapping is created on the first write, so an empty file stays empty
+   */
+  void open_file(fs::path const& filename, std::string const& mode)
+  {
+    FileSink::open_file(filename, mode);
+
+    if (is_null())
+    {
+      return;
+    }
+
+    // Anything the after_open callback wrote to the FILE* goes first
+    flush();
+
+    // A shared writable mapping requires a descriptor opened for reading and writing
+    int fd{-1};
+    do
+    {
+      fd = ::open(filename.string().data(), O_RDWR | O_CLOEXEC);
+    } while ((fd == -1) && (errno == EINTR));
+
+    if (fd == -1)
+    {
+      _throw_errno("open");
+    }
+
+    off_t const offset = ::lseek(fd, 0, SEEK_END);
+
+    if (offset == -1)
+    {
+      int const saved_errno = errno;
+      ::close(fd);
+      errno = saved_errno;
+      _throw_errno("lseek");
+    }
+
+    _mmap_fd = fd;
+    _write_offset = static_cast<uint64_t>(offset);
+    _synced_offset = _write_offset;
+  }
+
+  /**
+   * Unmaps the file and truncates it to the size of the written data before closing it
+   */
+  void close_file()
+  {
+    if (!_file)
+    {
+      return;
+    }
+
+    if (_mmap_fd != -1)
+    {
+      QUILL_TRY { _unmap_and_truncate(); }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH_ALL()
+      {
+        FILE* file = _file;
+        _file = nullptr;
+        std::fclose(file);
+        throw;
+      }
+  #endif
+    }
+
+    FileSink::close_file();
+  }
+
+  void _close_file_noexcept() noexcept
+  {
+    QUILL_TRY { close_file(); }
+  #if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH_ALL() {}
+  #endif
+  }
+
+private:
+  /***/
+  QUILL_NODISCARD static FileSinkConfig _make_mmap_config(MmapFileSinkConfig const& config)
+  {
+    FileSinkConfig mmap_config = config;
+
+    // The statements are copied to the mapping, the FILE* is only used by the callbacks
+    mmap_config.set_io_uring_enabled(false);
+    mmap_config.set_direct_io(false);
+    mmap_config.set_batch_write(false);
+    mmap_config.set_zero_copy_write(false);
+    mmap_config.set_write_buffer_size(0);
+    return mmap_config;
+  }
+
+  /***/
+  void _write_to_mapping(char const* data, size_t size)
+  {
+    _file_size += size;
+    _write_occurred = true;
+
+    while (size != 0)
+    {
+      if (!_window || (_write_offset == _window_offset + _window_size))
+      {
+        _map_window();
+      }
+
+      auto const bytes =
+        static_cast<size_t>((std::min)(static_cast<uint64_t>(size), _window_offset + _window_size - _write_offset));
+
+      std::memcpy(_window + (_write_offset - _window_offset), data, bytes);
+      _write_offset += bytes;
+      data += bytes;
+      size -= bytes;
+    }
+  }
+
+  /**
+   * Maps the window that contains _write_offset and extends the file to the end of it
+   */
+  void _map_window()
+  {
+    if (_window)
+    {
+      run_periodic_tasks();
+      ::munmap(_window, _window_size);
+      _window = nullptr;
+    }
+
+    int const fd = _mmap_fd;
+
+    _page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    _window_size = ((_mmap_window_size + _page_size - 1) / _page_size) * _page_size;
+    uint64_t const window_offset = (_write_offset / _window_size) * _window_size;
+
+  #if defined(__APPLE__)
+    // No fallocate, the file is extended sparse
+    int const ret = ::ftruncate(fd, static_cast<off_t>(window_offset + _window_size)) == 0 ? 0 : errno;
+  #else
+    // Allocating the blocks up front avoids a SIGBUS when the disk fills up while writing to the mapping
+    int ret{0};
+    do
+    {
+      ret = ::posix_fallocate(fd, static_cast<off_t>(window_offset), static_cast<off_t>(_window_size));
+    } while (ret == EINTR);
+  #endif
+
+    if (ret != 0)
+    {
+      errno = ret;
+      _throw_errno("fallocate");
+    }
+
+    void* window = ::mmap(nullptr, _window_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                          static_cast<off_t>(window_offset));
+
+    if (window == MAP_FAILED)
+    {
+      _throw_errno("mmap");
+    }
+
+    _window = static_cast<char*>(window);
+    _window_offset = window_offset;
+  }
+
+  /***/
+  void _unmap_and_truncate()
+  {
+    int const fd = _mmap_fd;
+    _mmap_fd = -1;
+
+    if (_window)
+    {
+      run_periodic_tasks();
+      ::munmap(_window, _window_size);
+      _window = nullptr;
+      _window_offset = 0;
+      _window_size = 0;
+    }
+
+    int ret{0};
+    do
+    {
+      ret = ::ftruncate(fd, static_cast<off_t>(_write_offset));
+    } while ((ret != 0) && (errno == EINTR));
+
+    ::close(fd);
+
+    if (ret != 0)
+    {
+      _throw_errno("ftruncate");
+    }
+
+    // Anything the before_close callback writes to the FILE* goes after the written data
+    ::lseek(fileno(_file), static_cast<off_t>(_write_offset), SEEK_SET);
+  }
+
+  /***/
+  static void _throw_errno(char const* function)
+  {
+    int const saved_errno = errno;
+    QUILL_THROW(QuillError{std::string{function} + " failed errno: " + std::to_string(saved_errno) +
+                           " error: " + std::strerror(saved_errno)});
+  }
+
+private:
+  size_t _mmap_window_size; /**< MmapFileSinkConfig::mmap_window_size(), before rounding to pages */
+  char* _window{nullptr};
+  uint64_t _window_offset{0}; /**< The file offset of the start of the mapped window */
+  size_t _window_size{0};
+  size_t _page_size{0};
+  uint64_t _write_offset{0};  /**< The file offset of the next write, the size of the written data */
+  uint64_t _synced_offset{0}; /**< The file offset up to which msync was requested */
+  int _mmap_fd{-1};
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
+#endif
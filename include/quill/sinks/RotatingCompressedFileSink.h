@@ -0,0 +1,54 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/sinks/CompressedFileSink.h"
+#include "quill/sinks/FileSink.h"
+#include "quill/sinks/RotatingSink.h"
+
+#include <cstdint>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * @brief The configuration options for the RotatingCompressedFileSink, the RotatingFileSinkConfig
+ * options plus the CompressedFileSinkConfig ones
+ */
+class RotatingCompressedFileSinkConfig : public RotatingFileSinkConfig
+{
+public:
+  /**
+   * @brief Sets the compression level, see CompressedFileSinkConfig::set_compression_level()
+   */
+  QUILL_ATTRIBUTE_COLD void set_compression_level(int32_t value) { _compression_level = value; }
+
+  /** Getters **/
+  QUILL_NODISCARD int32_t compression_level() const noexcept { return _compression_level; }
+
+  /**
+   * @brief The configuration of the CompressedFileSink that writes the current file
+   */
+  operator CompressedFileSinkConfig() const
+  {
+    CompressedFileSinkConfig compressed_config{static_cast<FileSinkConfig const&>(*this)};
+    compressed_config.set_compression_level(_compression_level);
+    return compressed_config;
+  }
+
+private:
+  int32_t _compression_level{0};
+};
+
+template <typename TCompressor>
+using RotatingCompressedFileSink = RotatingSink<CompressedFileSink<TCompressor>, RotatingCompressedFileSinkConfig>;
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
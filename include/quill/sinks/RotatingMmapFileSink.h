@@ -0,0 +1,64 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/QuillError.h"
+#include "quill/sinks/FileSink.h"
+#include "quill/sinks/MmapFileSink.h"
+#include "quill/sinks/RotatingSink.h"
+
+#include <cstddef>
+
+#if !defined(_WIN32)
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * @brief The configuration options for the RotatingMmapFileSink, the RotatingFileSinkConfig
+ * options plus the MmapFileSinkConfig ones
+ */
+class RotatingMmapFileSinkConfig : public RotatingFileSinkConfig
+{
+public:
+  /**
+   * @brief Sets the size of the memory mapped window, see MmapFileSinkConfig::set_mmap_window_size()
+   */
+  QUILL_ATTRIBUTE_COLD void set_mmap_window_size(size_t value)
+  {
+    if (value == 0)
+    {
+      QUILL_THROW(QuillError{"mmap_window_size must be greater than zero"});
+    }
+
+    _mmap_window_size = value;
+  }
+
+  /** Getters **/
+  QUILL_NODISCARD size_t mmap_window_size() const noexcept { return _mmap_window_size; }
+
+  /**
+   * @brief The configuration of the MmapFileSink that writes the current file
+   */
+  operator MmapFileSinkConfig() const
+  {
+    MmapFileSinkConfig mmap_config{static_cast<FileSinkConfig const&>(*this)};
+    mmap_config.set_mmap_window_size(_mmap_window_size);
+    return mmap_config;
+  }
+
+private:
+  size_t _mmap_window_size{MmapFileSinkConfig::default_mmap_window_size};
+};
+
+using RotatingMmapFileSink = RotatingSink<MmapFileSink, RotatingMmapFileSinkConfig>;
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
+#endif
@@ -17,13 +17,18 @@
 
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <ctime>
 #include <deque>
+#include <functional>
 #include <limits>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -34,6 +39,12 @@ QUILL_BEGIN_EXPORT
 
 class MacroMetadata;
 
+/**
+ * @brief Compresses a rotated file. Writes the compressed content of source to destination and
+ * returns true on success. The source file is removed by the sink after a successful compression
+ */
+using RotatedFileCompressor = std::function<bool(fs::path const& source, fs::path const& destination)>;
+
 /**
  * @brief The configuration options for the RotatingSink
  */
@@ -169,6 +180,35 @@ public:
    */
   QUILL_ATTRIBUTE_COLD void set_rotation_on_creation(bool value) { _rotation_on_creation = value; }
 
+  /**
+   * @brief Sets whether the rotated files are renamed, compressed and removed on a helper thread
+   * owned by the sink.
+   * When enabled, the backend thread only moves the closed file out of the way and opens the new
+   * file. The rest of the rotation runs on the helper thread, so a large max_backup_files or a slow
+   * filesystem does not stall the logging. The default value is false.
+   * @param value True to rotate the files in the background, false otherwise.
+   */
+  QUILL_ATTRIBUTE_COLD void set_background_rotation(bool value) { _background_rotation = value; }
+
+  /**
+   * @brief Sets a compressor for the rotated files.
+   * Each closed file is compressed into its rotated file name with the extension appended, e.g.
+   * "app.1.log.gz". Only files carrying the extension are recovered or removed as rotated files.
+   * Combine with set_background_rotation() to keep the compression off the backend thread.
+   * @param extension The extension appended to the rotated file names, e.g. ".gz"
+   * @param compressor The function compressing a closed file, e.g. compress_file<GzipCompressor>
+   */
+  QUILL_ATTRIBUTE_COLD void set_rotated_file_compression(std::string extension, RotatedFileCompressor compressor)
+  {
+    if (extension.empty() || !compressor)
+    {
+      QUILL_THROW(QuillError{"rotated file compression requires an extension and a compressor"});
+    }
+
+    _rotated_file_compression_extension = std::move(extension);
+    _rotated_file_compressor = std::move(compressor);
+  }
+
   /** Getter methods **/
   QUILL_NODISCARD size_t rotation_max_file_size() const noexcept { return _rotation_max_file_size; }
   QUILL_NODISCARD uint32_t max_backup_files() const noexcept { return _max_backup_files; }
@@ -188,6 +228,15 @@ public:
     return _rotation_naming_scheme;
   }
   QUILL_NODISCARD bool rotation_on_creation() const noexcept { return _rotation_on_creation; }
+  QUILL_NODISCARD bool background_rotation() const noexcept { return _background_rotation; }
+  QUILL_NODISCARD std::string const& rotated_file_compression_extension() const noexcept
+  {
+    return _rotated_file_compression_extension;
+  }
+  QUILL_NODISCARD RotatedFileCompressor const& rotated_file_compressor() const noexcept
+  {
+    return _rotated_file_compressor;
+  }
 
 private:
   /***/
@@ -262,6 +311,8 @@ private:
   }
 
 private:
+  std::string _rotated_file_compression_extension;
+  RotatedFileCompressor _rotated_file_compressor;
   std::pair<std::chrono::hours, std::chrono::minutes> _daily_rotation_time;
   size_t _rotation_max_file_size{0};                                  // 0 means disabled
   uint32_t _max_backup_files{(std::numeric_limits<uint32_t>::max)()}; // max means disabled
@@ -271,16 +322,115 @@ private:
   bool _overwrite_rolled_files{true};
   bool _remove_old_files{true};
   bool _rotation_on_creation{false};
+  bool _background_rotation{false};
+};
+
+namespace detail
+{
+/**
+ * Runs the rotation jobs of a RotatingSink in submission order on a thread that is started on
+ * the first job
+ */
+class RotationWorker
+{
+public:
+  RotationWorker() = default;
+  ~RotationWorker() { stop(); }
+
+  RotationWorker(RotationWorker const&) = delete;
+  RotationWorker& operator=(RotationWorker const&) = delete;
+
+  /***/
+  void submit(std::function<void()> job)
+  {
+    std::lock_guard<std::mutex> const lock{_mutex};
+
+    if (_stopped)
+    {
+      return;
+    }
+
+    if (!_thread.joinable())
+    {
+      _thread = std::thread{[this]() { _run(); }};
+    }
+
+    _jobs.push_back(std::move(job));
+    _cv.notify_one();
+  }
+
+  /**
+   * Completes the submitted jobs and joins the thread
+   */
+  void stop() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> const lock{_mutex};
+      _stopped = true;
+    }
+
+    _cv.notify_all();
+
+    if (_thread.joinable())
+    {
+      _thread.join();
+    }
+  }
+
+private:
+  /***/
+  void _run()
+  {
+    std::unique_lock<std::mutex> lock{_mutex};
+
+    while (true)
+    {
+      _cv.wait(lock, [this]() { return _stopped || !_jobs.empty(); });
+
+      if (_jobs.empty())
+      {
+        // stopped and drained
+        return;
+      }
+
+      std::function<void()> job = std::move(_jobs.front());
+      _jobs.pop_front();
+      lock.unlock();
+
+      QUILL_TRY { job(); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+      QUILL_CATCH_ALL() {}
+#endif
+
+      lock.lock();
+    }
+  }
+
+private:
+  std::deque<std::function<void()>> _jobs;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::thread _thread;
+  bool _stopped{false};
 };
+} // namespace detail
 
 /**
  * @brief The RotatingSink class
+ *
+ * @tparam TBase the file sink that writes the current file
+ * @tparam TConfig the configuration, a RotatingFileSinkConfig that also carries the options of
+ * TBase when TBase has its own configuration, e.g. RotatingMmapFileSinkConfig
  */
-template <typename TBase>
+template <typename TBase, typename TConfig = RotatingFileSinkConfig>
 class RotatingSink : public TBase
 {
+  static_assert(std::is_base_of_v<RotatingFileSinkConfig, TConfig>,
+                "RotatingSink TConfig must derive from RotatingFileSinkConfig");
+
 public:
   using base_type = TBase;
+  using config_type = TConfig;
 
   /**
    * @brief Constructor.
@@ -292,11 +442,10 @@ public:
    * @param file_event_notifier file event notifier
    * @param start_time start time
    */
-  RotatingSink(fs::path const& filename, RotatingFileSinkConfig const& config,
+  RotatingSink(fs::path const& filename, TConfig const& config,
                FileEventNotifier file_event_notifier = FileEventNotifier{},
                std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now())
-    : base_type(filename, static_cast<FileSinkConfig const&>(config),
-                std::move(file_event_notifier), false, start_time),
+    : base_type(filename, config, std::move(file_event_notifier), false, start_time),
       _config(config)
   {
     uint64_t const today_timestamp_ns = static_cast<uint64_t>(
@@ -320,6 +469,7 @@ public:
     if (recovery_succeeded)
     {
       _created_files.emplace_front(this->_filename, 0, std::string{});
+      _rotation_active = true;
     }
 
     // Rotate an existing startup file before the initial open so mode='w' does not truncate it.
@@ -348,7 +498,40 @@ public:
     }
   }
 
-  ~RotatingSink() override = default;
+  ~RotatingSink() override
+  {
+    // Complete the pending rotations before the members they use are destroyed
+    _rotation_worker.stop();
+  }
+
+  /**
+   * @brief The rotation is checked for each log statement, they are not written in batches
+   */
+  QUILL_NODISCARD bool supports_batch_write() const noexcept override { return false; }
+
+  /**
+   * @brief Rotates the file when needed before committing the log statement formatted into the
+   * output buffer, the log statement is kept in the buffer and written to the new file
+   */
+  QUILL_ATTRIBUTE_HOT void commit_log_statement(LogRecordView const& record, std::string const& process_id) override
+  {
+    if (!this->is_null() && _rotation_enabled())
+    {
+      bool time_rotation = false;
+
+      if (_config.rotation_frequency() != RotatingFileSinkConfig::RotationFrequency::Disabled)
+      {
+        time_rotation = _time_rotation(record.log_timestamp);
+      }
+
+      if (!time_rotation && _config.rotation_max_file_size() != 0)
+      {
+        _size_rotation(record.log_statement.size(), record.log_timestamp);
+      }
+    }
+
+    base_type::commit_log_statement(record, process_id);
+  }
 
   /**
    * @brief Writes a formatted log message to the stream
@@ -426,7 +609,7 @@ protected:
 
 private:
   /***/
-  QUILL_NODISCARD bool _rotation_enabled() const noexcept { return !_created_files.empty(); }
+  QUILL_NODISCARD bool _rotation_enabled() const noexcept { return _rotation_active; }
 
   /***/
   QUILL_NODISCARD bool _time_rotation(uint64_t record_timestamp_ns)
@@ -454,7 +637,13 @@ private:
   /***/
   void _rotate_files(uint64_t record_timestamp_ns)
   {
-    if ((_created_files.size() > _config.max_backup_files()) && !_config.overwrite_rolled_files())
+    size_t created_files_count;
+    {
+      std::lock_guard<std::mutex> const lock{_created_files_mutex};
+      created_files_count = _created_files.size();
+    }
+
+    if ((created_files_count > _config.max_backup_files()) && !_config.overwrite_rolled_files())
     {
       // We have reached the max number of backup files, and we are not allowed to overwrite the
       // oldest file. We will stop rotating
@@ -489,20 +678,16 @@ private:
   /***/
   void _rotate_closed_file(uint64_t record_timestamp_ns)
   {
+    if (_config.background_rotation() || _config.rotated_file_compressor())
+    {
+      _stage_closed_file(record_timestamp_ns);
+      return;
+    }
+
     bool rotation_succeeded = true;
 
     // datetime_suffix will be empty if we are using the default naming scheme
-    std::string datetime_suffix;
-    if (_config.rotation_naming_scheme() == RotatingFileSinkConfig::RotationNamingScheme::Date)
-    {
-      datetime_suffix =
-        this->format_datetime_string(_open_file_timestamp, _config.timezone(), "%Y%m%d");
-    }
-    else if (_config.rotation_naming_scheme() == RotatingFileSinkConfig::RotationNamingScheme::DateAndTime)
-    {
-      datetime_suffix =
-        this->format_datetime_string(_open_file_timestamp, _config.timezone(), "%Y%m%d_%H%M%S");
-    }
+    std::string const datetime_suffix = _rotated_datetime_suffix();
 
     // We need to rotate the files and rename them with an index.
     // Track completed renames so we can undo them if a later rename fails.
@@ -594,6 +779,173 @@ private:
     this->_file_size = 0;
   }
 
+  /**
+   * Moves the closed file to a staging name and opens the new file. Renaming the backups,
+   * compressing the closed file and removing the oldest backup is left to _rotate_staged_file()
+   */
+  void _stage_closed_file(uint64_t record_timestamp_ns)
+  {
+    std::string datetime_suffix = _rotated_datetime_suffix();
+
+    // The staging name does not parse as a rotated file, so it is never recovered or removed
+    auto const [stem, ext] = base_type::extract_stem_and_extension(this->_filename);
+    fs::path staged_file{stem + ".rotating-" + std::to_string(_open_file_timestamp) + "-" +
+                         std::to_string(++_staged_file_sequence) + ext};
+
+    if (!rename_file(this->_filename, staged_file))
+    {
+      this->open_file(this->_filename, _reopen_mode_after_failed_rotation(_config.open_mode()));
+      this->_file_size = _get_file_size(this->_filename);
+      return;
+    }
+
+    // Open file for logging
+    this->open_file(this->_filename, _config.open_mode());
+    _open_file_timestamp = record_timestamp_ns;
+    this->_file_size = 0;
+
+    if (_config.background_rotation())
+    {
+      _rotation_worker.submit(
+        [this, staged_file = std::move(staged_file), datetime_suffix = std::move(datetime_suffix)]()
+        { _rotate_staged_file(staged_file, datetime_suffix); });
+    }
+    else
+    {
+      _rotate_staged_file(staged_file, datetime_suffix);
+    }
+  }
+
+  /**
+   * Compresses the staged file and performs the renames of _rotate_closed_file(), with the staged
+   * file in place of the active file. On failure the renames are undone and the data of the
+   * closed file is left under the staging name. Runs on the rotation worker when background
+   * rotation is enabled
+   */
+  void _rotate_staged_file(fs::path const& staged_file, std::string const& datetime_suffix)
+  {
+    fs::path closed_file = staged_file;
+
+    if (_config.rotated_file_compressor())
+    {
+      // Compress before taking the lock, the compressed name does not parse as a rotated file either
+      fs::path compressed_file = staged_file;
+      compressed_file += _config.rotated_file_compression_extension();
+
+      if (!_compress_file(staged_file, compressed_file))
+      {
+        return;
+      }
+
+      _remove_file(staged_file);
+      closed_file = std::move(compressed_file);
+    }
+
+    std::lock_guard<std::mutex> const lock{_created_files_mutex};
+
+    bool rotation_succeeded = true;
+    std::vector<RenameRecord> completed_renames;
+
+    for (auto it = _created_files.rbegin(); it != _created_files.rend(); ++it)
+    {
+      uint32_t new_index;
+
+      if (_config.rotation_naming_scheme() == RotatingFileSinkConfig::RotationNamingScheme::Index ||
+          it->date_time == datetime_suffix)
+      {
+        new_index = it->index + 1;
+      }
+      else if (it->date_time.empty())
+      {
+        new_index = it->index;
+      }
+      else
+      {
+        continue;
+      }
+
+      // the front entry is the file that was active when the rotation started
+      fs::path const existing_file = (std::next(it) == _created_files.rend())
+        ? closed_file
+        : _get_rotated_filename(it->base_filename, it->index, it->date_time);
+      fs::path const renamed_file = _get_rotated_filename(it->base_filename, new_index, datetime_suffix);
+
+      if (!rename_file(existing_file, renamed_file))
+      {
+        rotation_succeeded = false;
+        break;
+      }
+
+      size_t const idx = static_cast<size_t>(std::distance(_created_files.begin(), it.base()) - 1);
+      completed_renames.push_back({existing_file, renamed_file, idx, new_index, datetime_suffix});
+    }
+
+    if (!rotation_succeeded)
+    {
+      // Undo completed renames in reverse order to restore on-disk state
+      for (auto rit = completed_renames.rbegin(); rit != completed_renames.rend(); ++rit)
+      {
+        rename_file(rit->renamed, rit->original);
+      }
+
+      return;
+    }
+
+    // All renames succeeded — apply metadata updates
+    for (auto const& rec : completed_renames)
+    {
+      _created_files[rec.created_files_idx].index = rec.new_index;
+      _created_files[rec.created_files_idx].date_time = rec.new_date_time;
+    }
+
+    // Check if we have too many files in the queue remove_file the oldest one
+    if (_created_files.size() > _config.max_backup_files())
+    {
+      FileInfo const& oldest_file = _created_files.back();
+      _remove_file(_get_rotated_filename(oldest_file.base_filename, oldest_file.index, oldest_file.date_time));
+      _created_files.pop_back();
+    }
+
+    // add the current file back to the list with index 0
+    _created_files.emplace_front(this->_filename, 0, std::string{});
+  }
+
+  /***/
+  QUILL_NODISCARD bool _compress_file(fs::path const& source, fs::path const& destination) const noexcept
+  {
+    bool compressed{false};
+
+    QUILL_TRY { compressed = _config.rotated_file_compressor()(source, destination); }
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_CATCH_ALL() { compressed = false; }
+#endif
+
+    if (!compressed)
+    {
+      // do not leave a partially written file behind
+      _remove_file(destination);
+    }
+
+    return compressed;
+  }
+
+  /***/
+  QUILL_NODISCARD std::string _rotated_datetime_suffix() const
+  {
+    // empty if we are using the default naming scheme
+    if (_config.rotation_naming_scheme() == RotatingFileSinkConfig::RotationNamingScheme::Date)
+    {
+      return this->format_datetime_string(_open_file_timestamp, _config.timezone(), "%Y%m%d");
+    }
+
+    if (_config.rotation_naming_scheme() == RotatingFileSinkConfig::RotationNamingScheme::DateAndTime)
+    {
+      return this->format_datetime_string(_open_file_timestamp, _config.timezone(), "%Y%m%d_%H%M%S");
+    }
+
+    return std::string{};
+  }
+
   /***/
   QUILL_NODISCARD bool _clean_and_recover_files(fs::path const& filename, std::string const& open_mode,
                                                 uint64_t today_timestamp_ns)
@@ -730,7 +1082,7 @@ private:
         while (recovered_files.size() > _config.max_backup_files())
         {
           FileInfo const& oldest_file = recovered_files.back();
-          _remove_file(_get_filename(oldest_file.base_filename, oldest_file.index, oldest_file.date_time));
+          _remove_file(_get_rotated_filename(oldest_file.base_filename, oldest_file.index, oldest_file.date_time));
           recovered_files.pop_back();
         }
       }
@@ -790,7 +1142,22 @@ private:
   {
     std::string const base_extension = base_filename.extension().string();
     std::string const base_stem = base_filename.stem().string();
-    std::string const candidate_name = candidate_filename.filename().string();
+    std::string candidate_name = candidate_filename.filename().string();
+
+    std::string const& compression_extension = _config.rotated_file_compression_extension();
+    if (!compression_extension.empty())
+    {
+      // only the compressed files are rotated files
+      if ((candidate_name.size() <= compression_extension.size()) ||
+          (candidate_name.compare(candidate_name.size() - compression_extension.size(),
+                                  compression_extension.size(), compression_extension) != 0))
+      {
+        return false;
+      }
+
+      candidate_name.resize(candidate_name.size() - compression_extension.size());
+    }
+
     std::string_view candidate_stem{candidate_name};
 
     if (!base_extension.empty())
@@ -1155,6 +1522,15 @@ private:
     return filename;
   }
 
+  /***/
+  QUILL_NODISCARD fs::path _get_rotated_filename(fs::path const& filename, uint32_t index,
+                                                 std::string const& date_time) const
+  {
+    fs::path rotated_filename = _get_filename(filename, index, date_time);
+    rotated_filename += _config.rotated_file_compression_extension();
+    return rotated_filename;
+  }
+
 protected:
   struct FileInfo
   {
@@ -1181,6 +1557,10 @@ protected:
   uint64_t _next_rotation_time{0};     /**< The next rotation time point */
   uint64_t _open_file_timestamp{0};    /**< The timestamp of the currently open file */
   RotatingFileSinkConfig _config;
+  std::mutex _created_files_mutex; /**< Guards _created_files when rotating in the background */
+  uint64_t _staged_file_sequence{0};
+  bool _rotation_active{false}; /**< Set when the rotated files were recovered */
+  detail::RotationWorker _rotation_worker; /**< Declared last, so it is stopped first */
 };
 
 QUILL_END_EXPORT
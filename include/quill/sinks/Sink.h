@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "quill/bundled/fmt/base.h"
 #include "quill/core/Attributes.h"
 #include "quill/core/LogLevel.h"
 #include "quill/core/PatternFormatterOptions.h"
@@ -15,7 +16,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -28,6 +31,7 @@ QUILL_BEGIN_NAMESPACE
 namespace detail
 {
 class BackendWorker;
+class SinkWorker;
 }
 
 /** Forward Declarations **/
@@ -35,8 +39,29 @@ QUILL_BEGIN_EXPORT
 
 class MacroMetadata;
 class MetricMetadata;
+struct MetricHistogramData;
+struct MetricSnapshot;
 class PatternFormatter;
 
+/**
+ * The arguments of Sink::write_log() for one log statement of a batch passed to
+ * Sink::write_log_batch()
+ */
+struct LogRecordView
+{
+  MacroMetadata const* log_metadata{nullptr};
+  uint64_t log_timestamp{0};
+  std::string_view thread_id;
+  std::string_view thread_name;
+  std::string_view logger_name;
+  LogLevel log_level{LogLevel::None};
+  std::string_view log_level_description;
+  std::string_view log_level_short_code;
+  std::vector<std::pair<std::string, std::string>> const* named_args{nullptr};
+  std::string_view log_message;
+  std::string_view log_statement;
+};
+
 QUILL_END_EXPORT
 
 QUILL_BEGIN_EXPORT
@@ -83,6 +108,32 @@ public:
     return _log_level.load(std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Assigns this sink to one of the sink worker threads configured in
+   * `BackendOptions::sink_workers`.
+   *
+   * All calls to the sink, including filtering, writing and flushing, are then made from that
+   * worker thread instead of the backend thread. An index without a matching worker keeps the sink
+   * on the backend thread.
+   * @note Must be called before the sink is passed to a logger.
+   * @param sink_worker_index Index into `BackendOptions::sink_workers`.
+   */
+  void set_sink_worker(uint32_t sink_worker_index) noexcept
+  {
+    _sink_worker_index.store(sink_worker_index, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the sink worker index set with set_sink_worker().
+   * @return The index, or `no_sink_worker` when the sink runs on the backend thread.
+   */
+  QUILL_NODISCARD uint32_t get_sink_worker() const noexcept
+  {
+    return _sink_worker_index.load(std::memory_order_relaxed);
+  }
+
+  static constexpr uint32_t no_sink_worker = (std::numeric_limits<uint32_t>::max)();
+
   /**
    * @brief Adds a new filter to the sink.
    * @note Thread safe.
@@ -95,8 +146,9 @@ public:
       QUILL_THROW(QuillError{"Filter pointer is nullptr"});
     }
 
-    // Call the user-overridable name accessor before taking the lock.
+    // Call the user-overridable accessors before taking the lock.
     std::string filter_name = filter->get_filter_name();
+    bool const metadata_only = filter->is_metadata_only();
 
     // Lock and add this filter to our global collection
     detail::LockGuard const lock{_global_filters_lock};
@@ -111,7 +163,7 @@ public:
       QUILL_THROW(QuillError{"Filter with the same name already exists"});
     }
 
-    _global_filters.emplace_back(std::move(filter_name), std::move(filter));
+    _global_filters.emplace_back(std::move(filter_name), std::move(filter), metadata_only);
 
     // Indicate a new filter was added - here relaxed is okay as the spinlock will do acq-rel on destruction
     _new_filter.store(true, std::memory_order_relaxed);
@@ -141,6 +193,85 @@ protected:
     std::vector<std::pair<std::string, std::string>> const* named_args,
     std::string_view log_message, std::string_view log_statement) = 0;
 
+  /**
+   * @brief Returns true when the backend should pass the log statements to write_log_batch()
+   * instead of calling write_log() for each of them.
+   * @note Accessor for backend processing. Called once, the result must not change afterwards.
+   */
+  QUILL_NODISCARD virtual bool supports_batch_write() const noexcept { return false; }
+
+  /**
+   * @brief Logs a batch of formatted log messages to the sink.
+   * @note Accessor for backend processing. Called only when supports_batch_write() returns true.
+   * The records are in the order they were logged and remain valid only for the duration of
+   * the call.
+   *
+   * The default implementation calls write_log() for each record.
+   * @param records The log records.
+   * @param count The number of log records.
+   * @param process_id Process Id
+   */
+  QUILL_ATTRIBUTE_HOT virtual void write_log_batch(LogRecordView const* records, size_t count,
+                                                   std::string const& process_id)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      LogRecordView const& record = records[i];
+      write_log(record.log_metadata, record.log_timestamp, record.thread_id, record.thread_name,
+                process_id, record.logger_name, record.log_level, record.log_level_description,
+                record.log_level_short_code, record.named_args, record.log_message,
+                record.log_statement);
+    }
+  }
+
+  /**
+   * @brief Returns true when the sink formats the messages itself, e.g. offline. The backend then
+   * skips formatting the message and calls write_log_format_args() when every sink of the logger
+   * supports it, the sink has no filters that need the formatted message and does not run on a
+   * sink worker.
+   * @note Accessor for backend processing. Called once, the result must not change afterwards.
+   */
+  QUILL_NODISCARD virtual bool supports_format_args() const noexcept { return false; }
+
+  /**
+   * @brief Logs a log statement with the serialized arguments instead of the formatted message.
+   * @note Accessor for backend processing. Called only when supports_format_args() returns true,
+   * arguments of a type with its own formatter are formatted by the backend and passed to
+   * write_log() instead.
+   * @param format_args The arguments as written by detail::serialize_format_args(), they are
+   * formatted with the message format of log_metadata. Named arguments are not split
+   */
+  QUILL_ATTRIBUTE_HOT virtual void write_log_format_args(
+    MacroMetadata const* /* log_metadata */, uint64_t /* log_timestamp */,
+    std::string_view /* thread_id */, std::string_view /* thread_name */,
+    std::string const& /* process_id */, std::string_view /* logger_name */,
+    LogLevel /* log_level */, std::string_view /* log_level_description */,
+    std::string_view /* log_level_short_code */, std::string_view /* format_args */)
+  {
+  }
+
+  /**
+   * @brief Returns the output buffer of the sink, so the backend formats the next log statement
+   * directly into it instead of passing it to write_log(), or nullptr when the sink does not
+   * provide one.
+   * @note Accessor for backend processing.
+   *
+   * The backend appends the log statement to the buffer and then calls commit_log_statement().
+   * A log statement that is not committed, e.g. because a filter dropped it, has to be discarded
+   * by the next call.
+   */
+  QUILL_NODISCARD virtual fmtquill::detail::buffer<char>* reserve_log_statement() { return nullptr; }
+
+  /**
+   * @brief Completes a log statement formatted into the buffer returned by
+   * reserve_log_statement(). record.log_statement is the log statement at the end of the buffer.
+   * @note Accessor for backend processing.
+   */
+  QUILL_ATTRIBUTE_HOT virtual void commit_log_statement(LogRecordView const& /* record */,
+                                                        std::string const& /* process_id */)
+  {
+  }
+
   /**
    * @brief Publishes a metric sample to the sink.
    * @note Accessor for backend processing.
@@ -156,6 +287,37 @@ protected:
   {
   }
 
+  /**
+   * @brief Publishes a histogram aggregated on the frontend, e.g. by MetricHistogram, to the sink.
+   * @note Accessor for backend processing.
+   *
+   * The histogram only counts the values recorded since the previous histogram of the same
+   * frontend thread, the sink is expected to merge it. The default implementation ignores it.
+   */
+  QUILL_ATTRIBUTE_HOT virtual void write_metric_histogram(
+    MetricMetadata const* /* metric_metadata */, uint64_t /* log_timestamp */,
+    std::string_view /* thread_id */, std::string_view /* thread_name */,
+    std::string const& /* process_id */, std::string_view /* logger_name */,
+    MetricHistogramData const& /* histogram */)
+  {
+  }
+
+  /**
+   * @brief Publishes a snapshot of the samples of a metric aggregated by the backend.
+   * @note Accessor for backend processing.
+   *
+   * Called every BackendOptions::metric_snapshot_interval for each metric that received samples
+   * or histograms during the interval, from all the threads publishing it through the logger.
+   * The timestamp is the one of the last sample. The default implementation ignores it.
+   */
+  QUILL_ATTRIBUTE_HOT virtual void write_metric_snapshot(MetricMetadata const* /* metric_metadata */,
+                                                         uint64_t /* log_timestamp */,
+                                                         std::string const& /* process_id */,
+                                                         std::string_view /* logger_name */,
+                                                         MetricSnapshot const& /* snapshot */)
+  {
+  }
+
   /**
    * @brief Flushes the sink, synchronizing the associated sink with its controlled output sequence.
    */
@@ -187,25 +349,52 @@ protected:
                                          std::string_view thread_id, std::string_view thread_name,
                                          std::string_view logger_name, LogLevel log_level,
                                          std::string_view log_message, std::string_view log_statement)
+  {
+    return apply_metadata_filters(log_metadata, log_timestamp, thread_id, thread_name, logger_name,
+                                  log_level) &&
+      apply_formatted_filters(log_metadata, log_timestamp, thread_id, thread_name, logger_name,
+                              log_level, log_message, log_statement);
+  }
+
+  /**
+   * @brief Applies the log level filter and the metadata only filters, before the log record
+   * is formatted.
+   * @note Called internally by the backend worker thread.
+   * @return True if the log record passes the filters, false otherwise.
+   */
+  QUILL_NODISCARD bool apply_metadata_filters(MacroMetadata const* log_metadata, uint64_t log_timestamp,
+                                              std::string_view thread_id, std::string_view thread_name,
+                                              std::string_view logger_name, LogLevel log_level)
   {
     if (log_level < _log_level.load(std::memory_order_relaxed))
     {
       return false;
     }
 
-    // Update our local collection of the filters
-    if (QUILL_UNLIKELY(_new_filter.exchange(false, std::memory_order_relaxed)))
-    {
-      // if there is a new filter we have to update
-      _local_filters.clear();
+    _update_local_filters();
 
-      detail::LockGuard const lock{_global_filters_lock};
+    return std::all_of(_local_metadata_filters.begin(), _local_metadata_filters.end(),
+                       [log_metadata, log_timestamp, thread_id, thread_name, logger_name,
+                        log_level](Filter* filter_elem)
+                       {
+                         return filter_elem->filter(log_metadata, log_timestamp, thread_id, thread_name,
+                                                    logger_name, log_level, std::string_view{},
+                                                    std::string_view{});
+                       });
+  }
 
-      for (auto const& filter : _global_filters)
-      {
-        _local_filters.push_back(filter.filter.get());
-      }
-    }
+  /**
+   * @brief Applies the filters that need the formatted log record, after
+   * apply_metadata_filters() has accepted it.
+   * @note Called internally by the backend worker thread.
+   * @return True if the log record passes the filters, false otherwise.
+   */
+  QUILL_NODISCARD bool apply_formatted_filters(MacroMetadata const* log_metadata, uint64_t log_timestamp,
+                                               std::string_view thread_id, std::string_view thread_name,
+                                               std::string_view logger_name, LogLevel log_level,
+                                               std::string_view log_message, std::string_view log_statement)
+  {
+    _update_local_filters();
 
     if (_local_filters.empty())
     {
@@ -224,25 +413,59 @@ protected:
   }
 
 private:
+  /**
+   * Updates our local collection of the filters
+   */
+  void _update_local_filters()
+  {
+    if (QUILL_UNLIKELY(_new_filter.exchange(false, std::memory_order_relaxed)))
+    {
+      // if there is a new filter we have to update
+      _local_filters.clear();
+      _local_metadata_filters.clear();
+
+      detail::LockGuard const lock{_global_filters_lock};
+
+      for (auto const& filter : _global_filters)
+      {
+        if (filter.metadata_only)
+        {
+          _local_metadata_filters.push_back(filter.filter.get());
+        }
+        else
+        {
+          _local_filters.push_back(filter.filter.get());
+        }
+      }
+    }
+  }
+
   friend class detail::BackendWorker;
+  friend class detail::SinkWorker;
 
   struct RegisteredFilter
   {
-    RegisteredFilter(std::string filter_name_arg, std::unique_ptr<Filter> filter_arg)
-      : filter_name(std::move(filter_name_arg)), filter(std::move(filter_arg))
+    RegisteredFilter(std::string filter_name_arg, std::unique_ptr<Filter> filter_arg, bool metadata_only_arg)
+      : filter_name(std::move(filter_name_arg)),
+        filter(std::move(filter_arg)),
+        metadata_only(metadata_only_arg)
     {
     }
 
     std::string filter_name;
     std::unique_ptr<Filter> filter;
+    bool metadata_only;
   };
 
   /** Override PatternFormatter for this sink **/
   std::optional<PatternFormatterOptions> _override_pattern_formatter_options; /* Set by the frontend and accessed by the backend to initialise PatternFormatter */
   std::shared_ptr<PatternFormatter> _override_pattern_formatter; /* The backend thread will set this once */
+  std::optional<bool> _batch_write; /* The backend thread will set this once from supports_batch_write() */
+  std::optional<bool> _format_args_write; /* The backend thread will set this once from supports_format_args() */
 
   /** Local Filters for this sink **/
   std::vector<Filter*> _local_filters;
+  std::vector<Filter*> _local_metadata_filters;
 
   /** Global filter for this sink **/
   std::vector<RegisteredFilter> _global_filters;
@@ -251,6 +474,7 @@ private:
   std::atomic<bool> _new_filter{false};
 
   std::atomic<LogLevel> _log_level{LogLevel::TraceL3};
+  std::atomic<uint32_t> _sink_worker_index{no_sink_worker};
 };
 
 QUILL_END_EXPORT
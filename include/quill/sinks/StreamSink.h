@@ -36,6 +36,11 @@
 
   #include <io.h>
   #include <windows.h>
+#else
+  #include <algorithm>
+  #include <climits>
+  #include <sys/uio.h>
+  #include <unistd.h>
 #endif
 
 QUILL_BEGIN_NAMESPACE
@@ -151,6 +156,57 @@ public:
     }
   }
 
+  /**
+   * @brief Writes a batch of formatted log messages to the stream
+   *
+   * A batch larger than min_writev_batch_size is written with writev() straight from the log
+   * statements, after flushing the stdio buffer, instead of being copied to the stdio buffer.
+   * @note On Windows or when a before_write callback is set, write_log() is called for each record.
+   */
+  QUILL_ATTRIBUTE_HOT void write_log_batch(LogRecordView const* records, size_t count,
+                                           std::string const& process_id) override
+  {
+#if defined(_WIN32)
+    Sink::write_log_batch(records, count, process_id);
+#else
+    if (QUILL_UNLIKELY(!_file))
+    {
+      // FileSink::flush() tries to re-open a deleted file and if it fails _file can be null
+      return;
+    }
+
+    if (_file_event_notifier.before_write)
+    {
+      Sink::write_log_batch(records, count, process_id);
+      return;
+    }
+
+    size_t batch_size{0};
+    for (size_t i = 0; i < count; ++i)
+    {
+      batch_size += records[i].log_statement.size();
+    }
+
+    if (batch_size < min_writev_batch_size)
+    {
+      // Copying a small batch to the stdio buffer is cheaper than a system call
+      for (size_t i = 0; i < count; ++i)
+      {
+        _write_statement(records[i].log_statement);
+      }
+
+      return;
+    }
+
+    // The stdio buffer holds the earlier log statements
+    flush();
+
+    _writev_statements(records, count);
+    _file_size += batch_size;
+    _write_occurred = true;
+#endif
+  }
+
   /**
    * Flushes the stream
    */
@@ -283,6 +339,73 @@ protected:
     _write_occurred = true;
   }
 
+#if !defined(_WIN32)
+  /**
+   * Writes the log statements of the records to the file descriptor of the stream, IOV_MAX
+   * statements per writev() call
+   */
+  void _writev_statements(LogRecordView const* records, size_t count)
+  {
+    int const fd = ::fileno(_file);
+    size_t record_index{0};
+
+    while (record_index < count)
+    {
+      size_t const iov_count = (std::min)(count - record_index, static_cast<size_t>(IOV_MAX));
+      _iovecs.resize(iov_count);
+
+      for (size_t i = 0; i < iov_count; ++i)
+      {
+        std::string_view const statement = records[record_index + i].log_statement;
+        _iovecs[i].iov_base = const_cast<char*>(statement.data());
+        _iovecs[i].iov_len = statement.size();
+      }
+
+      record_index += iov_count;
+
+      iovec* iov = _iovecs.data();
+      size_t iov_remaining = iov_count;
+
+      while (iov_remaining != 0)
+      {
+        ssize_t const written = ::writev(fd, iov, static_cast<int>(iov_remaining));
+
+        if (QUILL_UNLIKELY(written < 0))
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+
+          int const saved_errno = errno;
+          QUILL_THROW(QuillError{std::string{"writev failed errno: "} + std::to_string(saved_errno) +
+                                 " error: " + std::strerror(saved_errno)});
+        }
+
+        // Skip the buffers that were written and continue a partially written one
+        auto bytes = static_cast<size_t>(written);
+        while ((iov_remaining != 0) && (bytes >= iov->iov_len))
+        {
+          bytes -= iov->iov_len;
+          ++iov;
+          --iov_remaining;
+        }
+
+        if (QUILL_UNLIKELY((written == 0) && (iov_remaining != 0)))
+        {
+          QUILL_THROW(QuillError{"writev returned 0 bytes written without error"});
+        }
+
+        if (iov_remaining != 0)
+        {
+          iov->iov_base = static_cast<char*>(iov->iov_base) + bytes;
+          iov->iov_len -= bytes;
+        }
+      }
+    }
+  }
+#endif
+
   /**
    * Flushes the stream
    */
@@ -315,6 +438,11 @@ protected:
   FileEventNotifier _file_event_notifier;
   bool _is_null{false};
   bool _write_occurred{false};
+
+#if !defined(_WIN32)
+  static constexpr size_t min_writev_batch_size{16 * 1024};
+  std::vector<iovec> _iovecs;
+#endif
 };
 
 QUILL_END_EXPORT
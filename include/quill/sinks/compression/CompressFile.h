@@ -0,0 +1,102 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/Filesystem.h"
+#include "quill/core/QuillError.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * Compresses the source file into the destination file with one of the compressors of
+ * CompressedFileSink, e.g. ZstdCompressor.
+ *
+ * It can be used as the compressor of the rotated files:
+ * @code
+ * cfg.set_rotated_file_compression(".zst",
+ *   [](fs::path const& source, fs::path const& destination)
+ *   { return quill::compress_file<quill::ZstdCompressor>(source, destination); });
+ * @endcode
+ *
+ * @param source the file to compress
+ * @param destination the compressed file, it is overwritten if it exists
+ * @param compression_level the level passed to the compressor, 0 selects its default level
+ * @return true on success
+ */
+template <typename TCompressor>
+QUILL_NODISCARD bool compress_file(fs::path const& source, fs::path const& destination,
+                                   int32_t compression_level = 0)
+{
+  std::FILE* input = std::fopen(source.string().data(), "rb");
+
+  if (!input)
+  {
+    return false;
+  }
+
+  std::FILE* output = std::fopen(destination.string().data(), "wb");
+
+  if (!output)
+  {
+    std::fclose(input);
+    return false;
+  }
+
+  static constexpr size_t chunk_size{64 * 1024};
+  std::unique_ptr<char[]> chunk = std::make_unique<char[]>(chunk_size);
+
+  bool write_failed{false};
+  auto write = [output, &write_failed](char const* data, size_t size)
+  {
+    if (!write_failed && (std::fwrite(data, 1, size, output) != size))
+    {
+      write_failed = true;
+    }
+  };
+
+  QUILL_TRY
+  {
+    TCompressor compressor{compression_level};
+
+    size_t bytes_read;
+    while (!write_failed && ((bytes_read = std::fread(chunk.get(), 1, chunk_size, input)) != 0))
+    {
+      compressor.compress(std::string_view{chunk.get(), bytes_read}, write);
+    }
+
+    compressor.end_frame(write);
+  }
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_CATCH_ALL()
+  {
+    std::fclose(input);
+    std::fclose(output);
+    throw;
+  }
+#endif
+
+  bool const read_failed = std::ferror(input) != 0;
+  std::fclose(input);
+
+  bool const close_failed = std::fclose(output) != 0;
+
+  return !read_failed && !write_failed && !close_failed;
+}
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
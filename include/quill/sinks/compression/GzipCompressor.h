@@ -0,0 +1,130 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/QuillError.h"
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * Streaming gzip compressor for CompressedFileSink.
+ *
+ * Each end_frame() completes a gzip member. The file is a sequence of members, which gzip and
+ * zlib's gzread() decode as a single stream.
+ *
+ * @note Requires linking with zlib.
+ */
+class GzipCompressor
+{
+public:
+  /**
+   * @param level the zlib compression level, 0 selects the zlib default level
+   */
+  explicit GzipCompressor(int level)
+  {
+    std::memset(&_stream, 0, sizeof(_stream));
+
+    // 15 window bits plus 16 selects the gzip format
+    if (deflateInit2(&_stream, (level == 0) ? Z_DEFAULT_COMPRESSION : level, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      QUILL_THROW(QuillError{"deflateInit2 failed"});
+    }
+
+    _out_buffer = std::make_unique<char[]>(out_buffer_size);
+  }
+
+  ~GzipCompressor() { deflateEnd(&_stream); }
+
+  GzipCompressor(GzipCompressor const&) = delete;
+  GzipCompressor& operator=(GzipCompressor const&) = delete;
+
+  /**
+   * Compresses the input and passes any compressed output to write(char const*, size_t)
+   */
+  template <typename TWrite>
+  void compress(std::string_view input, TWrite&& write)
+  {
+    _stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    _stream.avail_in = static_cast<uInt>(input.size());
+    _frame_started = true;
+
+    do
+    {
+      _deflate(Z_NO_FLUSH, write);
+    } while (_stream.avail_in != 0);
+  }
+
+  /**
+   * Completes the current member and passes the remaining compressed output to write
+   */
+  template <typename TWrite>
+  void end_frame(TWrite&& write)
+  {
+    if (!_frame_started)
+    {
+      return;
+    }
+
+    _stream.next_in = nullptr;
+    _stream.avail_in = 0;
+
+    while (_deflate(Z_FINISH, write) != Z_STREAM_END)
+    {
+    }
+
+    // The next write starts a new gzip member
+    deflateReset(&_stream);
+    _frame_started = false;
+  }
+
+private:
+  template <typename TWrite>
+  int _deflate(int flush, TWrite& write)
+  {
+    _stream.next_out = reinterpret_cast<Bytef*>(_out_buffer.get());
+    _stream.avail_out = static_cast<uInt>(out_buffer_size);
+
+    int const ret = deflate(&_stream, flush);
+
+    if ((ret != Z_OK) && (ret != Z_STREAM_END) && (ret != Z_BUF_ERROR))
+    {
+      QUILL_THROW(QuillError{std::string{"gzip compression failed error: "} + std::to_string(ret)});
+    }
+
+    size_t const compressed_size = out_buffer_size - _stream.avail_out;
+
+    if (compressed_size != 0)
+    {
+      write(_out_buffer.get(), compressed_size);
+    }
+
+    return ret;
+  }
+
+private:
+  static constexpr size_t out_buffer_size{64 * 1024};
+
+  z_stream _stream;
+  std::unique_ptr<char[]> _out_buffer;
+  bool _frame_started{false};
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
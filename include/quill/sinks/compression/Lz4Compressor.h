@@ -0,0 +1,129 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/QuillError.h"
+
+#include <lz4frame.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * Streaming lz4 compressor for CompressedFileSink.
+ *
+ * Each end_frame() completes an lz4 frame. The file is a sequence of frames, which the lz4
+ * command line tool decodes as a single stream.
+ *
+ * @note Requires linking with liblz4.
+ */
+class Lz4Compressor
+{
+public:
+  /**
+   * @param level the lz4 compression level, 0 selects the fast default level
+   */
+  explicit Lz4Compressor(int level)
+  {
+    if (LZ4F_isError(LZ4F_createCompressionContext(&_cctx, LZ4F_VERSION)))
+    {
+      QUILL_THROW(QuillError{"LZ4F_createCompressionContext failed"});
+    }
+
+    std::memset(&_preferences, 0, sizeof(_preferences));
+    _preferences.compressionLevel = level;
+    _preferences.frameInfo.blockSizeID = LZ4F_max64KB;
+    _preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+
+    // Large enough for the header, the compression of one input chunk or the end of a frame
+    _out_buffer_size = (std::max)(static_cast<size_t>(LZ4F_HEADER_SIZE_MAX),
+                                  LZ4F_compressBound(input_chunk_size, &_preferences));
+    _out_buffer = std::make_unique<char[]>(_out_buffer_size);
+  }
+
+  ~Lz4Compressor() { LZ4F_freeCompressionContext(_cctx); }
+
+  Lz4Compressor(Lz4Compressor const&) = delete;
+  Lz4Compressor& operator=(Lz4Compressor const&) = delete;
+
+  /**
+   * Compresses the input and passes any compressed output to write(char const*, size_t)
+   */
+  template <typename TWrite>
+  void compress(std::string_view input, TWrite&& write)
+  {
+    if (!_frame_started)
+    {
+      size_t const header_size = _check(LZ4F_compressBegin(_cctx, _out_buffer.get(), _out_buffer_size, &_preferences));
+      write(_out_buffer.get(), header_size);
+      _frame_started = true;
+    }
+
+    while (!input.empty())
+    {
+      size_t const chunk_size = (std::min)(input.size(), input_chunk_size);
+      size_t const compressed_size = _check(
+        LZ4F_compressUpdate(_cctx, _out_buffer.get(), _out_buffer_size, input.data(), chunk_size, nullptr));
+
+      if (compressed_size != 0)
+      {
+        write(_out_buffer.get(), compressed_size);
+      }
+
+      input.remove_prefix(chunk_size);
+    }
+  }
+
+  /**
+   * Completes the current frame and passes the remaining compressed output to write
+   */
+  template <typename TWrite>
+  void end_frame(TWrite&& write)
+  {
+    if (!_frame_started)
+    {
+      return;
+    }
+
+    size_t const compressed_size = _check(LZ4F_compressEnd(_cctx, _out_buffer.get(), _out_buffer_size, nullptr));
+    _frame_started = false;
+    write(_out_buffer.get(), compressed_size);
+  }
+
+private:
+  static size_t _check(size_t result)
+  {
+    if (LZ4F_isError(result))
+    {
+      QUILL_THROW(QuillError{std::string{"lz4 compression failed error: "} + LZ4F_getErrorName(result)});
+    }
+
+    return result;
+  }
+
+private:
+  static constexpr size_t input_chunk_size{64 * 1024};
+
+  LZ4F_cctx* _cctx{nullptr};
+  LZ4F_preferences_t _preferences;
+  std::unique_ptr<char[]> _out_buffer;
+  size_t _out_buffer_size{0};
+  bool _frame_started{false};
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
@@ -0,0 +1,124 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/core/Attributes.h"
+#include "quill/core/QuillError.h"
+
+#include <zstd.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+QUILL_BEGIN_NAMESPACE
+
+QUILL_BEGIN_EXPORT
+
+/**
+ * Streaming zstd compressor for CompressedFileSink.
+ *
+ * Each end_frame() completes a zstd frame. The file is a sequence of frames, which the zstd
+ * command line tool and ZSTD_decompressStream() decode as a single stream.
+ *
+ * @note Requires linking with libzstd.
+ */
+class ZstdCompressor
+{
+public:
+  /**
+   * @param level the zstd compression level, 0 selects the zstd default level
+   */
+  explicit ZstdCompressor(int level) : _out_buffer_size(ZSTD_CStreamOutSize())
+  {
+    _cctx = ZSTD_createCCtx();
+
+    if (!_cctx)
+    {
+      QUILL_THROW(QuillError{"ZSTD_createCCtx failed"});
+    }
+
+    _check(ZSTD_CCtx_setParameter(_cctx, ZSTD_c_compressionLevel, level));
+    _out_buffer = std::make_unique<char[]>(_out_buffer_size);
+  }
+
+  ~ZstdCompressor() { ZSTD_freeCCtx(_cctx); }
+
+  ZstdCompressor(ZstdCompressor const&) = delete;
+  ZstdCompressor& operator=(ZstdCompressor const&) = delete;
+
+  /**
+   * Compresses the input and passes any compressed output to write(char const*, size_t)
+   */
+  template <typename TWrite>
+  void compress(std::string_view input, TWrite&& write)
+  {
+    _frame_started = true;
+    _stream(input, ZSTD_e_continue, write);
+  }
+
+  /**
+   * Completes the current frame and passes the remaining compressed output to write
+   */
+  template <typename TWrite>
+  void end_frame(TWrite&& write)
+  {
+    if (!_frame_started)
+    {
+      return;
+    }
+
+    _stream(std::string_view{}, ZSTD_e_end, write);
+    _frame_started = false;
+  }
+
+private:
+  template <typename TWrite>
+  void _stream(std::string_view input, ZSTD_EndDirective end_directive, TWrite& write)
+  {
+    ZSTD_inBuffer in_buffer{input.data(), input.size(), 0};
+
+    while (true)
+    {
+      ZSTD_outBuffer out_buffer{_out_buffer.get(), _out_buffer_size, 0};
+      size_t const remaining = _check(ZSTD_compressStream2(_cctx, &out_buffer, &in_buffer, end_directive));
+
+      if (out_buffer.pos != 0)
+      {
+        write(_out_buffer.get(), out_buffer.pos);
+      }
+
+      bool const done = (end_directive == ZSTD_e_continue) ? (in_buffer.pos == in_buffer.size) : (remaining == 0);
+
+      if (done)
+      {
+        return;
+      }
+    }
+  }
+
+  static size_t _check(size_t result)
+  {
+    if (ZSTD_isError(result))
+    {
+      QUILL_THROW(QuillError{std::string{"zstd compression failed error: "} + ZSTD_getErrorName(result)});
+    }
+
+    return result;
+  }
+
+private:
+  ZSTD_CCtx* _cctx{nullptr};
+  std::unique_ptr<char[]> _out_buffer;
+  size_t _out_buffer_size;
+  bool _frame_started{false};
+};
+
+QUILL_END_EXPORT
+
+QUILL_END_NAMESPACE
@@ -21,6 +21,7 @@
 #include <prometheus/registry.h>
 #include <prometheus/summary.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <map>
@@ -265,7 +266,11 @@ public:
       metric_metadata, prometheus::MetricType::Histogram, std::move(help), std::move(constant_labels),
       [buckets = std::move(bucket_boundaries)](
         histogram_family_t* family, Labels const& metric_labels, FamilyKey const& family_key) mutable
-      { return RegisteredHistogram{family_key, &family->Add(metric_labels, std::move(buckets))}; });
+      {
+        HistogramBuckets bucket_boundaries_copy = buckets;
+        return RegisteredHistogram{family_key, &family->Add(metric_labels, std::move(buckets)),
+                                   std::move(bucket_boundaries_copy)};
+      });
   }
 
   void register_summary(MetricMetadata const* metric_metadata, std::string help, SummaryQuantiles quantiles,
@@ -338,6 +343,28 @@ public:
                metric_it->second);
   }
 
+  void write_metric_histogram(MetricMetadata const* metric_metadata, uint64_t, std::string_view,
+                              std::string_view, std::string const&, std::string_view,
+                              MetricHistogramData const& histogram) override
+  {
+    QUILL_ASSERT(metric_metadata,
+                 "PrometheusSink::write_metric_histogram received a null metric metadata pointer");
+
+    detail::LockGuard const lock{_spinlock};
+
+    auto metric_it = _metrics.find(metric_metadata);
+    if (metric_it == _metrics.end())
+    {
+      return;
+    }
+
+    // Only histograms can merge pre-aggregated buckets, other metric types ignore them
+    if (auto* registered_histogram = std::get_if<RegisteredHistogram>(&metric_it->second))
+    {
+      _apply_histogram(*registered_histogram, histogram);
+    }
+  }
+
   void flush_sink() noexcept override {}
 
   void run_periodic_tasks() noexcept override {}
@@ -475,6 +502,7 @@ private:
   {
     FamilyKey family_key;
     prometheus::Histogram* metric;
+    HistogramBuckets bucket_boundaries;
   };
 
   struct RegisteredSummary
@@ -773,6 +801,35 @@ private:
     registered_metric.metric->Observe(value);
   }
 
+  static void _apply_histogram(RegisteredHistogram& registered_metric, MetricHistogramData const& histogram)
+  {
+    // Each frontend bucket is added to the first registered bucket that contains its upper bound,
+    // the last one being +Inf. Matching bucket boundaries give the exact result
+    std::vector<double> bucket_increments(registered_metric.bucket_boundaries.size() + 1, 0.0);
+
+    for (size_t i = 0; i <= histogram.bucket_bounds_count; ++i)
+    {
+      if (histogram.bucket_counts[i] == 0)
+      {
+        continue;
+      }
+
+      size_t bucket_index = registered_metric.bucket_boundaries.size();
+
+      if (i < histogram.bucket_bounds_count)
+      {
+        bucket_index = static_cast<size_t>(
+          std::lower_bound(registered_metric.bucket_boundaries.begin(),
+                           registered_metric.bucket_boundaries.end(), histogram.bucket_bounds[i]) -
+          registered_metric.bucket_boundaries.begin());
+      }
+
+      bucket_increments[bucket_index] += static_cast<double>(histogram.bucket_counts[i]);
+    }
+
+    registered_metric.metric->ObserveMultiple(bucket_increments, histogram.sum);
+  }
+
 private:
   Registry _registry;
   std::shared_ptr<prometheus::Collectable> _registry_collectable{
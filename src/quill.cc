@@ -82,6 +82,10 @@ module;
   #endif
   #include <io.h>
   #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
 #endif
 #if !defined(__INTEL_COMPILER)
   #if QUILL_HAS_INCLUDE(<x86gprintrin.h>)
@@ -111,6 +115,7 @@ export module quill;
 #include "quill/Backend.h"
 #include "quill/BackendTscClock.h"
 #include "quill/BinaryDataDeferredFormatCodec.h"
+#include "quill/BinaryLogReader.h"
 #include "quill/CsvWriter.h"
 #include "quill/DeferredFormatCodec.h"
 #include "quill/DirectFormatCodec.h"
@@ -123,15 +128,21 @@ export module quill;
 #include "quill/UserClockSource.h"
 #include "quill/Utility.h"
 #include "quill/filters/Filter.h"
+#include "quill/sinks/BinaryFileSink.h"
+#include "quill/sinks/CompressedFileSink.h"
 #include "quill/sinks/ConsoleSink.h"
 #include "quill/sinks/FileSink.h"
 #include "quill/sinks/JsonSink.h"
+#include "quill/sinks/MmapFileSink.h"
 #include "quill/sinks/NullSink.h"
+#include "quill/sinks/RotatingCompressedFileSink.h"
 #include "quill/sinks/RotatingFileSink.h"
 #include "quill/sinks/RotatingJsonFileSink.h"
+#include "quill/sinks/RotatingMmapFileSink.h"
 #include "quill/sinks/RotatingSink.h"
 #include "quill/sinks/Sink.h"
 #include "quill/sinks/StreamSink.h"
+#include "quill/sinks/compression/CompressFile.h"
 #include "quill/std/Array.h"
 #include "quill/std/Bitset.h"
 #include "quill/std/Chrono.h"
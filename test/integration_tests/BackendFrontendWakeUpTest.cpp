@@ -0,0 +1,101 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quill;
+
+/***/
+TEST_CASE("backend_frontend_wake_up")
+{
+  static constexpr size_t number_of_bursts = 10u;
+  static constexpr size_t number_of_messages = 100u;
+  static constexpr size_t number_of_threads = 4;
+  static constexpr char const* filename = "backend_frontend_wake_up.log";
+  static std::string const logger_name_prefix = "logger_";
+  static constexpr std::chrono::seconds sleep_duration{3};
+
+  // Start the backend thread with a long sleep, the frontend threads wake it up
+  BackendOptions backend_options;
+  backend_options.sleep_duration = sleep_duration;
+  backend_options.enable_frontend_wake_up = true;
+  backend_options.idle_spin_count = 16;
+  backend_options.idle_pause_count = 16;
+  backend_options.idle_yield_count = 16;
+  Backend::start(backend_options);
+
+  auto const start_time = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(
+      [i]()
+      {
+        auto file_sink = Frontend::create_or_get_sink<FileSink>(
+          filename,
+          []()
+          {
+            FileSinkConfig cfg;
+            cfg.set_open_mode('w');
+            return cfg;
+          }(),
+          FileEventNotifier{});
+
+        Logger* logger =
+          Frontend::create_or_get_logger(logger_name_prefix + std::to_string(i), std::move(file_sink));
+
+        for (size_t burst = 0; burst < number_of_bursts; ++burst)
+        {
+          for (size_t j = 0; j < number_of_messages; ++j)
+          {
+            LOG_INFO(logger, "Hello from thread {} this is message {}", i, burst * number_of_messages + j);
+          }
+
+          // Returns once the backend woke up and processed the burst
+          logger->flush_log();
+
+          // Let the backend go back to sleep
+          std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        }
+      });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  auto const elapsed = std::chrono::steady_clock::now() - start_time;
+
+  // Without the wake up each burst would wait for the sleep_duration. A message can rarely still
+  // miss the wake up, so only require that most of the bursts did not wait
+  REQUIRE_LT(elapsed, (number_of_bursts / 2) * sleep_duration);
+
+  Backend::stop();
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), number_of_bursts * number_of_messages * number_of_threads);
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    for (size_t j = 0; j < number_of_bursts * number_of_messages; ++j)
+    {
+      std::string expected_string = logger_name_prefix + std::to_string(i) +
+        "     Hello from thread " + std::to_string(i) + " this is message " + std::to_string(j);
+
+      REQUIRE(testing::file_contains(file_contents, expected_string));
+    }
+  }
+
+  testing::remove_file(filename);
+}
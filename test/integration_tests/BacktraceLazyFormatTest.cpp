@@ -0,0 +1,116 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+#include "quill/std/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace quill;
+
+/**
+ * Logs backtrace messages with each kind of argument and flushes them. The messages are stored
+ * with their encoded arguments and formatted when the backtrace is flushed, except the messages
+ * with a custom type argument that are formatted when they are stored
+ */
+void backtrace_lazy_format(char const* filename, size_t formatter_threads)
+{
+  static constexpr size_t number_of_messages = 64;
+
+  BackendOptions backend_options;
+  backend_options.formatter_threads = formatter_threads;
+  Backend::start(backend_options);
+
+  auto file_sink = Frontend::create_or_get_sink<FileSink>(
+    filename,
+    []()
+    {
+      FileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      return cfg;
+    }(),
+    FileEventNotifier{});
+
+  Logger* logger = Frontend::create_or_get_logger(
+    std::string{"logger_"} + filename, std::move(file_sink),
+    quill::PatternFormatterOptions{"%(log_level) %(message) [%(named_args)]"});
+
+  // The storage is smaller than the number of messages, so its events are reused
+  logger->init_backtrace(8, LogLevel::Error);
+
+  std::vector<std::string> expected_contents;
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    std::string const str = "string_" + std::to_string(i);
+    std::string_view const str_view = str;
+    char const* c_str = (i % 2 == 0) ? "even" : "odd";
+    auto const value = static_cast<int64_t>(i) * -3;
+    double const dbl = static_cast<double>(i) + 0.5;
+    std::vector<std::string> const vec{"a" + std::to_string(i), "b"};
+
+    switch (i % 4)
+    {
+    case 0:
+      LOG_BACKTRACE(logger, "Message {} {} {} {} {:.2f}", i, str, c_str, value, dbl);
+      expected_contents.push_back("BACKTRACE Message " + std::to_string(i) + " " + str + " " +
+                                  c_str + " " + std::to_string(value) + " " +
+                                  fmtquill::format("{:.2f}", dbl) + " []");
+      break;
+    case 1:
+      LOG_BACKTRACE(logger, "Named {index} {text}", i, str_view);
+      expected_contents.push_back("BACKTRACE Named " + std::to_string(i) + " " + str +
+                                  " [index: " + std::to_string(i) + ", text: " + str + "]");
+      break;
+    case 2:
+      LOG_BACKTRACE(logger, "Vector {} {}", i, vec);
+      expected_contents.push_back("BACKTRACE Vector " + std::to_string(i) + " [\"a" +
+                                  std::to_string(i) + "\", \"b\"] []");
+      break;
+    default:
+      LOG_RUNTIME_METADATA(logger, LogLevel::Backtrace, "BacktraceLazyFormatTest.cpp", 1234,
+                           "function", "Runtime {} {}", i, str);
+      expected_contents.push_back("BACKTRACE Runtime " + std::to_string(i) + " " + str + " []");
+      break;
+    }
+
+    if (i == number_of_messages / 2 - 1)
+    {
+      // Flushes the last 8 messages
+      LOG_ERROR(logger, "Error {}", i);
+      expected_contents.insert(expected_contents.end() - 8, "ERROR Error " + std::to_string(i) + " []");
+      expected_contents.erase(expected_contents.begin(), expected_contents.end() - 9);
+      logger->flush_log();
+    }
+  }
+
+  // Keeps the messages logged before the flush and the last 8 messages
+  expected_contents.erase(expected_contents.begin() + 9, expected_contents.end() - 8);
+
+  logger->flush_backtrace();
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  REQUIRE_EQ(testing::file_contents(filename), expected_contents);
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("backtrace_lazy_format")
+{
+  backtrace_lazy_format("backtrace_lazy_format.log", 1);
+}
+
+/***/
+TEST_CASE("backtrace_lazy_format_formatter_threads")
+{
+  backtrace_lazy_format("backtrace_lazy_format_formatter_threads.log", 3);
+}
@@ -0,0 +1,161 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/BinaryLogReader.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/backend/PatternFormatter.h"
+#include "quill/sinks/BinaryFileSink.h"
+#include "quill/std/Vector.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quill;
+
+/***/
+TEST_CASE("binary_file_sink")
+{
+  static constexpr size_t number_of_messages = 500u;
+  static constexpr size_t number_of_threads = 4;
+  static constexpr uint32_t number_of_runtime_call_sites = 600u;
+  static constexpr char const* filename = "binary_file_sink.bin";
+  static std::string const logger_name_prefix = "logger_";
+
+  // Start the logging backend thread
+  Backend::start();
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(
+      [i]()
+      {
+        auto binary_file_sink = Frontend::create_or_get_sink<BinaryFileSink>(filename,
+                                                                             []()
+                                                                             {
+                                                                               FileSinkConfig cfg;
+                                                                               cfg.set_open_mode('w');
+                                                                               return cfg;
+                                                                             }());
+
+        Logger* logger =
+          Frontend::create_or_get_logger(logger_name_prefix + std::to_string(i), std::move(binary_file_sink));
+
+        for (size_t j = 0; j < number_of_messages; ++j)
+        {
+          LOG_INFO(logger, "Hello from thread {thread_index} this is message {message_num} [{double:.2f}]",
+                   i, j, 3.17312);
+        }
+
+        LOG_WARNING(logger, "Positional args {} {}", i, "end");
+        LOG_INFO(logger, "Types {} {} {:.1f} {} {} {:x} {}", true, 'c', 1.5f, -42, int64_t{-7},
+                 (std::numeric_limits<uint64_t>::max)(), std::string{"str"});
+
+        // A type with its own formatter and a non-printable char are formatted by the backend
+        LOG_INFO(logger, "Vector {}", std::vector<int>{1, 2, 3});
+        LOG_INFO(logger, "Non printable {}", std::string{"a\x01"});
+        LOG_RUNTIME_METADATA(logger, LogLevel::Error, "runtime_file.cpp", 1234, "runtime_function",
+                             "Runtime metadata {}", i);
+      });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  // The backend reuses the storage of the runtime metadata for different call sites once the
+  // transit event buffer wraps around. Flushing after each statement keeps the buffer from growing
+  Logger* runtime_logger = Frontend::get_logger(logger_name_prefix + "0");
+
+  for (uint32_t k = 0; k < number_of_runtime_call_sites; ++k)
+  {
+    LOG_RUNTIME_METADATA(runtime_logger, LogLevel::Error, "other_runtime_file.cpp", k,
+                         "other_runtime_function", "Other runtime metadata {}", k);
+    runtime_logger->flush_log();
+  }
+
+  // flush all log and remove all loggers
+  for (Logger* logger : Frontend::get_all_loggers())
+  {
+    logger->flush_log();
+    Frontend::remove_logger(logger);
+  }
+
+  Backend::stop();
+
+  // Decode the file offline using the regular pattern formatter
+  BinaryLogReader reader{filename};
+  BinaryLogRecord record;
+
+  PatternFormatter pattern_formatter{PatternFormatterOptions{
+    "%(short_source_location) %(caller_function) LOG_%(log_level) %(logger) %(message) "
+    "[%(named_args)]"}};
+
+  std::vector<std::string> decoded;
+
+  while (reader.read_next(record))
+  {
+    REQUIRE(record.metadata);
+
+    std::string_view const log_statement = pattern_formatter.format(
+      record.timestamp, record.thread_id, record.thread_name, record.process_id, record.logger_name,
+      record.log_level_description, record.log_level_short_code, *record.metadata,
+      record.named_args, record.log_message, std::string_view{});
+
+    decoded.emplace_back(log_statement.data(), log_statement.size());
+  }
+
+  REQUIRE_EQ(decoded.size(),
+             number_of_threads * (number_of_messages + 5) + number_of_runtime_call_sites);
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    for (size_t j = 0; j < number_of_messages; ++j)
+    {
+      std::string const expected_string = "LOG_INFO " + logger_name_prefix + std::to_string(i) +
+        " Hello from thread " + std::to_string(i) + " this is message " + std::to_string(j) +
+        " [3.17] [thread_index: " + std::to_string(i) + ", message_num: " + std::to_string(j) +
+        ", double: 3.17]";
+
+      REQUIRE(quill::testing::file_contains(decoded, expected_string));
+    }
+
+    std::string const expected_positional = "LOG_WARNING " + logger_name_prefix +
+      std::to_string(i) + " Positional args " + std::to_string(i) + " end []";
+    REQUIRE(quill::testing::file_contains(decoded, expected_positional));
+
+    std::string const expected_types = "LOG_INFO " + logger_name_prefix + std::to_string(i) +
+      " Types true c 1.5 -42 -7 ffffffffffffffff str []";
+    REQUIRE(quill::testing::file_contains(decoded, expected_types));
+
+    std::string const expected_vector =
+      "LOG_INFO " + logger_name_prefix + std::to_string(i) + " Vector [1, 2, 3] []";
+    REQUIRE(quill::testing::file_contains(decoded, expected_vector));
+
+    std::string const expected_non_printable =
+      "LOG_INFO " + logger_name_prefix + std::to_string(i) + " Non printable a\\x01 []";
+    REQUIRE(quill::testing::file_contains(decoded, expected_non_printable));
+
+    std::string const expected_runtime = "runtime_file.cpp:1234 runtime_function LOG_ERROR " +
+      logger_name_prefix + std::to_string(i) + " Runtime metadata " + std::to_string(i);
+    REQUIRE(quill::testing::file_contains(decoded, expected_runtime));
+  }
+
+  for (uint32_t k = 0; k < number_of_runtime_call_sites; ++k)
+  {
+    std::string const expected_runtime = "other_runtime_file.cpp:" + std::to_string(k) +
+      " other_runtime_function LOG_ERROR " + logger_name_prefix + "0 Other runtime metadata " +
+      std::to_string(k);
+    REQUIRE(quill::testing::file_contains(decoded, expected_runtime));
+  }
+
+  testing::remove_file(filename);
+}
@@ -0,0 +1,119 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quill;
+
+// Small queues so the frontend threads keep blocking on a full queue
+struct BoundedFutexWaitFrontendOptions : quill::FrontendOptions
+{
+  static constexpr quill::QueueType queue_type = quill::QueueType::BoundedBlocking;
+  static constexpr size_t initial_queue_capacity = 4096;
+  static constexpr bool blocking_queue_futex_wait = true;
+};
+
+struct UnboundedFutexWaitFrontendOptions : quill::FrontendOptions
+{
+  static constexpr quill::QueueType queue_type = quill::QueueType::UnboundedBlocking;
+  static constexpr size_t initial_queue_capacity = 1024;
+  static constexpr size_t unbounded_queue_max_capacity = 4096;
+  static constexpr bool blocking_queue_futex_wait = true;
+};
+
+/***/
+template <typename TFrontendOptions>
+void test_blocking_queue_futex_wait(char const* filename)
+{
+  using CustomFrontend = FrontendImpl<TFrontendOptions>;
+
+  static constexpr size_t number_of_messages = 5000;
+  static constexpr size_t number_of_threads = 4;
+  static std::string const logger_name_prefix = "logger_";
+
+  Backend::start();
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(
+      [i, filename]()
+      {
+        auto file_sink = CustomFrontend::template create_or_get_sink<FileSink>(
+          filename,
+          []()
+          {
+            FileSinkConfig cfg;
+            cfg.set_open_mode('w');
+            return cfg;
+          }(),
+          FileEventNotifier{});
+
+        auto* logger =
+          CustomFrontend::create_or_get_logger(logger_name_prefix + std::to_string(i), std::move(file_sink));
+
+        for (size_t j = 0; j < number_of_messages; ++j)
+        {
+          LOG_INFO(logger, "Log something to fulfill the bound queue {} {}", i, j);
+        }
+
+        logger->flush_log();
+        CustomFrontend::remove_logger(logger);
+      });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  Backend::stop();
+
+  // No message is dropped and the messages of each thread are in order
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), number_of_messages * number_of_threads);
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    size_t next_message{0};
+    std::string const expected_prefix = logger_name_prefix + std::to_string(i) +
+      "     Log something to fulfill the bound queue " + std::to_string(i) + " ";
+
+    for (std::string const& line : file_contents)
+    {
+      size_t const pos = line.find(expected_prefix);
+
+      if (pos != std::string::npos)
+      {
+        REQUIRE_EQ(line.substr(pos + expected_prefix.size()), std::to_string(next_message));
+        ++next_message;
+      }
+    }
+
+    REQUIRE_EQ(next_message, number_of_messages);
+  }
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("bounded_blocking_queue_futex_wait")
+{
+  test_blocking_queue_futex_wait<BoundedFutexWaitFrontendOptions>(
+    "bounded_blocking_queue_futex_wait.log");
+}
+
+/***/
+TEST_CASE("unbounded_blocking_queue_futex_wait")
+{
+  test_blocking_queue_futex_wait<UnboundedFutexWaitFrontendOptions>(
+    "unbounded_blocking_queue_futex_wait.log");
+}
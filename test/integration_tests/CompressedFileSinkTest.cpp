@@ -0,0 +1,255 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/CompressedFileSink.h"
+#include "quill/sinks/RotatingCompressedFileSink.h"
+#include "quill/sinks/RotatingFileSink.h"
+#include "quill/sinks/compression/CompressFile.h"
+#include "quill/sinks/compression/GzipCompressor.h"
+
+#include <zlib.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace quill;
+
+/**
+ * Decompresses all the gzip members of the file
+ */
+std::vector<std::string> gzip_file_contents(fs::path const& filename)
+{
+  gzFile file = gzopen(filename.string().data(), "rb");
+  REQUIRE(file);
+
+  std::string contents;
+  char buffer[4096];
+  int bytes_read;
+
+  while ((bytes_read = gzread(file, buffer, sizeof(buffer))) > 0)
+  {
+    contents.append(buffer, static_cast<size_t>(bytes_read));
+  }
+
+  REQUIRE_EQ(bytes_read, 0);
+  gzclose(file);
+
+  std::vector<std::string> lines;
+  std::istringstream stream{contents};
+  std::string line;
+
+  while (std::getline(stream, line))
+  {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+/***/
+TEST_CASE("compressed_file_sink")
+{
+  static constexpr size_t number_of_messages = 5000;
+  static constexpr char const* filename = "compressed_file_sink.log.gz";
+
+  Backend::start();
+
+  FileEventNotifier file_event_notifier;
+
+  // Receives the statements before they are compressed
+  file_event_notifier.before_write = [](std::string_view message)
+  { return "before_write " + std::string{message}; };
+
+  auto file_sink = Frontend::create_or_get_sink<CompressedFileSink<GzipCompressor>>(
+    filename,
+    []()
+    {
+      CompressedFileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_compression_level(6);
+      return cfg;
+    }(),
+    file_event_notifier);
+
+  Logger* logger = Frontend::create_or_get_logger("logger", std::move(file_sink),
+                                                  quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello from compressed file sink this is message {}", i);
+  }
+
+  logger->flush_log();
+
+  // The flush completed a gzip member, the file is decodable while the sink is still open
+  std::vector<std::string> file_contents = gzip_file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), number_of_messages);
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello again this is message {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  // Compressed much smaller than the text
+  REQUIRE_LT(fs::file_size(filename), number_of_messages * 20);
+
+  file_contents = gzip_file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), number_of_messages * 2);
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    REQUIRE_EQ(file_contents[i],
+               "before_write Hello from compressed file sink this is message " + std::to_string(i));
+    REQUIRE_EQ(file_contents[number_of_messages + i],
+               "before_write Hello again this is message " + std::to_string(i));
+  }
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("rotating_compressed_file_sink")
+{
+  static constexpr size_t number_of_messages = 20000;
+  static constexpr char const* base_filename = "rotating_compressed_file_sink.gz";
+  static constexpr char const* base_filename_1 = "rotating_compressed_file_sink.1.gz";
+  static constexpr char const* base_filename_2 = "rotating_compressed_file_sink.2.gz";
+
+  Backend::start();
+
+  auto rotating_file_sink = Frontend::create_or_get_sink<RotatingCompressedFileSink<GzipCompressor>>(
+    base_filename,
+    []()
+    {
+      RotatingCompressedFileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_compression_level(6);
+      cfg.set_rotation_max_file_size(16 * 1024);
+      cfg.set_max_backup_files(2);
+      cfg.set_overwrite_rolled_files(false);
+      return cfg;
+    }());
+
+  Logger* logger = Frontend::create_or_get_logger(
+    "logger", std::move(rotating_file_sink), quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello rotating file log num {}", i);
+
+    if ((i % 100) == 0)
+    {
+      // Writes the compressed data, so the compressed file size reaches the rotation size
+      logger->flush_log();
+    }
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  // Each rotated file is a complete gzip stream, the newest messages are in the base file
+  std::vector<std::string> file_contents = gzip_file_contents(base_filename_2);
+  std::vector<std::string> const file_contents_1 = gzip_file_contents(base_filename_1);
+  std::vector<std::string> const file_contents_0 = gzip_file_contents(base_filename);
+
+  REQUIRE_FALSE(file_contents.empty());
+  REQUIRE_FALSE(file_contents_1.empty());
+
+  file_contents.insert(file_contents.end(), file_contents_1.begin(), file_contents_1.end());
+  file_contents.insert(file_contents.end(), file_contents_0.begin(), file_contents_0.end());
+
+  REQUIRE_EQ(file_contents.size(), number_of_messages);
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    REQUIRE_EQ(file_contents[i], "Hello rotating file log num " + std::to_string(i));
+  }
+
+  testing::remove_file(base_filename);
+  testing::remove_file(base_filename_1);
+  testing::remove_file(base_filename_2);
+}
+
+/***/
+TEST_CASE("rotating_file_sink_background_compression")
+{
+  static constexpr size_t number_of_messages = 8000;
+  static constexpr char const* base_filename = "rotating_file_sink_background_compression.log";
+  static constexpr char const* base_filename_1 = "rotating_file_sink_background_compression.1.log.gz";
+  static constexpr char const* base_filename_2 = "rotating_file_sink_background_compression.2.log.gz";
+  static constexpr char const* base_filename_3 = "rotating_file_sink_background_compression.3.log.gz";
+
+  {
+    // Without the compression extension it is not a rotated file and it is not removed
+    std::ofstream existing_file{"rotating_file_sink_background_compression.1.log"};
+    existing_file << "existing line\n";
+  }
+
+  Backend::start();
+
+  auto rotating_file_sink = Frontend::create_or_get_sink<RotatingFileSink>(
+    base_filename,
+    []()
+    {
+      RotatingFileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_rotation_max_file_size(64 * 1024);
+      cfg.set_max_backup_files(3);
+      cfg.set_background_rotation(true);
+      cfg.set_rotated_file_compression(".gz",
+                                       [](fs::path const& source, fs::path const& destination)
+                                       { return compress_file<GzipCompressor>(source, destination); });
+      return cfg;
+    }());
+
+  Logger* logger = Frontend::create_or_get_logger(
+    "logger", std::move(rotating_file_sink), quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello background compression num {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+
+  // The sink completes the pending compressions when it is destroyed
+  Backend::stop();
+
+  // The rotated files are compressed, the newest messages are in the base file
+  std::vector<std::string> file_contents = gzip_file_contents(base_filename_3);
+  std::vector<std::string> const file_contents_2 = gzip_file_contents(base_filename_2);
+  std::vector<std::string> const file_contents_1 = gzip_file_contents(base_filename_1);
+  std::vector<std::string> const file_contents_0 = testing::file_contents(base_filename);
+
+  REQUIRE_FALSE(file_contents_0.empty());
+
+  file_contents.insert(file_contents.end(), file_contents_2.begin(), file_contents_2.end());
+  file_contents.insert(file_contents.end(), file_contents_1.begin(), file_contents_1.end());
+  file_contents.insert(file_contents.end(), file_contents_0.begin(), file_contents_0.end());
+
+  size_t const first_message = number_of_messages - file_contents.size();
+  for (size_t i = 0; i < file_contents.size(); ++i)
+  {
+    REQUIRE_EQ(file_contents[i], "Hello background compression num " + std::to_string(first_message + i));
+  }
+
+  REQUIRE_EQ(testing::file_contents("rotating_file_sink_background_compression.1.log"),
+             std::vector<std::string>{"existing line"});
+
+  testing::remove_file(base_filename);
+  testing::remove_file(base_filename_1);
+  testing::remove_file(base_filename_2);
+  testing::remove_file(base_filename_3);
+  testing::remove_file("rotating_file_sink_background_compression.1.log");
+}
@@ -0,0 +1,98 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace quill;
+
+/**
+ * A FileSink that counts the batches it receives
+ */
+class BatchCountingFileSink : public FileSink
+{
+public:
+  using FileSink::FileSink;
+
+  void write_log_batch(LogRecordView const* records, size_t count, std::string const& process_id) override
+  {
+    ++batch_count;
+    max_batch_records = (std::max)(max_batch_records, count);
+    FileSink::write_log_batch(records, count, process_id);
+  }
+
+  size_t batch_count{0};
+  size_t max_batch_records{0};
+};
+
+/***/
+TEST_CASE("file_sink_batch_write")
+{
+  static constexpr size_t number_of_messages = 10000;
+  static constexpr char const* batch_filename = "file_sink_batch_write.log";
+  static constexpr char const* per_event_filename = "file_sink_batch_write_per_event.log";
+  static std::string const logger_name = "logger";
+  static std::string const padding(100, 'x');
+
+  auto make_sink = [](char const* filename, bool batch_write)
+  {
+    FileSinkConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_batch_write(batch_write);
+    return Frontend::create_or_get_sink<BatchCountingFileSink>(filename, cfg);
+  };
+
+  std::shared_ptr<Sink> batch_sink = make_sink(batch_filename, true);
+  std::shared_ptr<Sink> per_event_sink = make_sink(per_event_filename, false);
+
+  Logger* logger = Frontend::create_or_get_logger(logger_name, {batch_sink, per_event_sink},
+                                                  quill::PatternFormatterOptions{"%(message)"});
+  logger->init_backtrace(2, LogLevel::Error);
+
+  std::vector<std::string> expected_contents;
+
+  // Logged before the backend starts, so the backend processes them in large batches
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Batched message number {} {}", i, padding);
+    expected_contents.push_back("Batched message number " + std::to_string(i) + " " + padding);
+
+    if (i == number_of_messages / 2)
+    {
+      // The backtrace is written between the pending batch and the rest of the messages
+      LOG_BACKTRACE(logger, "Backtrace message {}", i);
+      LOG_ERROR(logger, "Error message {}", i);
+      expected_contents.push_back("Error message " + std::to_string(i));
+      expected_contents.push_back("Backtrace message " + std::to_string(i));
+    }
+  }
+
+  BackendOptions backend_options;
+  backend_options.transit_events_soft_limit = 1;
+  Backend::start(backend_options);
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  REQUIRE_EQ(testing::file_contents(batch_filename), expected_contents);
+  REQUIRE_EQ(testing::file_contents(per_event_filename), expected_contents);
+
+  auto const* batch_counting_sink = static_cast<BatchCountingFileSink const*>(batch_sink.get());
+  REQUIRE_GT(batch_counting_sink->batch_count, 0);
+  REQUIRE_GT(batch_counting_sink->max_batch_records, 1);
+
+  auto const* per_event_counting_sink = static_cast<BatchCountingFileSink const*>(per_event_sink.get());
+  REQUIRE_EQ(per_event_counting_sink->batch_count, 0);
+
+  testing::remove_file(batch_filename);
+  testing::remove_file(per_event_filename);
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+#include "quill/sinks/RotatingFileSink.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace quill;
+
+/***/
+TEST_CASE("file_sink_direct_io")
+{
+  static constexpr size_t number_of_messages = 5000;
+  static constexpr char const* filename = "file_sink_direct_io.log";
+  static std::string const logger_name = "logger";
+
+  {
+    // The sink appends to the existing content, which does not end on a block boundary
+    std::ofstream existing_file{filename};
+    existing_file << "existing line\n";
+  }
+
+  std::atomic<size_t> error_count{0};
+
+  BackendOptions backend_options;
+  backend_options.error_notifier = [&error_count](std::string const& error_message)
+  {
+    if (error_message.find("failed") != std::string::npos)
+    {
+      error_count.fetch_add(1);
+    }
+  };
+  Backend::start(backend_options);
+
+  FileEventNotifier file_event_notifier;
+
+  // Written through the FILE* while the other writes use O_DIRECT
+  file_event_notifier.after_open = [](fs::path const&, FILE* file)
+  { std::fputs("header line\n", file); };
+
+  file_event_notifier.before_close = [](fs::path const&, FILE* file)
+  { std::fputs("footer line\n", file); };
+
+  auto file_sink = Frontend::create_or_get_sink<FileSink>(
+    filename,
+    []()
+    {
+      FileSinkConfig cfg;
+      cfg.set_open_mode('a');
+      cfg.set_fsync_enabled(true);
+      cfg.set_direct_io(true);
+
+      // A small buffer so it is written many times between the flushes
+      cfg.set_write_buffer_size(4096);
+      return cfg;
+    }(),
+    file_event_notifier);
+
+  Logger* logger = Frontend::create_or_get_logger(logger_name, std::move(file_sink),
+                                                  quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello from direct io this is message {}", i);
+
+    if ((i % 1000) == 0)
+    {
+      // Each flush writes the unaligned tail, which is written again by the next flush
+      logger->flush_log();
+    }
+  }
+
+  logger->flush_log();
+
+  // The file has its logical size after a flush, the padding of the last block is truncated
+  std::vector<std::string> file_contents = quill::testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), number_of_messages + 2);
+  REQUIRE_EQ(file_contents.back(), "Hello from direct io this is message " + std::to_string(number_of_messages - 1));
+
+  Frontend::remove_logger(logger);
+
+  // The sink is destroyed and the file is closed when the backend stops
+  Backend::stop();
+
+  file_contents = quill::testing::file_contents(filename);
+
+  REQUIRE_EQ(file_contents.size(), number_of_messages + 3);
+  REQUIRE_EQ(file_contents.front(), "existing line");
+  REQUIRE_EQ(file_contents[1], "header line");
+  REQUIRE_EQ(file_contents.back(), "footer line");
+  REQUIRE_EQ(error_count.load(), 0);
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    REQUIRE_EQ(file_contents[i + 2], "Hello from direct io this is message " + std::to_string(i));
+  }
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("rotating_file_sink_direct_io")
+{
+  static constexpr size_t number_of_messages = 2500;
+  static constexpr char const* base_filename = "rotating_file_sink_direct_io.log";
+  static constexpr char const* base_filename_1 = "rotating_file_sink_direct_io.1.log";
+  static constexpr char const* base_filename_2 = "rotating_file_sink_direct_io.2.log";
+
+  Backend::start();
+
+  auto rotating_file_sink = Frontend::create_or_get_sink<RotatingFileSink>(
+    base_filename,
+    []()
+    {
+      RotatingFileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_rotation_max_file_size(32 * 1024);
+      cfg.set_max_backup_files(2);
+      cfg.set_overwrite_rolled_files(false);
+      cfg.set_direct_io(true);
+      return cfg;
+    }());
+
+  Logger* logger = Frontend::create_or_get_logger(
+    "logger", std::move(rotating_file_sink), quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello rotating file log num {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  // Each rotated file holds the messages it received in order, the newest are in the base file
+  std::vector<std::string> file_contents = testing::file_contents(base_filename_2);
+  std::vector<std::string> const file_contents_1 = testing::file_contents(base_filename_1);
+  std::vector<std::string> const file_contents_0 = testing::file_contents(base_filename);
+
+  REQUIRE_FALSE(file_contents.empty());
+  REQUIRE_FALSE(file_contents_1.empty());
+
+  file_contents.insert(file_contents.end(), file_contents_1.begin(), file_contents_1.end());
+  file_contents.insert(file_contents.end(), file_contents_0.begin(), file_contents_0.end());
+
+  REQUIRE_EQ(file_contents.size(), number_of_messages);
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    REQUIRE_EQ(file_contents[i], "Hello rotating file log num " + std::to_string(i));
+  }
+
+  testing::remove_file(base_filename);
+  testing::remove_file(base_filename_1);
+  testing::remove_file(base_filename_2);
+}
+
+/***/
+TEST_CASE("file_sink_direct_io_with_io_uring")
+{
+  FileSinkConfig cfg;
+  cfg.set_direct_io(true);
+  cfg.set_io_uring_enabled(true);
+
+  REQUIRE_THROWS_AS(FileSink("file_sink_direct_io_with_io_uring.log", cfg), QuillError);
+}
@@ -0,0 +1,187 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+#include "quill/sinks/RotatingFileSink.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quill;
+
+/***/
+TEST_CASE("file_sink_io_uring")
+{
+  static constexpr size_t number_of_messages = 5000;
+  static constexpr size_t number_of_threads = 4;
+  static constexpr char const* filename = "file_sink_io_uring.log";
+  static std::string const logger_name_prefix = "logger_";
+
+  {
+    // The sink appends to the existing content
+    std::ofstream existing_file{filename};
+    existing_file << "existing line\n";
+  }
+
+  std::atomic<size_t> error_count{0};
+
+  BackendOptions backend_options;
+  backend_options.error_notifier = [&error_count](std::string const& error_message)
+  {
+    if (error_message.find("failed") != std::string::npos)
+    {
+      error_count.fetch_add(1);
+    }
+  };
+  Backend::start(backend_options);
+
+  FileEventNotifier file_event_notifier;
+
+  // Written through the FILE* while the other writes go through io_uring
+  file_event_notifier.after_open = [](fs::path const&, FILE* file)
+  { std::fputs("header line\n", file); };
+
+  file_event_notifier.before_close = [](fs::path const&, FILE* file)
+  { std::fputs("footer line\n", file); };
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(
+      [i, &file_event_notifier]()
+      {
+        auto file_sink = Frontend::create_or_get_sink<FileSink>(
+          filename,
+          []()
+          {
+            FileSinkConfig cfg;
+            cfg.set_open_mode('a');
+            cfg.set_fsync_enabled(true);
+            cfg.set_io_uring_enabled(true);
+
+            // Small buffers so the writer runs out of free buffers
+            cfg.set_write_buffer_size(4096);
+            cfg.set_io_uring_buffer_count(2);
+            return cfg;
+          }(),
+          file_event_notifier);
+
+        Logger* logger = Frontend::create_or_get_logger(
+          logger_name_prefix + std::to_string(i), std::move(file_sink),
+          quill::PatternFormatterOptions{"%(logger) %(message)"});
+
+        for (size_t j = 0; j < number_of_messages; ++j)
+        {
+          LOG_INFO(logger, "Hello from thread {} this is message {}", i, j);
+        }
+      });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  for (Logger* logger : Frontend::get_all_loggers())
+  {
+    logger->flush_log();
+    Frontend::remove_logger(logger);
+  }
+
+  // The sink is destroyed and the file is closed when the backend stops
+  Backend::stop();
+
+  std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+
+  REQUIRE_EQ(file_contents.size(), number_of_threads * number_of_messages + 3);
+  REQUIRE_EQ(file_contents.front(), "existing line");
+  REQUIRE_EQ(file_contents[1], "header line");
+  REQUIRE_EQ(file_contents.back(), "footer line");
+  REQUIRE_EQ(error_count.load(), 0);
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    std::string const logger_name = logger_name_prefix + std::to_string(i);
+    size_t next_message{0};
+
+    for (std::string const& line : file_contents)
+    {
+      if (line.rfind(logger_name + " ", 0) == 0)
+      {
+        REQUIRE_EQ(line, logger_name + " Hello from thread " + std::to_string(i) +
+                           " this is message " + std::to_string(next_message));
+        ++next_message;
+      }
+    }
+
+    REQUIRE_EQ(next_message, number_of_messages);
+  }
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("rotating_file_sink_io_uring")
+{
+  static constexpr size_t number_of_messages = 2500;
+  static constexpr char const* base_filename = "rotating_file_sink_io_uring.log";
+  static constexpr char const* base_filename_1 = "rotating_file_sink_io_uring.1.log";
+  static constexpr char const* base_filename_2 = "rotating_file_sink_io_uring.2.log";
+
+  Backend::start();
+
+  auto rotating_file_sink = Frontend::create_or_get_sink<RotatingFileSink>(
+    base_filename,
+    []()
+    {
+      RotatingFileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_rotation_max_file_size(32 * 1024);
+      cfg.set_max_backup_files(2);
+      cfg.set_overwrite_rolled_files(false);
+      cfg.set_io_uring_enabled(true);
+      return cfg;
+    }());
+
+  Logger* logger = Frontend::create_or_get_logger(
+    "logger", std::move(rotating_file_sink), quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello rotating file log num {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  // Each rotated file holds the messages it received in order, the newest are in the base file
+  std::vector<std::string> file_contents = testing::file_contents(base_filename_2);
+  std::vector<std::string> const file_contents_1 = testing::file_contents(base_filename_1);
+  std::vector<std::string> const file_contents_0 = testing::file_contents(base_filename);
+
+  REQUIRE_FALSE(file_contents.empty());
+  REQUIRE_FALSE(file_contents_1.empty());
+
+  file_contents.insert(file_contents.end(), file_contents_1.begin(), file_contents_1.end());
+  file_contents.insert(file_contents.end(), file_contents_0.begin(), file_contents_0.end());
+
+  REQUIRE_EQ(file_contents.size(), number_of_messages);
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    REQUIRE_EQ(file_contents[i], "Hello rotating file log num " + std::to_string(i));
+  }
+
+  testing::remove_file(base_filename);
+  testing::remove_file(base_filename_1);
+  testing::remove_file(base_filename_2);
+}
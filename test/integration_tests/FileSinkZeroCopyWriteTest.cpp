@@ -0,0 +1,156 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/filters/Filter.h"
+#include "quill/sinks/FileSink.h"
+#include "quill/sinks/RotatingFileSink.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace quill;
+
+/**
+ * Drops the log statements that contain "drop", it needs the formatted log statement
+ */
+class DropStatementFilter : public Filter
+{
+public:
+  DropStatementFilter() : Filter("DropStatementFilter") {}
+
+  QUILL_NODISCARD bool filter(quill::MacroMetadata const* /** log_metadata **/,
+                              uint64_t /** log_timestamp **/, std::string_view /** thread_id **/,
+                              std::string_view /** thread_name **/, std::string_view /** logger_name **/,
+                              quill::LogLevel /** log_level **/, std::string_view /** log_message **/,
+                              std::string_view log_statement) noexcept override
+  {
+    return log_statement.find("drop") == std::string_view::npos;
+  }
+};
+
+/***/
+TEST_CASE("file_sink_zero_copy_write")
+{
+  static constexpr size_t number_of_messages = 5000;
+  static char const* filename = "file_sink_zero_copy_write.log";
+  static char const* shared_filename_a = "file_sink_zero_copy_write_shared_a.log";
+  static char const* shared_filename_b = "file_sink_zero_copy_write_shared_b.log";
+  static char const* rotating_filename = "file_sink_zero_copy_write_rotating.log";
+
+  FileSinkConfig cfg;
+  cfg.set_open_mode('w');
+  cfg.set_zero_copy_write(true);
+  cfg.set_write_buffer_size(4096);
+
+  // The only sink of the logger, the statements are formatted into its buffer
+  std::shared_ptr<Sink> file_sink = Frontend::create_or_get_sink<FileSink>(filename, cfg);
+  file_sink->add_filter(std::make_unique<DropStatementFilter>());
+  Logger* logger = Frontend::create_or_get_logger("logger", std::move(file_sink),
+                                                  quill::PatternFormatterOptions{"%(message)"});
+
+  // Two sinks share the statement, it is copied into the buffer of each sink
+  std::shared_ptr<Sink> shared_sink_a = Frontend::create_or_get_sink<FileSink>(shared_filename_a, cfg);
+  std::shared_ptr<Sink> shared_sink_b = Frontend::create_or_get_sink<FileSink>(shared_filename_b, cfg);
+  Logger* shared_logger = Frontend::create_or_get_logger(
+    "shared_logger", {std::move(shared_sink_a), std::move(shared_sink_b)},
+    quill::PatternFormatterOptions{"%(message)"});
+
+  // The rotation happens when the statement is committed
+  std::shared_ptr<Sink> rotating_sink = Frontend::create_or_get_sink<RotatingFileSink>(
+    rotating_filename,
+    []()
+    {
+      RotatingFileSinkConfig rfh_cfg;
+      rfh_cfg.set_open_mode('w');
+      rfh_cfg.set_zero_copy_write(true);
+      rfh_cfg.set_rotation_max_file_size(64 * 1024);
+      return rfh_cfg;
+    }());
+  Logger* rotating_logger = Frontend::create_or_get_logger(
+    "rotating_logger", std::move(rotating_sink), quill::PatternFormatterOptions{"%(message)"});
+
+  Backend::start();
+
+  std::vector<std::string> expected_contents;
+  std::vector<std::string> expected_shared_contents;
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Zero copy message number {}", i);
+    expected_contents.push_back("Zero copy message number " + std::to_string(i));
+
+    if (i % 10 == 0)
+    {
+      LOG_INFO(logger, "Zero copy message to drop {}", i);
+    }
+
+    LOG_INFO(shared_logger, "Shared message number {}", i);
+    expected_shared_contents.push_back("Shared message number " + std::to_string(i));
+
+    LOG_INFO(rotating_logger, "Zero copy message number {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Frontend::remove_logger(shared_logger);
+  Frontend::remove_logger(rotating_logger);
+  Backend::stop();
+
+  REQUIRE_EQ(testing::file_contents(filename), expected_contents);
+  REQUIRE_EQ(testing::file_contents(shared_filename_a), expected_shared_contents);
+  REQUIRE_EQ(testing::file_contents(shared_filename_b), expected_shared_contents);
+
+  // The newest messages are in the base file, the oldest in the highest index
+  std::vector<std::string> rotated_contents;
+  std::vector<std::string> rotated_filenames;
+
+  for (size_t index = 1;; ++index)
+  {
+    std::string const rotated_filename =
+      "file_sink_zero_copy_write_rotating." + std::to_string(index) + ".log";
+
+    if (!std::filesystem::exists(rotated_filename))
+    {
+      break;
+    }
+
+    rotated_filenames.insert(rotated_filenames.begin(), rotated_filename);
+  }
+
+  REQUIRE_GT(rotated_filenames.size(), 0);
+
+  for (std::string const& rotated_filename : rotated_filenames)
+  {
+    REQUIRE_LE(std::filesystem::file_size(rotated_filename), 64 * 1024);
+    std::vector<std::string> const contents = testing::file_contents(rotated_filename);
+    rotated_contents.insert(rotated_contents.end(), contents.begin(), contents.end());
+    testing::remove_file(rotated_filename);
+  }
+
+  std::vector<std::string> const base_contents = testing::file_contents(rotating_filename);
+  rotated_contents.insert(rotated_contents.end(), base_contents.begin(), base_contents.end());
+  REQUIRE_EQ(rotated_contents, expected_contents);
+
+  testing::remove_file(filename);
+  testing::remove_file(shared_filename_a);
+  testing::remove_file(shared_filename_b);
+  testing::remove_file(rotating_filename);
+}
+
+#if defined(QUILL_HAS_DIRECT_IO)
+/***/
+TEST_CASE("file_sink_zero_copy_write_with_direct_io")
+{
+  FileSinkConfig cfg;
+  cfg.set_zero_copy_write(true);
+  cfg.set_direct_io(true);
+
+  REQUIRE_THROWS_AS(FileSink("file_sink_zero_copy_write_with_direct_io.log", cfg), QuillError);
+}
+#endif
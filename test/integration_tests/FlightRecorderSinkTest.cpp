@@ -0,0 +1,230 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/FlightRecorderReader.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FlightRecorderSink.h"
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace quill;
+
+#if !defined(_WIN32)
+
+namespace
+{
+/***/
+std::vector<FlightRecorderRecord> read_records(char const* filename)
+{
+  FlightRecorderReader reader{filename};
+  std::vector<FlightRecorderRecord> records;
+  FlightRecorderRecord record;
+
+  while (reader.read_next(record))
+  {
+    records.push_back(record);
+  }
+
+  return records;
+}
+} // namespace
+
+/***/
+TEST_CASE("flight_recorder_sink")
+{
+  static constexpr size_t number_of_messages = 5000;
+  static constexpr char const* filename = "flight_recorder_sink.flight";
+
+  FlightRecorderSinkConfig cfg;
+  cfg.set_open_mode('w');
+  cfg.set_capacity(8192);
+
+  Backend::start();
+
+  std::vector<std::string> expected_contents;
+
+  for (size_t run = 0; run < 2; ++run)
+  {
+    Logger* logger = Frontend::create_or_get_logger(
+      "logger_" + std::to_string(run), Frontend::create_or_get_sink<FlightRecorderSink>(filename, filename, cfg),
+      quill::PatternFormatterOptions{"%(log_level) %(message)"});
+    logger->set_log_level(LogLevel::Debug);
+
+    for (size_t i = 0; i < number_of_messages; ++i)
+    {
+      LOG_DEBUG(logger, "Run {} message number {}", run, i);
+      expected_contents.push_back("DEBUG Run " + std::to_string(run) + " message number " +
+                                  std::to_string(i) + "\n");
+    }
+
+    logger->flush_log();
+
+    // Destroys the sink, the second run opens the file again and appends to the records
+    Frontend::remove_logger_blocking(logger);
+    cfg.set_open_mode('a');
+
+    // Only the most recent records fit in the file, in order and without gaps
+    std::vector<FlightRecorderRecord> const records = read_records(filename);
+    REQUIRE_GT(records.size(), 100);
+    REQUIRE_LT(records.size(), number_of_messages);
+
+    size_t const first_message = expected_contents.size() - records.size();
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+      REQUIRE_EQ(records[i].log_statement, expected_contents[first_message + i]);
+      REQUIRE_EQ(records[i].sequence, first_message + i);
+    }
+  }
+
+  Backend::stop();
+
+  // Starts with an empty circular buffer
+  {
+    cfg.set_open_mode('w');
+    FlightRecorderSink flight_recorder_sink{filename, cfg};
+    REQUIRE(read_records(filename).empty());
+  }
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("flight_recorder_sink_survives_sigkill")
+{
+  static constexpr size_t number_of_messages = 1000;
+  static constexpr char const* filename = "flight_recorder_sink_survives_sigkill.flight";
+
+  pid_t const pid = ::fork();
+  REQUIRE_NE(pid, -1);
+
+  if (pid == 0)
+  {
+    // The child writes the records and is killed without unmapping or closing the file
+    FlightRecorderSinkConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_capacity(16384);
+
+    FlightRecorderSink flight_recorder_sink{filename, cfg};
+
+    for (size_t i = 0; i < number_of_messages; ++i)
+    {
+      std::string const log_statement = "Message number " + std::to_string(i) + "\n";
+      flight_recorder_sink.write_log(nullptr, i, "", "", "", "", LogLevel::Info, "", "", nullptr,
+                                     "", log_statement);
+    }
+
+    std::raise(SIGKILL);
+  }
+
+  int status{0};
+  REQUIRE_EQ(::waitpid(pid, &status, 0), pid);
+  REQUIRE(WIFSIGNALED(status));
+  REQUIRE_EQ(WTERMSIG(status), SIGKILL);
+
+  std::vector<FlightRecorderRecord> const records = read_records(filename);
+  REQUIRE_GT(records.size(), 100);
+  REQUIRE_LT(records.size(), number_of_messages);
+
+  // The newest record is the last one written before the kill
+  size_t const first_message = number_of_messages - records.size();
+
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    REQUIRE_EQ(records[i].log_statement, "Message number " + std::to_string(first_message + i) + "\n");
+    REQUIRE_EQ(records[i].sequence, first_message + i);
+    REQUIRE_EQ(records[i].timestamp, first_message + i);
+  }
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("flight_recorder_sink_truncates_large_log_statement")
+{
+  static constexpr char const* filename = "flight_recorder_sink_truncates_large_log_statement.flight";
+
+  FlightRecorderSinkConfig cfg;
+  cfg.set_open_mode('w');
+  cfg.set_capacity(4096);
+
+  {
+    FlightRecorderSink flight_recorder_sink{filename, cfg};
+
+    std::string const small_log_statement = "small\n";
+    std::string const large_log_statement(10000, 'x');
+
+    flight_recorder_sink.write_log(nullptr, 0, "", "", "", "", LogLevel::Info, "", "", nullptr, "",
+                                   small_log_statement);
+    flight_recorder_sink.write_log(nullptr, 0, "", "", "", "", LogLevel::Info, "", "", nullptr, "",
+                                   large_log_statement);
+  }
+
+  // The large log statement fills the whole buffer
+  std::vector<FlightRecorderRecord> const records = read_records(filename);
+  REQUIRE_EQ(records.size(), 1);
+  REQUIRE_EQ(records[0].sequence, 1);
+  REQUIRE_EQ(records[0].log_statement, std::string(4096 - sizeof(detail::FlightRecorderRecordHeader), 'x'));
+
+  REQUIRE_THROWS_AS(cfg.set_capacity(1024), QuillError);
+  REQUIRE_THROWS_AS(FlightRecorderReader{"flight_recorder_sink_missing_file.flight"}, QuillError);
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("flight_recorder_sink_capacity_alignment")
+{
+  static constexpr char const* filename = "flight_recorder_sink_capacity_alignment.flight";
+
+  FlightRecorderSinkConfig cfg;
+  cfg.set_open_mode('w');
+
+  // A capacity that is not a multiple of the record alignment would let a padded record that fills
+  // the whole buffer end past the mapping
+  REQUIRE_THROWS_AS(cfg.set_capacity(4100), QuillError);
+  REQUIRE_THROWS_AS(cfg.set_capacity(4097), QuillError);
+
+  cfg.set_capacity(4104);
+
+  {
+    FlightRecorderSink flight_recorder_sink{filename, cfg};
+
+    std::string const small_log_statement = "small\n";
+    std::string const long_log_statement(4104 - sizeof(detail::FlightRecorderRecordHeader) - 3, 'y');
+    std::string const large_log_statement(10000, 'x');
+
+    flight_recorder_sink.write_log(nullptr, 0, "", "", "", "", LogLevel::Info, "", "", nullptr, "",
+                                   small_log_statement);
+    flight_recorder_sink.write_log(nullptr, 1, "", "", "", "", LogLevel::Info, "", "", nullptr, "",
+                                   long_log_statement);
+
+    // The padded long record fills the whole buffer
+    std::vector<FlightRecorderRecord> const records = read_records(filename);
+    REQUIRE_EQ(records.size(), 1);
+    REQUIRE_EQ(records[0].sequence, 1);
+    REQUIRE_EQ(records[0].log_statement, long_log_statement);
+
+    flight_recorder_sink.write_log(nullptr, 2, "", "", "", "", LogLevel::Info, "", "", nullptr, "",
+                                   large_log_statement);
+  }
+
+  REQUIRE_EQ(fs::file_size(filename), sizeof(detail::FlightRecorderFileHeader) + 4104);
+
+  std::vector<FlightRecorderRecord> const records = read_records(filename);
+  REQUIRE_EQ(records.size(), 1);
+  REQUIRE_EQ(records[0].sequence, 2);
+  REQUIRE_EQ(records[0].log_statement, std::string(4104 - sizeof(detail::FlightRecorderRecordHeader), 'x'));
+
+  testing::remove_file(filename);
+}
+#endif
@@ -0,0 +1,208 @@
+#include "doctest/doctest.h"
+
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/MetricAggregation.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace quill;
+
+struct CapturedHistogram
+{
+  MetricMetadata const* metric_metadata{nullptr};
+  std::vector<double> bucket_bounds;
+  std::vector<uint64_t> bucket_counts;
+  uint64_t count{0};
+  double sum{0};
+  double min{0};
+  double max{0};
+  std::string logger_name;
+};
+
+struct MetricAggregationCapturingSink final : public quill::Sink
+{
+  void write_log(quill::MacroMetadata const*, uint64_t, std::string_view, std::string_view,
+                 std::string const&, std::string_view, quill::LogLevel, std::string_view,
+                 std::string_view, std::vector<std::pair<std::string, std::string>> const*,
+                 std::string_view, std::string_view) override
+  {
+  }
+
+  void write_metric(quill::MetricMetadata const* metric_metadata, uint64_t, std::string_view,
+                    std::string_view, std::string const&, std::string_view, double value) override
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    metrics.emplace_back(metric_metadata, value);
+  }
+
+  void write_metric_histogram(quill::MetricMetadata const* metric_metadata, uint64_t,
+                              std::string_view, std::string_view, std::string const&,
+                              std::string_view logger_name, MetricHistogramData const& histogram) override
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    histograms.push_back(CapturedHistogram{
+      metric_metadata,
+      std::vector<double>{histogram.bucket_bounds, histogram.bucket_bounds + histogram.bucket_bounds_count},
+      std::vector<uint64_t>{histogram.bucket_counts,
+                            histogram.bucket_counts + histogram.bucket_bounds_count + 1},
+      histogram.count, histogram.sum, histogram.min, histogram.max, std::string{logger_name}});
+  }
+
+  void flush_sink() noexcept override {}
+
+  std::mutex mutex;
+  std::vector<std::pair<MetricMetadata const*, double>> metrics;
+  std::vector<CapturedHistogram> histograms;
+};
+
+/***/
+TEST_CASE("metric_aggregation")
+{
+  static std::string const logger_name = "metric_aggregation_test_logger";
+
+  Backend::start();
+
+  auto metric_sink =
+    Frontend::create_or_get_sink<MetricAggregationCapturingSink>("metric_aggregation_test_sink");
+  Logger* logger = Frontend::create_or_get_logger(logger_name, metric_sink);
+
+  MetricMetadata const* counter_metadata =
+    Frontend::create_metric("metric_aggregation_test_requests_total", "requests_total");
+  MetricMetadata const* gauge_metadata =
+    Frontend::create_metric("metric_aggregation_test_queue_depth", "queue_depth");
+  MetricMetadata const* histogram_metadata =
+    Frontend::create_metric("metric_aggregation_test_latency", "latency");
+  MetricMetadata const* interval_counter_metadata =
+    Frontend::create_metric("metric_aggregation_test_interval_total", "interval_total");
+  MetricMetadata const* thread_counter_metadata =
+    Frontend::create_metric("metric_aggregation_test_thread_total", "thread_total");
+
+  // Only publish by the number of updates, so the test does not depend on timing
+  MetricAggregationOptions options;
+  options.max_updates = 4;
+  options.max_interval = std::chrono::nanoseconds{0};
+
+  {
+    MetricCounter counter{logger, counter_metadata, options};
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+      counter.add(1.5);
+    }
+
+    // Two samples of 4 updates were published, the remaining 2 are published on destruction
+  }
+
+  MetricAggregationOptions gauge_options;
+  gauge_options.max_updates = 1000;
+  gauge_options.max_interval = std::chrono::nanoseconds{0};
+
+  MetricGauge gauge{logger, gauge_metadata, gauge_options};
+
+  for (size_t i = 1; i <= 5; ++i)
+  {
+    gauge.set(static_cast<double>(i));
+  }
+
+  REQUIRE(gauge.flush());
+
+  // Nothing to publish without an update
+  REQUIRE(gauge.flush());
+
+  MetricAggregationOptions histogram_options;
+  histogram_options.max_updates = 5;
+  histogram_options.max_interval = std::chrono::nanoseconds{0};
+
+  MetricHistogram histogram{logger, histogram_metadata, {1.0, 5.0, 10.0}, histogram_options};
+
+  for (double const value : {0.5, 1.0, 3.0, 7.0, 20.0})
+  {
+    histogram.record(value);
+  }
+
+  histogram.record(4.0);
+  REQUIRE(histogram.flush());
+
+  {
+    // The first update after max_interval publishes, only the elapsed time can trigger it here
+    MetricAggregationOptions interval_options;
+    interval_options.max_updates = 1000;
+    interval_options.max_interval = std::chrono::milliseconds{1};
+
+    MetricCounter interval_counter{logger, interval_counter_metadata, interval_options};
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    interval_counter.add(2.0);
+
+    // Nothing is left to publish on destruction
+  }
+
+  std::thread exiting_thread(
+    [logger, thread_counter_metadata, options]()
+    {
+      // The handle is destroyed when the thread exits, before the thread context it created
+      thread_local MetricCounter thread_counter{logger, thread_counter_metadata, options};
+
+      for (size_t i = 0; i < 6; ++i)
+      {
+        thread_counter.add(1.0);
+      }
+    });
+
+  exiting_thread.join();
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+  REQUIRE_THROWS_AS(MetricHistogram(logger, histogram_metadata, {1.0, 1.0}), QuillError);
+  REQUIRE_THROWS_AS(MetricHistogram(logger, histogram_metadata, {5.0, 1.0}), QuillError);
+#endif
+
+  logger->flush_log();
+  Backend::stop();
+  Frontend::remove_logger(logger);
+
+  auto* sink_ptr = static_cast<MetricAggregationCapturingSink*>(metric_sink.get());
+  std::lock_guard<std::mutex> const lock{sink_ptr->mutex};
+
+  REQUIRE_EQ(sink_ptr->metrics.size(), 7);
+  REQUIRE_EQ(sink_ptr->metrics[0].first, counter_metadata);
+  REQUIRE_EQ(sink_ptr->metrics[0].second, doctest::Approx{6.0});
+  REQUIRE_EQ(sink_ptr->metrics[1].first, counter_metadata);
+  REQUIRE_EQ(sink_ptr->metrics[1].second, doctest::Approx{6.0});
+  REQUIRE_EQ(sink_ptr->metrics[2].first, counter_metadata);
+  REQUIRE_EQ(sink_ptr->metrics[2].second, doctest::Approx{3.0});
+  REQUIRE_EQ(sink_ptr->metrics[3].first, gauge_metadata);
+  REQUIRE_EQ(sink_ptr->metrics[3].second, doctest::Approx{5.0});
+  REQUIRE_EQ(sink_ptr->metrics[4].first, interval_counter_metadata);
+  REQUIRE_EQ(sink_ptr->metrics[4].second, doctest::Approx{2.0});
+  REQUIRE_EQ(sink_ptr->metrics[5].first, thread_counter_metadata);
+  REQUIRE_EQ(sink_ptr->metrics[5].second, doctest::Approx{4.0});
+  REQUIRE_EQ(sink_ptr->metrics[6].first, thread_counter_metadata);
+  REQUIRE_EQ(sink_ptr->metrics[6].second, doctest::Approx{2.0});
+
+  REQUIRE_EQ(sink_ptr->histograms.size(), 2);
+
+  CapturedHistogram const& first = sink_ptr->histograms[0];
+  REQUIRE_EQ(first.metric_metadata, histogram_metadata);
+  REQUIRE_EQ(first.logger_name, logger_name);
+  REQUIRE_EQ(first.bucket_bounds, std::vector<double>{1.0, 5.0, 10.0});
+  REQUIRE_EQ(first.bucket_counts, std::vector<uint64_t>{2, 1, 1, 1});
+  REQUIRE_EQ(first.count, 5);
+  REQUIRE_EQ(first.sum, doctest::Approx{31.5});
+  REQUIRE_EQ(first.min, doctest::Approx{0.5});
+  REQUIRE_EQ(first.max, doctest::Approx{20.0});
+
+  // The counts start again after each publish
+  CapturedHistogram const& second = sink_ptr->histograms[1];
+  REQUIRE_EQ(second.bucket_counts, std::vector<uint64_t>{0, 1, 0, 0});
+  REQUIRE_EQ(second.count, 1);
+  REQUIRE_EQ(second.sum, doctest::Approx{4.0});
+  REQUIRE_EQ(second.min, doctest::Approx{4.0});
+  REQUIRE_EQ(second.max, doctest::Approx{4.0});
+}
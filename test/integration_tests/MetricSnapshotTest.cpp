@@ -0,0 +1,228 @@
+#include "doctest/doctest.h"
+
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/MetricAggregation.h"
+#include "quill/core/LogLinearHistogram.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace quill;
+
+struct CapturedSnapshot
+{
+  MetricMetadata const* metric_metadata{nullptr};
+  std::string logger_name;
+  uint64_t count{0};
+  double sum{0};
+  double min{0};
+  double max{0};
+  std::vector<std::pair<double, double>> quantiles;
+  uint64_t first_timestamp{0};
+  uint64_t last_timestamp{0};
+};
+
+struct MetricSnapshotCapturingSink final : public quill::Sink
+{
+  void write_log(quill::MacroMetadata const*, uint64_t, std::string_view, std::string_view,
+                 std::string const&, std::string_view, quill::LogLevel, std::string_view,
+                 std::string_view, std::vector<std::pair<std::string, std::string>> const*,
+                 std::string_view, std::string_view) override
+  {
+  }
+
+  void write_metric_snapshot(quill::MetricMetadata const* metric_metadata, uint64_t,
+                             std::string const&, std::string_view logger_name,
+                             MetricSnapshot const& snapshot) override
+  {
+    CapturedSnapshot captured{metric_metadata,
+                              std::string{logger_name},
+                              snapshot.histogram->count(),
+                              snapshot.histogram->sum(),
+                              snapshot.histogram->min(),
+                              snapshot.histogram->max(),
+                              {},
+                              snapshot.first_timestamp,
+                              snapshot.last_timestamp};
+
+    for (size_t i = 0; i < snapshot.quantiles_count; ++i)
+    {
+      captured.quantiles.emplace_back(snapshot.quantiles[i], snapshot.quantile_values[i]);
+    }
+
+    std::lock_guard<std::mutex> const lock{mutex};
+    snapshots.push_back(std::move(captured));
+  }
+
+  void flush_sink() noexcept override {}
+
+  std::mutex mutex;
+  std::vector<CapturedSnapshot> snapshots;
+};
+
+/***/
+TEST_CASE("metric_snapshot")
+{
+  static std::string const logger_name = "metric_snapshot_test_logger";
+  static std::string const removed_logger_name = "metric_snapshot_test_removed_logger";
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+  BackendOptions invalid_options;
+  invalid_options.metric_snapshot_quantiles = {0.5, 1.5};
+  REQUIRE_THROWS_AS(Backend::start(invalid_options), QuillError);
+#endif
+
+  // The interval is long enough to only get the snapshots on logger removal and backend stop
+  BackendOptions backend_options;
+  backend_options.metric_snapshot_interval = std::chrono::hours{1};
+  backend_options.metric_snapshot_quantiles = {0.5, 0.99};
+  Backend::start(backend_options);
+
+  auto metric_sink = Frontend::create_or_get_sink<MetricSnapshotCapturingSink>("metric_snapshot_test_sink");
+  Logger* logger = Frontend::create_or_get_logger(logger_name, metric_sink);
+  Logger* removed_logger = Frontend::create_or_get_logger(removed_logger_name, metric_sink);
+
+  MetricMetadata const* latency_metadata =
+    Frontend::create_metric("metric_snapshot_test_latency", "latency");
+  MetricMetadata const* size_metadata = Frontend::create_metric("metric_snapshot_test_size", "size");
+
+  for (uint64_t i = 1; i <= 1000; ++i)
+  {
+    logger->publish_metric(latency_metadata, static_cast<double>(i));
+  }
+
+  {
+    // The frontend histograms are merged with the samples of the same metric
+    MetricHistogram histogram{logger, latency_metadata, {2000.0, 4000.0}};
+    histogram.record(3000.0);
+    histogram.record(3000.0);
+  }
+
+  removed_logger->publish_metric(size_metadata, 64.0);
+  removed_logger->publish_metric(size_metadata, 128.0);
+  Frontend::remove_logger_blocking(removed_logger);
+
+  {
+    auto* sink_ptr = static_cast<MetricSnapshotCapturingSink*>(metric_sink.get());
+    std::lock_guard<std::mutex> const lock{sink_ptr->mutex};
+
+    REQUIRE_EQ(sink_ptr->snapshots.size(), 1);
+    CapturedSnapshot const& removed = sink_ptr->snapshots[0];
+    REQUIRE_EQ(removed.metric_metadata, size_metadata);
+    REQUIRE_EQ(removed.logger_name, removed_logger_name);
+    REQUIRE_EQ(removed.count, 2);
+    REQUIRE_EQ(removed.sum, doctest::Approx{192.0});
+    REQUIRE_EQ(removed.min, doctest::Approx{64.0});
+    REQUIRE_EQ(removed.max, doctest::Approx{128.0});
+  }
+
+  logger->flush_log();
+  Backend::stop();
+  Frontend::remove_logger(logger);
+
+  auto* sink_ptr = static_cast<MetricSnapshotCapturingSink*>(metric_sink.get());
+  std::lock_guard<std::mutex> const lock{sink_ptr->mutex};
+
+  REQUIRE_EQ(sink_ptr->snapshots.size(), 2);
+
+  CapturedSnapshot const& latency = sink_ptr->snapshots[1];
+  REQUIRE_EQ(latency.metric_metadata, latency_metadata);
+  REQUIRE_EQ(latency.logger_name, logger_name);
+  REQUIRE_EQ(latency.count, 1002);
+  REQUIRE_EQ(latency.sum, doctest::Approx{500500.0 + 6000.0});
+  REQUIRE_EQ(latency.min, doctest::Approx{1.0});
+  REQUIRE_EQ(latency.max, doctest::Approx{3000.0});
+  REQUIRE_GT(latency.first_timestamp, 0);
+  REQUIRE_GE(latency.last_timestamp, latency.first_timestamp);
+
+  REQUIRE_EQ(latency.quantiles.size(), 2);
+  REQUIRE_EQ(latency.quantiles[0].first, doctest::Approx{0.5});
+  REQUIRE_EQ(latency.quantiles[0].second, doctest::Approx{501.0}.epsilon(0.016));
+  REQUIRE_EQ(latency.quantiles[1].first, doctest::Approx{0.99});
+  REQUIRE_EQ(latency.quantiles[1].second, doctest::Approx{992.0}.epsilon(0.016));
+}
+
+/**
+ * Records the log messages and the metric snapshots in the order the sink receives them
+ */
+struct MetricSnapshotOrderSink final : public quill::Sink
+{
+  void write_log(quill::MacroMetadata const*, uint64_t, std::string_view, std::string_view,
+                 std::string const&, std::string_view, quill::LogLevel, std::string_view,
+                 std::string_view, std::vector<std::pair<std::string, std::string>> const*,
+                 std::string_view log_message, std::string_view) override
+  {
+    events.emplace_back(log_message);
+  }
+
+  void write_metric_snapshot(quill::MetricMetadata const* metric_metadata, uint64_t,
+                             std::string const&, std::string_view, MetricSnapshot const& snapshot) override
+  {
+    events.push_back(metric_metadata->metric_key() + " " + std::to_string(snapshot.histogram->count()));
+  }
+
+  void flush_sink() noexcept override {}
+
+  std::vector<std::string> events;
+};
+
+/***/
+TEST_CASE("metric_snapshot_sink_worker")
+{
+  static constexpr size_t number_of_metrics = 8;
+
+  BackendOptions backend_options;
+  backend_options.metric_snapshot_interval = std::chrono::hours{1};
+  backend_options.sink_workers.resize(1);
+  Backend::start(backend_options);
+
+  auto metric_sink = Frontend::create_or_get_sink<MetricSnapshotOrderSink>("metric_snapshot_order_sink");
+  metric_sink->set_sink_worker(0);
+  Logger* logger = Frontend::create_or_get_logger("metric_snapshot_sink_worker_logger", metric_sink);
+
+  std::vector<MetricMetadata const*> metrics;
+  for (size_t i = 0; i < number_of_metrics; ++i)
+  {
+    metrics.push_back(Frontend::create_metric("metric_snapshot_sink_worker_" + std::to_string(i), "value"));
+  }
+
+  for (size_t i = 0; i < number_of_metrics; ++i)
+  {
+    for (size_t j = 0; j <= i; ++j)
+    {
+      logger->publish_metric(metrics[i], static_cast<double>(j));
+    }
+
+    LOG_INFO(logger, "published {}", i);
+  }
+
+  // The snapshots of the pass on stop are written after the log statements queued to the worker
+  Backend::stop();
+  Frontend::remove_logger(logger);
+
+  auto* sink_ptr = static_cast<MetricSnapshotOrderSink*>(metric_sink.get());
+  REQUIRE_EQ(sink_ptr->events.size(), 2 * number_of_metrics);
+
+  std::vector<std::string> snapshots;
+  for (size_t i = 0; i < number_of_metrics; ++i)
+  {
+    REQUIRE_EQ(sink_ptr->events[i], "published " + std::to_string(i));
+    snapshots.push_back(sink_ptr->events[number_of_metrics + i]);
+  }
+
+  for (size_t i = 0; i < number_of_metrics; ++i)
+  {
+    std::string const expected =
+      "metric_snapshot_sink_worker_" + std::to_string(i) + " " + std::to_string(i + 1);
+    REQUIRE_NE(std::find(snapshots.begin(), snapshots.end(), expected), snapshots.end());
+  }
+}
@@ -0,0 +1,143 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/MmapFileSink.h"
+#include "quill/sinks/RotatingMmapFileSink.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace quill;
+
+/***/
+TEST_CASE("mmap_file_sink")
+{
+  static constexpr size_t number_of_messages = 5000;
+  static constexpr char const* filename = "mmap_file_sink.log";
+
+  {
+    // The sink appends to the existing content
+    std::ofstream existing_file{filename};
+    existing_file << "existing line\n";
+  }
+
+  Backend::start();
+
+  FileEventNotifier file_event_notifier;
+
+  // Written through the FILE* while the other writes go to the mapping
+  file_event_notifier.after_open = [](fs::path const&, FILE* file)
+  { std::fputs("header line\n", file); };
+
+  file_event_notifier.before_close = [](fs::path const&, FILE* file)
+  { std::fputs("footer line\n", file); };
+
+  auto file_sink = Frontend::create_or_get_sink<MmapFileSink>(
+    filename,
+    []()
+    {
+      MmapFileSinkConfig cfg;
+      cfg.set_open_mode('a');
+      cfg.set_fsync_enabled(true);
+
+      // A small window so the file is extended and remapped many times
+      cfg.set_mmap_window_size(8192);
+      return cfg;
+    }(),
+    file_event_notifier);
+
+  Logger* logger = Frontend::create_or_get_logger("logger", std::move(file_sink),
+                                                  quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello from mmap this is message {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+
+  // The sink is destroyed and the file is closed when the backend stops
+  Backend::stop();
+
+  // The file is truncated to the written data, there are no zeros left after the footer
+  std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+
+  REQUIRE_EQ(file_contents.size(), number_of_messages + 3);
+  REQUIRE_EQ(file_contents.front(), "existing line");
+  REQUIRE_EQ(file_contents[1], "header line");
+  REQUIRE_EQ(file_contents.back(), "footer line");
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    REQUIRE_EQ(file_contents[i + 2], "Hello from mmap this is message " + std::to_string(i));
+  }
+
+  testing::remove_file(filename);
+}
+
+/***/
+TEST_CASE("rotating_mmap_file_sink")
+{
+  static constexpr size_t number_of_messages = 2500;
+  static constexpr char const* base_filename = "rotating_mmap_file_sink.log";
+  static constexpr char const* base_filename_1 = "rotating_mmap_file_sink.1.log";
+  static constexpr char const* base_filename_2 = "rotating_mmap_file_sink.2.log";
+
+  Backend::start();
+
+  auto rotating_file_sink = Frontend::create_or_get_sink<RotatingMmapFileSink>(
+    base_filename,
+    []()
+    {
+      RotatingMmapFileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_rotation_max_file_size(32 * 1024);
+      cfg.set_max_backup_files(2);
+      cfg.set_overwrite_rolled_files(false);
+
+      // Smaller than a file, each file is remapped a few times before it rotates
+      cfg.set_mmap_window_size(8192);
+      return cfg;
+    }());
+
+  Logger* logger = Frontend::create_or_get_logger(
+    "logger", std::move(rotating_file_sink), quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello rotating file log num {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  // Each rotated file is truncated to its data, the newest messages are in the base file
+  std::vector<std::string> file_contents = testing::file_contents(base_filename_2);
+  std::vector<std::string> const file_contents_1 = testing::file_contents(base_filename_1);
+  std::vector<std::string> const file_contents_0 = testing::file_contents(base_filename);
+
+  REQUIRE_FALSE(file_contents.empty());
+  REQUIRE_FALSE(file_contents_1.empty());
+  REQUIRE_LE(fs::file_size(base_filename_1), 32 * 1024);
+
+  file_contents.insert(file_contents.end(), file_contents_1.begin(), file_contents_1.end());
+  file_contents.insert(file_contents.end(), file_contents_0.begin(), file_contents_0.end());
+
+  REQUIRE_EQ(file_contents.size(), number_of_messages);
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    REQUIRE_EQ(file_contents[i], "Hello rotating file log num " + std::to_string(i));
+  }
+
+  testing::remove_file(base_filename);
+  testing::remove_file(base_filename_1);
+  testing::remove_file(base_filename_2);
+}
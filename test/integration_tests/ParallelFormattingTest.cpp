@@ -0,0 +1,155 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace quill;
+
+/***/
+TEST_CASE("parallel_formatting")
+{
+  static constexpr size_t number_of_messages = 2000;
+  static constexpr size_t number_of_threads = 4;
+  static constexpr char const* filename = "parallel_formatting.log";
+  static std::string const logger_name_prefix = "logger_";
+
+  auto log_messages = [](size_t i, size_t first_message)
+  {
+    auto file_sink = Frontend::create_or_get_sink<FileSink>(filename,
+                                                            []()
+                                                            {
+                                                              FileSinkConfig cfg;
+                                                              cfg.set_open_mode('w');
+                                                              return cfg;
+                                                            }(),
+                                                            FileEventNotifier{});
+
+    Logger* logger = Frontend::create_or_get_logger(
+      logger_name_prefix + std::to_string(i), std::move(file_sink),
+      quill::PatternFormatterOptions{"%(logger) %(message) [%(named_args)]"});
+
+    std::string const text = "text_" + std::to_string(i);
+
+    for (size_t j = first_message; j < first_message + number_of_messages; ++j)
+    {
+      // string_view arguments reference the frontend queue until they are formatted
+      LOG_INFO(logger, "Hello {name} {num} {view} {dbl:.1f}", std::string{"thread"}, j,
+               std::string_view{text}, 1.25);
+
+      if ((j % 500) == 0)
+      {
+        // Larger than the initial queue capacity, the frontend switches to a new queue buffer
+        LOG_INFO(logger, "Large {}", std::string(200'000, 'x'));
+        LOG_RUNTIME_METADATA(logger, LogLevel::Info, "file.cpp", 1, "function",
+                             "Runtime {value}", j);
+      }
+    }
+  };
+
+  // Log before the backend starts so the backend reads large batches
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back([i, &log_messages]() { log_messages(i, 0); });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  std::atomic<size_t> error_count{0};
+
+  BackendOptions backend_options;
+  backend_options.formatter_threads = 4;
+  backend_options.error_notifier = [&error_count](std::string const& error_message)
+  {
+    if (error_message.find("Could not format log statement") != std::string::npos)
+    {
+      error_count.fetch_add(1);
+    }
+  };
+
+  Backend::start(backend_options);
+
+  threads.clear();
+
+  // Log again while the backend is running
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(
+      [i, &log_messages]()
+      {
+        log_messages(i, number_of_messages);
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+        LOG_INFO(Frontend::get_logger(logger_name_prefix + std::to_string(i)),
+                 "invalid format [{%f}]", 321.1);
+#endif
+      });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  for (Logger* logger : Frontend::get_all_loggers())
+  {
+    logger->flush_log();
+    Frontend::remove_logger(logger);
+  }
+
+  Backend::stop();
+
+  std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+
+  size_t const extra_messages_per_thread = 2 * 2 * (number_of_messages / 500);
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+  REQUIRE_EQ(file_contents.size(),
+             number_of_threads * (2 * number_of_messages + extra_messages_per_thread + 1));
+  REQUIRE_EQ(error_count.load(), number_of_threads);
+#else
+  REQUIRE_EQ(file_contents.size(), number_of_threads * (2 * number_of_messages + extra_messages_per_thread));
+#endif
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    std::string const logger_name = logger_name_prefix + std::to_string(i);
+    std::string const text = "text_" + std::to_string(i);
+
+    // The messages of each thread are written in order
+    size_t next_message{0};
+
+    for (std::string const& line : file_contents)
+    {
+      if (line.rfind(logger_name + " Hello", 0) == 0)
+      {
+        std::string const num = std::to_string(next_message);
+
+        REQUIRE_EQ(line,
+                   logger_name + " Hello thread " + num + " " + text + " 1.2 [name: thread, num: " +
+                     num + ", view: " + text + ", dbl: 1.2]");
+        ++next_message;
+      }
+    }
+
+    REQUIRE_EQ(next_message, 2 * number_of_messages);
+
+    REQUIRE(quill::testing::file_contains(file_contents, logger_name + " Runtime 3500 [value: 3500]"));
+  }
+
+  testing::remove_file(filename);
+}
@@ -0,0 +1,87 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/RotatingFileSink.h"
+
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace quill;
+
+/***/
+TEST_CASE("rotating_sink_background_rotation")
+{
+  static constexpr size_t number_of_messages = 10000;
+  static constexpr uint32_t max_backup_files = 4;
+  static char const* base_filename = "rotating_sink_background_rotation.log";
+
+  // Start the logging backend thread
+  Backend::start();
+
+  auto rotating_file_sink = Frontend::create_or_get_sink<RotatingFileSink>(
+    base_filename,
+    []()
+    {
+      RotatingFileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_rotation_max_file_size(4 * 1024);
+      cfg.set_max_backup_files(max_backup_files);
+      cfg.set_background_rotation(true);
+      return cfg;
+    }());
+
+  Logger* logger = Frontend::create_or_get_logger(
+    "logger", std::move(rotating_file_sink), quill::PatternFormatterOptions{"%(message)"});
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    LOG_INFO(logger, "Hello background rotation num {}", i);
+  }
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+
+  // The sink completes the pending rotations when it is destroyed
+  Backend::stop();
+
+  // The oldest files were removed, the remaining files hold the newest messages in order
+  std::vector<std::string> file_contents;
+  for (uint32_t index = max_backup_files; index > 0; --index)
+  {
+    std::string const filename =
+      "rotating_sink_background_rotation." + std::to_string(index) + ".log";
+    std::vector<std::string> const rotated_file_contents = testing::file_contents(filename);
+    REQUIRE_FALSE(rotated_file_contents.empty());
+    file_contents.insert(file_contents.end(), rotated_file_contents.begin(), rotated_file_contents.end());
+    testing::remove_file(filename);
+  }
+
+  std::vector<std::string> const file_contents_0 = testing::file_contents(base_filename);
+  file_contents.insert(file_contents.end(), file_contents_0.begin(), file_contents_0.end());
+
+  size_t const first_message = number_of_messages - file_contents.size();
+  for (size_t i = 0; i < file_contents.size(); ++i)
+  {
+    REQUIRE_EQ(file_contents[i], "Hello background rotation num " + std::to_string(first_message + i));
+  }
+
+  // No staged file is left behind
+  std::error_code ec;
+  size_t rotation_files{0};
+  for (fs::directory_iterator it{fs::current_path(), ec}, end; !ec && (it != end); it.increment(ec))
+  {
+    if (it->path().filename().string().find("rotating_sink_background_rotation.") == 0)
+    {
+      ++rotation_files;
+    }
+  }
+
+  REQUIRE_EQ(rotation_files, 1);
+
+  testing::remove_file(base_filename);
+}
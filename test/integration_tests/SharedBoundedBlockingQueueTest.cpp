@@ -0,0 +1,129 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/FileSink.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quill;
+
+// Small shared queues so that the producers also have to block
+struct CustomFrontendOptions : quill::FrontendOptions
+{
+  static constexpr quill::QueueType queue_type = quill::QueueType::SharedBoundedBlocking;
+  static constexpr size_t initial_queue_capacity = 4096;
+  static constexpr size_t shared_queue_count = 3;
+};
+
+using CustomFrontend = FrontendImpl<CustomFrontendOptions>;
+using CustomLogger = LoggerImpl<CustomFrontendOptions>;
+
+/***/
+TEST_CASE("shared_bounded_blocking_queue")
+{
+  static constexpr char const* filename = "shared_bounded_blocking_queue.log";
+  static std::string const logger_name = "logger";
+  static constexpr size_t number_of_rounds = 4;
+  static constexpr size_t number_of_threads = 32;
+  static constexpr size_t number_of_messages = 200;
+
+  // Start the logging backend thread
+  Backend::start();
+
+  auto file_sink = CustomFrontend::create_or_get_sink<FileSink>(
+    filename,
+    []()
+    {
+      FileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      return cfg;
+    }(),
+    FileEventNotifier{});
+
+  CustomLogger* logger = CustomFrontend::create_or_get_logger(
+    logger_name, std::move(file_sink),
+    PatternFormatterOptions{"%(thread_id) %(log_level) %(logger) %(message)"});
+
+  std::vector<uint32_t> thread_ids;
+  std::vector<std::thread> threads;
+
+  // Many short-lived threads, each one is mapped to one of the shared queues
+  for (size_t round = 0; round < number_of_rounds; ++round)
+  {
+    thread_ids.resize((round + 1) * number_of_threads);
+
+    for (size_t i = 0; i < number_of_threads; ++i)
+    {
+      size_t const thread_index = round * number_of_threads + i;
+
+      threads.emplace_back(
+        [logger, thread_index, &thread_ids]()
+        {
+          thread_ids[thread_index] = detail::get_thread_id();
+
+          for (size_t j = 0; j < number_of_messages; ++j)
+          {
+            LOG_INFO(logger, "Thread {} message {}", thread_index, j);
+          }
+
+          LOG_RUNTIME_METADATA(logger, LogLevel::Warning, "runtime_file.cpp", 10, "runtime_function",
+                               "Thread {} runtime metadata", thread_index);
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    threads.clear();
+  }
+
+  logger->flush_log();
+
+  // The number of queues does not grow with the number of threads
+  size_t thread_context_count{0};
+  detail::ThreadContextManager::instance().for_each_thread_context(
+    [&thread_context_count](detail::ThreadContext const* thread_context)
+    {
+      REQUIRE(thread_context->has_shared_queue_type());
+      ++thread_context_count;
+    });
+  REQUIRE_EQ(thread_context_count, CustomFrontendOptions::shared_queue_count);
+
+  Frontend::remove_logger(logger);
+
+  // Wait until the backend thread stops for test stability
+  Backend::stop();
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), number_of_rounds * number_of_threads * (number_of_messages + 1));
+
+  for (size_t thread_index = 0; thread_index < number_of_rounds * number_of_threads; ++thread_index)
+  {
+    // Every record carries the id of the thread that logged it, not the one of the shared queue
+    std::string const thread_id = std::to_string(thread_ids[thread_index]);
+
+    for (size_t j = 0; j < number_of_messages; ++j)
+    {
+      std::string const expected_string = thread_id + " INFO " + logger_name + " Thread " +
+        std::to_string(thread_index) + " message " + std::to_string(j);
+
+      REQUIRE(testing::file_contains(file_contents, expected_string));
+    }
+
+    std::string const expected_runtime = thread_id + " WARNING " + logger_name + " Thread " +
+      std::to_string(thread_index) + " runtime metadata";
+
+    REQUIRE(testing::file_contains(file_contents, expected_runtime));
+  }
+
+  testing::remove_file(filename);
+}
@@ -0,0 +1,128 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/sinks/Sink.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace quill;
+
+#if !defined(_WIN32)
+
+/**
+ * A sink that never returns from write_log, so the backend can not process anything after the
+ * first log statement
+ */
+class BlockingSink : public Sink
+{
+public:
+  void write_log(MacroMetadata const*, uint64_t, std::string_view, std::string_view,
+                 std::string const&, std::string_view, LogLevel, std::string_view,
+                 std::string_view, std::vector<std::pair<std::string, std::string>> const*,
+                 std::string_view, std::string_view) override
+  {
+    entered.store(true);
+
+    while (true)
+    {
+      std::this_thread::sleep_for(std::chrono::seconds{1});
+    }
+  }
+
+  void flush_sink() override {}
+
+  static inline std::atomic<bool> entered{false};
+};
+
+/***/
+TEST_CASE("signal_handler_pending_log_statements")
+{
+  static constexpr size_t number_of_messages = 100;
+  static constexpr char const* filename = "signal_handler_pending_log_statements.log";
+
+  pid_t const pid = ::fork();
+  REQUIRE_NE(pid, -1);
+
+  if (pid == 0)
+  {
+    int const fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    // The backend never flushes, so the signal handler times out and writes the pending log
+    // statements before it raises the signal again
+    SignalHandlerOptions sho{};
+    sho.catchable_signals = std::vector<int>{SIGABRT};
+    sho.timeout_seconds = 1;
+    sho.pending_log_statements_fd = fd;
+    Backend::start<FrontendOptions>(BackendOptions{}, sho);
+
+    Logger* logger = Frontend::create_or_get_logger(
+      "logger", Frontend::create_or_get_sink<BlockingSink>("blocking_sink"));
+
+    LOG_INFO(logger, "Blocks the backend");
+
+    while (!BlockingSink::entered.load())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    for (size_t i = 0; i < number_of_messages; ++i)
+    {
+      LOG_INFO(logger, "Pending message {} {}", i, std::string{"text"});
+    }
+
+    LOG_WARNING(logger, "Named {name} {value}", std::string_view{"abc"}, 42);
+    LOG_RUNTIME_METADATA(logger, LogLevel::Error, "runtime_file.cpp", 1234, "function",
+                         "Runtime {}", 7);
+
+    std::abort();
+  }
+
+  int status{0};
+  REQUIRE_EQ(::waitpid(pid, &status, 0), pid);
+  REQUIRE(WIFSIGNALED(status));
+  REQUIRE_EQ(WTERMSIG(status), SIGABRT);
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+
+  // The header, the pending messages, the named and runtime metadata messages and the two log
+  // statements of the signal handler
+  REQUIRE_EQ(file_contents.size(), number_of_messages + 5);
+  REQUIRE_EQ(file_contents[0], "Log statements not processed by the backend:");
+
+  for (size_t i = 0; i < number_of_messages; ++i)
+  {
+    std::string const& line = file_contents[i + 1];
+    REQUIRE_NE(line.find("SignalHandlerPendingLogStatementsTest.cpp:"), std::string::npos);
+
+    std::string const expected = " INFO logger Pending message " + std::to_string(i) + " text";
+    REQUIRE_EQ(line.substr(line.size() - expected.size()), expected);
+  }
+
+  REQUIRE(testing::file_contains(file_contents, " WARNING logger Named {name} {value} [abc, 42]"));
+  REQUIRE(testing::file_contains(file_contents, "] runtime_file.cpp:1234 ERROR logger Runtime 7"));
+  REQUIRE(testing::file_contains(
+    file_contents, " INFO logger Received signal: SIGABRT (signum: " + std::to_string(SIGABRT) + ")"));
+  REQUIRE(testing::file_contains(
+    file_contents,
+    " CRITICAL logger Program terminated unexpectedly due to signal: SIGABRT (signum: " +
+      std::to_string(SIGABRT) + ")"));
+
+  testing::remove_file(filename);
+}
+#endif
@@ -0,0 +1,194 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/DeferredFormatCodec.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/filters/Filter.h"
+#include "quill/sinks/FileSink.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace quill;
+
+namespace
+{
+std::atomic<size_t> format_count{0};
+
+struct CountedFormat
+{
+  int value{0};
+};
+} // namespace
+
+template <>
+struct fmtquill::formatter<CountedFormat>
+{
+  constexpr auto parse(format_parse_context& ctx) { return ctx.begin(); }
+
+  auto format(CountedFormat const& counted_format, format_context& ctx) const -> decltype(ctx.out())
+  {
+    format_count.fetch_add(1);
+    return fmtquill::format_to(ctx.out(), "counted {}", counted_format.value);
+  }
+};
+
+template <>
+struct quill::Codec<CountedFormat> : quill::DeferredFormatCodec<CountedFormat>
+{
+};
+
+/**
+ * Drops the log statements with a message format starting with "drop", using only the metadata
+ */
+class DropMessageFormatFilter : public Filter
+{
+public:
+  DropMessageFormatFilter(std::atomic<size_t>& calls, std::atomic<bool>& received_log_statement)
+    : Filter("DropMessageFormatFilter"), _calls(calls), _received_log_statement(received_log_statement)
+  {
+  }
+
+  QUILL_NODISCARD bool is_metadata_only() const noexcept override { return true; }
+
+  QUILL_NODISCARD bool filter(MacroMetadata const* log_metadata, uint64_t, std::string_view,
+                              std::string_view, std::string_view, LogLevel, std::string_view log_message,
+                              std::string_view log_statement) noexcept override
+  {
+    _calls.fetch_add(1);
+
+    if (!log_message.empty() || !log_statement.empty())
+    {
+      _received_log_statement.store(true);
+    }
+
+    return std::strncmp(log_metadata->message_format(), "drop", 4) != 0;
+  }
+
+private:
+  std::atomic<size_t>& _calls;
+  std::atomic<bool>& _received_log_statement;
+};
+
+/**
+ * Accepts everything, checks it is called with the formatted log statement
+ */
+class FormattedFilter : public Filter
+{
+public:
+  FormattedFilter(std::atomic<size_t>& calls, std::atomic<bool>& received_empty_log_statement)
+    : Filter("FormattedFilter"), _calls(calls), _received_empty_log_statement(received_empty_log_statement)
+  {
+  }
+
+  QUILL_NODISCARD bool filter(MacroMetadata const*, uint64_t, std::string_view, std::string_view,
+                              std::string_view, LogLevel, std::string_view log_message,
+                              std::string_view log_statement) noexcept override
+  {
+    _calls.fetch_add(1);
+
+    if (log_message.empty() || log_statement.empty())
+    {
+      _received_empty_log_statement.store(true);
+    }
+
+    return true;
+  }
+
+private:
+  std::atomic<size_t>& _calls;
+  std::atomic<bool>& _received_empty_log_statement;
+};
+
+/***/
+TEST_CASE("sink_pre_format_filter")
+{
+  static constexpr char const* filename_a = "sink_pre_format_filter_a.log";
+  static constexpr char const* filename_b = "sink_pre_format_filter_b.log";
+  static std::string const logger_name = "logger";
+
+  Backend::start();
+
+  std::atomic<size_t> metadata_filter_calls{0};
+  std::atomic<bool> metadata_filter_received_log_statement{false};
+  std::atomic<size_t> formatted_filter_calls{0};
+  std::atomic<bool> formatted_filter_received_empty_log_statement{false};
+
+  auto file_sink_a = Frontend::create_or_get_sink<FileSink>(
+    filename_a,
+    []()
+    {
+      FileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      return cfg;
+    }(),
+    FileEventNotifier{});
+
+  file_sink_a->set_log_level_filter(LogLevel::Warning);
+  file_sink_a->add_filter(std::make_unique<DropMessageFormatFilter>(
+    metadata_filter_calls, metadata_filter_received_log_statement));
+
+  auto file_sink_b = Frontend::create_or_get_sink<FileSink>(
+    filename_b,
+    []()
+    {
+      FileSinkConfig cfg;
+      cfg.set_open_mode('w');
+      return cfg;
+    }(),
+    FileEventNotifier{});
+
+  file_sink_b->set_log_level_filter(LogLevel::Error);
+  file_sink_b->add_filter(std::make_unique<FormattedFilter>(
+    formatted_filter_calls, formatted_filter_received_empty_log_statement));
+
+  Logger* logger = Frontend::create_or_get_logger(
+    logger_name, {std::move(file_sink_a), std::move(file_sink_b)}, PatternFormatterOptions{"%(message)"});
+
+  // Rejected by the log level filter of both sinks
+  LOG_INFO(logger, "info {}", CountedFormat{1});
+
+  // Rejected by the metadata only filter of sink a and the log level filter of sink b
+  LOG_WARNING(logger, "drop warning {}", CountedFormat{2});
+
+  logger->flush_log();
+
+  // None of the sinks writes these log statements, the message is never formatted
+  REQUIRE_EQ(format_count.load(), 0);
+  REQUIRE_EQ(metadata_filter_calls.load(), 1);
+
+  // Accepted by sink a
+  LOG_WARNING(logger, "keep warning {}", CountedFormat{3});
+
+  // Accepted by sink b
+  LOG_ERROR(logger, "drop error {}", CountedFormat{4});
+
+  logger->flush_log();
+  Frontend::remove_logger(logger);
+  Backend::stop();
+
+  REQUIRE_EQ(format_count.load(), 2);
+
+  // Each filter runs once per log statement that reaches it
+  REQUIRE_EQ(metadata_filter_calls.load(), 3);
+  REQUIRE_EQ(formatted_filter_calls.load(), 1);
+  REQUIRE_FALSE(metadata_filter_received_log_statement.load());
+  REQUIRE_FALSE(formatted_filter_received_empty_log_statement.load());
+
+  std::vector<std::string> const file_contents_a = quill::testing::file_contents(filename_a);
+  REQUIRE_EQ(file_contents_a.size(), 1);
+  REQUIRE_EQ(file_contents_a.front(), "keep warning counted 3");
+
+  std::vector<std::string> const file_contents_b = quill::testing::file_contents(filename_b);
+  REQUIRE_EQ(file_contents_b.size(), 1);
+  REQUIRE_EQ(file_contents_b.front(), "drop error counted 4");
+
+  testing::remove_file(filename_a);
+  testing::remove_file(filename_b);
+}
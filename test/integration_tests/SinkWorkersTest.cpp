@@ -0,0 +1,278 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Backend.h"
+#include "quill/Frontend.h"
+#include "quill/LogMacros.h"
+#include "quill/MetricAggregation.h"
+#include "quill/backend/ThreadUtilities.h"
+#include "quill/sinks/FileSink.h"
+#include "quill/sinks/JsonSink.h"
+#include "quill/sinks/Sink.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quill;
+
+/**
+ * Records the calling thread and the log messages
+ */
+class RecordingSink final : public Sink
+{
+public:
+  void write_log(MacroMetadata const* log_metadata, uint64_t, std::string_view, std::string_view,
+                 std::string const&, std::string_view, LogLevel, std::string_view, std::string_view,
+                 std::vector<std::pair<std::string, std::string>> const*,
+                 std::string_view log_message, std::string_view) override
+  {
+    thread_ids.push_back(detail::get_thread_id());
+    messages.emplace_back(log_message);
+    caller_functions.emplace_back(log_metadata->caller_function());
+  }
+
+  void flush_sink() override
+  {
+    flush_thread_id.store(detail::get_thread_id());
+    ++flush_count;
+  }
+
+  std::vector<uint32_t> thread_ids;
+  std::vector<std::string> messages;
+  std::vector<std::string> caller_functions;
+  std::atomic<uint32_t> flush_thread_id{0};
+  std::atomic<size_t> flush_count{0};
+};
+
+/***/
+TEST_CASE("sink_workers")
+{
+  static constexpr size_t number_of_messages = 1000u;
+  static constexpr size_t number_of_threads = 4;
+  static constexpr char const* filename = "sink_workers.log";
+  static constexpr char const* json_filename = "sink_workers.json";
+  static std::string const logger_name_prefix = "logger_";
+
+  BackendOptions backend_options;
+  backend_options.sink_workers.resize(2);
+
+  // Use a small queue to exercise the backend waiting on a busy worker and the direct write of
+  // records larger than the queue
+  backend_options.sink_workers[1].queue_capacity = 4096;
+  Backend::start(backend_options);
+
+  auto file_sink = Frontend::create_or_get_sink<FileSink>(filename,
+                                                          []()
+                                                          {
+                                                            FileSinkConfig cfg;
+                                                            cfg.set_open_mode('w');
+                                                            return cfg;
+                                                          }(),
+                                                          FileEventNotifier{});
+  file_sink->set_sink_worker(0);
+
+  auto json_file_sink = Frontend::create_or_get_sink<JsonFileSink>(json_filename,
+                                                                   []()
+                                                                   {
+                                                                     FileSinkConfig cfg;
+                                                                     cfg.set_open_mode('w');
+                                                                     return cfg;
+                                                                   }(),
+                                                                   FileEventNotifier{});
+  json_file_sink->set_sink_worker(1);
+
+  auto recording_sink = Frontend::create_or_get_sink<RecordingSink>("recording_sink");
+  recording_sink->set_sink_worker(1);
+  auto* recording_sink_ptr = static_cast<RecordingSink*>(recording_sink.get());
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(
+      [i, &file_sink, &json_file_sink, &recording_sink]()
+      {
+        Logger* logger = Frontend::create_or_get_logger(
+          logger_name_prefix + std::to_string(i), {file_sink, json_file_sink, recording_sink});
+
+        for (size_t j = 0; j < number_of_messages; ++j)
+        {
+          LOG_INFO(logger, "Hello from thread {thread_index} this is message {message_num}", i, j);
+        }
+
+        LOG_RUNTIME_METADATA(logger, LogLevel::Warning, "runtime_file.cpp", 42, "runtime_function",
+                             "Runtime metadata {}", i);
+
+        // Larger than the queue of the second worker
+        LOG_INFO(logger, "Large message {}", std::string(8192, 'a'));
+      });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  size_t const flush_count_before = recording_sink_ptr->flush_count.load();
+
+  // flush_log() returns only after the worker flushed the sink
+  Logger* logger = Frontend::get_logger(logger_name_prefix + "0");
+  logger->flush_log();
+  REQUIRE_GT(recording_sink_ptr->flush_count.load(), flush_count_before);
+  REQUIRE_NE(recording_sink_ptr->flush_thread_id.load(), Backend::get_thread_id());
+
+  // The sink was called from the worker except for the records that did not fit in its queue
+  REQUIRE_EQ(recording_sink_ptr->messages.size(), number_of_threads * (number_of_messages + 2));
+
+  for (size_t k = 0; k < recording_sink_ptr->messages.size(); ++k)
+  {
+    if (recording_sink_ptr->messages[k].size() < 8192)
+    {
+      REQUIRE_NE(recording_sink_ptr->thread_ids[k], Backend::get_thread_id());
+    }
+  }
+
+  // Each sink sees the messages of every thread in order
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    size_t next_message{0};
+    std::string const prefix = "Hello from thread " + std::to_string(i) + " this is message ";
+
+    for (std::string const& message : recording_sink_ptr->messages)
+    {
+      if (message.rfind(prefix, 0) == 0)
+      {
+        REQUIRE_EQ(message, prefix + std::to_string(next_message));
+        ++next_message;
+      }
+    }
+
+    REQUIRE_EQ(next_message, number_of_messages);
+
+    REQUIRE(quill::testing::file_contains(recording_sink_ptr->messages,
+                                          "Runtime metadata " + std::to_string(i)));
+  }
+
+  REQUIRE(quill::testing::file_contains(recording_sink_ptr->caller_functions, "runtime_function"));
+
+  for (Logger* elem : Frontend::get_all_loggers())
+  {
+    Frontend::remove_logger(elem);
+  }
+
+  Backend::stop();
+
+  std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+  std::vector<std::string> const json_file_contents = quill::testing::file_contents(json_filename);
+
+  REQUIRE_EQ(file_contents.size(), number_of_threads * (number_of_messages + 2));
+  REQUIRE_EQ(json_file_contents.size(), number_of_threads * (number_of_messages + 2));
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    for (size_t j = 0; j < number_of_messages; ++j)
+    {
+      std::string const expected_string = logger_name_prefix + std::to_string(i) +
+        "     Hello from thread " + std::to_string(i) + " this is message " + std::to_string(j);
+      REQUIRE(quill::testing::file_contains(file_contents, expected_string));
+
+      std::string const expected_json_string = std::string{R"("thread_index":")"} +
+        std::to_string(i) + std::string{R"(","message_num":")"} + std::to_string(j) + "\"";
+      REQUIRE(quill::testing::file_contains(json_file_contents, expected_json_string));
+    }
+
+    std::string const expected_runtime_json = R"("file_name":"runtime_file.cpp","line":"42")";
+    REQUIRE(quill::testing::file_contains(json_file_contents, expected_runtime_json));
+  }
+
+  testing::remove_file(filename);
+  testing::remove_file(json_filename);
+}
+
+/**
+ * Records the log messages and the histograms in the order the sink receives them
+ */
+class MetricHistogramRecordingSink final : public Sink
+{
+public:
+  void write_log(MacroMetadata const*, uint64_t, std::string_view, std::string_view, std::string const&,
+                 std::string_view, LogLevel, std::string_view, std::string_view,
+                 std::vector<std::pair<std::string, std::string>> const*, std::string_view log_message,
+                 std::string_view) override
+  {
+    events.emplace_back(log_message);
+  }
+
+  void write_metric_histogram(MetricMetadata const*, uint64_t, std::string_view, std::string_view,
+                              std::string const&, std::string_view, MetricHistogramData const& histogram) override
+  {
+    events.emplace_back("histogram " + std::to_string(histogram.bucket_bounds_count) + " " +
+                        std::to_string(histogram.count) + " " +
+                        std::to_string(histogram.bucket_counts[histogram.bucket_bounds_count]));
+    histogram_thread_ids.push_back(detail::get_thread_id());
+  }
+
+  void flush_sink() override {}
+
+  std::vector<std::string> events;
+  std::vector<uint32_t> histogram_thread_ids;
+};
+
+/***/
+TEST_CASE("sink_workers_metric_histogram")
+{
+  BackendOptions backend_options;
+  backend_options.sink_workers.resize(1);
+  backend_options.sink_workers[0].queue_capacity = 4096;
+  Backend::start(backend_options);
+
+  auto recording_sink = Frontend::create_or_get_sink<MetricHistogramRecordingSink>(
+    "metric_histogram_recording_sink");
+  recording_sink->set_sink_worker(0);
+  auto* recording_sink_ptr = static_cast<MetricHistogramRecordingSink*>(recording_sink.get());
+
+  Logger* logger = Frontend::create_or_get_logger("metric_histogram_logger", recording_sink);
+  MetricMetadata const* metric_metadata =
+    Frontend::create_metric("sink_workers_metric_histogram_latency", "latency");
+
+  MetricAggregationOptions options;
+  options.max_updates = 1000;
+  options.max_interval = std::chrono::nanoseconds{0};
+
+  // The bounds of the large histogram do not fit in the queue of the worker
+  std::vector<double> large_bucket_bounds;
+  for (size_t i = 0; i < 512; ++i)
+  {
+    large_bucket_bounds.push_back(static_cast<double>(i));
+  }
+
+  MetricHistogram histogram{logger, metric_metadata, {1.0, 10.0}, options};
+  MetricHistogram large_histogram{logger, metric_metadata, large_bucket_bounds, options};
+
+  LOG_INFO(logger, "before");
+  histogram.record(0.5);
+  histogram.record(20.0);
+  REQUIRE(histogram.flush());
+  LOG_INFO(logger, "between");
+  large_histogram.record(1000.0);
+  REQUIRE(large_histogram.flush());
+  LOG_INFO(logger, "after");
+
+  logger->flush_log();
+
+  // The histograms are written in order with the log statements
+  REQUIRE_EQ(recording_sink_ptr->events,
+             std::vector<std::string>{"before", "histogram 2 2 1", "between", "histogram 512 1 1", "after"});
+
+  // The histogram is written by the worker, the one larger than its queue by the backend thread
+  REQUIRE_EQ(recording_sink_ptr->histogram_thread_ids.size(), 2);
+  REQUIRE_NE(recording_sink_ptr->histogram_thread_ids[0], Backend::get_thread_id());
+  REQUIRE_EQ(recording_sink_ptr->histogram_thread_ids[1], Backend::get_thread_id());
+
+  Frontend::remove_logger(logger);
+  Backend::stop();
+}
@@ -4,6 +4,7 @@
 #include "quill/core/BoundedSPSCQueue.h"
 #include "quill/core/QuillError.h"
 
+#include <chrono>
 #include <cstring>
 #include <limits>
 #include <thread>
@@ -186,6 +187,69 @@ TEST_CASE("bounded_queue_write_after_drain_uses_full_capacity")
   REQUIRE_NE(buffer.prepare_write(4000u), nullptr);
 }
 
+TEST_CASE("bounded_queue_for_each_unread")
+{
+  BoundedSPSCQueue buffer{4096u};
+
+  // The last unread record wraps around to the start of the storage
+  for (uint32_t i = 0; i < 40; ++i)
+  {
+    std::byte* write_buf = buffer.prepare_write(100u);
+    REQUIRE_NE(write_buf, nullptr);
+    buffer.finish_write(100u);
+    buffer.commit_write();
+
+    REQUIRE_NE(buffer.prepare_read(), nullptr);
+    buffer.finish_read(100u);
+    buffer.commit_read();
+  }
+
+  static constexpr size_t record_size{48};
+
+  for (uint32_t i = 0; i < 3; ++i)
+  {
+    std::byte* write_buf = buffer.prepare_write(record_size);
+    REQUIRE_NE(write_buf, nullptr);
+    std::memcpy(write_buf, &i, sizeof(uint32_t));
+    buffer.finish_write(record_size);
+    buffer.commit_write();
+  }
+
+  // Consumed but not released, it is not visited
+  REQUIRE_NE(buffer.prepare_read(), nullptr);
+  buffer.finish_read(record_size);
+
+  std::vector<uint32_t> unread;
+  buffer.for_each_unread(
+    [&unread](std::byte* record, size_t available_bytes)
+    {
+      REQUIRE_GE(available_bytes, record_size);
+      uint32_t value;
+      std::memcpy(&value, record, sizeof(uint32_t));
+      unread.push_back(value);
+      return record_size;
+    });
+
+  REQUIRE_EQ(unread, std::vector<uint32_t>{1, 2});
+
+  // The reader position does not change
+  std::byte* res = buffer.prepare_read();
+  REQUIRE_NE(res, nullptr);
+  uint32_t value;
+  std::memcpy(&value, res, sizeof(uint32_t));
+  REQUIRE_EQ(value, 1);
+
+  // Returning 0 stops the iteration
+  size_t calls{0};
+  buffer.for_each_unread(
+    [&calls](std::byte*, size_t)
+    {
+      ++calls;
+      return size_t{0};
+    });
+  REQUIRE_EQ(calls, 1);
+}
+
 #if defined(QUILL_X86ARCH) && !defined(QUILL_NO_EXCEPTIONS)
 TEST_CASE("below_minimum_capacity_throws_before_allocating")
 {
@@ -209,6 +273,25 @@ TEST_CASE("oversized_capacity_throws_before_allocating")
 }
 #endif
 
+#if defined(QUILL_HAS_FUTEX)
+TEST_CASE("bounded_queue_wait_for_space_returns_after_timeout")
+{
+  BoundedSPSCQueue buffer{4096u, quill::HugePagesPolicy::Never, 5, true};
+
+  std::byte* write_buf = buffer.prepare_write(4096u);
+  REQUIRE_NE(write_buf, nullptr);
+  buffer.finish_write(4096u);
+  buffer.commit_write();
+  REQUIRE_EQ(buffer.prepare_write(64u), nullptr);
+
+  // Nothing reads the queue, the writer must not stay blocked
+  auto const start = std::chrono::steady_clock::now();
+  buffer.wait_for_space(64u, 1'000'000);
+  REQUIRE_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds{500});
+  REQUIRE_EQ(buffer.prepare_write(64u), nullptr);
+}
+#endif
+
 TEST_SUITE_END();
 
 #if defined(_WIN32) && defined(_MSC_VER) && !defined(__GNUC__)
@@ -0,0 +1,106 @@
+#include "doctest/doctest.h"
+
+#include "quill/DeferredFormatCodec.h"
+#include "quill/core/Codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_SUITE_BEGIN("Codec");
+
+using namespace quill;
+
+namespace
+{
+enum class TestEnum : uint16_t
+{
+  A = 1,
+  B = 7
+};
+
+enum class UserCodecEnum : uint8_t
+{
+  X
+};
+} // namespace
+
+template <>
+struct fmtquill::formatter<UserCodecEnum>
+{
+  constexpr auto parse(format_parse_context& ctx) { return ctx.begin(); }
+
+  auto format(UserCodecEnum const&, format_context& ctx) const
+  {
+    return fmtquill::format_to(ctx.out(), "X");
+  }
+};
+
+template <>
+struct quill::Codec<UserCodecEnum> : quill::DeferredFormatCodec<UserCodecEnum>
+{
+};
+
+/***/
+TEST_CASE("fixed_encoded_size_traits")
+{
+  static_assert(detail::has_fixed_encoded_size_v<>);
+  static_assert(detail::fixed_encoded_size_v<> == 0);
+
+  static_assert(detail::has_fixed_encoded_size_v<int, double const&, TestEnum, bool, void const*, char>);
+  static_assert(detail::fixed_encoded_size_v<int, double const&, TestEnum, bool, void const*, char> ==
+                sizeof(int) + sizeof(double) + sizeof(TestEnum) + sizeof(bool) + sizeof(void const*) +
+                  sizeof(char));
+
+  // anything that may need the size cache or a user codec is sized at runtime
+  static_assert(!detail::has_fixed_encoded_size_v<int, char const*>);
+  static_assert(!detail::has_fixed_encoded_size_v<std::string>);
+  static_assert(!detail::has_fixed_encoded_size_v<std::string_view, int>);
+  static_assert(!detail::has_fixed_encoded_size_v<char[8]>);
+  static_assert(!detail::has_fixed_encoded_size_v<UserCodecEnum>);
+}
+
+/***/
+TEST_CASE("encode_fixed_size_matches_encode")
+{
+  int const i = -42;
+  uint64_t const u = 1234567890123ull;
+  double const d = 3.14159;
+  TestEnum const e = TestEnum::B;
+  bool const b = true;
+  void const* p = &i;
+
+  constexpr size_t encoded_size =
+    detail::fixed_encoded_size_v<decltype(i), decltype(u), decltype(d), decltype(e), decltype(b), decltype(p)>;
+
+  detail::SizeCacheVector size_cache;
+  REQUIRE_EQ(detail::compute_encoded_size_and_cache_string_lengths(size_cache, i, u, d, e, b, p), encoded_size);
+  REQUIRE_EQ(size_cache.size(), 0u);
+
+  std::vector<std::byte> expected(encoded_size);
+  std::byte* expected_ptr = expected.data();
+  detail::encode(expected_ptr, size_cache, i, u, d, e, b, p);
+  REQUIRE_EQ(static_cast<size_t>(expected_ptr - expected.data()), encoded_size);
+
+  std::vector<std::byte> actual(encoded_size);
+  std::byte* actual_ptr = actual.data();
+  detail::encode_fixed_size(actual_ptr, i, u, d, e, b, p);
+  REQUIRE_EQ(static_cast<size_t>(actual_ptr - actual.data()), encoded_size);
+
+  REQUIRE_EQ(std::memcmp(expected.data(), actual.data(), encoded_size), 0);
+
+  // decode back with the regular codecs
+  std::byte* read_ptr = actual.data();
+  REQUIRE_EQ(Codec<int>::decode_arg(read_ptr), i);
+  REQUIRE_EQ(Codec<uint64_t>::decode_arg(read_ptr), u);
+  REQUIRE_EQ(Codec<double>::decode_arg(read_ptr), doctest::Approx{d});
+  REQUIRE_EQ(Codec<TestEnum>::decode_arg(read_ptr), e);
+  REQUIRE_EQ(Codec<bool>::decode_arg(read_ptr), b);
+  REQUIRE_EQ(Codec<void const*>::decode_arg(read_ptr), p);
+  REQUIRE_EQ(read_ptr, actual_ptr);
+}
+
+TEST_SUITE_END();
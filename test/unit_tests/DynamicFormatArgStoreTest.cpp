@@ -28,6 +28,44 @@ TEST_CASE("dynamic_format_arg_store")
                       fmtquill::basic_format_args<fmtquill::format_context>{store.data(), store.size()});
 
   REQUIRE_EQ(result, std::string{"42 and abc and 1.5 and efg"});
+  REQUIRE_FALSE(store.has_custom_type());
+}
+
+/***/
+struct CustomType
+{
+  int value;
+};
+
+template <>
+struct fmtquill::formatter<CustomType>
+{
+  constexpr auto parse(format_parse_context& ctx) { return ctx.begin(); }
+
+  auto format(CustomType const& custom_type, format_context& ctx) const
+  {
+    return fmtquill::format_to(ctx.out(), "custom {}", custom_type.value);
+  }
+};
+
+/***/
+TEST_CASE("dynamic_format_arg_store_custom_type")
+{
+  DynamicFormatArgStore store;
+
+  store.push_back(42);
+  REQUIRE_FALSE(store.has_custom_type());
+
+  store.push_back(CustomType{7});
+  REQUIRE(store.has_custom_type());
+
+  std::string const result = fmtquill::vformat(
+    "{} and {}", fmtquill::basic_format_args<fmtquill::format_context>{store.data(), store.size()});
+
+  REQUIRE_EQ(result, std::string{"42 and custom 7"});
+
+  store.clear();
+  REQUIRE_FALSE(store.has_custom_type());
 }
 
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "doctest/doctest.h"
+
+#include "quill/backend/FormatterPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+TEST_SUITE_BEGIN("FormatterPool");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+TEST_CASE("formatter_pool_runs_each_task_once")
+{
+  FormatterPool formatter_pool{3, "FormatterPoolTest"};
+  REQUIRE_EQ(formatter_pool.thread_count(), 3);
+
+  std::vector<std::atomic<uint32_t>> calls(1000);
+
+  auto task = [&calls](size_t index) { calls[index].fetch_add(1, std::memory_order_relaxed); };
+  formatter_pool.run(calls.size(), task);
+
+  for (auto const& call : calls)
+  {
+    REQUIRE_EQ(call.load(), 1);
+  }
+}
+
+/***/
+TEST_CASE("formatter_pool_alternating_batch_sizes")
+{
+  // Consecutive batches of very different sizes. A pool thread that wakes up late for a batch
+  // must never run a task index of the next one or count it as completed
+  FormatterPool formatter_pool{4, "FormatterPoolTest"};
+
+  constexpr size_t large_batch_size{64};
+  std::vector<std::atomic<uint32_t>> calls(large_batch_size);
+
+  for (size_t iteration = 0; iteration < 20000; ++iteration)
+  {
+    size_t const batch_size = (iteration % 2 == 0) ? large_batch_size : (iteration % 3);
+
+    for (auto& call : calls)
+    {
+      call.store(0, std::memory_order_relaxed);
+    }
+
+    std::atomic<size_t> out_of_range_tasks{0};
+
+    auto task = [&calls, &out_of_range_tasks, batch_size](size_t index)
+    {
+      if (index >= batch_size)
+      {
+        out_of_range_tasks.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+
+      calls[index].fetch_add(1, std::memory_order_relaxed);
+    };
+
+    formatter_pool.run(batch_size, task);
+
+    REQUIRE_EQ(out_of_range_tasks.load(), 0);
+
+    size_t wrong_calls{0};
+    for (size_t i = 0; i < large_batch_size; ++i)
+    {
+      wrong_calls += (calls[i].load() != ((i < batch_size) ? 1u : 0u)) ? 1 : 0;
+    }
+
+    REQUIRE_EQ(wrong_calls, 0);
+  }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,99 @@
+#include "doctest/doctest.h"
+
+#include "quill/core/JsonEscape.h"
+
+#include <string>
+#include <string_view>
+
+TEST_SUITE_BEGIN("JsonEscape");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+std::string escape(std::string_view value)
+{
+  fmtquill::memory_buffer out;
+  append_json_escaped(out, value);
+  return std::string{out.data(), out.size()};
+}
+
+/***/
+std::string expected_escape(unsigned char c)
+{
+  switch (c)
+  {
+  case '"':
+    return "\\\"";
+  case '\\':
+    return "\\\\";
+  case '\b':
+    return "\\b";
+  case '\f':
+    return "\\f";
+  case '\n':
+    return "\\n";
+  case '\r':
+    return "\\r";
+  case '\t':
+    return "\\t";
+  default:
+    return (c < 0x20) ? fmtquill::format("\\u{:04X}", c) : std::string(1, static_cast<char>(c));
+  }
+}
+
+TEST_CASE("json_escape_every_byte_at_every_position")
+{
+  // The scanner handles 32 and 16 byte blocks and a tail, each byte is placed at every position
+  // of the blocks and the tail
+  for (size_t length : {1u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 64u, 79u})
+  {
+    for (size_t pos = 0; pos < length; ++pos)
+    {
+      for (unsigned int byte = 0; byte < 256; ++byte)
+      {
+        std::string value(length, 'a');
+        value[pos] = static_cast<char>(byte);
+
+        std::string const expected =
+          std::string(pos, 'a') + expected_escape(static_cast<unsigned char>(byte)) + std::string(length - pos - 1, 'a');
+
+        REQUIRE_EQ(escape(value), expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("json_escape_line_and_paragraph_separators")
+{
+  std::string_view const line_separator = "\xE2\x80\xA8";
+  std::string_view const paragraph_separator = "\xE2\x80\xA9";
+
+  // A separator split across the 16 and 32 byte blocks
+  for (size_t pos : {0u, 14u, 15u, 30u, 31u, 40u})
+  {
+    std::string value(pos, 'x');
+    value.append(line_separator);
+    value.append(std::string(20, 'y'));
+    value.append(paragraph_separator);
+
+    REQUIRE_EQ(escape(value), std::string(pos, 'x') + "\\u2028" + std::string(20, 'y') + "\\u2029");
+  }
+
+  // Other sequences starting with E2, including a truncated one, are copied unchanged
+  std::string const other = "\xE2\x82\xAC euro \xE2\x80\xA7 \xE2\x80";
+  REQUIRE_EQ(escape(other), other);
+}
+
+TEST_CASE("json_escape_mixed")
+{
+  REQUIRE_EQ(escape(""), "");
+  REQUIRE_EQ(escape("plain text without anything to escape, longer than a block"),
+             "plain text without anything to escape, longer than a block");
+  REQUIRE_EQ(escape("reason \"price outside of the collar\"\tat C:\\orders\\today\n"),
+             "reason \\\"price outside of the collar\\\"\\tat C:\\\\orders\\\\today\\n");
+  REQUIRE_EQ(escape("\"\"\\\\\x01\x1F"), "\\\"\\\"\\\\\\\\\\u0001\\u001F");
+  REQUIRE_EQ(escape("λόγος \"utf8\""), "λόγος \\\"utf8\\\"");
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,131 @@
+#include "doctest/doctest.h"
+
+#include "quill/core/LogLinearHistogram.h"
+#include "quill/core/Metric.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+TEST_SUITE_BEGIN("LogLinearHistogram");
+
+using namespace quill;
+
+/***/
+TEST_CASE("log_linear_histogram_quantiles")
+{
+  // The histogram is a few KB, keep it off the stack
+  auto histogram = std::make_unique<LogLinearHistogram>();
+
+  REQUIRE_EQ(histogram->count(), 0);
+  REQUIRE_EQ(histogram->value_at_quantile(0.5), doctest::Approx{0});
+
+  for (uint64_t i = 1; i <= 10000; ++i)
+  {
+    histogram->record(static_cast<double>(i));
+  }
+
+  REQUIRE_EQ(histogram->count(), 10000);
+  REQUIRE_EQ(histogram->sum(), doctest::Approx{50005000.0});
+  REQUIRE_EQ(histogram->min(), doctest::Approx{1.0});
+  REQUIRE_EQ(histogram->max(), doctest::Approx{10000.0});
+
+  // Within half a bucket of the exact values
+  for (double const quantile : {0.1, 0.5, 0.9, 0.99, 0.999})
+  {
+    double const expected = quantile * 10000;
+    REQUIRE_LE(std::fabs(histogram->value_at_quantile(quantile) - expected) / expected, 0.016);
+  }
+
+  REQUIRE_EQ(histogram->value_at_quantile(0.0), doctest::Approx{1.0});
+  REQUIRE_EQ(histogram->value_at_quantile(1.0), doctest::Approx{10000.0});
+
+  histogram->reset();
+  REQUIRE_EQ(histogram->count(), 0);
+  REQUIRE_EQ(histogram->sum(), doctest::Approx{0});
+  REQUIRE_EQ(histogram->value_at_quantile(0.99), doctest::Approx{0});
+}
+
+/***/
+TEST_CASE("log_linear_histogram_out_of_range_values")
+{
+  auto histogram = std::make_unique<LogLinearHistogram>();
+
+  histogram->record(-5.0);
+  histogram->record(0.0);
+  histogram->record(std::numeric_limits<double>::quiet_NaN());
+  histogram->record(1e-12);
+  histogram->record(1e20, 2);
+  histogram->record(std::numeric_limits<double>::infinity());
+
+  // NaN is ignored, the others are counted in the underflow and overflow buckets
+  REQUIRE_EQ(histogram->count(), 6);
+  REQUIRE_EQ(histogram->min(), doctest::Approx{-5.0});
+  REQUIRE(std::isinf(histogram->max()));
+  REQUIRE_EQ(histogram->value_at_quantile(0.5), doctest::Approx{-5.0});
+  REQUIRE(std::isinf(histogram->value_at_quantile(0.9)));
+}
+
+/***/
+TEST_CASE("log_linear_histogram_merge")
+{
+  auto first = std::make_unique<LogLinearHistogram>();
+  auto second = std::make_unique<LogLinearHistogram>();
+  auto combined = std::make_unique<LogLinearHistogram>();
+
+  for (uint64_t i = 1; i <= 1000; ++i)
+  {
+    double const value = static_cast<double>(i) * 0.001;
+    ((i % 3) == 0 ? *first : *second).record(value);
+    combined->record(value);
+  }
+
+  first->merge(*second);
+
+  REQUIRE_EQ(first->count(), combined->count());
+  REQUIRE_EQ(first->sum(), doctest::Approx{combined->sum()});
+  REQUIRE_EQ(first->min(), doctest::Approx{combined->min()});
+  REQUIRE_EQ(first->max(), doctest::Approx{combined->max()});
+
+  for (double const quantile : {0.5, 0.9, 0.99})
+  {
+    REQUIRE_EQ(first->value_at_quantile(quantile), doctest::Approx{combined->value_at_quantile(quantile)});
+  }
+
+  // Merging an empty histogram does not change min and max
+  first->merge(LogLinearHistogram{});
+  REQUIRE_EQ(first->min(), doctest::Approx{combined->min()});
+  REQUIRE_EQ(first->count(), combined->count());
+}
+
+/***/
+TEST_CASE("log_linear_histogram_merge_fixed_buckets")
+{
+  double const bucket_bounds[] = {1.0, 10.0, 100.0};
+  uint64_t const bucket_counts[] = {5, 0, 90, 5};
+
+  MetricHistogramData data;
+  data.bucket_bounds = bucket_bounds;
+  data.bucket_counts = bucket_counts;
+  data.bucket_bounds_count = 3;
+  data.count = 100;
+  data.sum = 6000.0;
+  data.min = 0.5;
+  data.max = 250.0;
+
+  auto histogram = std::make_unique<LogLinearHistogram>();
+  histogram->merge(data);
+
+  REQUIRE_EQ(histogram->count(), 100);
+  REQUIRE_EQ(histogram->sum(), doctest::Approx{6000.0});
+  REQUIRE_EQ(histogram->min(), doctest::Approx{0.5});
+  REQUIRE_EQ(histogram->max(), doctest::Approx{250.0});
+
+  // The values of a fixed bucket are recorded as its upper bound, the overflow bucket as the max
+  REQUIRE_EQ(histogram->value_at_quantile(0.05), doctest::Approx{1.0}.epsilon(0.016));
+  REQUIRE_EQ(histogram->value_at_quantile(0.5), doctest::Approx{100.0}.epsilon(0.016));
+  REQUIRE_EQ(histogram->value_at_quantile(0.99), doctest::Approx{250.0});
+}
+
+TEST_SUITE_END();
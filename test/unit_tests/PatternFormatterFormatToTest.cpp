@@ -0,0 +1,64 @@
+#include "doctest/doctest.h"
+
+#include "quill/LogMacros.h"
+#include "quill/backend/PatternFormatter.h"
+#include "quill/core/Common.h"
+#include "quill/core/MacroMetadata.h"
+#include "quill/core/OutputBuffer.h"
+#include <string>
+#include <string_view>
+
+TEST_SUITE_BEGIN("PatternFormatterFormatTo");
+
+using namespace quill::detail;
+using namespace quill;
+
+TEST_CASE("pattern_formatter_format_to_output_buffer")
+{
+  PatternFormatter custom_pattern_formatter{PatternFormatterOptions{
+    "%(log_level:<8) [%(logger)] %(message)", "%H:%M:%S.%Qns", Timezone::GmtTime, false}};
+
+  uint64_t const ts{1579815761000023000};
+  char const* thread_id = "31341";
+  char const* thread_name = "test_thread";
+  std::string_view const process_id = "123";
+  std::string const logger_name = "test_logger";
+  MacroMetadata macro_metadata{__FILE__ ":" QUILL_STRINGIFY(__LINE__),
+                               __func__,
+                               "Formatted into the buffer {}",
+                               nullptr,
+                               LogLevel::Info,
+                               MacroMetadata::Event::Log};
+
+  // The log statements are appended after what is already in the buffer
+  quill::detail::OutputBuffer output_buffer;
+  std::string_view const previous{"previous\n"};
+  output_buffer.append(previous.data(), previous.data() + previous.size());
+
+  std::string_view const first_statement = custom_pattern_formatter.format_to(
+    output_buffer, ts, thread_id, thread_name, process_id, logger_name, "INFO", "I",
+    macro_metadata, nullptr, std::string_view{"Formatted into the buffer 1"}, std::string_view{});
+
+  REQUIRE_EQ(first_statement, "INFO     [test_logger] Formatted into the buffer 1\n");
+
+  // Grow the buffer past its capacity
+  std::string const long_message(1024, 'x');
+  std::string_view const second_statement = custom_pattern_formatter.format_to(
+    output_buffer, ts, thread_id, thread_name, process_id, logger_name, "INFO", "I",
+    macro_metadata, nullptr, long_message, std::string_view{});
+
+  REQUIRE_EQ(second_statement, "INFO     [test_logger] " + long_message + "\n");
+  REQUIRE_EQ(std::string_view{output_buffer.data(), output_buffer.size()},
+             "previous\nINFO     [test_logger] Formatted into the buffer 1\nINFO     [test_logger] " +
+               long_message + "\n");
+
+  // format() still uses the internal buffer of the formatter
+  std::string_view const formatted = custom_pattern_formatter.format(
+    ts, thread_id, thread_name, process_id, logger_name, "INFO", "I", macro_metadata, nullptr,
+    std::string_view{"Formatted into the buffer 2"}, std::string_view{});
+
+  REQUIRE_EQ(formatted, "INFO     [test_logger] Formatted into the buffer 2\n");
+  REQUIRE_EQ(output_buffer.size(), previous.size() + first_statement.size() + second_statement.size());
+}
+
+TEST_SUITE_END();
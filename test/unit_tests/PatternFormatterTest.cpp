@@ -1305,4 +1305,88 @@ TEST_CASE("pattern_with_literal_braces")
 #endif
 }
 
+TEST_CASE("pattern_with_format_specifiers_matches_fmt")
+{
+  // The padding of the compiled pattern must match fmt, including non ASCII values and
+  // specifiers that are formatted by fmt
+  uint64_t const ts{1579815761000023000};
+  char const* thread_id = "31341";
+  MacroMetadata macro_metadata{
+    __FILE__ ":" QUILL_STRINGIFY(__LINE__), __func__, "hello", nullptr, LogLevel::Info, MacroMetadata::Event::Log};
+
+  std::vector<std::string> const specifiers{":<12", ":>12", ":^12", ":^11", ":*^12", ":->12",
+                                            ":12",  ":3",   ":.3",  ":>.2", ":<1",   ":s"};
+
+  for (std::string const& logger_name : {std::string{"logger"}, std::string{"λόγος"}, std::string{}})
+  {
+    for (std::string const& specifier : specifiers)
+    {
+      PatternFormatter custom_pattern_formatter{PatternFormatterOptions{
+        "[%(logger" + specifier + ")] %(message)", "%H:%M:%S.%Qns", Timezone::GmtTime, false}};
+
+      auto const& formatted_buffer = custom_pattern_formatter.format(
+        ts, thread_id, thread_name, process_id, logger_name, "INFO", "I", macro_metadata, nullptr,
+        "hello", std::string_view{});
+
+      std::string const expected_string =
+        "[" + fmtquill::format(fmtquill::runtime("{" + specifier + "}"), logger_name) + "] hello\n";
+
+      REQUIRE_EQ(fmtquill::to_string(formatted_buffer), expected_string);
+    }
+  }
+}
+
+TEST_CASE("pattern_formatter_call_site_fragments")
+{
+  // The call site attributes are rendered once per MacroMetadata, runtime metadata reuses the
+  // same address for different call sites and is formatted each time
+  PatternFormatter custom_pattern_formatter{PatternFormatterOptions{
+    "%(short_source_location:<16) %(caller_function) [%(logger)] %(tags)%(message)",
+    "%H:%M:%S.%Qns", Timezone::GmtTime, false}};
+
+  uint64_t const ts{1579815761000023000};
+  char const* thread_id = "31341";
+
+  MacroMetadata first_macro_metadata{
+    "first.cpp:10", "first_function", "first", "#one ", LogLevel::Info, MacroMetadata::Event::Log};
+
+  MacroMetadata second_macro_metadata{
+    "second.cpp:20", "second_function", "second", nullptr, LogLevel::Info, MacroMetadata::Event::Log};
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    auto formatted_buffer = custom_pattern_formatter.format(
+      ts, thread_id, thread_name, process_id, "logger", "INFO", "I", first_macro_metadata,
+      nullptr, "first " + std::to_string(i), std::string_view{});
+
+    REQUIRE_EQ(fmtquill::to_string(formatted_buffer),
+               "first.cpp:10     first_function [logger] #one first " + std::to_string(i) + "\n");
+
+    formatted_buffer = custom_pattern_formatter.format(
+      ts, thread_id, thread_name, process_id, "other", "INFO", "I", second_macro_metadata,
+      nullptr, "second " + std::to_string(i), std::string_view{});
+
+    REQUIRE_EQ(fmtquill::to_string(formatted_buffer),
+               "second.cpp:20    second_function [other] second " + std::to_string(i) + "\n");
+  }
+
+  MacroMetadata runtime_macro_metadata{
+    "runtime.cpp:1", "runtime_function", "{}", nullptr, LogLevel::Info, MacroMetadata::Event::Log, true};
+
+  auto formatted_buffer = custom_pattern_formatter.format(
+    ts, thread_id, thread_name, process_id, "logger", "INFO", "I", runtime_macro_metadata, nullptr,
+    "runtime", std::string_view{});
+
+  REQUIRE_EQ(fmtquill::to_string(formatted_buffer), "runtime.cpp:1    runtime_function [logger] runtime\n");
+
+  runtime_macro_metadata = MacroMetadata{
+    "other.cpp:2", "other_function", "{}", nullptr, LogLevel::Info, MacroMetadata::Event::Log, true};
+
+  formatted_buffer = custom_pattern_formatter.format(ts, thread_id, thread_name, process_id, "logger",
+                                                     "INFO", "I", runtime_macro_metadata, nullptr,
+                                                     "runtime", std::string_view{});
+
+  REQUIRE_EQ(fmtquill::to_string(formatted_buffer), "other.cpp:2      other_function [logger] runtime\n");
+}
+
 TEST_SUITE_END();
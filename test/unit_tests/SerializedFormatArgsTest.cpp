@@ -0,0 +1,99 @@
+#include "doctest/doctest.h"
+
+#include "misc/DocTestExtensions.h"
+#include "quill/backend/SerializedFormatArgs.h"
+#include "quill/core/DynamicFormatArgStore.h"
+
+#include "quill/bundled/fmt/format.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+TEST_SUITE_BEGIN("SerializedFormatArgs");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+TEST_CASE("serialize_deserialize_format_args")
+{
+  DynamicFormatArgStore store;
+  store.push_back(-42);
+  store.push_back(7u);
+  store.push_back((std::numeric_limits<long long>::min)());
+  store.push_back((std::numeric_limits<unsigned long long>::max)());
+  store.push_back(true);
+  store.push_back('c');
+  store.push_back(1.5f);
+  store.push_back(2.25);
+  store.push_back(std::string_view{"abc"});
+  store.push_back("efg");
+  store.push_back(static_cast<void const*>(nullptr));
+
+  fmtquill::memory_buffer serialized_args;
+  REQUIRE(serialize_format_args(store, nullptr, serialized_args));
+
+  DynamicFormatArgStore deserialized_store;
+  REQUIRE(deserialize_format_args(std::string_view{serialized_args.data(), serialized_args.size()},
+                                  deserialized_store));
+  REQUIRE_EQ(deserialized_store.size(), store.size());
+
+  std::string const message_format = "{} {} {} {} {} {} {:.1f} {} {} {} {}";
+
+  std::string const expected = fmtquill::vformat(
+    message_format, fmtquill::basic_format_args<fmtquill::format_context>{store.data(), store.size()});
+
+  std::string const result = fmtquill::vformat(
+    message_format,
+    fmtquill::basic_format_args<fmtquill::format_context>{deserialized_store.data(),
+                                                          deserialized_store.size()});
+
+  REQUIRE_EQ(result, expected);
+  REQUIRE_EQ(result,
+             std::string{"-42 7 -9223372036854775808 18446744073709551615 true c 1.5 2.25 abc efg 0x0"});
+}
+
+/***/
+TEST_CASE("serialize_format_args_unsupported")
+{
+  fmtquill::memory_buffer serialized_args;
+
+  {
+    DynamicFormatArgStore store;
+    store.push_back(1.5L);
+    REQUIRE_FALSE(serialize_format_args(store, nullptr, serialized_args));
+  }
+
+  {
+    // Strings with a non-printable char are formatted and sanitized by the backend
+    DynamicFormatArgStore store;
+    store.push_back(std::string_view{"a\x01"});
+
+    serialized_args.clear();
+    REQUIRE(serialize_format_args(store, nullptr, serialized_args));
+
+    serialized_args.clear();
+    REQUIRE_FALSE(serialize_format_args(store, [](char c) { return c >= ' '; }, serialized_args));
+  }
+}
+
+/***/
+TEST_CASE("deserialize_format_args_truncated")
+{
+  DynamicFormatArgStore store;
+  store.push_back(42);
+  store.push_back(std::string_view{"abc"});
+
+  fmtquill::memory_buffer serialized_args;
+  REQUIRE(serialize_format_args(store, nullptr, serialized_args));
+
+  for (size_t size = 0; size < serialized_args.size(); ++size)
+  {
+    DynamicFormatArgStore deserialized_store;
+    REQUIRE_FALSE(deserialize_format_args(std::string_view{serialized_args.data(), size}, deserialized_store));
+  }
+}
+
+TEST_SUITE_END();
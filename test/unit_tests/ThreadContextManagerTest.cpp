@@ -4,6 +4,8 @@
 #include "quill/core/FrontendOptions.h"
 #include "quill/core/ThreadContextManager.h"
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <thread>
 
 TEST_SUITE_BEGIN("ThreadContextManager");
@@ -170,4 +172,68 @@ TEST_CASE("invalid_thread_context_counter_handles_large_batches")
   REQUIRE_FALSE(ThreadContextManager::instance().has_invalid_thread_context());
 }
 
+/***/
+TEST_CASE("thread_identity_table_is_bounded")
+{
+  ThreadIdentityTable thread_identities{4};
+
+  // The same thread id and name is interned once
+  ThreadIdentity const* first = thread_identities.intern(100, "worker");
+  REQUIRE_EQ(thread_identities.intern(100, "worker"), first);
+  REQUIRE_EQ(first->thread_id, "100");
+  REQUIRE_EQ(first->thread_name, "worker");
+
+  // A recycled thread id with another name gets its own identity while there is space
+  ThreadIdentity const* renamed = thread_identities.intern(100, "renamed");
+  REQUIRE_NE(renamed, first);
+  REQUIRE_EQ(renamed->thread_name, "renamed");
+
+  REQUIRE_NE(thread_identities.intern(101, "worker"), first);
+  REQUIRE_NE(thread_identities.intern(102, "worker"), first);
+  REQUIRE_EQ(thread_identities.size(), 4);
+
+  // Once full, the interned identities are still found
+  REQUIRE_EQ(thread_identities.intern(100, "worker"), first);
+  REQUIRE_EQ(thread_identities.intern(100, "renamed"), renamed);
+
+  // A new thread name or thread id gets no identity, instead of the identity of another thread
+  REQUIRE_EQ(thread_identities.intern(100, "other"), nullptr);
+  REQUIRE_EQ(thread_identities.intern(103, "worker"), nullptr);
+  REQUIRE_EQ(thread_identities.size(), 4);
+}
+
+/***/
+TEST_CASE("pause_consumer_waits_for_the_backend_to_stop_reading")
+{
+  ThreadContextManager& manager = ThreadContextManager::instance();
+
+  // Nothing reads the queues, the pause is granted immediately
+  REQUIRE(manager.pause_consumer(0));
+  manager.resume_consumer();
+
+  // The consumer is reading the queues and does not stop within the timeout
+  manager.begin_consume();
+  REQUIRE_FALSE(manager.pause_consumer(5'000'000));
+  manager.end_consume();
+
+  // While paused, the consumer blocks in begin_consume() until resume_consumer()
+  REQUIRE(manager.pause_consumer(0));
+
+  std::atomic<bool> consuming{false};
+  std::thread consumer(
+    [&manager, &consuming]()
+    {
+      manager.begin_consume();
+      consuming.store(true);
+      manager.end_consume();
+    });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  REQUIRE_FALSE(consuming.load());
+
+  manager.resume_consumer();
+  consumer.join();
+  REQUIRE(consuming.load());
+}
+
 TEST_SUITE_END();
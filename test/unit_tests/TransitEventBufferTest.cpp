@@ -142,7 +142,7 @@ TEST_CASE("transit_event_unbounded_buffer")
 /***/
 TEST_CASE("transit_event_large_format_buffer_with_reallocations")
 {
-  // Test with FormatBuffer > 128 bytes (TransitEvent::FormatBuffer stack size is 88)
+  // Test with messages longer than the inline storage of TransitEvent::FormatBuffer (144 bytes)
   // Use random sizes [20, 512] to trigger various reallocation scenarios
   TransitEventBuffer bte{4};
 
@@ -158,8 +158,8 @@ TEST_CASE("transit_event_large_format_buffer_with_reallocations")
     TransitEvent* te = bte.back();
     REQUIRE(te);
 
-    te->formatted_msg->clear();
-    te->formatted_msg->append(large_string.data(), large_string.data() + large_string.size());
+    te->formatted_msg.clear();
+    te->formatted_msg.append(large_string.data(), large_string.data() + large_string.size());
 
     // Also store named args with iteration number for validation
     te->extra_data = std::make_unique<TransitEvent::ExtraData>();
@@ -174,7 +174,7 @@ TEST_CASE("transit_event_large_format_buffer_with_reallocations")
       // Pull same record and verify again
       TransitEvent* te2 = bte.back();
       REQUIRE(te2);
-      std::string_view actual_msg(te2->formatted_msg->data(), te2->formatted_msg->size());
+      std::string_view actual_msg(te2->formatted_msg.data(), te2->formatted_msg.size());
       REQUIRE_EQ(actual_msg, large_string);
     }
 
@@ -194,8 +194,8 @@ TEST_CASE("transit_event_large_format_buffer_with_reallocations")
       REQUIRE(te);
 
       // Check formatted_msg content and size
-      REQUIRE_EQ(te->formatted_msg->size(), expected_data[i].first);
-      std::string_view actual_msg(te->formatted_msg->data(), te->formatted_msg->size());
+      REQUIRE_EQ(te->formatted_msg.size(), expected_data[i].first);
+      std::string_view actual_msg(te->formatted_msg.data(), te->formatted_msg.size());
       REQUIRE_EQ(actual_msg, expected_data[i].second);
 
       // Verify named_args are intact
@@ -227,8 +227,8 @@ TEST_CASE("transit_event_buffer_shrink_and_regrow")
     TransitEvent* te = bte.back();
     REQUIRE(te);
 
-    te->formatted_msg->clear();
-    te->formatted_msg->append(data.data(), data.data() + data.size());
+    te->formatted_msg.clear();
+    te->formatted_msg.append(data.data(), data.data() + data.size());
 
     te->extra_data = std::make_unique<TransitEvent::ExtraData>();
     te->extra_data->named_args.clear();
@@ -246,7 +246,7 @@ TEST_CASE("transit_event_buffer_shrink_and_regrow")
   {
     TransitEvent* te = bte.front();
     REQUIRE(te);
-    std::string_view msg(te->formatted_msg->data(), te->formatted_msg->size());
+    std::string_view msg(te->formatted_msg.data(), te->formatted_msg.size());
     REQUIRE_EQ(msg, phase1_data[i]);
     bte.pop_front();
   }
@@ -269,8 +269,8 @@ TEST_CASE("transit_event_buffer_shrink_and_regrow")
     TransitEvent* te = bte.back();
     REQUIRE(te);
 
-    te->formatted_msg->clear();
-    te->formatted_msg->append(large_data.data(), large_data.data() + large_data.size());
+    te->formatted_msg.clear();
+    te->formatted_msg.append(large_data.data(), large_data.data() + large_data.size());
 
     te->extra_data = std::make_unique<TransitEvent::ExtraData>();
     te->extra_data->named_args.clear();
@@ -288,8 +288,8 @@ TEST_CASE("transit_event_buffer_shrink_and_regrow")
     TransitEvent* te = bte.front();
     REQUIRE(te);
 
-    REQUIRE_EQ(te->formatted_msg->size(), phase4_data[i].second);
-    std::string_view actual(te->formatted_msg->data(), te->formatted_msg->size());
+    REQUIRE_EQ(te->formatted_msg.size(), phase4_data[i].second);
+    std::string_view actual(te->formatted_msg.data(), te->formatted_msg.size());
     REQUIRE_EQ(actual, phase4_data[i].first);
 
     std::string expected_key = "regrow_" + std::to_string(i);
@@ -326,8 +326,8 @@ TEST_CASE("transit_event_buffer_interleaved_operations")
       REQUIRE(te);
 
       // Test formatted_msg with heap-allocated buffer
-      te->formatted_msg->clear();
-      te->formatted_msg->append(data.data(), data.data() + data.size());
+      te->formatted_msg.clear();
+      te->formatted_msg.append(data.data(), data.data() + data.size());
 
       // Test extra_data with named_args
       te->extra_data = std::make_unique<TransitEvent::ExtraData>();
@@ -349,8 +349,8 @@ TEST_CASE("transit_event_buffer_interleaved_operations")
       REQUIRE(te);
 
       // Verify formatted_msg content matches
-      REQUIRE_EQ(te->formatted_msg->size(), active_data[0].second);
-      std::string_view actual_msg(te->formatted_msg->data(), te->formatted_msg->size());
+      REQUIRE_EQ(te->formatted_msg.size(), active_data[0].second);
+      std::string_view actual_msg(te->formatted_msg.data(), te->formatted_msg.size());
       REQUIRE_EQ(actual_msg, active_data[0].first);
 
       // Verify named_args are valid
@@ -371,8 +371,8 @@ TEST_CASE("transit_event_buffer_interleaved_operations")
     TransitEvent* te = bte.front();
     REQUIRE(te);
 
-    REQUIRE_EQ(te->formatted_msg->size(), active_data[0].second);
-    std::string_view actual_msg(te->formatted_msg->data(), te->formatted_msg->size());
+    REQUIRE_EQ(te->formatted_msg.size(), active_data[0].second);
+    std::string_view actual_msg(te->formatted_msg.data(), te->formatted_msg.size());
     REQUIRE_EQ(actual_msg, active_data[0].first);
 
     bte.pop_front();
@@ -395,8 +395,8 @@ TEST_CASE("transit_event_buffer_shrink_flag_with_move_semantics")
     TransitEvent* te = bte1.back();
     REQUIRE(te);
     std::string data = "test_" + std::to_string(i);
-    te->formatted_msg->clear();
-    te->formatted_msg->append(data.data(), data.data() + data.size());
+    te->formatted_msg.clear();
+    te->formatted_msg.append(data.data(), data.data() + data.size());
     bte1.push_back();
   }
 
@@ -433,8 +433,8 @@ TEST_CASE("transit_event_copy_to_backtrace_scenario")
   REQUIRE(te1);
 
   std::string large_msg(300, 'A');
-  te1->formatted_msg->clear();
-  te1->formatted_msg->append(large_msg.data(), large_msg.data() + large_msg.size());
+  te1->formatted_msg.clear();
+  te1->formatted_msg.append(large_msg.data(), large_msg.data() + large_msg.size());
 
   te1->extra_data = std::make_unique<TransitEvent::ExtraData>();
   te1->extra_data->named_args.emplace_back("key1", "value1");
@@ -450,9 +450,8 @@ TEST_CASE("transit_event_copy_to_backtrace_scenario")
   original->copy_to(copy_event);
 
   // Verify the copy is independent and correct
-  REQUIRE(copy_event.formatted_msg);
-  REQUIRE_EQ(copy_event.formatted_msg->size(), 300);
-  REQUIRE_EQ(std::string_view(copy_event.formatted_msg->data(), copy_event.formatted_msg->size()), large_msg);
+  REQUIRE_EQ(copy_event.formatted_msg.size(), 300);
+  REQUIRE_EQ(std::string_view(copy_event.formatted_msg.data(), copy_event.formatted_msg.size()), large_msg);
 
   REQUIRE(copy_event.extra_data);
   REQUIRE_EQ(copy_event.extra_data->named_args.size(), 2);
@@ -461,10 +460,10 @@ TEST_CASE("transit_event_copy_to_backtrace_scenario")
 
   // Modify original and verify copy is unaffected
   std::string modified = "MODIFIED";
-  original->formatted_msg->clear();
-  original->formatted_msg->append(modified.data(), modified.data() + modified.size());
+  original->formatted_msg.clear();
+  original->formatted_msg.append(modified.data(), modified.data() + modified.size());
 
-  REQUIRE_EQ(std::string_view(copy_event.formatted_msg->data(), copy_event.formatted_msg->size()), large_msg);
+  REQUIRE_EQ(std::string_view(copy_event.formatted_msg.data(), copy_event.formatted_msg.size()), large_msg);
 
   bte.pop_front();
   REQUIRE(bte.empty());
@@ -473,7 +472,7 @@ TEST_CASE("transit_event_copy_to_backtrace_scenario")
 /***/
 TEST_CASE("transit_event_formatted_msg_validity_after_expansion")
 {
-  // Test that formatted_msg unique_ptr remains valid after buffer expansion
+  // Test that formatted_msg keeps its contents after buffer expansion
   // This tests for potential issues with move semantics and reallocation
   TransitEventBuffer bte{2};
 
@@ -482,11 +481,10 @@ TEST_CASE("transit_event_formatted_msg_validity_after_expansion")
   {
     TransitEvent* te = bte.back();
     REQUIRE(te);
-    REQUIRE(te->formatted_msg); // Should always be valid
 
     std::string data = "test_" + std::to_string(i);
-    te->formatted_msg->clear();
-    te->formatted_msg->append(data.data(), data.data() + data.size());
+    te->formatted_msg.clear();
+    te->formatted_msg.append(data.data(), data.data() + data.size());
 
     bte.push_back();
   }
@@ -497,12 +495,11 @@ TEST_CASE("transit_event_formatted_msg_validity_after_expansion")
   // Next back() call will trigger expansion
   TransitEvent* te_new = bte.back();
   REQUIRE(te_new);
-  REQUIRE(te_new->formatted_msg);
 
   // Verify we can use it safely
-  te_new->formatted_msg->clear();
+  te_new->formatted_msg.clear();
   std::string large_data(200, 'X');
-  te_new->formatted_msg->append(large_data.data(), large_data.data() + large_data.size());
+  te_new->formatted_msg.append(large_data.data(), large_data.data() + large_data.size());
 
   bte.push_back();
 
@@ -515,8 +512,7 @@ TEST_CASE("transit_event_formatted_msg_validity_after_expansion")
   {
     TransitEvent* te = bte.front();
     REQUIRE(te);
-    REQUIRE(te->formatted_msg); // Must still be valid
-    REQUIRE_GT(te->formatted_msg->size(), 0);
+    REQUIRE_GT(te->formatted_msg.size(), 0);
     bte.pop_front();
   }
 
@@ -598,22 +594,21 @@ TEST_CASE("transit_event_buffer_stress_test")
     {
       TransitEvent* te = bte.back();
       REQUIRE(te);
-      REQUIRE(te->formatted_msg);
 
       // Populate with large formatted_msg (20 to 8192 bytes) to stress memory
       size_t msg_size = 20 + (std::rand() % 8173);
-      te->formatted_msg->clear();
-      te->formatted_msg->reserve(msg_size);
+      te->formatted_msg.clear();
+      te->formatted_msg.reserve(msg_size);
 
       // Fill with recognizable pattern
       char pattern_char = 'A' + (global_event_id % 26);
       for (size_t i = 0; i < msg_size; ++i)
       {
-        te->formatted_msg->push_back(pattern_char);
+        te->formatted_msg.push_back(pattern_char);
       }
       te->timestamp = global_event_id;
 
-      REQUIRE_EQ(te->formatted_msg->size(), msg_size);
+      REQUIRE_EQ(te->formatted_msg.size(), msg_size);
 
       bte.push_back();
       global_event_id++;
@@ -626,7 +621,6 @@ TEST_CASE("transit_event_buffer_stress_test")
     {
       TransitEvent* te = bte.front();
       REQUIRE(te);
-      REQUIRE(te->formatted_msg);
 
       size_t expected_id = (iteration * total_events) + pop_idx;
 
@@ -634,9 +628,9 @@ TEST_CASE("transit_event_buffer_stress_test")
 
       // Verify formatted_msg pattern
       char expected_char = 'A' + (expected_id % 26);
-      for (size_t i = 0; i < te->formatted_msg->size(); ++i)
+      for (size_t i = 0; i < te->formatted_msg.size(); ++i)
       {
-        REQUIRE_EQ((*te->formatted_msg)[i], expected_char);
+        REQUIRE_EQ(te->formatted_msg[i], expected_char);
       }
 
       bte.pop_front();
@@ -658,4 +652,48 @@ TEST_CASE("transit_event_buffer_stress_test")
   REQUIRE_EQ(global_event_id, 12800);
 }
 
+/***/
+TEST_CASE("transit_event_buffer_at_index_after_expansion")
+{
+  // The formatter threads reference the events by their index from the front, the events are
+  // moved when the buffer expands
+  TransitEventBuffer bte{4};
+
+  std::vector<size_t> indexes;
+
+  for (size_t i = 0; i < 20; ++i)
+  {
+    TransitEvent* te = bte.back();
+    REQUIRE(te);
+    te->timestamp = i;
+    indexes.push_back(bte.size());
+    bte.push_back();
+  }
+
+  REQUIRE_GT(bte.capacity(), 4);
+
+  // The events are formatted after all of them were pushed
+  for (size_t i = 0; i < indexes.size(); ++i)
+  {
+    TransitEvent* te = bte.at(indexes[i]);
+    REQUIRE_EQ(te->timestamp, i);
+
+    std::string const data(i * 20, 'A' + static_cast<char>(i % 26));
+    te->formatted_msg.clear();
+    te->formatted_msg.append(data.data(), data.data() + data.size());
+  }
+
+  for (size_t i = 0; i < indexes.size(); ++i)
+  {
+    TransitEvent* te = bte.front();
+    REQUIRE(te);
+    REQUIRE_EQ(te->timestamp, i);
+    REQUIRE_EQ(std::string_view(te->formatted_msg.data(), te->formatted_msg.size()),
+               std::string(i * 20, 'A' + static_cast<char>(i % 26)));
+    bte.pop_front();
+  }
+
+  REQUIRE(bte.empty());
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,113 @@
+#include "doctest/doctest.h"
+
+#include "quill/backend/TransitEventHeap.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+TEST_SUITE_BEGIN("TransitEventHeap");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+TEST_CASE("transit_event_heap_pops_in_timestamp_order")
+{
+  TransitEventHeap<size_t> heap;
+  REQUIRE(heap.empty());
+
+  std::vector<uint64_t> const timestamps{50, 10, 40, 30, 20, 60, 0, 70};
+
+  for (size_t i = 0; i < timestamps.size(); ++i)
+  {
+    heap.push(timestamps[i], i);
+  }
+
+  REQUIRE_EQ(heap.size(), timestamps.size());
+
+  std::vector<uint64_t> popped;
+  while (!heap.empty())
+  {
+    popped.push_back(heap.top_timestamp());
+    REQUIRE_EQ(timestamps[heap.top()], heap.top_timestamp());
+    heap.pop();
+  }
+
+  REQUIRE(std::is_sorted(popped.begin(), popped.end()));
+  REQUIRE_EQ(popped.size(), timestamps.size());
+}
+
+/***/
+TEST_CASE("transit_event_heap_equal_timestamps_are_fifo")
+{
+  TransitEventHeap<size_t> heap;
+
+  for (size_t i = 0; i < 16; ++i)
+  {
+    heap.push(100, i);
+  }
+
+  for (size_t i = 0; i < 16; ++i)
+  {
+    REQUIRE_EQ(heap.top(), i);
+    heap.pop();
+  }
+
+  REQUIRE(heap.empty());
+}
+
+/***/
+TEST_CASE("transit_event_heap_merges_sorted_sequences")
+{
+  // Simulates the backend: every owner has a sorted sequence of timestamps and stays in the heap
+  // until its sequence is drained
+  static constexpr size_t number_of_owners = 37;
+  static constexpr size_t events_per_owner = 100;
+
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<uint64_t> dist{1, 1000};
+
+  std::vector<std::vector<uint64_t>> owners(number_of_owners);
+  for (auto& owner : owners)
+  {
+    uint64_t timestamp{0};
+    for (size_t i = 0; i < events_per_owner; ++i)
+    {
+      timestamp += dist(gen);
+      owner.push_back(timestamp);
+    }
+  }
+
+  std::vector<size_t> positions(number_of_owners, 0);
+  TransitEventHeap<size_t> heap;
+
+  for (size_t owner = 0; owner < number_of_owners; ++owner)
+  {
+    heap.push(owners[owner].front(), owner);
+  }
+
+  std::vector<uint64_t> merged;
+  while (!heap.empty())
+  {
+    size_t const owner = heap.top();
+    merged.push_back(owners[owner][positions[owner]]);
+
+    if (++positions[owner] < events_per_owner)
+    {
+      heap.replace_top(owners[owner][positions[owner]], owner);
+    }
+    else
+    {
+      heap.pop();
+    }
+  }
+
+  REQUIRE_EQ(merged.size(), number_of_owners * events_per_owner);
+  REQUIRE(std::is_sorted(merged.begin(), merged.end()));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,120 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include "quill/BinaryLogReader.h"
+#include "quill/backend/PatternFormatter.h"
+#include "quill/core/PatternFormatterOptions.h"
+#include "quill/sinks/JsonSink.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <string_view>
+
+/**
+ * Decodes a file written by quill::BinaryFileSink to text or json on stdout.
+ *
+ * Usage: quill_decode [--json] [--pattern <format_pattern>] [--time-pattern <timestamp_pattern>]
+ *                     [--gmt] <file>
+ */
+
+namespace
+{
+void print_usage()
+{
+  std::fprintf(stderr,
+               "Usage: quill_decode [--json] [--pattern <format_pattern>] "
+               "[--time-pattern <timestamp_pattern>] [--gmt] <file>\n");
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  quill::PatternFormatterOptions pattern_formatter_options;
+  bool json_output{false};
+  char const* filename{nullptr};
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string_view const arg{argv[i]};
+
+    if (arg == "--json")
+    {
+      json_output = true;
+    }
+    else if ((arg == "--pattern") && (i + 1 < argc))
+    {
+      pattern_formatter_options.format_pattern = argv[++i];
+    }
+    else if ((arg == "--time-pattern") && (i + 1 < argc))
+    {
+      pattern_formatter_options.timestamp_pattern = argv[++i];
+    }
+    else if (arg == "--gmt")
+    {
+      pattern_formatter_options.timestamp_timezone = quill::Timezone::GmtTime;
+    }
+    else if (!filename && (arg.empty() || arg[0] != '-'))
+    {
+      filename = argv[i];
+    }
+    else
+    {
+      print_usage();
+      return 1;
+    }
+  }
+
+  if (!filename)
+  {
+    print_usage();
+    return 1;
+  }
+
+  try
+  {
+    quill::BinaryLogReader reader{filename};
+    quill::BinaryLogRecord record;
+
+    if (json_output)
+    {
+      // Reuse the json sink so the output is identical to JsonConsoleSink
+      quill::JsonConsoleSink json_sink;
+
+      while (reader.read_next(record))
+      {
+        json_sink.write_log(record.metadata, record.timestamp, record.thread_id, record.thread_name,
+                            std::string{record.process_id}, record.logger_name, record.log_level,
+                            record.log_level_description, record.log_level_short_code,
+                            record.named_args, record.log_message, std::string_view{});
+      }
+
+      json_sink.flush_sink();
+    }
+    else
+    {
+      quill::PatternFormatter pattern_formatter{pattern_formatter_options};
+
+      while (reader.read_next(record))
+      {
+        std::string_view const log_statement = pattern_formatter.format(
+          record.timestamp, record.thread_id, record.thread_name, record.process_id,
+          record.logger_name, record.log_level_description, record.log_level_short_code,
+          *record.metadata, record.named_args, record.log_message, std::string_view{});
+
+        std::fwrite(log_statement.data(), sizeof(char), log_statement.size(), stdout);
+      }
+    }
+  }
+  catch (std::exception const& e)
+  {
+    std::fprintf(stderr, "quill_decode: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @page copyright
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include "quill/FlightRecorderReader.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <exception>
+#include <string_view>
+
+/**
+ * Prints the records of a file written by quill::FlightRecorderSink on stdout, from the oldest to
+ * the newest.
+ *
+ * Usage: quill_flight_recorder [--sequence] <file>
+ */
+
+namespace
+{
+void print_usage() { std::fprintf(stderr, "Usage: quill_flight_recorder [--sequence] <file>\n"); }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  bool print_sequence{false};
+  char const* filename{nullptr};
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string_view const arg{argv[i]};
+
+    if (arg == "--sequence")
+    {
+      print_sequence = true;
+    }
+    else if (!filename && (arg.empty() || arg[0] != '-'))
+    {
+      filename = argv[i];
+    }
+    else
+    {
+      print_usage();
+      return 1;
+    }
+  }
+
+  if (!filename)
+  {
+    print_usage();
+    return 1;
+  }
+
+  try
+  {
+    quill::FlightRecorderReader reader{filename};
+    quill::FlightRecorderRecord record;
+
+    while (reader.read_next(record))
+    {
+      if (print_sequence)
+      {
+        std::fprintf(stdout, "%" PRIu64 " ", record.sequence);
+      }
+
+      std::fwrite(record.log_statement.data(), sizeof(char), record.log_statement.size(), stdout);
+    }
+  }
+  catch (std::exception const& e)
+  {
+    std::fprintf(stderr, "quill_flight_recorder: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}